@@ -22,6 +22,7 @@
 #include "any.h"
 #include "message.h"
 #include <kj/compat/gtest.h>
+#include <kj/map.h>
 #include "test-util.h"
 
 namespace capnp {
@@ -375,6 +376,7 @@ KJ_TEST("Bit list with nonzero pad bits") {
 
   // Should be equal, despite nonzero padding.
   KJ_ASSERT(message1.getRoot<AnyList>() == message2.getRoot<AnyList>());
+  KJ_EXPECT(message1.getRoot<AnyList>().hashCode() == message2.getRoot<AnyList>().hashCode());
 }
 
 KJ_TEST("Pointer list unequal to struct list") {
@@ -434,6 +436,127 @@ KJ_TEST("Truncating non-null pointer fields does not preserve equality") {
             message1.getRoot<AnyPointer>().equals(message2.getRoot<AnyPointer>()));
 }
 
+KJ_TEST("structural hash agrees across encodings") {
+  MallocMessageBuilder builder;
+  initTestMessage(builder.initRoot<TestAllTypes>());
+  auto reader = builder.getRoot<AnyStruct>().asReader();
+
+  // Every object in its own segment, connected by far pointers.
+  MallocMessageBuilder farBuilder(1, AllocationStrategy::FIXED_SIZE);
+  initTestMessage(farBuilder.initRoot<TestAllTypes>());
+  KJ_ASSERT(farBuilder.getSegmentsForOutput().size() > 1);
+  auto farReader = farBuilder.getRoot<AnyStruct>().asReader();
+
+  auto canonical = reader.canonicalize();
+  auto canonicalReader = readMessageUnchecked<AnyStruct>(canonical.begin());
+
+  KJ_EXPECT(farReader == reader);
+  KJ_EXPECT(canonicalReader == reader);
+  KJ_EXPECT(farReader.hashCode() == reader.hashCode());
+  KJ_EXPECT(canonicalReader.hashCode() == reader.hashCode());
+  KJ_EXPECT(builder.getRoot<AnyPointer>().hashCode() ==
+            farBuilder.getRoot<AnyPointer>().hashCode());
+
+  // An old-version struct and a new-version struct whose extra fields are unset differ only in
+  // their section sizes.
+  MallocMessageBuilder oldBuilder;
+  auto oldRoot = oldBuilder.initRoot<test::TestOldVersion>();
+  oldRoot.setOld1(123);
+  oldRoot.setOld2("foo");
+  MallocMessageBuilder newBuilder;
+  auto newRoot = newBuilder.initRoot<test::TestNewVersion>();
+  newRoot.setOld1(123);
+  newRoot.setOld2("foo");
+  auto oldReader = oldBuilder.getRoot<AnyStruct>().asReader();
+  auto newReader = newBuilder.getRoot<AnyStruct>().asReader();
+  KJ_EXPECT(oldReader.getDataSection().size() != newReader.getDataSection().size());
+  KJ_EXPECT(oldReader == newReader);
+  KJ_EXPECT(oldReader.hashCode() == newReader.hashCode());
+
+  newRoot.setOld1(124);
+  KJ_EXPECT(oldReader != newReader);
+  KJ_EXPECT(oldReader.hashCode() != newReader.hashCode());
+}
+
+KJ_TEST("structural hash distinguishes values") {
+  MallocMessageBuilder builderA;
+  auto rootA = builderA.initRoot<TestAllTypes>();
+  initTestMessage(rootA);
+  MallocMessageBuilder builderB;
+  auto rootB = builderB.initRoot<TestAllTypes>();
+  initTestMessage(rootB);
+  auto anyA = builderA.getRoot<AnyStruct>();
+  auto anyB = builderB.getRoot<AnyStruct>();
+  KJ_EXPECT(anyA.hashCode() == anyB.hashCode());
+
+  rootB.getStructField().setTextField("buzz");
+  KJ_EXPECT(anyA.hashCode() != anyB.hashCode());
+  rootA.getStructField().setTextField("buzz");
+  KJ_EXPECT(anyA.hashCode() == anyB.hashCode());
+
+  rootA.getBoolList().set(2, true);
+  KJ_EXPECT(anyA.hashCode() != anyB.hashCode());
+  rootB.getBoolList().set(2, true);
+  KJ_EXPECT(anyA.hashCode() == anyB.hashCode());
+
+  rootA.setUInt64Field(0);
+  KJ_EXPECT(anyA.hashCode() != anyB.hashCode());
+
+  // A null pointer, an empty struct and an empty list are all different.
+  MallocMessageBuilder empty;
+  auto emptyRoot = empty.initRoot<test::TestAnyPointer>();
+  auto field = emptyRoot.getAnyPointerField();
+  uint nullHash = field.hashCode();
+  field.initAsAnyStruct(0, 0);
+  uint structHash = field.hashCode();
+  field.initAsAnyList(ElementSize::VOID, 0);
+  uint listHash = field.hashCode();
+  KJ_EXPECT(nullHash != structHash);
+  KJ_EXPECT(nullHash != listHash);
+  KJ_EXPECT(structHash != listHash);
+}
+
+KJ_TEST("structs as hash table keys") {
+  // Index readers from one message, then look them up with equal readers from another.
+
+  MallocMessageBuilder builder;
+  auto list = builder.initRoot<test::TestAllTypes>().initStructList(100);
+  for (auto i: kj::indices(list)) {
+    list[i].setInt32Field(i % 10);
+    list[i].setTextField(kj::str("item", i % 10));
+  }
+
+  kj::HashMap<AnyStruct::Reader, uint> index;
+  for (auto i: kj::indices(list)) {
+    index.upsert(list.asReader()[i], 1, [](uint& count, uint&&) { ++count; });
+  }
+  KJ_EXPECT(index.size() == 10);
+
+  MallocMessageBuilder probeBuilder;
+  auto probe = probeBuilder.initRoot<TestAllTypes>();
+  probe.setInt32Field(3);
+  probe.setTextField("item3");
+  KJ_EXPECT(KJ_ASSERT_NONNULL(index.find(probeBuilder.getRoot<AnyStruct>().asReader())) == 10);
+
+  probe.setTextField("item4");
+  KJ_EXPECT(index.find(probeBuilder.getRoot<AnyStruct>().asReader()) == nullptr);
+}
+
+KJ_TEST("benchmark: structural hash") {
+  MallocMessageBuilder builder;
+  initTestMessage(builder.initRoot<TestAllTypes>());
+  auto reader = builder.getRoot<AnyStruct>().asReader();
+
+  uint hash = reader.hashCode();
+  doBenchmark([&]() {
+    KJ_ASSERT(reader.hashCode() == hash);
+  });
+  doBenchmark([&]() {
+    auto canonical = reader.canonicalize();
+    KJ_ASSERT(kj::hashCode(canonical.asBytes()) != 0);
+  });
+}
+
 }  // namespace
 }  // namespace _ (private)
 }  // namespace capnp
@@ -22,6 +22,7 @@
 #include "any.h"
 
 #include <kj/debug.h>
+#include <kj/hash.h>
 
 #if !CAPNP_LITE
 #include "capability.h"
@@ -79,18 +80,68 @@ kj::Own<ClientHook> AnyPointer::Pipeline::asCap() {
 
 #endif  // !CAPNP_LITE
 
+namespace {
+
+size_t trimTrailingZeros(kj::ArrayPtr<const byte> bytes) {
+  // Returns the size of `bytes` with trailing zero bytes removed. Data sections are mostly made
+  // of whole words, so skip zero words eight bytes at a time before finishing bytewise.
+
+  size_t size = bytes.size();
+  while (size >= sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, bytes.begin() + size - sizeof(uint64_t), sizeof(word));
+    if (word != 0) break;
+    size -= sizeof(uint64_t);
+  }
+  while (size > 0 && bytes[size - 1] == 0) {
+    -- size;
+  }
+  return size;
+}
+
+size_t trimTrailingNulls(List<AnyPointer>::Reader ptrs) {
+  size_t size = ptrs.size();
+  while (size > 0 && ptrs[size - 1].isNull()) {
+    -- size;
+  }
+  return size;
+}
+
+class StructuralHasher {
+  // Incremental murmur2 combiner, matching the way kj::hashCode() combines array elements.
+
+public:
+  explicit StructuralHasher(uint seed): h(seed) {}
+
+  void add(uint k) {
+    k *= m;
+    k ^= k >> r;
+    k *= m;
+    h *= m;
+    h ^= k;
+  }
+
+  uint finish() {
+    h ^= h >> 13;
+    h *= m;
+    h ^= h >> 15;
+    return h;
+  }
+
+private:
+  static constexpr uint m = 0x5bd1e995;
+  static constexpr uint r = 24;
+  uint h;
+};
+
+}  // namespace
+
 Equality AnyStruct::Reader::equals(AnyStruct::Reader right) const {
   auto dataL = getDataSection();
-  size_t dataSizeL = dataL.size();
-  while(dataSizeL > 0 && dataL[dataSizeL - 1] == 0) {
-    -- dataSizeL;
-  }
+  size_t dataSizeL = trimTrailingZeros(dataL);
 
   auto dataR = right.getDataSection();
-  size_t dataSizeR = dataR.size();
-  while(dataSizeR > 0 && dataR[dataSizeR - 1] == 0) {
-    -- dataSizeR;
-  }
+  size_t dataSizeR = trimTrailingZeros(dataR);
 
   if(dataSizeL != dataSizeR) {
     return Equality::NOT_EQUAL;
@@ -101,16 +152,10 @@ Equality AnyStruct::Reader::equals(AnyStruct::Reader right) const {
   }
 
   auto ptrsL = getPointerSection();
-  size_t ptrsSizeL = ptrsL.size();
-  while (ptrsSizeL > 0 && ptrsL[ptrsSizeL - 1].isNull()) {
-    -- ptrsSizeL;
-  }
+  size_t ptrsSizeL = trimTrailingNulls(ptrsL);
 
   auto ptrsR = right.getPointerSection();
-  size_t ptrsSizeR = ptrsR.size();
-  while (ptrsSizeR > 0 && ptrsR[ptrsSizeR - 1].isNull()) {
-    -- ptrsSizeR;
-  }
+  size_t ptrsSizeR = trimTrailingNulls(ptrsR);
 
   if(ptrsSizeL != ptrsSizeR) {
     return Equality::NOT_EQUAL;
@@ -227,6 +272,77 @@ Equality AnyPointer::Reader::equals(AnyPointer::Reader right) const {
   KJ_UNREACHABLE;
 }
 
+uint AnyStruct::Reader::hashCode() const {
+  // Must agree with equals(): trailing zero data bytes and trailing null pointers don't count,
+  // so that the same value encoded with different section sizes hashes the same.
+
+  auto data = getDataSection();
+  size_t dataSize = trimTrailingZeros(data);
+  auto ptrs = getPointerSection();
+  size_t ptrsSize = trimTrailingNulls(ptrs);
+
+  StructuralHasher hasher(ptrsSize);
+  hasher.add(kj::hashCode(data.slice(0, dataSize)));
+  for (size_t i = 0; i < ptrsSize; i++) {
+    hasher.add(ptrs[i].hashCode());
+  }
+  return hasher.finish();
+}
+
+uint AnyList::Reader::hashCode() const {
+  StructuralHasher hasher(size());
+  hasher.add(static_cast<uint>(getElementSize()));
+
+  switch(getElementSize()) {
+    case ElementSize::VOID:
+    case ElementSize::BIT:
+    case ElementSize::BYTE:
+    case ElementSize::TWO_BYTES:
+    case ElementSize::FOUR_BYTES:
+    case ElementSize::EIGHT_BYTES: {
+      auto bytes = getRawBytes();
+
+      if (getElementSize() == ElementSize::BIT && size() % 8 != 0) {
+        // As in equals(), ignore the padding bits after the last element.
+        uint8_t mask = (1 << (size() % 8)) - 1;
+        hasher.add(bytes[bytes.size() - 1] & mask);
+        bytes = bytes.slice(0, bytes.size() - 1);
+      }
+
+      hasher.add(kj::hashCode(bytes));
+      return hasher.finish();
+    }
+    case ElementSize::POINTER:
+    case ElementSize::INLINE_COMPOSITE: {
+      for (auto element: as<List<AnyStruct>>()) {
+        hasher.add(element.hashCode());
+      }
+      return hasher.finish();
+    }
+  }
+  KJ_UNREACHABLE;
+}
+
+uint AnyPointer::Reader::hashCode() const {
+  // Capabilities can't be compared, so they all hash alike; equals() reports
+  // UNKNOWN_CONTAINS_CAPS for them anyway.
+
+  auto type = getPointerType();
+  StructuralHasher hasher(static_cast<uint>(type));
+  switch(type) {
+    case PointerType::NULL_:
+    case PointerType::CAPABILITY:
+      break;
+    case PointerType::STRUCT:
+      hasher.add(getAs<AnyStruct>().hashCode());
+      break;
+    case PointerType::LIST:
+      hasher.add(getAs<AnyList>().hashCode());
+      break;
+  }
+  return hasher.finish();
+}
+
 bool AnyPointer::Reader::operator==(AnyPointer::Reader right) const {
   switch(equals(right)) {
     case Equality::EQUAL:
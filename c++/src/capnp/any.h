@@ -110,6 +110,11 @@ struct AnyPointer {
       return !(*this == right);
     }
 
+    uint hashCode() const;
+    // Structural hash consistent with equals(): pointers that compare EQUAL hash alike, however
+    // they are encoded. This makes readers usable as keys in kj::HashMap and friends. All
+    // capabilities hash alike.
+
     template <typename T>
     inline ReaderFor<T> getAs() const;
     // Valid for T = any generated struct type, interface type, List<U>, Text, or Data.
@@ -167,6 +172,7 @@ struct AnyPointer {
     inline bool operator!=(AnyPointer::Reader right) const {
       return !(*this == right);
     }
+    inline uint hashCode() const { return asReader().hashCode(); }
 
     inline void clear();
     // Set to null.
@@ -483,6 +489,11 @@ public:
     return !(*this == right);
   }
 
+  uint hashCode() const;
+  // Structural hash consistent with equals(). Trailing zero data and trailing null pointers are
+  // ignored, so a struct hashes the same whether it was written by an older or newer version of
+  // its schema, canonicalized or not.
+
   template <typename T>
   ReaderFor<T> as() const {
     // T must be a struct type.
@@ -499,6 +510,7 @@ private:
   template <typename, Kind>
   friend struct _::PointerHelpers;
   friend class Orphanage;
+  friend class FieldMask;
 };
 
 class AnyStruct::Builder {
@@ -530,6 +542,7 @@ public:
   inline bool operator!=(AnyStruct::Reader right) const {
     return !(*this == right);
   }
+  inline uint hashCode() const { return asReader().hashCode(); }
 
   inline operator Reader() const { return Reader(_builder.asReader()); }
   inline Reader asReader() const { return Reader(_builder.asReader()); }
@@ -548,6 +561,7 @@ private:
   _::StructBuilder _builder;
   friend class Orphanage;
   friend class CapBuilderContext;
+  friend class FieldMask;
 };
 
 #if !CAPNP_LITE
@@ -657,6 +671,9 @@ public:
     return !(*this == right);
   }
 
+  uint hashCode() const;
+  // Structural hash consistent with equals().
+
   inline MessageSize totalSize() const {
     return _reader.totalSize().asPublic();
   }
@@ -696,6 +713,7 @@ public:
   inline bool operator!=(AnyList::Reader right) const{
     return !(*this == right);
   }
+  inline uint hashCode() const { return asReader().hashCode(); }
 
   template <typename T> BuilderFor<T> as() {
     // T must be List<U>.
@@ -1015,6 +1033,9 @@ struct PointerHelpers<AnyStruct, Kind::OTHER> {
   static inline void set(PointerBuilder builder, AnyStruct::Reader value) {
     builder.setStruct(value._reader);
   }
+  static inline _::StructReader getInternalReader(const AnyStruct::Reader& reader) {
+    return reader._reader;
+  }
   static inline AnyStruct::Builder init(
       PointerBuilder builder, uint16_t dataWordCount, uint16_t pointerCount) {
     return AnyStruct::Builder(builder.initStruct(
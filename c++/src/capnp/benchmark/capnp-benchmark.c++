@@ -0,0 +1,512 @@
+// Copyright (c) 2026 Cloudflare, Inc. and contributors
+// Licensed under the MIT License:
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Serialization and RPC benchmarks.
+//
+// Each scenario reports throughput and, where it makes sense, per-operation latency percentiles.
+// With --json, each result is printed as a JSON object on its own line, so that CI can compare
+// runs.
+//
+// The RPC scenarios run the client and server on the same thread, so they measure the CPU cost of
+// a call through the whole stack (including the kernel, for socketpair and TCP) rather than
+// network latency.
+//
+// The exception is rpc-bulk, which sends large calls over loopback TCP connections with injected
+// latency: each connection can only write one window's worth of data per round trip, as on a
+// long-distance link. It compares a single connection against a striped stream over several.
+
+#include <capnp/test-util.h>
+#include <capnp/rpc-twoparty.h>
+#include <capnp/striped-stream.h>
+#include <capnp/serialize.h>
+#include <capnp/serialize-packed.h>
+#include <kj/async-io.h>
+#include <kj/debug.h>
+#include <kj/main.h>
+#include <kj/miniposix.h>
+#include <algorithm>
+#include <string.h>
+
+namespace capnp {
+namespace _ {  // private
+namespace {
+
+// =======================================================================================
+// Measurement
+
+class Measurement {
+public:
+  Measurement(kj::StringPtr scenario, kj::StringPtr transport, uint64_t iterations,
+              bool recordLatency)
+      : scenario(scenario), transport(transport) {
+    if (recordLatency) latencies.reserve(iterations);
+  }
+
+  template <typename Func>
+  void run(uint64_t iterations, Func&& func) {
+    // Call `func()` `iterations` times, after a short warm-up.
+
+    for (uint64_t i = kj::min(iterations / 10, uint64_t(100)); i > 0; i--) {
+      func();
+    }
+
+    auto& clock = kj::systemPreciseMonotonicClock();
+    auto start = clock.now();
+    if (latencies.capacity() > 0) {
+      auto last = start;
+      for (uint64_t i = 0; i < iterations; i++) {
+        func();
+        auto now = clock.now();
+        latencies.add((now - last) / kj::NANOSECONDS);
+        last = now;
+      }
+    } else {
+      for (uint64_t i = 0; i < iterations; i++) {
+        func();
+      }
+    }
+    elapsed = clock.now() - start;
+    ops += iterations;
+  }
+
+  void setOpsPerIteration(uint64_t n) {
+    // For scenarios where each call to `func()` performs several operations.
+    ops *= n;
+  }
+
+  void setBytesPerOp(uint64_t n) { bytesPerOp = n; }
+
+  kj::String format(bool json) {
+    int64_t nanos = kj::max(elapsed / kj::NANOSECONDS, int64_t(1));
+    uint64_t opsPerSec = ops * 1000000000ull / nanos;
+
+    kj::Vector<kj::String> fields;
+    if (json) {
+      fields.add(kj::str("\"scenario\": \"", scenario, "\""));
+      fields.add(kj::str("\"transport\": \"", transport, "\""));
+      fields.add(kj::str("\"ops\": ", ops));
+      fields.add(kj::str("\"elapsedNs\": ", nanos));
+      fields.add(kj::str("\"opsPerSec\": ", opsPerSec));
+      if (bytesPerOp > 0) {
+        fields.add(kj::str("\"bytesPerSec\": ", bytesPerOp * opsPerSec));
+      }
+      if (!latencies.empty()) {
+        fields.add(kj::str("\"p50Ns\": ", percentile(50)));
+        fields.add(kj::str("\"p99Ns\": ", percentile(99)));
+      }
+      return kj::str("{", kj::strArray(fields, ", "), "}");
+    } else {
+      fields.add(kj::str(opsPerSec, " ops/s"));
+      if (bytesPerOp > 0) {
+        fields.add(kj::str(bytesPerOp * opsPerSec / 1000000, " MB/s"));
+      }
+      if (!latencies.empty()) {
+        fields.add(kj::str("p50 ", percentile(50), " ns"));
+        fields.add(kj::str("p99 ", percentile(99), " ns"));
+      }
+      return kj::str(scenario, "/", transport, ": ", kj::strArray(fields, ", "));
+    }
+  }
+
+private:
+  kj::StringPtr scenario;
+  kj::StringPtr transport;
+  uint64_t ops = 0;
+  uint64_t bytesPerOp = 0;
+  kj::Duration elapsed = 0 * kj::NANOSECONDS;
+  kj::Vector<int64_t> latencies;
+  bool sorted = false;
+
+  int64_t percentile(uint p) {
+    if (!sorted) {
+      std::sort(latencies.begin(), latencies.end());
+      sorted = true;
+    }
+    return latencies[kj::min(latencies.size() * p / 100, latencies.size() - 1)];
+  }
+};
+
+// =======================================================================================
+// RPC servers
+
+class ExtendsServer final: public test::TestExtends::Server {
+protected:
+  kj::Promise<void> foo(FooContext context) override {
+    context.getResults().setX("bar");
+    return kj::READY_NOW;
+  }
+};
+
+class PipelineServer final: public test::TestPipeline::Server {
+protected:
+  kj::Promise<void> getCap(GetCapContext context) override {
+    context.releaseParams();
+    auto results = context.getResults();
+    results.setS("bar");
+    results.initOutBox().setCap(extends);
+    return kj::READY_NOW;
+  }
+
+private:
+  test::TestExtends::Client extends = kj::heap<ExtendsServer>();
+};
+
+class BulkServer final: public test::TestInterface::Server {
+protected:
+  kj::Promise<void> baz(BazContext context) override {
+    context.releaseParams();
+    return kj::READY_NOW;
+  }
+};
+
+// =======================================================================================
+// Transports
+
+class DelayedStream final: public kj::AsyncIoStream {
+  // Wraps a stream so that each write takes one round trip per `WINDOW` bytes, capping the
+  // stream's throughput the way a TCP window caps a connection's throughput on a high-latency link.
+
+public:
+  static constexpr size_t WINDOW = 64 * 1024;
+  static constexpr kj::Duration RTT = 2 * kj::MILLISECONDS;
+
+  DelayedStream(kj::Own<kj::AsyncIoStream> inner, kj::Timer& timer)
+      : inner(kj::mv(inner)), timer(timer) {}
+
+  kj::Promise<size_t> tryRead(void* buffer, size_t minBytes, size_t maxBytes) override {
+    return inner->tryRead(buffer, minBytes, maxBytes);
+  }
+  kj::Promise<void> write(const void* buffer, size_t size) override {
+    return delay(size).then([this, buffer, size]() { return inner->write(buffer, size); });
+  }
+  kj::Promise<void> write(kj::ArrayPtr<const kj::ArrayPtr<const byte>> pieces) override {
+    size_t size = 0;
+    for (auto& piece: pieces) size += piece.size();
+    return delay(size).then([this, pieces]() { return inner->write(pieces); });
+  }
+  kj::Promise<void> whenWriteDisconnected() override {
+    return inner->whenWriteDisconnected();
+  }
+  void shutdownWrite() override {
+    inner->shutdownWrite();
+  }
+
+private:
+  kj::Own<kj::AsyncIoStream> inner;
+  kj::Timer& timer;
+
+  kj::Promise<void> delay(size_t size) {
+    return timer.afterDelay((size + WINDOW - 1) / WINDOW * RTT);
+  }
+};
+
+struct RpcEndpoint {
+  // A client for a PipelineServer, reached over some transport.
+
+  kj::Own<kj::AsyncIoStream> clientStream;
+  kj::Own<kj::AsyncIoStream> serverStream;
+  kj::Own<TwoPartyClient> client;
+  kj::Own<TwoPartyClient> server;
+  test::TestPipeline::Client cap = nullptr;
+};
+
+// =======================================================================================
+
+class BenchmarkMain {
+public:
+  BenchmarkMain(kj::ProcessContext& context): context(context) {}
+
+  kj::MainFunc getMain() {
+    return kj::MainBuilder(context, "Cap'n Proto benchmarks",
+          "Runs serialization and RPC benchmarks, reporting throughput and latency.")
+        .addOptionWithArg({'n', "iterations"}, KJ_BIND_METHOD(*this, setIterations), "<count>",
+            "Run each scenario for <count> iterations. Defaults to 20000.")
+        .addOptionWithArg({'f', "filter"}, KJ_BIND_METHOD(*this, setFilter), "<text>",
+            "Only run scenarios whose full name (e.g. \"rpc-call/tcp\") contains <text>.")
+        .addOption({"json"}, KJ_BIND_METHOD(*this, setJson),
+            "Print each result as a JSON object on its own line.")
+        .callAfterParsing(KJ_BIND_METHOD(*this, run))
+        .build();
+  }
+
+private:
+  kj::ProcessContext& context;
+  uint64_t iterations = 20000;
+  kj::Maybe<kj::String> filter;
+  bool json = false;
+
+  kj::MainBuilder::Validity setIterations(kj::StringPtr param) {
+    KJ_IF_MAYBE(n, param.tryParseAs<uint64_t>()) {
+      if (*n > 0) {
+        iterations = *n;
+        return true;
+      }
+    }
+    return "expected a positive integer";
+  }
+
+  kj::MainBuilder::Validity setFilter(kj::StringPtr param) {
+    filter = kj::str(param);
+    return true;
+  }
+
+  kj::MainBuilder::Validity setJson() {
+    json = true;
+    return true;
+  }
+
+  bool matches(kj::StringPtr scenario, kj::StringPtr transport) {
+    KJ_IF_MAYBE(f, filter) {
+      auto name = kj::str(scenario, "/", transport);
+      return strstr(name.cStr(), f->cStr()) != nullptr;
+    }
+    return true;
+  }
+
+  void report(Measurement& measurement) {
+    auto line = kj::str(measurement.format(json), '\n');
+    kj::FdOutputStream(STDOUT_FILENO).write(line.begin(), line.size());
+  }
+
+  kj::MainBuilder::Validity run() {
+    runSerialization();
+
+    auto io = kj::setupAsyncIo();
+    for (auto transport: {"local", "local-promise", "pipe", "socketpair", "tcp"}) {
+      if (!matches("rpc-call", transport) && !matches("rpc-pipelined", transport) &&
+          !matches("rpc-concurrent", transport)) {
+        continue;
+      }
+      auto endpoint = connect(io, transport);
+      runRpc(io.waitScope, endpoint.cap, transport);
+    }
+
+    for (uint streamCount: {1, 4}) {
+      auto transport = streamCount == 1 ? "tcp-delayed"_kj : "striped4-delayed"_kj;
+      if (matches("rpc-bulk", transport)) {
+        runBulk(io, streamCount, transport);
+      }
+    }
+
+    return true;
+  }
+
+  // -------------------------------------------------------------------
+  // Serialization
+
+  void runSerialization() {
+    MallocMessageBuilder prototype;
+    initTestMessage(prototype.getRoot<test::TestAllTypes>());
+    auto flat = messageToFlatArray(prototype);
+    auto flatBytes = flat.asBytes();
+
+    kj::VectorOutputStream packedStream;
+    writePackedMessage(packedStream, prototype);
+    auto packed = kj::heapArray(packedStream.getArray());
+
+    if (matches("build", "memory")) {
+      Measurement m("build", "memory", iterations, false);
+      m.setBytesPerOp(flatBytes.size());
+      m.run(iterations, [&]() {
+        MallocMessageBuilder message;
+        initTestMessage(message.getRoot<test::TestAllTypes>());
+        auto words = messageToFlatArray(message);
+      });
+      report(m);
+    }
+
+    if (matches("read", "memory")) {
+      Measurement m("read", "memory", iterations, false);
+      m.setBytesPerOp(flatBytes.size());
+      m.run(iterations, [&]() {
+        FlatArrayMessageReader reader(flat);
+        KJ_ASSERT(reader.getRoot<test::TestAllTypes>().totalSize().wordCount > 0);
+      });
+      report(m);
+    }
+
+    if (matches("packed-write", "memory")) {
+      Measurement m("packed-write", "memory", iterations, false);
+      m.setBytesPerOp(flatBytes.size());
+      kj::VectorOutputStream output;
+      m.run(iterations, [&]() {
+        output.clear();
+        writePackedMessage(output, prototype);
+      });
+      report(m);
+    }
+
+    if (matches("packed-read", "memory")) {
+      Measurement m("packed-read", "memory", iterations, false);
+      m.setBytesPerOp(flatBytes.size());
+      m.run(iterations, [&]() {
+        kj::ArrayInputStream input(packed);
+        PackedMessageReader reader(input);
+        KJ_ASSERT(reader.getRoot<test::TestAllTypes>().totalSize().wordCount > 0);
+      });
+      report(m);
+    }
+  }
+
+  // -------------------------------------------------------------------
+  // RPC
+
+  RpcEndpoint connect(kj::AsyncIoContext& io, kj::StringPtr transport) {
+    RpcEndpoint result;
+    auto bootstrap = kj::heap<PipelineServer>();
+
+    if (transport == "local") {
+      result.cap = kj::mv(bootstrap);
+      return result;
+    } else if (transport == "local-promise") {
+      // A local capability reached through a promise which has already resolved, as is common for
+      // capabilities returned by other local calls.
+      result.cap = kj::Promise<test::TestPipeline::Client>(
+          test::TestPipeline::Client(kj::mv(bootstrap)));
+      result.cap.whenResolved().wait(io.waitScope);
+      return result;
+    } else if (transport == "pipe") {
+      auto pipe = kj::newTwoWayPipe();
+      result.clientStream = kj::mv(pipe.ends[0]);
+      result.serverStream = kj::mv(pipe.ends[1]);
+    } else if (transport == "socketpair") {
+      auto pipe = io.provider->newTwoWayPipe();
+      result.clientStream = kj::mv(pipe.ends[0]);
+      result.serverStream = kj::mv(pipe.ends[1]);
+    } else if (transport == "tcp") {
+      auto& network = io.provider->getNetwork();
+      auto listener = network.parseAddress("127.0.0.1").wait(io.waitScope)->listen();
+      auto acceptPromise = listener->accept();
+      auto addr = network.parseAddress("127.0.0.1", listener->getPort()).wait(io.waitScope);
+      result.clientStream = addr->connect().wait(io.waitScope);
+      result.serverStream = acceptPromise.wait(io.waitScope);
+    } else {
+      KJ_FAIL_ASSERT("unknown transport", transport);
+    }
+
+    result.server = kj::heap<TwoPartyClient>(*result.serverStream, kj::mv(bootstrap),
+                                             rpc::twoparty::Side::SERVER);
+    result.client = kj::heap<TwoPartyClient>(*result.clientStream);
+    result.cap = result.client->bootstrap().castAs<test::TestPipeline>();
+    return result;
+  }
+
+  void runBulk(kj::AsyncIoContext& io, uint streamCount, kj::StringPtr transport) {
+    constexpr size_t PAYLOAD_SIZE = 1 << 20;
+
+    auto& network = io.provider->getNetwork();
+    auto listener = network.parseAddress("127.0.0.1").wait(io.waitScope)->listen();
+    auto addr = network.parseAddress("127.0.0.1", listener->getPort()).wait(io.waitScope);
+    auto clientStreams = kj::heapArrayBuilder<kj::Own<kj::AsyncIoStream>>(streamCount);
+    auto serverStreams = kj::heapArrayBuilder<kj::Own<kj::AsyncIoStream>>(streamCount);
+    for (uint i = 0; i < streamCount; i++) {
+      auto acceptPromise = listener->accept();
+      clientStreams.add(kj::heap<DelayedStream>(addr->connect().wait(io.waitScope),
+                                                io.provider->getTimer()));
+      serverStreams.add(kj::heap<DelayedStream>(acceptPromise.wait(io.waitScope),
+                                                io.provider->getTimer()));
+    }
+
+    kj::Own<kj::AsyncIoStream> clientStream, serverStream;
+    if (streamCount == 1) {
+      clientStream = kj::mv(clientStreams[0]);
+      serverStream = kj::mv(serverStreams[0]);
+    } else {
+      clientStream = newStripedStream(clientStreams.finish(), DelayedStream::WINDOW);
+      serverStream = newStripedStream(serverStreams.finish(), DelayedStream::WINDOW);
+    }
+
+    TwoPartyClient server(*serverStream, kj::heap<BulkServer>(), rpc::twoparty::Side::SERVER);
+    TwoPartyClient client(*clientStream);
+    auto cap = client.bootstrap().castAs<test::TestInterface>();
+
+    auto payload = kj::heapArray<byte>(PAYLOAD_SIZE);
+    memset(payload.begin(), 'x', payload.size());
+
+    uint64_t bulkIterations = kj::max(iterations / 1000, uint64_t(3));
+    Measurement m("rpc-bulk", transport, bulkIterations, true);
+    m.setBytesPerOp(PAYLOAD_SIZE);
+    m.run(bulkIterations, [&]() {
+      auto request = cap.bazRequest();
+      request.initS().setDataField(payload);
+      request.send().wait(io.waitScope);
+    });
+    report(m);
+  }
+
+  void runRpc(kj::WaitScope& waitScope, test::TestPipeline::Client& pipeline,
+              kj::StringPtr transport) {
+    auto getCap = [&]() {
+      auto request = pipeline.getCapRequest();
+      request.setN(234);
+      return request.send();
+    };
+    auto callFoo = [](test::TestInterface::Client cap) {
+      auto request = cap.fooRequest();
+      request.setI(123);
+      request.setJ(true);
+      return request.send();
+    };
+
+    test::TestInterface::Client cap = getCap().wait(waitScope).getOutBox().getCap();
+
+    if (matches("rpc-call", transport)) {
+      // One call at a time.
+      Measurement m("rpc-call", transport, iterations, true);
+      m.run(iterations, [&]() {
+        callFoo(cap).wait(waitScope);
+      });
+      report(m);
+    }
+
+    if (matches("rpc-pipelined", transport)) {
+      // A call made on the result of another call, before the first call has returned.
+      Measurement m("rpc-pipelined", transport, iterations, true);
+      m.run(iterations, [&]() {
+        auto first = getCap();
+        callFoo(first.getOutBox().getCap()).wait(waitScope);
+      });
+      report(m);
+    }
+
+    if (matches("rpc-concurrent", transport)) {
+      // Many calls in flight at once.
+      constexpr uint BATCH = 64;
+      uint64_t batches = kj::max(iterations / BATCH, uint64_t(1));
+      Measurement m("rpc-concurrent", transport, batches, false);
+      m.run(batches, [&]() {
+        auto promises = kj::heapArrayBuilder<kj::Promise<void>>(BATCH);
+        for (uint i = 0; i < BATCH; i++) {
+          promises.add(callFoo(cap).ignoreResult());
+        }
+        kj::joinPromises(promises.finish()).wait(waitScope);
+      });
+      m.setOpsPerIteration(BATCH);
+      report(m);
+    }
+  }
+};
+
+}  // namespace
+}  // namespace _ (private)
+}  // namespace capnp
+
+KJ_MAIN(capnp::_::BenchmarkMain);
@@ -1419,6 +1419,253 @@ KJ_TEST("RevocableServer") {
       revocable.getClient().waitForeverRequest().send().ignoreResult().wait(waitScope));
 }
 
+KJ_TEST("Request deadlines reach local servers") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  class ServerImpl: public test::TestInterface::Server {
+  public:
+    kj::Maybe<kj::TimePoint> deadline;
+
+    kj::Promise<void> foo(FooContext context) override {
+      deadline = context.getDeadline();
+      context.initResults().setX("foo");
+      return kj::READY_NOW;
+    }
+  };
+
+  ServerImpl server;
+  test::TestInterface::Client client = kj::Own<ServerImpl>(&server, kj::NullDisposer::instance);
+
+  auto t0 = kj::origin<kj::TimePoint>();
+
+  {
+    // The earliest deadline wins.
+    auto request = client.fooRequest();
+    request.setDeadline(t0 + 2 * kj::SECONDS);
+    request.setDeadline(t0 + 1 * kj::SECONDS);
+    request.setDeadline(t0 + 3 * kj::SECONDS);
+    request.setDeadline(nullptr);
+    request.send().wait(waitScope);
+    KJ_EXPECT(KJ_ASSERT_NONNULL(server.deadline) == t0 + 1 * kj::SECONDS);
+  }
+
+  {
+    client.fooRequest().send().wait(waitScope);
+    KJ_EXPECT(server.deadline == nullptr);
+  }
+}
+
+KJ_TEST("Deadlines propagate to calls made by local servers") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  class InnerImpl: public test::TestInterface::Server {
+  public:
+    kj::Vector<kj::Maybe<kj::TimePoint>> seen;
+
+    kj::Promise<void> foo(FooContext context) override {
+      seen.add(context.getDeadline());
+      context.initResults().setX("inner");
+      return kj::READY_NOW;
+    }
+  };
+
+  class OuterImpl: public test::TestInterface::Server {
+  public:
+    OuterImpl(test::TestInterface::Client inner): inner(kj::mv(inner)) {}
+
+    kj::Promise<void> foo(FooContext context) override {
+      // Both made while the method runs, so both inherit its deadline without setDeadline().
+      // The second one can only tighten it.
+      auto first = inner.fooRequest().send();
+      auto request = inner.fooRequest();
+      request.setDeadline(kj::origin<kj::TimePoint>() + 1 * kj::SECONDS);
+      auto second = request.send();
+      return first.then([second = kj::mv(second)](auto&&) mutable {
+        KJ_EXPECT(TraceContext::currentDeadline() == nullptr);
+        return second.ignoreResult();
+      }).then([context]() mutable {
+        context.initResults().setX("outer");
+      });
+    }
+
+  private:
+    test::TestInterface::Client inner;
+  };
+
+  InnerImpl inner;
+  OuterImpl outer(kj::Own<InnerImpl>(&inner, kj::NullDisposer::instance));
+  test::TestInterface::Client client = kj::Own<OuterImpl>(&outer, kj::NullDisposer::instance);
+
+  auto t0 = kj::origin<kj::TimePoint>();
+
+  {
+    auto request = client.fooRequest();
+    request.setDeadline(t0 + 5 * kj::SECONDS);
+    request.send().wait(waitScope);
+  }
+
+  KJ_ASSERT(inner.seen.size() == 2);
+  KJ_EXPECT(KJ_ASSERT_NONNULL(inner.seen[0]) == t0 + 5 * kj::SECONDS);
+  KJ_EXPECT(KJ_ASSERT_NONNULL(inner.seen[1]) == t0 + 1 * kj::SECONDS);
+  KJ_EXPECT(TraceContext::currentDeadline() == nullptr);
+
+  {
+    // Calls without a deadline don't acquire one.
+    inner.seen.clear();
+    client.fooRequest().send().wait(waitScope);
+    KJ_ASSERT(inner.seen.size() == 2);
+    KJ_EXPECT(inner.seen[0] == nullptr);
+  }
+}
+
+KJ_TEST("Trace contexts propagate to nested and tail calls made by local servers") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  class InnerImpl: public test::TestInterface::Server {
+  public:
+    kj::Vector<kj::Maybe<TraceContext>> seen;
+
+    kj::Promise<void> foo(FooContext context) override {
+      seen.add(context.getTraceContext());
+      context.initResults().setX("inner");
+      return kj::READY_NOW;
+    }
+  };
+
+  class OuterImpl: public test::TestInterface::Server {
+  public:
+    OuterImpl(test::TestInterface::Client inner): inner(kj::mv(inner)) {}
+
+    kj::Maybe<TraceContext> seen;
+
+    kj::Promise<void> foo(FooContext context) override {
+      seen = context.getTraceContext();
+
+      // Made while the method runs, so it inherits the trace context implicitly.
+      return inner.fooRequest().send().then([this, context](auto&&) mutable {
+        // Continuations don't, but tail calls inherit it explicitly.
+        KJ_EXPECT(TraceContext::current() == nullptr);
+        return context.tailCall(inner.fooRequest());
+      });
+    }
+
+  private:
+    test::TestInterface::Client inner;
+  };
+
+  InnerImpl inner;
+  OuterImpl outer(kj::Own<InnerImpl>(&inner, kj::NullDisposer::instance));
+  test::TestInterface::Client client = kj::Own<OuterImpl>(&outer, kj::NullDisposer::instance);
+
+  auto trace = TraceContext::newTrace();
+  KJ_EXPECT(trace.traceIdHigh != 0 || trace.traceIdLow != 0);
+  KJ_EXPECT(trace.spanId != 0);
+
+  {
+    auto request = client.fooRequest();
+    request.setTraceContext(trace);
+    KJ_EXPECT(request.send().wait(waitScope).getX() == "inner");
+  }
+
+  auto& seen = KJ_ASSERT_NONNULL(outer.seen);
+  KJ_EXPECT(seen.traceIdHigh == trace.traceIdHigh);
+  KJ_EXPECT(seen.traceIdLow == trace.traceIdLow);
+  KJ_EXPECT(seen.spanId == trace.spanId);
+
+  KJ_ASSERT(inner.seen.size() == 2);
+  for (auto& maybeContext: inner.seen) {
+    auto& context = KJ_ASSERT_NONNULL(maybeContext);
+    KJ_EXPECT(context.traceIdHigh == trace.traceIdHigh);
+    KJ_EXPECT(context.traceIdLow == trace.traceIdLow);
+    KJ_EXPECT(context.spanId == trace.spanId);
+  }
+
+  KJ_EXPECT(TraceContext::current() == nullptr);
+
+  {
+    // Untraced calls stay untraced.
+    inner.seen.clear();
+    client.fooRequest().send().wait(waitScope);
+    KJ_EXPECT(outer.seen == nullptr);
+    KJ_ASSERT(inner.seen.size() == 2);
+    KJ_EXPECT(inner.seen[0] == nullptr);
+    KJ_EXPECT(inner.seen[1] == nullptr);
+  }
+}
+
+KJ_TEST("Local call results stay valid while later calls reuse message segments") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  int callCount = 0;
+  test::TestInterface::Client client(kj::heap<TestInterfaceImpl>(callCount));
+
+  auto callFoo = [&]() {
+    auto request = client.fooRequest();
+    request.setI(123);
+    request.setJ(true);
+    return request.send().wait(waitScope);
+  };
+
+  auto first = callFoo();
+  auto params = client.fooRequest();
+  params.setI(123);
+  auto allocations = localMessageSegmentAllocationsForTest();
+  for (uint i = 0; i < 100; i++) {
+    KJ_EXPECT(callFoo().getX() == "foo");
+  }
+  KJ_EXPECT(first.getX() == "foo");
+  KJ_EXPECT(params.getI() == 123);
+  KJ_EXPECT(callCount == 101);
+
+  // Only the first call in the loop had to allocate segments (for its params and results); the
+  // rest reused them.
+  KJ_EXPECT(localMessageSegmentAllocationsForTest() - allocations <= 2,
+            localMessageSegmentAllocationsForTest() - allocations);
+
+  // Other local capabilities on the thread draw from the same pool.
+  int otherCallCount = 0;
+  test::TestInterface::Client other(kj::heap<TestInterfaceImpl>(otherCallCount));
+  allocations = localMessageSegmentAllocationsForTest();
+  for (uint i = 0; i < 10; i++) {
+    auto request = other.fooRequest();
+    request.setI(123);
+    request.setJ(true);
+    KJ_EXPECT(request.send().wait(waitScope).getX() == "foo");
+  }
+  KJ_EXPECT(localMessageSegmentAllocationsForTest() == allocations);
+  KJ_EXPECT(otherCallCount == 10);
+}
+
+KJ_TEST("Calls on a resolved promise client stay ordered after queued calls") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  auto paf = kj::newPromiseAndFulfiller<test::TestCallOrder::Client>();
+  test::TestCallOrder::Client client(kj::mv(paf.promise));
+
+  auto call0 = client.getCallSequenceRequest().send();
+  auto call1 = client.getCallSequenceRequest().send();
+
+  paf.fulfiller->fulfill(kj::heap<TestCallOrderImpl>());
+
+  // Resolution hasn't been processed yet, so this one queues too.
+  auto call2 = client.getCallSequenceRequest().send();
+
+  waitScope.poll();
+
+  // The queue has drained, so this call goes directly to the server.
+  auto call3 = client.getCallSequenceRequest().send();
+
+  KJ_EXPECT(call0.wait(waitScope).getN() == 0);
+  KJ_EXPECT(call1.wait(waitScope).getN() == 1);
+  KJ_EXPECT(call2.wait(waitScope).getN() == 2);
+  KJ_EXPECT(call3.wait(waitScope).getN() == 3);
+}
+
 }  // namespace
 }  // namespace _
 }  // namespace capnp
@@ -27,6 +27,8 @@
 #include <kj/refcount.h>
 #include <kj/debug.h>
 #include <kj/vector.h>
+#include <kj/threadlocal.h>
+#include <atomic>
 #include <map>
 #include "generated-header-support.h"
 
@@ -63,6 +65,62 @@ ClientHook::ClientHook() {
 
 // =======================================================================================
 
+namespace {
+
+KJ_THREADLOCAL_PTR(const TraceContext::Scope) currentScope = nullptr;
+
+uint64_t newTraceId() {
+  // IDs only need to be unique, not unpredictable, so a counter seeded from the clock and the
+  // address space layout, then scrambled with the SplitMix64 finalizer, does the job.
+  static std::atomic<uint64_t> state(
+      uint64_t((kj::systemPreciseCalendarClock().now() - kj::UNIX_EPOCH) / kj::NANOSECONDS) ^
+      reinterpret_cast<uintptr_t>(&state));
+  uint64_t z = state.fetch_add(0x9e3779b97f4a7c15ull, std::memory_order_relaxed);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  z ^= z >> 31;
+  return z == 0 ? 1 : z;
+}
+
+}  // namespace
+
+TraceContext TraceContext::newTrace() {
+  return { newTraceId(), newTraceId(), newTraceId() };
+}
+
+TraceContext TraceContext::newSpan() const {
+  return { traceIdHigh, traceIdLow, newTraceId() };
+}
+
+kj::Maybe<TraceContext> TraceContext::current() {
+  const Scope* scope = currentScope;
+  if (scope == nullptr) {
+    return nullptr;
+  } else {
+    return scope->context;
+  }
+}
+
+kj::Maybe<kj::TimePoint> TraceContext::currentDeadline() {
+  const Scope* scope = currentScope;
+  if (scope == nullptr) {
+    return nullptr;
+  } else {
+    return scope->deadline;
+  }
+}
+
+TraceContext::Scope::Scope(kj::Maybe<TraceContext> context, kj::Maybe<kj::TimePoint> deadline)
+    : context(context), deadline(deadline), previous(currentScope) {
+  currentScope = this;
+}
+
+TraceContext::Scope::~Scope() {
+  currentScope = previous;
+}
+
+// =======================================================================================
+
 Capability::Client::Client(decltype(nullptr))
     : hook(newNullCap()) {}
 
@@ -135,24 +193,182 @@ static inline uint firstSegmentSize(kj::Maybe<MessageSize> sizeHint) {
   }
 }
 
-class LocalResponse final: public ResponseHook {
+class LocalMessagePool;
+KJ_THREADLOCAL_PTR(LocalMessagePool) threadMessagePool = nullptr;
+static thread_local uint64_t threadSegmentAllocations = 0;
+
+class LocalMessagePool final: public kj::Refcounted {
+  // Recycles the first segments of the params and results messages of calls made on
+  // LocalClients, so that a steady stream of small in-process calls doesn't have to allocate a
+  // fresh segment for every message.
+  //
+  // There is one pool per thread, shared by all of the thread's LocalClients, so that the memory
+  // held in reserve doesn't grow with the number of capabilities. The pool lives as long as
+  // anything references it (LocalClients, and messages holding its segments).
+  //
+  // MallocMessageBuilder zeroes the used part of a caller-provided first segment when it is
+  // destroyed, so segments come back zeroed and can be handed out again as-is.
+
 public:
-  LocalResponse(kj::Maybe<MessageSize> sizeHint)
-      : message(firstSegmentSize(sizeHint)) {}
+  static constexpr uint SEGMENT_WORDS = SUGGESTED_FIRST_SEGMENT_WORDS;
+  static constexpr uint MAX_FREE_SEGMENTS = 16;
 
-  MallocMessageBuilder message;
+  LocalMessagePool() {
+    threadMessagePool = this;
+  }
+  ~LocalMessagePool() noexcept(false) {
+    threadMessagePool = nullptr;
+  }
+  KJ_DISALLOW_COPY_AND_MOVE(LocalMessagePool);
+
+  static kj::Own<LocalMessagePool> forThisThread() {
+    LocalMessagePool* existing = threadMessagePool;
+    if (existing == nullptr) {
+      return kj::refcounted<LocalMessagePool>();
+    } else {
+      return kj::addRef(*existing);
+    }
+  }
+
+  kj::Array<word> take() {
+    if (freeSegments.empty()) {
+      return newZeroedSegment(SEGMENT_WORDS);
+    } else {
+      auto result = kj::mv(freeSegments.back());
+      freeSegments.removeLast();
+      return result;
+    }
+  }
+
+  void recycle(kj::Array<word> segment) {
+    if (freeSegments.size() < MAX_FREE_SEGMENTS) {
+      freeSegments.add(kj::mv(segment));
+    }
+  }
+
+  static kj::Array<word> newZeroedSegment(uint size) {
+    ++threadSegmentAllocations;
+    auto result = kj::heapArray<word>(size);
+    memset(result.begin(), 0, result.size() * sizeof(word));
+    return result;
+  }
+
+private:
+  kj::Vector<kj::Array<word>> freeSegments;
+};
+
+class LocalMessageSegment {
+  // The first segment of a LocalMessage. This is a separate base class so that it is destroyed
+  // after the MallocMessageBuilder, which zeroes the segment on its way out.
+
+public:
+  LocalMessageSegment(kj::Maybe<MessageSize> sizeHint, kj::Maybe<LocalMessagePool&> poolParam) {
+    uint size = firstSegmentSize(sizeHint);
+    KJ_IF_MAYBE(p, poolParam) {
+      if (size <= LocalMessagePool::SEGMENT_WORDS) {
+        segment = p->take();
+        pool = kj::addRef(*p);
+        return;
+      }
+    }
+    segment = LocalMessagePool::newZeroedSegment(kj::max(size, 1u));
+  }
+  ~LocalMessageSegment() noexcept(false) {
+    KJ_IF_MAYBE(p, pool) {
+      p->get()->recycle(kj::mv(segment));
+    }
+  }
+  KJ_DISALLOW_COPY_AND_MOVE(LocalMessageSegment);
+
+protected:
+  kj::Array<word> segment;
+  kj::Maybe<kj::Own<LocalMessagePool>> pool;
+};
+
+class LocalMessage final: private LocalMessageSegment, public MallocMessageBuilder {
+  // The params or results of a local call. If a pool is given and the size hint fits, the first
+  // segment is borrowed from the pool.
+
+public:
+  LocalMessage(kj::Maybe<MessageSize> sizeHint, kj::Maybe<LocalMessagePool&> pool)
+      : LocalMessageSegment(sizeHint, pool), MallocMessageBuilder(segment) {}
 };
 
-class LocalCallContext final: public CallContextHook, public ResponseHook, public kj::Refcounted {
+class LocalCallContext final: public RequestHook, public CallContextHook, public ResponseHook,
+                              public kj::Refcounted {
+  // A call on a local capability. The same object serves as the RequestHook while the params are
+  // being built, as the CallContextHook while the call runs, and as the ResponseHook once it has
+  // returned, so that a local call makes one allocation for all three.
+
 public:
-  LocalCallContext(kj::Own<MallocMessageBuilder>&& request, kj::Own<ClientHook> clientRef,
-                   ClientHook::CallHints hints, bool isStreaming)
-      : request(kj::mv(request)), clientRef(kj::mv(clientRef)), hints(hints),
-        isStreaming(isStreaming) {}
+  LocalCallContext(uint64_t interfaceId, uint16_t methodId, kj::Maybe<MessageSize> sizeHint,
+                   ClientHook::CallHints hints, kj::Own<ClientHook> clientRef,
+                   kj::Maybe<LocalMessagePool&> poolParam)
+      : interfaceId(interfaceId), methodId(methodId), clientRef(kj::mv(clientRef)), hints(hints),
+        deadline(TraceContext::currentDeadline()), traceContext(TraceContext::current()) {
+    KJ_IF_MAYBE(p, poolParam) {
+      pool = kj::addRef(*p);
+    }
+    request.emplace(sizeHint, poolParam);
+  }
+
+  static Request<AnyPointer, AnyPointer> newRequest(
+      uint64_t interfaceId, uint16_t methodId, kj::Maybe<MessageSize> sizeHint,
+      ClientHook::CallHints hints, kj::Own<ClientHook> client,
+      kj::Maybe<LocalMessagePool&> pool = nullptr) {
+    auto hook = kj::refcounted<LocalCallContext>(
+        interfaceId, methodId, sizeHint, hints, kj::mv(client), pool);
+    auto root = KJ_ASSERT_NONNULL(hook->request).getRoot<AnyPointer>();
+    return Request<AnyPointer, AnyPointer>(root, kj::mv(hook));
+  }
+
+  // implements RequestHook ------------------------------------------
+
+  RemotePromise<AnyPointer> send() override {
+    bool isStreaming = false;
+    return sendImpl(isStreaming);
+  }
+
+  kj::Promise<void> sendStreaming() override {
+    // We don't do any special handling of streaming in RequestHook for local requests, because
+    // there is no latency to compensate for between the client and server in this case.  However,
+    // we record whether the call was streaming, so that it can be preserved as a streaming call
+    // if the local capability later resolves to a remote capability.
+    bool isStreaming = true;
+    return sendImpl(isStreaming).ignoreResult();
+  }
+
+  AnyPointer::Pipeline sendForPipeline() override {
+    KJ_REQUIRE(!sent, "Already called send() on this request.");
+    sent = true;
+
+    hints.onlyPromisePipeline = true;
+    auto vpap = clientRef->call(interfaceId, methodId, kj::addRef(*this), hints);
+    return AnyPointer::Pipeline(kj::mv(vpap.pipeline));
+  }
+
+  const void* getBrand() override {
+    return nullptr;
+  }
+
+  void setDeadline(kj::TimePoint newDeadline) override {
+    if (sent) return;
+    KJ_IF_MAYBE(d, deadline) {
+      if (*d <= newDeadline) return;
+    }
+    deadline = newDeadline;
+  }
+
+  void setTraceContext(const TraceContext& context) override {
+    if (sent) return;
+    traceContext = context;
+  }
+
+  // implements CallContextHook --------------------------------------
 
   AnyPointer::Reader getParams() override {
     KJ_IF_MAYBE(r, request) {
-      return r->get()->getRoot<AnyPointer>();
+      return r->getRoot<AnyPointer>();
     } else {
       KJ_FAIL_REQUIRE("Can't call getParams() after releaseParams().");
     }
@@ -161,10 +377,12 @@ public:
     request = nullptr;
   }
   AnyPointer::Builder getResults(kj::Maybe<MessageSize> sizeHint) override {
-    if (response == nullptr) {
-      auto localResponse = kj::heap<LocalResponse>(sizeHint);
-      responseBuilder = localResponse->message.getRoot<AnyPointer>();
-      response = Response<AnyPointer>(responseBuilder.asReader(), kj::mv(localResponse));
+    if (response == nullptr && tailCallResponse == nullptr) {
+      kj::Maybe<LocalMessagePool&> poolRef;
+      KJ_IF_MAYBE(p, pool) {
+        poolRef = **p;
+      }
+      responseBuilder = response.emplace(sizeHint, poolRef).getRoot<AnyPointer>();
     }
     return responseBuilder;
   }
@@ -181,7 +399,8 @@ public:
     return kj::mv(result.promise);
   }
   ClientHook::VoidPromiseAndPipeline directTailCall(kj::Own<RequestHook>&& request) override {
-    KJ_REQUIRE(response == nullptr, "Can't call tailCall() after initializing the results struct.");
+    KJ_REQUIRE(response == nullptr && tailCallResponse == nullptr,
+               "Can't call tailCall() after initializing the results struct.");
 
     if (hints.onlyPromisePipeline) {
       return {
@@ -197,7 +416,7 @@ public:
       auto promise = request->send();
 
       auto voidPromise = promise.then([this](Response<AnyPointer>&& tailResponse) {
-        response = kj::mv(tailResponse);
+        tailCallResponse = kj::mv(tailResponse);
       });
 
       return { kj::mv(voidPromise), PipelineHook::from(kj::mv(promise)) };
@@ -211,86 +430,53 @@ public:
   kj::Own<CallContextHook> addRef() override {
     return kj::addRef(*this);
   }
-
-  kj::Maybe<kj::Own<MallocMessageBuilder>> request;
-  kj::Maybe<Response<AnyPointer>> response;
-  AnyPointer::Builder responseBuilder = nullptr;  // only valid if `response` is non-null
-  kj::Own<ClientHook> clientRef;
-  kj::Maybe<kj::Own<kj::PromiseFulfiller<AnyPointer::Pipeline>>> tailCallPipelineFulfiller;
-  ClientHook::CallHints hints;
-  bool isStreaming;
-};
-
-class LocalRequest final: public RequestHook {
-public:
-  inline LocalRequest(uint64_t interfaceId, uint16_t methodId,
-                      kj::Maybe<MessageSize> sizeHint, ClientHook::CallHints hints,
-                      kj::Own<ClientHook> client)
-      : message(kj::heap<MallocMessageBuilder>(firstSegmentSize(sizeHint))),
-        interfaceId(interfaceId), methodId(methodId), hints(hints), client(kj::mv(client)) {}
-
-  RemotePromise<AnyPointer> send() override {
-    bool isStreaming = false;
-    return sendImpl(isStreaming);
+  kj::Maybe<kj::TimePoint> getDeadline() override {
+    return deadline;
   }
-
-  kj::Promise<void> sendStreaming() override {
-    // We don't do any special handling of streaming in RequestHook for local requests, because
-    // there is no latency to compensate for between the client and server in this case.  However,
-    // we record whether the call was streaming, so that it can be preserved as a streaming call
-    // if the local capability later resolves to a remote capability.
-    bool isStreaming = true;
-    return sendImpl(isStreaming).ignoreResult();
-  }
-
-  AnyPointer::Pipeline sendForPipeline() override {
-    KJ_REQUIRE(message.get() != nullptr, "Already called send() on this request.");
-
-    hints.onlyPromisePipeline = true;
-    bool isStreaming = false;
-    auto context = kj::refcounted<LocalCallContext>(
-        kj::mv(message), client->addRef(), hints, isStreaming);
-    auto vpap = client->call(interfaceId, methodId, kj::addRef(*context), hints);
-    return AnyPointer::Pipeline(kj::mv(vpap.pipeline));
-  }
-
-  const void* getBrand() override {
-    return nullptr;
+  kj::Maybe<TraceContext> getTraceContext() override {
+    return traceContext;
   }
 
-  kj::Own<MallocMessageBuilder> message;
-
 private:
   uint64_t interfaceId;
   uint16_t methodId;
+  kj::Maybe<LocalMessage> request;
+  kj::Maybe<LocalMessage> response;
+  kj::Maybe<Response<AnyPointer>> tailCallResponse;
+  AnyPointer::Builder responseBuilder = nullptr;  // only valid if `response` is non-null
+  kj::Own<ClientHook> clientRef;
+  kj::Maybe<kj::Own<LocalMessagePool>> pool;
+  kj::Maybe<kj::Own<kj::PromiseFulfiller<AnyPointer::Pipeline>>> tailCallPipelineFulfiller;
   ClientHook::CallHints hints;
-  kj::Own<ClientHook> client;
+  bool isStreaming = false;
+  bool sent = false;
+  kj::Maybe<kj::TimePoint> deadline;
+  kj::Maybe<TraceContext> traceContext;
 
   RemotePromise<AnyPointer> sendImpl(bool isStreaming) {
-    KJ_REQUIRE(message.get() != nullptr, "Already called send() on this request.");
+    KJ_REQUIRE(!sent, "Already called send() on this request.");
+    sent = true;
+    this->isStreaming = isStreaming;
 
-    auto context = kj::refcounted<LocalCallContext>(kj::mv(message), client->addRef(), hints, isStreaming);
-    auto promiseAndPipeline = client->call(interfaceId, methodId, kj::addRef(*context), hints);
+    auto promiseAndPipeline = clientRef->call(interfaceId, methodId, kj::addRef(*this), hints);
 
     // Now the other branch returns the response from the context.
-    auto promise = promiseAndPipeline.promise.then([context=kj::mv(context)]() mutable {
+    auto promise = promiseAndPipeline.promise.then([context=kj::addRef(*this)]() mutable {
       // force response allocation
-      auto reader = context->getResults(MessageSize { 0, 0 }).asReader();
+      AnyPointer::Reader reader = context->getResults(MessageSize { 0, 0 }).asReader();
 
-      if (context->isShared()) {
-        // We can't just move away context->response as `context` itself is still referenced by
-        // something -- probably a Pipeline object. As a bit of a hack, LocalCallContext itself
-        // implements ResponseHook so that we can just return a ref on it.
-        //
-        // TODO(cleanup): Maybe ResponseHook should be refcounted? Note that context->response
-        //   might not necessarily contain a LocalResponse if it was resolved by a tail call, so
-        //   we'd have to add refcounting to all ResponseHook implementations.
-        context->releaseParams();      // The call is done so params can definitely be dropped.
-        context->clientRef = nullptr;  // Definitely not using the client cap anymore either.
-        return Response<AnyPointer>(reader, kj::mv(context));
-      } else {
-        return kj::mv(KJ_ASSERT_NONNULL(context->response));
+      KJ_IF_MAYBE(r, context->tailCallResponse) {
+        if (!context->isShared()) {
+          return kj::mv(*r);
+        }
+        reader = *r;
       }
+
+      // The context itself serves as the ResponseHook, so the results don't need an allocation
+      // of their own, and a pooled results segment goes back to the pool when they're dropped.
+      context->releaseParams();      // The call is done so params can definitely be dropped.
+      context->clientRef = nullptr;  // Definitely not using the client cap anymore either.
+      return Response<AnyPointer>(reader, kj::mv(context));
     });
 
     // We return the other branch.
@@ -403,24 +589,37 @@ public:
   Request<AnyPointer, AnyPointer> newCall(
       uint64_t interfaceId, uint16_t methodId, kj::Maybe<MessageSize> sizeHint,
       CallHints hints) override {
-    auto hook = kj::heap<LocalRequest>(
-        interfaceId, methodId, sizeHint, hints, kj::addRef(*this));
-    auto root = hook->message->getRoot<AnyPointer>();
-    return Request<AnyPointer, AnyPointer>(root, kj::mv(hook));
+    KJ_IF_MAYBE(r, directTarget()) {
+      return r->newCall(interfaceId, methodId, sizeHint, hints);
+    }
+
+    return LocalCallContext::newRequest(interfaceId, methodId, sizeHint, hints, kj::addRef(*this));
   }
 
   VoidPromiseAndPipeline call(uint64_t interfaceId, uint16_t methodId,
                               kj::Own<CallContextHook>&& context, CallHints hints) override {
+    KJ_IF_MAYBE(r, directTarget()) {
+      return r->call(interfaceId, methodId, kj::mv(context), hints);
+    }
+
+    // Count the call as queued until it has been forwarded (or canceled).
+    ++queuedCalls;
+    auto queued = kj::defer([self = kj::addRef(*this)]() mutable { --self->queuedCalls; });
+
     if (hints.noPromisePipelining) {
       // Optimize for no pipelining.
       auto promise = promiseForCallForwarding.addBranch()
-          .then([=,context=kj::mv(context)](kj::Own<ClientHook>&& client) mutable {
+          .then([=,context=kj::mv(context),queued=kj::mv(queued)]
+                (kj::Own<ClientHook>&& client) mutable {
+        queued.run();
         return client->call(interfaceId, methodId, kj::mv(context), hints).promise;
       });
       return VoidPromiseAndPipeline { kj::mv(promise), getDisabledPipeline() };
     } else if (hints.onlyPromisePipeline) {
       auto pipelinePromise = promiseForCallForwarding.addBranch()
-          .then([=,context=kj::mv(context)](kj::Own<ClientHook>&& client) mutable {
+          .then([=,context=kj::mv(context),queued=kj::mv(queued)]
+                (kj::Own<ClientHook>&& client) mutable {
+        queued.run();
         return client->call(interfaceId, methodId, kj::mv(context), hints).pipeline;
       });
       return VoidPromiseAndPipeline {
@@ -429,7 +628,9 @@ public:
       };
     } else {
       auto split = promiseForCallForwarding.addBranch()
-          .then([=,context=kj::mv(context)](kj::Own<ClientHook>&& client) mutable {
+          .then([=,context=kj::mv(context),queued=kj::mv(queued)]
+                (kj::Own<ClientHook>&& client) mutable {
+        queued.run();
         auto vpap = client->call(interfaceId, methodId, kj::mv(context), hints);
         return kj::tuple(kj::mv(vpap.promise), kj::mv(vpap.pipeline));
       }).split();
@@ -478,6 +679,9 @@ private:
   kj::Maybe<kj::Own<ClientHook>> redirect;
   // Once the promise resolves, this will become non-null and point to the underlying object.
 
+  uint queuedCalls = 0;
+  // Number of calls which have been queued but not yet forwarded to `redirect`.
+
   ClientHookPromiseFork promise;
   // Promise that resolves when we have a new ClientHook to forward to.
   //
@@ -499,6 +703,15 @@ private:
   // confuse the application if a queued call returns before the capability on which it was made
   // resolves).  Luckily, we know that queued calls will involve, at the very least, an
   // eventLoop.evalLater.
+
+  kj::Maybe<ClientHook&> directTarget() {
+    // Once we've resolved and every queued call has been forwarded, new calls can go straight to
+    // the resolution, skipping the queue without overtaking any earlier call.
+    KJ_IF_MAYBE(r, redirect) {
+      if (queuedCalls == 0) return **r;
+    }
+    return nullptr;
+  }
 };
 
 kj::Own<ClientHook> QueuedPipeline::getPipelinedCap(kj::Array<PipelineOp>&& ops) {
@@ -582,10 +795,8 @@ public:
       return r->get()->newCall(interfaceId, methodId, sizeHint, hints);
     }
 
-    auto hook = kj::heap<LocalRequest>(
-        interfaceId, methodId, sizeHint, hints, kj::addRef(*this));
-    auto root = hook->message->getRoot<AnyPointer>();
-    return Request<AnyPointer, AnyPointer>(root, kj::mv(hook));
+    return LocalCallContext::newRequest(
+        interfaceId, methodId, sizeHint, hints, kj::addRef(*this), getMessagePool());
   }
 
   VoidPromiseAndPipeline call(uint64_t interfaceId, uint16_t methodId,
@@ -747,6 +958,16 @@ private:
   kj::Maybe<kj::Canceler> revoker;
   // If non-null, all promises must be wrapped in this revoker.
 
+  kj::Maybe<kj::Own<LocalMessagePool>> messagePool;
+  // This thread's pool, looked up on first use by newCall().
+
+  LocalMessagePool& getMessagePool() {
+    KJ_IF_MAYBE(p, messagePool) {
+      return **p;
+    }
+    return *messagePool.emplace(LocalMessagePool::forThisThread());
+  }
+
   void startResolveTask(Capability::Server& serverRef) {
     resolveTask = serverRef.shortenPath().map([this](kj::Promise<Capability::Client> promise) {
       KJ_IF_MAYBE(r, revoker) {
@@ -868,7 +1089,9 @@ private:
       return kj::cp(*e);
     }
 
-    // `server` can't be null here since `brokenException` is null.
+    // `server` can't be null here since `brokenException` is null. Calls which the method makes
+    // before returning inherit its trace context and deadline.
+    TraceContext::Scope traceScope(context.getTraceContext(), context.getDeadline());
     auto result = KJ_ASSERT_NONNULL(server)->dispatchCall(interfaceId, methodId,
                                        CallContext<AnyPointer, AnyPointer>(context));
 
@@ -1146,6 +1369,10 @@ void BuilderCapabilityTable::dropCap(uint index) {
 
 namespace _ {  // private
 
+uint64_t localMessageSegmentAllocationsForTest() {
+  return threadSegmentAllocations;
+}
+
 Capability::Client CapabilityServerSetBase::addInternal(
     kj::Own<Capability::Server>&& server, void* ptr) {
   return Capability::Client(kj::refcounted<LocalClient>(kj::mv(server), *this, ptr));
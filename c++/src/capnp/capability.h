@@ -27,6 +27,7 @@
 
 #include <kj/async.h>
 #include <kj/vector.h>
+#include <kj/time.h>
 #include "raw-schema.h"
 #include "any.h"
 #include "pointer-helpers.h"
@@ -94,6 +95,68 @@ struct Capability {
   };
 };
 
+// =======================================================================================
+// Distributed tracing
+
+struct TraceContext {
+  // Identifies a position in a distributed trace, in the style of W3C Trace Context: the trace as
+  // a whole, and the span within it (typically a call) to which further work should be attributed.
+  //
+  // A request carries a trace context if one was set with `Request::setTraceContext()`, or if the
+  // request was created while a server method which was itself called with a trace context was
+  // running (see `current()`). The callee sees it as `CallContext::getTraceContext()`. Over RPC,
+  // the context travels with the call, and an RpcSystem with a span exporter (see
+  // `RpcSystem::setSpanExporter()`) records a span for each traced call it sends or receives.
+
+  uint64_t traceIdHigh = 0;
+  uint64_t traceIdLow = 0;
+  uint64_t spanId = 0;
+
+  static TraceContext newTrace();
+  // Start a new trace, with random IDs.
+
+  TraceContext newSpan() const;
+  // Returns a context in the same trace but with a new random span ID.
+
+  static kj::Maybe<TraceContext> current();
+  // Returns the trace context of the server method currently running on this thread, if any, or
+  // whatever was set by the innermost `Scope`. New requests pick it up automatically.
+  //
+  // KJ has no notion of an asynchronous task's context, so the method's trace context is only
+  // current while the method itself is running, i.e. until it returns its promise. In
+  // continuations, either set the trace context on each request explicitly, or use a `Scope`:
+  //
+  //     return foo.then([this, context]() mutable {
+  //       TraceContext::Scope scope(context.getTraceContext(), context.getDeadline());
+  //       return bar.bazRequest().send();  // inherits the trace context and deadline
+  //     });
+
+  static kj::Maybe<kj::TimePoint> currentDeadline();
+  // Like `current()`, but returns the deadline of the running server method (see
+  // `Request::setDeadline()`). New requests inherit it the same way, so a server's deadline
+  // reaches the calls it makes without any code in the server.
+
+  class Scope;
+};
+
+class TraceContext::Scope {
+  // Makes a trace context and deadline current on this thread for the scope's lifetime. The
+  // server dispatch code creates one around each method call. Scopes must be destroyed in the
+  // reverse order they were created.
+
+public:
+  explicit Scope(kj::Maybe<TraceContext> context, kj::Maybe<kj::TimePoint> deadline = nullptr);
+  ~Scope();
+  KJ_DISALLOW_COPY_AND_MOVE(Scope);
+
+private:
+  kj::Maybe<TraceContext> context;
+  kj::Maybe<kj::TimePoint> deadline;
+  const Scope* previous;
+
+  friend struct TraceContext;
+};
+
 // =======================================================================================
 // Capability clients
 
@@ -139,6 +202,24 @@ public:
   //   returning a capability that points back to the caller's vat, calls on the pipelined
   //   capability may continue to proxy through the callee.
 
+  void setDeadline(kj::Maybe<kj::TimePoint> deadline);
+  // Declare that the caller won't be interested in the result after `deadline`, as measured by
+  // `kj::systemPreciseMonotonicClock()` (or equivalently, a `kj::Timer` driven by the event
+  // port). The callee can see the deadline via `CallContext::getDeadline()`, and an RpcSystem
+  // which has been given a timer (see `RpcSystem::setTimer()`) will cancel the call on the server
+  // side once the deadline passes, provided the method allows cancellation.
+  //
+  // The deadline does not affect the caller's own promise; use `kj::Timer::timeoutAfter()` or
+  // similar for that. If called more than once, the earliest deadline wins; null is ignored.
+  //
+  // A request created while a server method is running starts out with that method's deadline
+  // (see `TraceContext::currentDeadline()`), so deadlines propagate to downstream calls
+  // automatically. Calling this can only make the deadline earlier.
+
+  void setTraceContext(kj::Maybe<TraceContext> context);
+  // Make this call part of the given trace, replacing any trace context it inherited from
+  // `TraceContext::current()`. Null is ignored. See `TraceContext`.
+
 private:
   kj::Own<RequestHook> hook;
 
@@ -160,6 +241,12 @@ public:
 
   kj::Promise<void> send() KJ_WARN_UNUSED_RESULT;
 
+  void setDeadline(kj::Maybe<kj::TimePoint> deadline);
+  // Same as `Request::setDeadline()`.
+
+  void setTraceContext(kj::Maybe<TraceContext> context);
+  // Same as `Request::setTraceContext()`.
+
 private:
   kj::Own<RequestHook> hook;
 
@@ -425,6 +512,19 @@ public:
   //
   // In general, this should be the last thing a method implementation calls, and the promise
   // returned from `tailCall()` should then be returned by the method implementation.
+  //
+  // If this call has a deadline, the tail call inherits it (unless it already has an earlier one).
+  // The tail call also inherits this call's trace context.
+
+  kj::Maybe<kj::TimePoint> getDeadline();
+  // Get the deadline the caller specified using `Request::setDeadline()`, if any. Requests made
+  // while the method is running inherit it, like the trace context; in continuations, use a
+  // `TraceContext::Scope` (see `TraceContext::current()`) or set it on each request explicitly.
+
+  kj::Maybe<TraceContext> getTraceContext();
+  // Get the trace context to which this call's work should be attributed, if the call is being
+  // traced. Over RPC, this names the span the receiving RpcSystem created for the call, if it has
+  // a span exporter, or otherwise the caller's span. See `TraceContext`.
 
   void allowCancellation()
       KJ_UNAVAILABLE(
@@ -457,6 +557,12 @@ public:
   // - It wouldn't be particularly useful since streaming calls don't return anything, and they
   //   already compensate for latency.
 
+  kj::Maybe<kj::TimePoint> getDeadline();
+  // Same as `CallContext::getDeadline()`.
+
+  kj::Maybe<TraceContext> getTraceContext();
+  // Same as `CallContext::getTraceContext()`.
+
   void allowCancellation()
       KJ_UNAVAILABLE(
           "As of Cap'n Proto 1.0, allowCancellation must be applied statically using an "
@@ -740,6 +846,17 @@ public:
   // discover when tail call is going to be sent over its own connection and therefore can be
   // optimized into a remote tail call.
 
+  virtual void setDeadline(kj::TimePoint deadline) {}
+  // Implements `Request::setDeadline()`. If a deadline was already set, the earlier one must be
+  // kept. Deadlines are advisory, so the default implementation just ignores them; hooks which
+  // wrap another request should forward this.
+
+  virtual void setTraceContext(const TraceContext& context) {}
+  // Implements `Request::setTraceContext()`. Like deadlines, trace contexts may be ignored, and
+  // hooks which wrap another request should forward them. Hooks which carry trace contexts and
+  // deadlines should initialize them from `TraceContext::current()` and
+  // `TraceContext::currentDeadline()` when constructed.
+
   template <typename T, typename U>
   inline static kj::Own<RequestHook> from(Request<T, U>&& request) {
     return kj::mv(request.hook);
@@ -873,6 +990,12 @@ public:
 
   virtual kj::Own<CallContextHook> addRef() = 0;
 
+  virtual kj::Maybe<kj::TimePoint> getDeadline() { return nullptr; }
+  // Implements `CallContext::getDeadline()`.
+
+  virtual kj::Maybe<TraceContext> getTraceContext() { return nullptr; }
+  // Implements `CallContext::getTraceContext()`.
+
   template <typename Params, typename Results>
   static CallContextHook& from(CallContext<Params, Results>& context) { return *context.hook; }
   template <typename Params>
@@ -895,6 +1018,14 @@ kj::Own<ClientHook> newBrokenCap(kj::Exception&& reason);
 kj::Own<PipelineHook> newBrokenPipeline(kj::Exception&& reason);
 // Helper function that creates a pipeline which simply throws exceptions when called.
 
+namespace _ {  // private
+
+uint64_t localMessageSegmentAllocationsForTest();
+// Counts the first segments allocated on this thread for the params and results of local calls,
+// as opposed to those taken from the thread's pool of recycled segments.
+
+}  // namespace _ (private)
+
 Request<AnyPointer, AnyPointer> newBrokenRequest(
     kj::Exception&& reason, kj::Maybe<MessageSize> sizeHint);
 // Helper function that creates a Request object that simply throws exceptions when sent.
@@ -1086,6 +1217,34 @@ kj::Promise<void> StreamingRequest<Params>::send() {
   return promise;
 }
 
+template <typename Params, typename Results>
+inline void Request<Params, Results>::setDeadline(kj::Maybe<kj::TimePoint> deadline) {
+  KJ_IF_MAYBE(d, deadline) {
+    hook->setDeadline(*d);
+  }
+}
+
+template <typename Params>
+inline void StreamingRequest<Params>::setDeadline(kj::Maybe<kj::TimePoint> deadline) {
+  KJ_IF_MAYBE(d, deadline) {
+    hook->setDeadline(*d);
+  }
+}
+
+template <typename Params, typename Results>
+inline void Request<Params, Results>::setTraceContext(kj::Maybe<TraceContext> context) {
+  KJ_IF_MAYBE(c, context) {
+    hook->setTraceContext(*c);
+  }
+}
+
+template <typename Params>
+inline void StreamingRequest<Params>::setTraceContext(kj::Maybe<TraceContext> context) {
+  KJ_IF_MAYBE(c, context) {
+    hook->setTraceContext(*c);
+  }
+}
+
 inline Capability::Client::Client(kj::Own<ClientHook>&& hook): hook(kj::mv(hook)) {}
 template <typename T, typename>
 inline Capability::Client::Client(kj::Own<T>&& server)
@@ -1177,8 +1336,26 @@ template <typename Params, typename Results>
 template <typename SubParams>
 inline kj::Promise<void> CallContext<Params, Results>::tailCall(
     Request<SubParams, Results>&& tailRequest) {
+  tailRequest.setDeadline(hook->getDeadline());
+  tailRequest.setTraceContext(hook->getTraceContext());
   return hook->tailCall(kj::mv(tailRequest.hook));
 }
+template <typename Params, typename Results>
+inline kj::Maybe<kj::TimePoint> CallContext<Params, Results>::getDeadline() {
+  return hook->getDeadline();
+}
+template <typename Params>
+inline kj::Maybe<kj::TimePoint> StreamingCallContext<Params>::getDeadline() {
+  return hook->getDeadline();
+}
+template <typename Params, typename Results>
+inline kj::Maybe<TraceContext> CallContext<Params, Results>::getTraceContext() {
+  return hook->getTraceContext();
+}
+template <typename Params>
+inline kj::Maybe<TraceContext> StreamingCallContext<Params>::getTraceContext() {
+  return hook->getTraceContext();
+}
 
 template <typename Params, typename Results>
 CallContext<Params, Results> Capability::Server::internalGetTypedContext(
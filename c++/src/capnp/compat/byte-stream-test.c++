@@ -705,6 +705,104 @@ KJ_TEST("KJ -> ByteStream RPC -> KJ promise stream -> ByteStream -> KJ") {
   waitScope.cancelAllDetached();
 }
 
+#if !_WIN32
+class CountingByteStream final: public ByteStream::Server {
+  // Forwards to another ByteStream, counting write() calls along the way.
+
+public:
+  CountingByteStream(ByteStream::Client inner): inner(kj::mv(inner)) {}
+
+  uint writeCount = 0;
+
+  kj::Promise<void> write(WriteContext context) override {
+    ++writeCount;
+    auto params = context.getParams();
+    auto req = inner.writeRequest(params.totalSize());
+    req.setBytes(params.getBytes());
+    return req.send();
+  }
+  kj::Promise<void> end(EndContext context) override {
+    return context.tailCall(inner.endRequest());
+  }
+  kj::Promise<void> openPipe(OpenPipeContext context) override {
+    return context.tailCall(inner.openPipeRequest());
+  }
+
+private:
+  ByteStream::Client inner;
+};
+
+void testPipeNegotiation(bool receiverHasProvider, uint maxFdsPerMessage, bool expectPipe) {
+  auto io = kj::setupAsyncIo();
+  auto& waitScope = io.waitScope;
+
+  ByteStreamFactory senderFactory(*io.lowLevelProvider);
+  ByteStreamFactory pipeReceiverFactory(*io.lowLevelProvider);
+  ByteStreamFactory plainReceiverFactory;
+  auto& receiverFactory = receiverHasProvider ? pipeReceiverFactory : plainReceiverFactory;
+
+  // The destination is an OS pipe, so a receiver using the fast path can splice() into it.
+  auto destination = io.provider->newOneWayPipe();
+  auto backCap = receiverFactory.kjToCapnp(kj::mv(destination.out));
+
+  auto rpcPipe = io.provider->newCapabilityPipe();
+  capnp::TwoPartyClient client(*rpcPipe.ends[0], maxFdsPerMessage);
+  capnp::TwoPartyClient server(*rpcPipe.ends[1], maxFdsPerMessage, kj::mv(backCap),
+                               rpc::twoparty::Side::SERVER);
+
+  auto counterServer = kj::heap<CountingByteStream>(client.bootstrap().castAs<ByteStream>());
+  auto& counter = *counterServer;
+  auto front = senderFactory.capnpToKjExplicitEnd(kj::mv(counterServer));
+
+  {
+    auto promise = front->write("foo", 3);
+    expectRead(*destination.in, "foo").wait(waitScope);
+    promise.wait(waitScope);
+  }
+
+  {
+    auto str = makeString(1 << 17);
+    auto promise = front->write(str.begin(), str.size());
+    expectRead(*destination.in, str).wait(waitScope);
+    promise.wait(waitScope);
+  }
+
+  {
+    // Pump from another OS pipe, which can be spliced straight into ours.
+    auto source = io.provider->newOneWayPipe();
+    auto str = makeString(1 << 16);
+    auto pumpPromise = source.in->pumpTo(*front, str.size());
+    auto writePromise = source.out->write(str.begin(), str.size());
+    expectRead(*destination.in, str).wait(waitScope);
+    writePromise.wait(waitScope);
+    KJ_EXPECT(pumpPromise.wait(waitScope) == str.size());
+  }
+
+  front->end().wait(waitScope);
+
+  if (expectPipe) {
+    KJ_EXPECT(counter.writeCount == 0, counter.writeCount);
+  } else {
+    KJ_EXPECT(counter.writeCount > 0);
+  }
+
+  front = nullptr;
+  KJ_EXPECT(destination.in->readAllText().wait(waitScope) == "");
+}
+
+KJ_TEST("KJ -> ByteStream RPC -> KJ uses a pipe when the connection can pass fds") {
+  testPipeNegotiation(true, 1, true);
+}
+
+KJ_TEST("KJ -> ByteStream RPC -> KJ falls back to write() when the receiver has no pipes") {
+  testPipeNegotiation(false, 1, false);
+}
+
+KJ_TEST("KJ -> ByteStream RPC -> KJ falls back to write() when the connection can't pass fds") {
+  testPipeNegotiation(true, 0, false);
+}
+#endif  // !_WIN32
+
 // TODO:
 // - Parallel writes (requires streaming)
 // - Write to KJ -> capnp -> RPC -> capnp -> KJ loopback without shortening, verify we can write
@@ -23,6 +23,12 @@
 #include <kj/one-of.h>
 #include <kj/debug.h>
 
+#if !_WIN32
+#include <kj/io.h>
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
 namespace capnp {
 
 const uint MAX_BYTES_PER_WRITE = 1 << 16;
@@ -320,6 +326,23 @@ private:
 
 // =======================================================================================
 
+#if !_WIN32
+class ByteStreamFactory::PipeImpl final: public capnp::ByteStream::Pipe::Server {
+  // Returned by openPipe(). Owns the receiver's copy of the pipe's write end, which is closed once
+  // the caller has taken its own copy and dropped this capability.
+
+public:
+  PipeImpl(kj::AutoCloseFd fd): fd(kj::mv(fd)) {}
+
+  kj::Maybe<int> getFd() override { return fd.get(); }
+
+private:
+  kj::AutoCloseFd fd;
+};
+#endif
+
+// =======================================================================================
+
 class ByteStreamFactory::CapnpToKjStreamAdapter final: public StreamServerBase {
   // Implements Cap'n Proto ByteStream as a wrapper around a KJ stream.
 
@@ -376,6 +399,9 @@ public:
       KJ_CASE_ONEOF(capnpStream, capnp::ByteStream::Client) {
         return &capnpStream;
       }
+      KJ_CASE_ONEOF(piped, Piped) {
+        return whenPipeDrained(piped);
+      }
       KJ_CASE_ONEOF(b, Borrowed) {
         KJ_FAIL_REQUIRE("concurrent streaming calls disallowed") { break; }
         return kj::Promise<void>(kj::READY_NOW);
@@ -400,6 +426,11 @@ public:
         // Ugh I guess we need to send a real end() request here.
         capnpStream.endRequest(MessageSize {2, 0}).send().detach([](kj::Exception&&){});
       }
+      KJ_CASE_ONEOF(piped, Piped) {
+        // Let the pump drain whatever is still in the pipe before the inner stream is dropped.
+        piped.pump.addBranch().attach(kj::mv(piped.stream)).detach([](kj::Exception&&){});
+        state = Ended();
+      }
       KJ_CASE_ONEOF(b, Borrowed) {
         // Fine, ignore.
       }
@@ -423,6 +454,11 @@ public:
         // Ugh I guess we need to send a real end() request here.
         return capnpStream.endRequest(MessageSize {2, 0}).send().ignoreResult();
       }
+      KJ_CASE_ONEOF(piped, Piped) {
+        auto promise = piped.pump.addBranch().attach(kj::mv(piped.stream));
+        state = Ended();
+        return promise;
+      }
       KJ_CASE_ONEOF(b, Borrowed) {
         // Fine, ignore.
         return kj::READY_NOW;
@@ -583,6 +619,11 @@ protected:
       KJ_CASE_ONEOF(capnpStream, capnp::ByteStream::Client) {
         return Capability::Client(capnpStream);
       }
+      KJ_CASE_ONEOF(piped, Piped) {
+        return whenPipeDrained(piped).then([this]() {
+          return shortenPathImpl();
+        });
+      }
       KJ_CASE_ONEOF(b, Borrowed) {
         KJ_FAIL_REQUIRE("concurrent streaming calls disallowed") { break; }
         return kj::NEVER_DONE;
@@ -614,6 +655,11 @@ protected:
         req.setBytes(params.getBytes());
         return req.send();
       }
+      KJ_CASE_ONEOF(piped, Piped) {
+        return whenPipeDrained(piped).then([this, context]() mutable {
+          return write(context);
+        });
+      }
       KJ_CASE_ONEOF(b, Borrowed) {
         KJ_FAIL_REQUIRE("concurrent streaming calls disallowed") { break; }
         return kj::READY_NOW;
@@ -649,6 +695,11 @@ protected:
         auto req = capnpStream.endRequest(params.totalSize());
         return context.tailCall(kj::mv(req));
       }
+      KJ_CASE_ONEOF(piped, Piped) {
+        return whenPipeDrained(piped).then([this, context]() mutable {
+          return end(context);
+        });
+      }
       KJ_CASE_ONEOF(b, Borrowed) {
         KJ_FAIL_REQUIRE("concurrent streaming calls disallowed") { break; }
         return kj::READY_NOW;
@@ -674,6 +725,11 @@ protected:
         KJ_CASE_ONEOF(capnpStream, capnp::ByteStream::Client) {
           return KJ_ASSERT_NONNULL(*s->get())(params.getExpectedServerHostname());
         }
+        KJ_CASE_ONEOF(piped, Piped) {
+          return whenPipeDrained(piped).then([this, context]() mutable {
+            return startTls(context);
+          });
+        }
         KJ_CASE_ONEOF(e, Ended) {
           KJ_FAIL_REQUIRE("cannot call startTls on a bytestream that was ended");
         }
@@ -713,6 +769,68 @@ protected:
         req.setLimit(params.getLimit());
         return context.tailCall(kj::mv(req));
       }
+      KJ_CASE_ONEOF(piped, Piped) {
+        return whenPipeDrained(piped).then([this, context]() mutable {
+          return getSubstream(context);
+        });
+      }
+      KJ_CASE_ONEOF(b, Borrowed) {
+        KJ_FAIL_REQUIRE("concurrent streaming calls disallowed") { break; }
+        return kj::READY_NOW;
+      }
+      KJ_CASE_ONEOF(e, Ended) {
+        KJ_FAIL_REQUIRE("already called end()") { break; }
+        return kj::READY_NOW;
+      }
+    }
+    KJ_UNREACHABLE;
+  }
+
+  kj::Promise<void> openPipe(OpenPipeContext context) override {
+    KJ_SWITCH_ONEOF(state) {
+      KJ_CASE_ONEOF(prober, kj::Own<PathProber>) {
+        return prober->whenReady().then([this, context]() mutable {
+          KJ_ASSERT(!state.is<kj::Own<PathProber>>());
+          return openPipe(context);
+        });
+      }
+      KJ_CASE_ONEOF(kjStream, kj::Own<kj::AsyncOutputStream>) {
+#if _WIN32
+        KJ_UNIMPLEMENTED("ByteStream pipes are not supported on Windows");
+#else
+        KJ_IF_MAYBE(provider, factory.lowLevelProvider) {
+          int fds[2];
+#if __linux__ && !__BIONIC__
+          KJ_SYSCALL(pipe2(fds, O_CLOEXEC));
+#else
+          KJ_SYSCALL(pipe(fds));
+          KJ_SYSCALL(fcntl(fds[1], F_SETFD, FD_CLOEXEC));
+#endif
+          kj::AutoCloseFd readFd(fds[0]);
+          kj::AutoCloseFd writeFd(fds[1]);
+
+          // Pump the read end into the inner stream. If the inner stream wraps a file descriptor
+          // too, KJ will splice() between them without copying through userspace.
+          auto readEnd = provider->wrapInputFd(kj::mv(readFd));
+          auto pump = readEnd->pumpTo(*kjStream).ignoreResult().attach(kj::mv(readEnd));
+          auto stream = kj::mv(kjStream);
+          state = Piped { kj::mv(stream), pump.fork() };
+
+          context.initResults(MessageSize {2, 1}).setPipe(kj::heap<PipeImpl>(kj::mv(writeFd)));
+          return kj::READY_NOW;
+        } else {
+          KJ_UNIMPLEMENTED("this ByteStreamFactory was not given a LowLevelAsyncIoProvider");
+        }
+#endif
+      }
+      KJ_CASE_ONEOF(capnpStream, capnp::ByteStream::Client) {
+        return context.tailCall(capnpStream.openPipeRequest(MessageSize {2, 0}));
+      }
+      KJ_CASE_ONEOF(piped, Piped) {
+        return whenPipeDrained(piped).then([this, context]() mutable {
+          return openPipe(context);
+        });
+      }
       KJ_CASE_ONEOF(b, Borrowed) {
         KJ_FAIL_REQUIRE("concurrent streaming calls disallowed") { break; }
         return kj::READY_NOW;
@@ -730,10 +848,28 @@ private:
   kj::Maybe<kj::Own<kj::TlsStarterCallback>> tlsStarter;
 
   struct Borrowed { kj::Own<kj::AsyncOutputStream> stream; };
+  struct Piped {
+    kj::Own<kj::AsyncOutputStream> stream;
+    kj::ForkedPromise<void> pump;
+    // Pumps the read end of the pipe handed out by openPipe() into `stream`. Completes when every
+    // copy of the write end has been closed.
+  };
   struct Ended {};
 
   kj::OneOf<kj::Own<PathProber>, kj::Own<kj::AsyncOutputStream>,
-            capnp::ByteStream::Client, Borrowed, Ended> state;
+            capnp::ByteStream::Client, Borrowed, Piped, Ended> state;
+
+  kj::Promise<void> whenPipeDrained(Piped& piped) {
+    // Calls received while a pipe is open wait for the writer to close it (or to drop it without
+    // ever taking the file descriptor) and for its contents to reach the inner stream. Then we go
+    // back to writing the inner stream directly.
+    return piped.pump.addBranch().then([this]() {
+      KJ_IF_MAYBE(p, state.tryGet<Piped>()) {
+        auto stream = kj::mv(p->stream);
+        state = kj::mv(stream);
+      }
+    });
+  }
 
   class SubstreamCallbackImpl final: public capnp::ByteStream::SubstreamCallback::Server {
   public:
@@ -810,7 +946,11 @@ public:
       //   use a detached promise for now, which is probably OK since capabilities are refcounted and
       //   asynchronously destroyed anyway.
       // TODO(cleanup): Fix this when KJ streads add an explicit end() method.
-      KJ_IF_MAYBE(o, optimized) {
+      if (pipe != nullptr) {
+        // Close our end of the pipe first so the receiver's pump sees EOF.
+        pipe = nullptr;
+        inner.endRequest(MessageSize {2, 0}).send().detach([](kj::Exception&&){});
+      } else KJ_IF_MAYBE(o, optimized) {
         o->directEnd();
       } else {
         inner.endRequest(MessageSize {2, 0}).send().detach([](kj::Exception&&){});
@@ -821,7 +961,18 @@ public:
   kj::Promise<void> end() override {
     KJ_REQUIRE(explicitEnd, "not expecting explicit end");
 
-    KJ_IF_MAYBE(o, optimized) {
+    KJ_IF_MAYBE(negotiation, pipeNegotiation) {
+      if (!pipeNegotiated) {
+        return negotiation->addBranch().then([this]() { return end(); });
+      }
+    }
+
+    if (pipe != nullptr) {
+      // Close our end of the pipe first so the receiver's pump sees EOF. The receiver's end()
+      // then completes once the pump has drained.
+      pipe = nullptr;
+      return inner.endRequest(MessageSize {2, 0}).send().ignoreResult();
+    } else KJ_IF_MAYBE(o, optimized) {
       return o->directExplicitEnd();
     } else {
       return inner.endRequest(MessageSize {2, 0}).send().ignoreResult();
@@ -829,6 +980,15 @@ public:
   }
 
   kj::Promise<void> write(const void* buffer, size_t size) override {
+    KJ_IF_MAYBE(promise, whenPipeNegotiated()) {
+      return promise->then([this,buffer,size]() {
+        return write(buffer, size);
+      });
+    }
+    KJ_IF_MAYBE(p, pipe) {
+      return p->get()->write(buffer, size);
+    }
+
     KJ_SWITCH_ONEOF(getShortestPath()) {
       KJ_CASE_ONEOF(promise, kj::Promise<void>) {
         return promise.then([this,buffer,size]() {
@@ -871,6 +1031,15 @@ public:
   }
 
   kj::Promise<void> write(kj::ArrayPtr<const kj::ArrayPtr<const byte>> pieces) override {
+    KJ_IF_MAYBE(promise, whenPipeNegotiated()) {
+      return promise->then([this,pieces]() {
+        return write(pieces);
+      });
+    }
+    KJ_IF_MAYBE(p, pipe) {
+      return p->get()->write(pieces);
+    }
+
     KJ_SWITCH_ONEOF(getShortestPath()) {
       KJ_CASE_ONEOF(promise, kj::Promise<void>) {
         return promise.then([this,pieces]() {
@@ -926,14 +1095,27 @@ public:
 
   kj::Maybe<kj::Promise<uint64_t>> tryPumpFrom(
       kj::AsyncInputStream& input, uint64_t amount = kj::maxValue) override {
-    KJ_IF_MAYBE(rpc, kj::dynamicDowncastIfAvailable<CapnpToKjStreamAdapter::PathProber>(input)) {
-      // Oh interesting, it turns we're hosting an incoming ByteStream which is pumping to this
-      // outgoing ByteStream. We can let the Cap'n Proto RPC layer know that it can shorten the
-      // path from one to the other.
-      return rpc->pumpToShorterPath(inner, amount);
-    } else {
-      return pumpLoop(input, 0, amount);
+    if (pipe == nullptr && pipeNegotiation == nullptr) {
+      KJ_IF_MAYBE(rpc, kj::dynamicDowncastIfAvailable<CapnpToKjStreamAdapter::PathProber>(input)) {
+        // Oh interesting, it turns we're hosting an incoming ByteStream which is pumping to this
+        // outgoing ByteStream. We can let the Cap'n Proto RPC layer know that it can shorten the
+        // path from one to the other.
+        return rpc->pumpToShorterPath(inner, amount);
+      }
     }
+
+    KJ_IF_MAYBE(promise, whenPipeNegotiated()) {
+      return promise->then([this,&input,amount]() {
+        return KJ_ASSERT_NONNULL(tryPumpFrom(input, amount));
+      });
+    }
+    KJ_IF_MAYBE(p, pipe) {
+      // Let the input pump straight into the pipe. If the input is itself a file descriptor, KJ
+      // will splice() it.
+      return input.pumpTo(**p, amount);
+    }
+
+    return pumpLoop(input, 0, amount);
   }
 
   kj::Promise<void> whenWriteDisconnected() override {
@@ -954,6 +1136,73 @@ private:
   bool explicitEnd;
   // Did the creator promise to explicitly call end()?
 
+  kj::Maybe<kj::Own<kj::AsyncOutputStream>> pipe;
+  // Write end of the pipe obtained through openPipe(), if negotiation succeeded. Once set, all
+  // data goes through it, even if `optimized` is discovered later.
+
+  kj::Maybe<kj::ForkedPromise<void>> pipeNegotiation;
+  bool pipeNegotiated = false;
+  // Set when the factory has a LowLevelAsyncIoProvider and the first write or pump was attempted.
+  // `pipeNegotiated` becomes true once the openPipe() call has settled either way.
+
+  kj::Maybe<kj::Promise<void>> whenPipeNegotiated() {
+    // Starts pipe negotiation on the first call, if enabled. Returns a promise if writes must wait
+    // for negotiation to settle before picking a path, or null if they can proceed now.
+
+    if (pipeNegotiated) return nullptr;
+
+    KJ_IF_MAYBE(negotiation, pipeNegotiation) {
+      return negotiation->addBranch();
+    }
+
+#if _WIN32
+    pipeNegotiated = true;
+    return nullptr;
+#else
+    KJ_IF_MAYBE(provider, factory.lowLevelProvider) {
+      if (optimized != nullptr) {
+        // The stream is in our own process; path shortening beats a pipe.
+        pipeNegotiated = true;
+        return nullptr;
+      }
+
+      auto& negotiation = pipeNegotiation.emplace(negotiatePipe(*provider).fork());
+      return negotiation.addBranch();
+    } else {
+      pipeNegotiated = true;
+      return nullptr;
+    }
+#endif
+  }
+
+#if !_WIN32
+  kj::Promise<void> negotiatePipe(kj::LowLevelAsyncIoProvider& provider) {
+    return inner.openPipeRequest(MessageSize {2, 0}).send()
+        .then([this,&provider](capnp::Response<capnp::ByteStream::OpenPipeResults>&& response) {
+      auto pipeCap = response.getPipe();
+      auto promise = pipeCap.getFd();
+      return promise.then([this,&provider,pipeCap=kj::mv(pipeCap)](kj::Maybe<int> fd) {
+        KJ_IF_MAYBE(f, fd) {
+          // The descriptor belongs to `pipeCap`; take our own copy, then let the capability go so
+          // the receiver closes its copy of the write end.
+          int ownFd;
+          KJ_SYSCALL(ownFd = fcntl(*f, F_DUPFD_CLOEXEC, 0));
+          pipe = provider.wrapOutputFd(ownFd,
+              kj::LowLevelAsyncIoProvider::TAKE_OWNERSHIP |
+              kj::LowLevelAsyncIoProvider::ALREADY_CLOEXEC);
+        }
+        // Otherwise, the connection couldn't carry the descriptor. Fall back to write().
+      });
+    }).catch_([](kj::Exception&& e) {
+      // Most likely the other side doesn't implement openPipe() or wasn't given a
+      // LowLevelAsyncIoProvider. Fall back to write(). (If the stream is actually broken, the
+      // next write() will report it.)
+    }).then([this]() {
+      pipeNegotiated = true;
+    });
+  }
+#endif
+
   kj::Promise<void> findShorterPath(capnp::ByteStream::Client& capnpClient) {
     // If the capnp stream turns out to resolve back to this process, shorten the path.
     // Also, implement whenWriteDisconnected() based on this.
@@ -1140,6 +1389,9 @@ private:
 
 // =======================================================================================
 
+ByteStreamFactory::ByteStreamFactory(kj::LowLevelAsyncIoProvider& lowLevelProvider)
+    : lowLevelProvider(lowLevelProvider) {}
+
 capnp::ByteStream::Client ByteStreamFactory::kjToCapnp(kj::Own<kj::AsyncOutputStream> kjStream) {
   return streamSet.add(kj::heap<CapnpToKjStreamAdapter>(*this, kj::mv(kjStream)));
 }
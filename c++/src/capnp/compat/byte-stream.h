@@ -54,6 +54,16 @@ class ByteStreamFactory {
   // between RPC ByteStreams and KJ streams.
 
 public:
+  ByteStreamFactory() = default;
+  explicit ByteStreamFactory(kj::LowLevelAsyncIoProvider& lowLevelProvider);
+  // Passing a LowLevelAsyncIoProvider enables the pipe fast path (see `ByteStream.openPipe()` in
+  // byte-stream.capnp): streams returned by kjToCapnp() will hand out a pipe on request, and
+  // streams returned by capnpToKj() will ask for one before their first write, falling back to
+  // `write()` calls if the other side declines or the RPC connection can't pass file descriptors.
+  // Only useful when the RPC connection is a Unix socket with file descriptor passing enabled
+  // (e.g. TwoPartyVatNetwork with `maxFdsPerMessage` > 0). Not supported on Windows, where the
+  // provider is ignored.
+
   capnp::ByteStream::Client kjToCapnp(kj::Own<kj::AsyncOutputStream> kjStream);
   capnp::ByteStream::Client kjToCapnp(
       kj::Own<kj::AsyncOutputStream> kjStream, kj::Maybe<kj::Own<kj::TlsStarterCallback>> tlsStarter);
@@ -63,11 +73,13 @@ public:
 
 private:
   CapabilityServerSet<capnp::ByteStream> streamSet;
+  kj::Maybe<kj::LowLevelAsyncIoProvider&> lowLevelProvider;
 
   class StreamServerBase;
   class SubstreamImpl;
   class CapnpToKjStreamAdapter;
   class KjToCapnpStreamAdapter;
+  class PipeImpl;
 };
 
 }  // namespace capnp
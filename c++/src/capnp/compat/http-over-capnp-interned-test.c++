@@ -0,0 +1,2 @@
+#define TEST_PEER_OPTIMIZATION_LEVEL HttpOverCapnpFactory::LEVEL_3
+#include "http-over-capnp-test.c++"
@@ -23,6 +23,7 @@
 #include <kj/compat/http.h>
 #include <kj/test.h>
 #include <kj/debug.h>
+#include <kj/time.h>
 #include <capnp/rpc-twoparty.h>
 #include <stdlib.h>
 #if KJ_BENCHMARK_MALLOC
@@ -81,6 +82,23 @@ public:
       KJ_LOG(WARNING, upBandwidth, downBandwidth,
           clientReadCount, clientWriteCount, serverReadCount, serverWriteCount);
     }
+
+    if (requestCount > 0) {
+      auto totalNs = requestTime / kj::NANOSECONDS;
+      auto meanLatencyNs = totalNs / requestCount;
+      auto requestsPerSecond = totalNs == 0 ? 0 : requestCount * 1'000'000'000ull / totalNs;
+      KJ_LOG(WARNING, requestCount, meanLatencyNs, requestsPerSecond);
+    }
+  }
+
+  template <typename Func>
+  void timeRequest(Func&& func) {
+    // Runs one request, counting it towards the latency and throughput figures.
+    auto& clock = kj::systemPreciseMonotonicClock();
+    auto start = clock.now();
+    func();
+    requestTime += clock.now() - start;
+    ++requestCount;
   }
 
   enum Side { CLIENT, SERVER };
@@ -200,6 +218,9 @@ private:
   size_t serverWriteCount;
 
   bool hadStreamPair = false;
+
+  uint64_t requestCount = 0;
+  kj::Duration requestTime = 0 * kj::NANOSECONDS;
 };
 
 // =======================================================================================
@@ -340,7 +361,7 @@ KJ_TEST("Benchmark baseline") {
   auto headerTable = headerTableBuilder.build();
 
   doBenchmark([&]() {
-    sender.sendRequest(service).wait(waitScope);
+    metrics.timeRequest([&]() { sender.sendRequest(service).wait(waitScope); });
   });
 }
 
@@ -357,7 +378,7 @@ KJ_TEST("Benchmark KJ HTTP client wrapper") {
   auto client = kj::newHttpClient(service);
 
   doBenchmark([&]() {
-    sender.sendRequest(*client).wait(waitScope);
+    metrics.timeRequest([&]() { sender.sendRequest(*client).wait(waitScope); });
   });
 }
 
@@ -379,11 +400,12 @@ KJ_TEST("Benchmark KJ HTTP full protocol") {
   auto client = kj::newHttpClient(*headerTable, pair.client);
 
   doBenchmark([&]() {
-    sender.sendRequest(*client).wait(waitScope);
+    metrics.timeRequest([&]() { sender.sendRequest(*client).wait(waitScope); });
   });
 }
 
-KJ_TEST("Benchmark HTTP-over-capnp local call") {
+template <typename DoBenchmark>
+void benchmarkLocalCall(HttpOverCapnpFactory::OptimizationLevel level, DoBenchmark&& doBenchmark) {
   kj::EventLoop loop;
   kj::WaitScope waitScope(loop);
   Metrics metrics;
@@ -396,19 +418,20 @@ KJ_TEST("Benchmark HTTP-over-capnp local call") {
 
   // Client and server use different HttpOverCapnpFactory instances to block path-shortening.
   ByteStreamFactory bsFactory;
-  HttpOverCapnpFactory hocFactory(bsFactory, headerIds.clone(), HttpOverCapnpFactory::LEVEL_2);
+  HttpOverCapnpFactory hocFactory(bsFactory, headerIds.clone(), level);
   ByteStreamFactory bsFactory2;
-  HttpOverCapnpFactory hocFactory2(bsFactory2, kj::mv(headerIds), HttpOverCapnpFactory::LEVEL_2);
+  HttpOverCapnpFactory hocFactory2(bsFactory2, kj::mv(headerIds), level);
 
   auto cap = hocFactory.kjToCapnp(kj::attachRef(service));
   auto roundTrip = hocFactory2.capnpToKj(kj::mv(cap));
 
   doBenchmark([&]() {
-    sender.sendRequest(*roundTrip).wait(waitScope);
+    metrics.timeRequest([&]() { sender.sendRequest(*roundTrip).wait(waitScope); });
   });
 }
 
-KJ_TEST("Benchmark HTTP-over-capnp full RPC") {
+template <typename DoBenchmark>
+void benchmarkFullRpc(HttpOverCapnpFactory::OptimizationLevel level, DoBenchmark&& doBenchmark) {
   kj::EventLoop loop;
   kj::WaitScope waitScope(loop);
   Metrics metrics;
@@ -422,9 +445,9 @@ KJ_TEST("Benchmark HTTP-over-capnp full RPC") {
 
   // Client and server use different HttpOverCapnpFactory instances to block path-shortening.
   ByteStreamFactory bsFactory;
-  HttpOverCapnpFactory hocFactory(bsFactory, headerIds.clone(), HttpOverCapnpFactory::LEVEL_2);
+  HttpOverCapnpFactory hocFactory(bsFactory, headerIds.clone(), level);
   ByteStreamFactory bsFactory2;
-  HttpOverCapnpFactory hocFactory2(bsFactory2, kj::mv(headerIds), HttpOverCapnpFactory::LEVEL_2);
+  HttpOverCapnpFactory hocFactory2(bsFactory2, kj::mv(headerIds), level);
 
   TwoPartyServer server(hocFactory.kjToCapnp(kj::attachRef(service)));
 
@@ -436,10 +459,26 @@ KJ_TEST("Benchmark HTTP-over-capnp full RPC") {
   auto roundTrip = hocFactory2.capnpToKj(client.bootstrap().castAs<capnp::HttpService>());
 
   doBenchmark([&]() {
-    sender.sendRequest(*roundTrip).wait(waitScope);
+    metrics.timeRequest([&]() { sender.sendRequest(*roundTrip).wait(waitScope); });
   });
 }
 
+KJ_TEST("Benchmark HTTP-over-capnp local call") {
+  benchmarkLocalCall(HttpOverCapnpFactory::LEVEL_2, [this](auto&& func) { doBenchmark(func); });
+}
+
+KJ_TEST("Benchmark HTTP-over-capnp local call, interned headers") {
+  benchmarkLocalCall(HttpOverCapnpFactory::LEVEL_3, [this](auto&& func) { doBenchmark(func); });
+}
+
+KJ_TEST("Benchmark HTTP-over-capnp full RPC") {
+  benchmarkFullRpc(HttpOverCapnpFactory::LEVEL_2, [this](auto&& func) { doBenchmark(func); });
+}
+
+KJ_TEST("Benchmark HTTP-over-capnp full RPC, interned headers") {
+  benchmarkFullRpc(HttpOverCapnpFactory::LEVEL_3, [this](auto&& func) { doBenchmark(func); });
+}
+
 }  // namespace
 }  // namespace capnp
 
@@ -671,6 +671,106 @@ KJ_TEST("HttpService isn't destroyed while call outstanding") {
   KJ_EXPECT(!destroyed);
 }
 
+class EchoHeaderService final: public kj::HttpService {
+  // Responds to every request with a copy of its headers.
+public:
+  EchoHeaderService(kj::HttpHeaderTable& headerTable): headerTable(headerTable) {}
+
+  kj::Promise<void> request(
+      kj::HttpMethod method, kj::StringPtr url, const kj::HttpHeaders& headers,
+      kj::AsyncInputStream& requestBody, kj::HttpService::Response& response) override {
+    response.send(200, "OK", headers.clone(), uint64_t(0));
+    return kj::READY_NOW;
+  }
+
+private:
+  kj::HttpHeaderTable& headerTable;
+};
+
+class HeaderSpy final: public capnp::HttpService::Server {
+  // Forwards calls to another HttpService, recording how request headers were encoded.
+public:
+  HeaderSpy(capnp::HttpService::Client inner, kj::Vector<kj::String>& log)
+      : inner(kj::mv(inner)), log(log) {}
+
+  kj::Promise<void> request(RequestContext context) override {
+    auto params = context.getParams();
+    for (auto header: params.getRequest().getHeaders()) {
+      switch (header.which()) {
+        case capnp::HttpHeader::COMMON:
+          log.add(kj::str("common ", header.getCommon().getName()));
+          break;
+        case capnp::HttpHeader::UNCOMMON:
+          log.add(kj::str("uncommon ", header.getUncommon().getName()));
+          break;
+        case capnp::HttpHeader::INTERNED:
+          log.add(kj::str("interned ", header.getInterned().getIndex()));
+          break;
+      }
+    }
+
+    auto req = inner.requestRequest();
+    req.setRequest(params.getRequest());
+    req.setContext(params.getContext());
+    return context.tailCall(kj::mv(req));
+  }
+
+  kj::Promise<void> internHeaders(InternHeadersContext context) override {
+    auto names = context.getParams().getNames();
+    log.add(kj::str("intern ", names.size()));
+
+    auto req = inner.internHeadersRequest();
+    req.setNames(names);
+    context.getResults().setService(
+        kj::heap<HeaderSpy>(req.send().getService(), log));
+    return kj::READY_NOW;
+  }
+
+private:
+  capnp::HttpService::Client inner;
+  kj::Vector<kj::String>& log;
+};
+
+KJ_TEST("HTTP-over-Cap'n-Proto header interning") {
+  kj::EventLoop eventLoop;
+  kj::WaitScope waitScope(eventLoop);
+
+  ByteStreamFactory streamFactory;
+  kj::HttpHeaderTable::Builder tableBuilder;
+  auto hMyHeader = tableBuilder.add("My-Header");
+  HttpOverCapnpFactory factory(streamFactory, tableBuilder, HttpOverCapnpFactory::LEVEL_3);
+  auto headerTable = tableBuilder.build();
+
+  kj::Vector<kj::String> log;
+  auto back = factory.kjToCapnp(kj::heap<EchoHeaderService>(*headerTable));
+  auto front = factory.capnpToKj(kj::heap<HeaderSpy>(kj::mv(back), log));
+  auto client = kj::newHttpClient(*front);
+
+  for (auto i KJ_UNUSED: kj::zeroTo(2)) {
+    kj::HttpHeaders headers(*headerTable);
+    headers.set(hMyHeader, "foo");
+    headers.set(kj::HttpHeaderId::CONTENT_TYPE, "text/plain");
+    headers.add("Other-Header", "bar");
+
+    auto response = client->request(kj::HttpMethod::GET, "/", headers).response
+        .wait(waitScope);
+    KJ_EXPECT(response.statusCode == 200);
+    KJ_EXPECT(KJ_ASSERT_NONNULL(response.headers->get(hMyHeader)) == "foo");
+    KJ_EXPECT(KJ_ASSERT_NONNULL(response.headers->get(kj::HttpHeaderId::CONTENT_TYPE))
+        == "text/plain");
+    KJ_EXPECT(strstr(response.headers->toString().cStr(), "Other-Header: bar\r\n") != nullptr);
+    response.body->readAllText().wait(waitScope);
+  }
+
+  // The table is interned once, up front; our one custom header is then sent by index.
+  auto myIndex = hMyHeader.hashCode();
+  KJ_EXPECT(kj::strArray(log, "; ") == kj::str(
+      "intern ", headerTable->idCount(), "; "
+      "common contentType; interned ", myIndex, "; uncommon Other-Header; "
+      "common contentType; interned ", myIndex, "; uncommon Other-Header"),
+      log);
+}
+
 
 class ConnectWriteCloseService final: public kj::HttpService {
   // A simple CONNECT server that will accept a connection, write some data and close the
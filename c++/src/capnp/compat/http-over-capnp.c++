@@ -108,6 +108,111 @@ private:
 
 // =======================================================================================
 
+class HttpOverCapnpFactory::HeaderInterning final: public kj::Refcounted {
+  // Maps between indexes into a name list negotiated with HttpService.internHeaders() and IDs in
+  // our HttpHeaderTable.
+
+public:
+  struct Name {
+    kj::Maybe<kj::HttpHeaderId> id;  // null if the name isn't in our table
+    kj::String text;                 // empty if this index isn't used
+  };
+
+  HeaderInterning(const kj::HttpHeaderTable& table,
+                  kj::ArrayPtr<const capnp::CommonHeaderName> nameKjToCapnp)
+      : indexById(kj::heapArray<uint>(table.idCount())) {
+    // Interns our own table: index i is the header whose ID has hashCode() i. Headers that have a
+    // CommonHeaderName are left blank since they're already sent compactly.
+
+    auto builder = kj::heapArrayBuilder<Name>(table.idCount());
+    table.forEach([&](kj::HttpHeaderId id, kj::StringPtr name) {
+      uint i = id.hashCode();
+      if (i < nameKjToCapnp.size() && nameKjToCapnp[i] != capnp::CommonHeaderName::INVALID) {
+        builder.add(Name { nullptr, nullptr });
+        indexById[i] = NOT_INTERNED;
+      } else {
+        builder.add(Name { id, kj::heapString(name) });
+        indexById[i] = i;
+      }
+    });
+    byIndex = builder.finish();
+  }
+
+  HeaderInterning(const kj::HttpHeaderTable& table, List<Text>::Reader names)
+      : indexById(kj::heapArray<uint>(table.idCount())) {
+    // Interns a peer's name list, as received by internHeaders().
+
+    KJ_REQUIRE(names.size() <= MAX_NAMES, "too many interned header names", names.size());
+
+    for (auto& slot: indexById) slot = NOT_INTERNED;
+
+    auto builder = kj::heapArrayBuilder<Name>(names.size());
+    for (auto i: kj::indices(names)) {
+      auto name = names[i];
+      kj::Maybe<kj::HttpHeaderId> id;
+      if (name.size() > 0) {
+        KJ_IF_MAYBE(found, table.stringToId(name)) {
+          id = *found;
+          auto& slot = indexById[found->hashCode()];
+          if (slot == NOT_INTERNED) slot = i;
+        }
+      }
+      builder.add(Name { id, kj::heapString(name) });
+    }
+    byIndex = builder.finish();
+  }
+
+  void copyNamesTo(List<Text>::Builder names) const {
+    KJ_ASSERT(names.size() == byIndex.size());
+    for (auto i: kj::indices(byIndex)) {
+      names.set(i, byIndex[i].text);
+    }
+  }
+
+  uint size() const { return byIndex.size(); }
+
+  kj::Maybe<uint> indexOf(kj::HttpHeaderId id) const {
+    uint i = id.hashCode();
+    if (i < indexById.size() && indexById[i] != NOT_INTERNED) {
+      return indexById[i];
+    } else {
+      return nullptr;
+    }
+  }
+
+  const Name& get(uint index) const {
+    KJ_REQUIRE(index < byIndex.size() && byIndex[index].text.size() > 0,
+        "unknown interned header index", index);
+    return byIndex[index];
+  }
+
+  static kj::Maybe<HeaderInterning&> from(kj::Maybe<kj::Own<HeaderInterning>>& interning) {
+    KJ_IF_MAYBE(i, interning) {
+      return **i;
+    } else {
+      return nullptr;
+    }
+  }
+
+  static kj::Maybe<kj::Own<HeaderInterning>> addRef(
+      kj::Maybe<kj::Own<HeaderInterning>>& interning) {
+    KJ_IF_MAYBE(i, interning) {
+      return kj::addRef(**i);
+    } else {
+      return nullptr;
+    }
+  }
+
+private:
+  static constexpr uint MAX_NAMES = 1u << 16;
+  static constexpr uint NOT_INTERNED = kj::maxValue;
+
+  kj::Array<Name> byIndex;
+  kj::Array<uint> indexById;  // indexed by HttpHeaderId::hashCode()
+};
+
+// =======================================================================================
+
 class HttpOverCapnpFactory::CapnpToKjWebSocketAdapter final: public capnp::WebSocket::Server {
 public:
   CapnpToKjWebSocketAdapter(kj::Own<RequestState> state, kj::WebSocket& webSocket,
@@ -248,8 +353,10 @@ class HttpOverCapnpFactory::ClientRequestContextImpl final
 public:
   ClientRequestContextImpl(HttpOverCapnpFactory& factory,
                            kj::Own<RequestState> state,
-                           kj::HttpService::Response& kjResponse)
-      : factory(factory), state(kj::mv(state)), kjResponse(kjResponse) {}
+                           kj::HttpService::Response& kjResponse,
+                           kj::Maybe<kj::Own<HeaderInterning>> interning)
+      : factory(factory), state(kj::mv(state)), kjResponse(kjResponse),
+        interning(kj::mv(interning)) {}
 
   ~ClientRequestContextImpl() noexcept(false) {
     // Note this implicitly cancels the upstream pump task.
@@ -273,7 +380,8 @@ public:
     }
 
     auto bodyStream = kjResponse.send(rpcResponse.getStatusCode(), rpcResponse.getStatusText(),
-        factory.headersToKj(rpcResponse.getHeaders()), expectedSize);
+        factory.headersToKj(rpcResponse.getHeaders(), HeaderInterning::from(interning)),
+        expectedSize);
 
     auto results = context.getResults(MessageSize { 16, 1 });
     if (hasBody) {
@@ -295,7 +403,8 @@ public:
 
     auto shorteningPaf = kj::newPromiseAndFulfiller<kj::Promise<Capability::Client>>();
 
-    auto ownWebSocket = kjResponse.acceptWebSocket(factory.headersToKj(params.getHeaders()));
+    auto ownWebSocket = kjResponse.acceptWebSocket(
+        factory.headersToKj(params.getHeaders(), HeaderInterning::from(interning)));
     auto& webSocket = *ownWebSocket;
     state->holdWebSocket(kj::mv(ownWebSocket));
 
@@ -325,14 +434,17 @@ private:
 
   kj::HttpService::Response& kjResponse;
   // Must check state->assertNotCanceled() before using this.
+
+  kj::Maybe<kj::Own<HeaderInterning>> interning;
 };
 
 class HttpOverCapnpFactory::ConnectClientRequestContextImpl final
     : public capnp::HttpService::ConnectClientRequestContext::Server {
 public:
   ConnectClientRequestContextImpl(HttpOverCapnpFactory& factory,
-      kj::HttpService::ConnectResponse& connResponse)
-      : factory(factory), connResponse(connResponse) {}
+      kj::HttpService::ConnectResponse& connResponse,
+      kj::Maybe<kj::Own<HeaderInterning>> interning)
+      : factory(factory), connResponse(connResponse), interning(kj::mv(interning)) {}
 
   kj::Promise<void> startConnect(StartConnectContext context) override {
     KJ_REQUIRE(!sent, "already called startConnect() or startError()");
@@ -341,7 +453,7 @@ public:
     auto params = context.getParams();
     auto resp = params.getResponse();
 
-    auto headers = factory.headersToKj(resp.getHeaders());
+    auto headers = factory.headersToKj(resp.getHeaders(), HeaderInterning::from(interning));
     connResponse.accept(resp.getStatusCode(), resp.getStatusText(), headers);
 
     return kj::READY_NOW;
@@ -354,7 +466,7 @@ public:
     auto params = context.getParams();
     auto resp = params.getResponse();
 
-    auto headers = factory.headersToKj(resp.getHeaders());
+    auto headers = factory.headersToKj(resp.getHeaders(), HeaderInterning::from(interning));
 
     auto bodySize = resp.getBodySize();
     kj::Maybe<uint64_t> expectedSize;
@@ -375,6 +487,7 @@ private:
   bool sent = false;
 
   kj::HttpService::ConnectResponse& connResponse;
+  kj::Maybe<kj::Own<HeaderInterning>> interning;
 };
 
 class HttpOverCapnpFactory::KjToCapnpHttpServiceAdapter final: public kj::HttpService {
@@ -398,7 +511,7 @@ public:
     metadata.setMethod(static_cast<capnp::HttpMethod>(method));
     metadata.setUrl(url);
     metadata.adoptHeaders(factory.headersToCapnp(
-        headers, Orphanage::getForMessageContaining(metadata)));
+        headers, Orphanage::getForMessageContaining(metadata), HeaderInterning::from(interning)));
 
     kj::Maybe<kj::AsyncInputStream&> maybeRequestBody;
 
@@ -423,8 +536,8 @@ public:
       state->cancel();
     });
 
-    rpcRequest.setContext(
-        kj::heap<ClientRequestContextImpl>(factory, kj::addRef(*state), kjResponse));
+    rpcRequest.setContext(kj::heap<ClientRequestContextImpl>(
+        factory, kj::addRef(*state), kjResponse, HeaderInterning::addRef(interning)));
 
     auto pipeline = rpcRequest.send();
 
@@ -468,28 +581,29 @@ public:
       return requestImpl(inner.startRequestRequest(), method, url, headers, requestBody, kjResponse,
           [](auto& pipeline) { return pipeline.getContext().whenResolved(); });
     } else {
-      return requestImpl(inner.requestRequest(), method, url, headers, requestBody, kjResponse,
-          [](auto& pipeline) { return pipeline.ignoreResult(); });
+      return requestImpl(getInner().requestRequest(), method, url, headers, requestBody,
+          kjResponse, [](auto& pipeline) { return pipeline.ignoreResult(); });
     }
   }
 
   kj::Promise<void> connect(
       kj::StringPtr host, const kj::HttpHeaders& headers, kj::AsyncIoStream& connection,
       ConnectResponse& tunnel, kj::HttpConnectSettings settings) override {
-    auto rpcRequest = inner.connectRequest();
+    auto rpcRequest = getInner().connectRequest();
     auto downPipe = kj::newOneWayPipe();
     rpcRequest.setHost(host);
     rpcRequest.setDown(factory.streamFactory.kjToCapnp(kj::mv(downPipe.out)));
     rpcRequest.initSettings().setUseTls(settings.useTls);
 
-    auto context = kj::heap<ConnectClientRequestContextImpl>(factory, tunnel);
+    auto context = kj::heap<ConnectClientRequestContextImpl>(
+        factory, tunnel, HeaderInterning::addRef(interning));
     RevocableServer<capnp::HttpService::ConnectClientRequestContext> revocableContext(*context);
 
     auto builder = capnp::Request<
         capnp::HttpService::ConnectParams,
         capnp::HttpService::ConnectResults>::Builder(rpcRequest);
     rpcRequest.adoptHeaders(factory.headersToCapnp(headers,
-        Orphanage::getForMessageContaining(builder)));
+        Orphanage::getForMessageContaining(builder), HeaderInterning::from(interning)));
     rpcRequest.setContext(revocableContext.getClient());
     RemotePromise<capnp::HttpService::ConnectResults> pipeline = rpcRequest.send();
 
@@ -534,6 +648,22 @@ public:
 private:
   HttpOverCapnpFactory& factory;
   capnp::HttpService::Client inner;
+
+  kj::Maybe<kj::Own<HeaderInterning>> interning;
+  // Set once `inner` has been replaced by an internHeaders() session.
+
+  capnp::HttpService::Client& getInner() {
+    if (factory.peerOptimizationLevel >= LEVEL_3 && interning == nullptr) {
+      // First call: offer our header table to the peer and make all further calls through the
+      // returned session. Pipelining means we don't wait for it.
+      auto& ownInterning = factory.getOwnInterning();
+      auto req = inner.internHeadersRequest();
+      ownInterning.copyNamesTo(req.initNames(ownInterning.size()));
+      inner = req.send().getService();
+      interning = kj::addRef(ownInterning);
+    }
+    return inner;
+  }
 };
 
 kj::Own<kj::HttpService> HttpOverCapnpFactory::capnpToKj(capnp::HttpService::Client rpcService) {
@@ -592,11 +722,13 @@ class HttpOverCapnpFactory::HttpServiceResponseImpl
 public:
   HttpServiceResponseImpl(HttpOverCapnpFactory& factory,
                           capnp::HttpRequest::Reader request,
-                          capnp::HttpService::ClientRequestContext::Client clientContext)
+                          capnp::HttpService::ClientRequestContext::Client clientContext,
+                          kj::Maybe<kj::Own<HeaderInterning>> interning)
       : factory(factory),
+        interning(kj::mv(interning)),
         method(validateMethod(request.getMethod())),
         url(request.getUrl()),
-        headers(factory.headersToKj(request.getHeaders())),
+        headers(factory.headersToKj(request.getHeaders(), HeaderInterning::from(this->interning))),
         clientContext(kj::mv(clientContext)) {}
 
   kj::Own<kj::AsyncOutputStream> send(
@@ -615,7 +747,8 @@ public:
     rpcResponse.setStatusCode(statusCode);
     rpcResponse.setStatusText(statusText);
     rpcResponse.adoptHeaders(factory.headersToCapnp(
-        headers, Orphanage::getForMessageContaining(rpcResponse)));
+        headers, Orphanage::getForMessageContaining(rpcResponse),
+        HeaderInterning::from(interning)));
     bool hasBody = true;
     KJ_IF_MAYBE(s, expectedBodySize) {
       rpcResponse.getBodySize().setFixed(*s);
@@ -647,7 +780,8 @@ public:
 
     req.adoptHeaders(factory.headersToCapnp(
         headers, Orphanage::getForMessageContaining(
-            capnp::HttpService::ClientRequestContext::StartWebSocketParams::Builder(req))));
+            capnp::HttpService::ClientRequestContext::StartWebSocketParams::Builder(req)),
+        HeaderInterning::from(interning)));
 
     auto pipe = kj::newWebSocketPipe();
     auto shorteningPaf = kj::newPromiseAndFulfiller<kj::Promise<Capability::Client>>();
@@ -678,6 +812,7 @@ public:
   }
 
   HttpOverCapnpFactory& factory;
+  kj::Maybe<kj::Own<HeaderInterning>> interning;  // `headers` may alias into this
   kj::HttpMethod method;
   kj::StringPtr url;
   kj::HttpHeaders headers;
@@ -695,8 +830,9 @@ class HttpOverCapnpFactory::HttpOverCapnpConnectResponseImpl final :
 public:
   HttpOverCapnpConnectResponseImpl(
       HttpOverCapnpFactory& factory,
-      capnp::HttpService::ConnectClientRequestContext::Client context) :
-      context(context), factory(factory) {}
+      capnp::HttpService::ConnectClientRequestContext::Client context,
+      kj::Maybe<kj::Own<HeaderInterning>> interning) :
+      context(context), factory(factory), interning(kj::mv(interning)) {}
 
   void accept(uint statusCode, kj::StringPtr statusText, const kj::HttpHeaders& headers) override {
     KJ_REQUIRE(replyTask == nullptr, "already called accept() or reject()");
@@ -706,7 +842,8 @@ public:
     rpcResponse.setStatusCode(statusCode);
     rpcResponse.setStatusText(statusText);
     rpcResponse.adoptHeaders(factory.headersToCapnp(
-        headers, Orphanage::getForMessageContaining(rpcResponse)));
+        headers, Orphanage::getForMessageContaining(rpcResponse),
+        HeaderInterning::from(interning)));
 
     replyTask = req.send().ignoreResult();
   }
@@ -724,7 +861,8 @@ public:
     rpcResponse.setStatusCode(statusCode);
     rpcResponse.setStatusText(statusText);
     rpcResponse.adoptHeaders(factory.headersToCapnp(
-        headers, Orphanage::getForMessageContaining(rpcResponse)));
+        headers, Orphanage::getForMessageContaining(rpcResponse),
+        HeaderInterning::from(interning)));
 
     auto errorBody = kj::mv(pipe.in);
     // Set the body size if the error body exists.
@@ -746,6 +884,7 @@ public:
 
   capnp::HttpService::ConnectClientRequestContext::Client context;
   capnp::HttpOverCapnpFactory& factory;
+  kj::Maybe<kj::Own<HeaderInterning>> interning;
   kj::Maybe<kj::Promise<void>> replyTask;
 };
 
@@ -759,8 +898,9 @@ public:
                            kj::Own<capnp::HttpRequest::Reader> request,
                            capnp::HttpService::ClientRequestContext::Client clientContext,
                            kj::Own<kj::AsyncInputStream> requestBodyIn,
-                           kj::HttpService& kjService)
-      : HttpServiceResponseImpl(factory, *request, kj::mv(clientContext)),
+                           kj::HttpService& kjService,
+                           kj::Maybe<kj::Own<HeaderInterning>> interning)
+      : HttpServiceResponseImpl(factory, *request, kj::mv(clientContext), kj::mv(interning)),
         request(kj::mv(request)),
         serviceCap(kj::mv(serviceCap)),
         // Note we attach `requestBodyIn` to `task` so that we will implicitly cancel reading
@@ -789,8 +929,9 @@ private:
 
 class HttpOverCapnpFactory::CapnpToKjHttpServiceAdapter final: public capnp::HttpService::Server {
 public:
-  CapnpToKjHttpServiceAdapter(HttpOverCapnpFactory& factory, kj::Own<kj::HttpService> inner)
-      : factory(factory), inner(kj::mv(inner)) {}
+  CapnpToKjHttpServiceAdapter(HttpOverCapnpFactory& factory, kj::Own<kj::HttpService> inner,
+                              kj::Maybe<kj::Own<HeaderInterning>> interning = nullptr)
+      : factory(factory), inner(kj::mv(inner)), interning(kj::mv(interning)) {}
 
   template <typename Params, typename Results, typename Callback>
   kj::Promise<void> requestImpl(CallContext<Params, Results> context, Callback&& callback) {
@@ -843,7 +984,8 @@ public:
       public:
         using HttpServiceResponseImpl::HttpServiceResponseImpl;
       };
-      auto impl = kj::heap<FinalHttpServiceResponseImpl>(factory, metadata, params.getContext());
+      auto impl = kj::heap<FinalHttpServiceResponseImpl>(
+          factory, metadata, params.getContext(), HeaderInterning::addRef(interning));
       auto promise = inner->request(impl->method, impl->url, impl->headers, *requestBody, *impl);
       return promise.attach(kj::mv(requestBody), kj::mv(impl));
     });
@@ -854,7 +996,7 @@ public:
         [&](auto& results, auto& metadata, auto& params, auto& requestBody) {
       results.setContext(kj::heap<ServerRequestContextImpl>(
           factory, thisCap(), capnp::clone(metadata), params.getContext(), kj::mv(requestBody),
-          *inner));
+          *inner, HeaderInterning::addRef(interning)));
 
       return kj::READY_NOW;
     });
@@ -866,7 +1008,7 @@ public:
     kj::Own<kj::TlsStarterCallback> tlsStarter = kj::heap<kj::TlsStarterCallback>();
     kj::HttpConnectSettings settings = { .useTls = params.getSettings().getUseTls()};
     settings.tlsStarter = tlsStarter;
-    auto headers = factory.headersToKj(params.getHeaders());
+    auto headers = factory.headersToKj(params.getHeaders(), HeaderInterning::from(interning));
     auto pipe = kj::newTwoWayPipe();
 
     class EofDetector final: public kj::AsyncOutputStream {
@@ -923,16 +1065,29 @@ public:
     context.initResults(capnp::MessageSize { 4, 1 }).setUp(kj::mv(up));
 
     auto response = kj::heap<HttpOverCapnpConnectResponseImpl>(
-        factory, context.getParams().getContext());
+        factory, context.getParams().getContext(), HeaderInterning::addRef(interning));
 
     return inner->connect(host, headers, *pipe.ends[0], *response, settings).attach(
-        kj::mv(host), kj::mv(headers), kj::mv(response), kj::mv(pipe))
+        kj::mv(host), kj::mv(headers), kj::mv(response), kj::mv(pipe),
+        HeaderInterning::addRef(interning))
         .exclusiveJoin(kj::mv(pumpTask));
   }
 
+  kj::Promise<void> internHeaders(InternHeadersContext context) override {
+    auto interning = kj::refcounted<HeaderInterning>(
+        factory.headerTable, context.getParams().getNames());
+    context.releaseParams();
+
+    // The session shares our inner service, keeping us alive for as long as it exists.
+    context.initResults(MessageSize {4, 1}).setService(kj::heap<CapnpToKjHttpServiceAdapter>(
+        factory, kj::attachRef(*inner, thisCap()), kj::mv(interning)));
+    return kj::READY_NOW;
+  }
+
 private:
   HttpOverCapnpFactory& factory;
   kj::Own<kj::HttpService> inner;
+  kj::Maybe<kj::Own<HeaderInterning>> interning;
 };
 
 capnp::HttpService::Client HttpOverCapnpFactory::kjToCapnp(kj::Own<kj::HttpService> service) {
@@ -1004,8 +1159,19 @@ HttpOverCapnpFactory::HttpOverCapnpFactory(ByteStreamFactory& streamFactory,
   }
 }
 
+HttpOverCapnpFactory::~HttpOverCapnpFactory() noexcept(false) {}
+
+HttpOverCapnpFactory::HeaderInterning& HttpOverCapnpFactory::getOwnInterning() {
+  KJ_IF_MAYBE(i, ownInterning) {
+    return **i;
+  } else {
+    KJ_REQUIRE(headerTable.isReady(), "HttpHeaderTable must be built before making requests");
+    return *ownInterning.emplace(kj::refcounted<HeaderInterning>(headerTable, nameKjToCapnp));
+  }
+}
+
 Orphan<List<capnp::HttpHeader>> HttpOverCapnpFactory::headersToCapnp(
-    const kj::HttpHeaders& headers, Orphanage orphanage) {
+    const kj::HttpHeaders& headers, Orphanage orphanage, kj::Maybe<HeaderInterning&> interning) {
   auto result = orphanage.newOrphan<List<capnp::HttpHeader>>(headers.size());
   auto rpcHeaders = result.get();
   uint i = 0;
@@ -1013,15 +1179,33 @@ Orphan<List<capnp::HttpHeader>> HttpOverCapnpFactory::headersToCapnp(
     auto capnpName = id.hashCode() < nameKjToCapnp.size()
         ? nameKjToCapnp[id.hashCode()]
         : capnp::CommonHeaderName::INVALID;
-    if (capnpName == capnp::CommonHeaderName::INVALID) {
-      auto header = rpcHeaders[i++].initUncommon();
-      header.setName(id.toString());
-      header.setValue(value);
-    } else {
+    if (capnpName != capnp::CommonHeaderName::INVALID) {
       auto header = rpcHeaders[i++].initCommon();
       header.setName(capnpName);
+      if (interning != nullptr) {
+        // Peers that understand interning also decode common values correctly. (Older peers
+        // checked the value's range against the wrong table, so we only send them text.)
+        KJ_IF_MAYBE(commonValue, valueKjToCapnp.find(value)) {
+          header.setCommonValue(*commonValue);
+          return;
+        }
+      }
       header.setValue(value);
+      return;
     }
+
+    KJ_IF_MAYBE(in, interning) {
+      KJ_IF_MAYBE(index, in->indexOf(id)) {
+        auto header = rpcHeaders[i++].initInterned();
+        header.setIndex(*index);
+        header.setValue(value);
+        return;
+      }
+    }
+
+    auto header = rpcHeaders[i++].initUncommon();
+    header.setName(id.toString());
+    header.setValue(value);
   }, [&](kj::StringPtr name, kj::StringPtr value) {
     auto header = rpcHeaders[i++].initUncommon();
     header.setName(name);
@@ -1032,9 +1216,20 @@ Orphan<List<capnp::HttpHeader>> HttpOverCapnpFactory::headersToCapnp(
 }
 
 kj::HttpHeaders HttpOverCapnpFactory::headersToKj(
-    List<capnp::HttpHeader>::Reader capnpHeaders) const {
+    List<capnp::HttpHeader>::Reader capnpHeaders, kj::Maybe<HeaderInterning&> interning) const {
   kj::HttpHeaders result(headerTable);
 
+  auto setIndexed = [&](kj::HttpHeaderId headerId, kj::StringPtr value) {
+    if (result.get(headerId) == nullptr) {
+      result.set(headerId, value);
+    } else {
+      // Unusual: This is a duplicate header, so fall back to add(), which may trigger
+      //   comma-concatenation, except in certain cases where comma-concatentaion would
+      //   be problematic.
+      result.add(headerId.toString(), value);
+    }
+  };
+
   for (auto header: capnpHeaders) {
     switch (header.which()) {
       case capnp::HttpHeader::COMMON: {
@@ -1045,21 +1240,13 @@ kj::HttpHeaders HttpOverCapnpFactory::headersToKj(
         switch (nv.which()) {
           case capnp::HttpHeader::Common::COMMON_VALUE: {
             auto cvInt = static_cast<uint>(nv.getCommonValue());
-            KJ_REQUIRE(nameInt < valueCapnpToKj.size(),
+            KJ_REQUIRE(cvInt > 0 && cvInt < valueCapnpToKj.size(),
                 "unknown common header value", nv.getCommonValue());
-            result.set(nameCapnpToKj[nameInt], valueCapnpToKj[cvInt]);
+            setIndexed(nameCapnpToKj[nameInt], valueCapnpToKj[cvInt]);
             break;
           }
           case capnp::HttpHeader::Common::VALUE: {
-            auto headerId = nameCapnpToKj[nameInt];
-            if (result.get(headerId) == nullptr) {
-              result.set(headerId, nv.getValue());
-            } else {
-              // Unusual: This is a duplicate header, so fall back to add(), which may trigger
-              //   comma-concatenation, except in certain cases where comma-concatentaion would
-              //   be problematic.
-              result.add(headerId.toString(), nv.getValue());
-            }
+            setIndexed(nameCapnpToKj[nameInt], nv.getValue());
             break;
           }
         }
@@ -1068,6 +1255,20 @@ kj::HttpHeaders HttpOverCapnpFactory::headersToKj(
       case capnp::HttpHeader::UNCOMMON: {
         auto nv = header.getUncommon();
         result.add(nv.getName(), nv.getValue());
+        break;
+      }
+      case capnp::HttpHeader::INTERNED: {
+        auto nv = header.getInterned();
+        auto& in = KJ_REQUIRE_NONNULL(interning,
+            "interned header received outside of an internHeaders() session");
+        auto& name = in.get(nv.getIndex());
+        KJ_IF_MAYBE(id, name.id) {
+          setIndexed(*id, nv.getValue());
+        } else {
+          // Not in our table; treat it like an uncommon header.
+          result.add(name.text, nv.getValue());
+        }
+        break;
       }
     }
   }
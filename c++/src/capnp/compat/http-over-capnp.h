@@ -60,13 +60,19 @@ public:
     LEVEL_1,
     // Use startRequest(), the original version of the protocol.
 
-    LEVEL_2
+    LEVEL_2,
     // Use request(). This is more efficient than startRequest() but won't work with old peers that
     // only implement startRequest().
+
+    LEVEL_3
+    // Like LEVEL_2, but also call internHeaders() once per capnpToKj() wrapper, so that header
+    // names registered in the HttpHeaderTable are sent as small integers instead of text. Won't
+    // work with peers that don't implement internHeaders().
   };
 
   HttpOverCapnpFactory(ByteStreamFactory& streamFactory, HeaderIdBundle headerIds,
                        OptimizationLevel peerOptimizationLevel = LEVEL_1);
+  ~HttpOverCapnpFactory() noexcept(false);
 
   kj::Own<kj::HttpService> capnpToKj(capnp::HttpService::Client rpcService);
   capnp::HttpService::Client kjToCapnp(kj::Own<kj::HttpService> service);
@@ -80,6 +86,11 @@ private:
   kj::Array<kj::StringPtr> valueCapnpToKj;
   kj::HashMap<kj::StringPtr, capnp::CommonHeaderValue> valueKjToCapnp;
 
+  class HeaderInterning;
+  kj::Maybe<kj::Own<HeaderInterning>> ownInterning;
+  // Interning of our own header table, as offered to peers via internHeaders(). Built on first use
+  // since the table may not be ready when the factory is constructed.
+
   class RequestState;
 
   class CapnpToKjWebSocketAdapter;
@@ -94,11 +105,15 @@ private:
   class ServerRequestContextImpl;
   class CapnpToKjHttpServiceAdapter;
 
-  kj::HttpHeaders headersToKj(capnp::List<capnp::HttpHeader>::Reader capnpHeaders) const;
-  // Returned headers may alias into `capnpHeaders`.
+  HeaderInterning& getOwnInterning();
+
+  kj::HttpHeaders headersToKj(capnp::List<capnp::HttpHeader>::Reader capnpHeaders,
+                              kj::Maybe<HeaderInterning&> interning = nullptr) const;
+  // Returned headers may alias into `capnpHeaders` and `interning`.
 
   capnp::Orphan<capnp::List<capnp::HttpHeader>> headersToCapnp(
-      const kj::HttpHeaders& headers, capnp::Orphanage orphanage);
+      const kj::HttpHeaders& headers, capnp::Orphanage orphanage,
+      kj::Maybe<HeaderInterning&> interning = nullptr);
 };
 
 }  // namespace capnp
@@ -20,7 +20,9 @@
 // THE SOFTWARE.
 
 #include "json-rpc.h"
+#include <kj/compat/http.h>
 #include <kj/test.h>
+#include <kj/time.h>
 #include <capnp/test-util.h>
 
 namespace capnp {
@@ -95,6 +97,117 @@ KJ_TEST("json-rpc multiple calls") {
   KJ_EXPECT(callCount == 2);
 }
 
+KJ_TEST("json-rpc batch") {
+  auto io = kj::setupAsyncIo();
+  auto pipe = kj::newTwoWayPipe();
+
+  JsonRpc::ContentLengthTransport clientTransport(*pipe.ends[0]);
+  JsonRpc::ContentLengthTransport serverTransport(*pipe.ends[1]);
+
+  int callCount = 0;
+
+  JsonRpc server(serverTransport, toDynamic(kj::heap<TestInterfaceImpl>(callCount)));
+
+  clientTransport.send(
+      "[{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"foo\",\"params\":{\"i\":123,\"j\":true}},"
+      " {\"jsonrpc\":\"2.0\",\"method\":\"foo\",\"params\":{\"i\":123,\"j\":true}},"
+      " {\"jsonrpc\":\"2.0\",\"id\":\"two\",\"method\":\"nope\",\"params\":{}},"
+      " 5]").wait(io.waitScope);
+
+  // One response for each element except the notification, in order.
+  KJ_EXPECT(clientTransport.receive().wait(io.waitScope) ==
+      "[{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":{\"x\":\"foo\"}},"
+      "{\"jsonrpc\":\"2.0\",\"id\":\"two\",\"error\":"
+          "{\"code\":-32601,\"message\":\"Method not found\"}},"
+      "{\"jsonrpc\":\"2.0\",\"id\":null,\"error\":{\"code\":-32600,\"message\":"
+          "\"Invalid Request\"}}]");
+  KJ_EXPECT(callCount == 2);
+
+  // A batch of only notifications gets no response, and an empty batch is an error.
+  clientTransport.send(
+      "[{\"jsonrpc\":\"2.0\",\"method\":\"foo\",\"params\":{\"i\":123,\"j\":true}}]")
+      .wait(io.waitScope);
+  clientTransport.send("[]").wait(io.waitScope);
+  KJ_EXPECT(clientTransport.receive().wait(io.waitScope) ==
+      "{\"jsonrpc\":\"2.0\",\"id\":null,\"error\":"
+          "{\"code\":-32600,\"message\":\"Invalid Request: empty batch\"}}");
+  KJ_EXPECT(callCount == 3);
+}
+
+class WebSocketTransport final: public JsonRpc::Transport {
+public:
+  explicit WebSocketTransport(kj::WebSocket& webSocket): webSocket(webSocket) {}
+
+  kj::Promise<void> send(kj::StringPtr text) override {
+    return webSocket.send(text);
+  }
+
+  kj::Promise<kj::String> receive() override {
+    return webSocket.receive().then([](kj::WebSocket::Message&& message) -> kj::String {
+      KJ_SWITCH_ONEOF(message) {
+        KJ_CASE_ONEOF(text, kj::String) {
+          return kj::mv(text);
+        }
+        KJ_CASE_ONEOF(data, kj::Array<byte>) {
+          return kj::heapString(data.asChars());
+        }
+        KJ_CASE_ONEOF(close, kj::WebSocket::Close) {
+          KJ_FAIL_REQUIRE("WebSocket closed", close.code, close.reason);
+        }
+      }
+      KJ_UNREACHABLE;
+    });
+  }
+
+private:
+  kj::WebSocket& webSocket;
+};
+
+KJ_TEST("json-rpc benchmark over WebSocket") {
+  auto io = kj::setupAsyncIo();
+  auto pipe = kj::newTwoWayPipe();
+  auto clientWebSocket = kj::newWebSocket(kj::mv(pipe.ends[0]), nullptr);
+  auto serverWebSocket = kj::newWebSocket(kj::mv(pipe.ends[1]), nullptr);
+
+  WebSocketTransport clientTransport(*clientWebSocket);
+  WebSocketTransport serverTransport(*serverWebSocket);
+
+  int callCount = 0;
+
+  JsonRpc client(clientTransport);
+  JsonRpc server(serverTransport, toDynamic(kj::heap<TestInterfaceImpl>(callCount)));
+
+  auto cap = client.getPeer<test::TestInterface>();
+
+  // Each iteration makes a burst of calls without waiting in between, as a chatty client would.
+  static constexpr uint CALLS_PER_ITERATION = 16;
+
+  auto& clock = kj::systemPreciseMonotonicClock();
+  auto start = clock.now();
+  uint64_t iterations = 0;
+
+  doBenchmark([&]() {
+    auto promises = kj::heapArrayBuilder<kj::Promise<void>>(CALLS_PER_ITERATION);
+    for (auto i KJ_UNUSED: kj::zeroTo(CALLS_PER_ITERATION)) {
+      auto req = cap.fooRequest();
+      req.setI(123);
+      req.setJ(true);
+      promises.add(req.send().then([](auto response) {
+        KJ_EXPECT(response.getX() == "foo");
+      }));
+    }
+    kj::joinPromises(promises.finish()).wait(io.waitScope);
+    ++iterations;
+  });
+
+  auto totalNs = (clock.now() - start) / kj::NANOSECONDS;
+  uint64_t calls = iterations * CALLS_PER_ITERATION;
+  auto callsPerSecond = totalNs == 0 ? 0 : calls * 1'000'000'000ull / totalNs;
+  KJ_LOG(WARNING, calls, callsPerSecond);
+
+  KJ_EXPECT(callCount == calls);
+}
+
 }  // namespace
 }  // namespace _ (private)
 }  // namespace capnp
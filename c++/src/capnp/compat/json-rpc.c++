@@ -21,13 +21,37 @@
 
 #include "json-rpc.h"
 #include <kj/compat/http.h>
-#include <capnp/compat/json-rpc.capnp.h>
 
 namespace capnp {
 
 static constexpr uint64_t JSON_NAME_ANNOTATION_ID = 0xfa5b1fd61c2e7c3dull;
 static constexpr uint64_t JSON_NOTIFICATION_ANNOTATION_ID = 0xa0a054dea32fd98cull;
 
+namespace {
+
+struct MethodInfo {
+  kj::StringPtr name;
+  bool isNotification = false;
+};
+
+MethodInfo getMethodInfo(InterfaceSchema::Method method) {
+  auto proto = method.getProto();
+  MethodInfo result { proto.getName() };
+  for (auto annotation: proto.getAnnotations()) {
+    switch (annotation.getId()) {
+      case JSON_NAME_ANNOTATION_ID:
+        result.name = annotation.getValue().getText();
+        break;
+      case JSON_NOTIFICATION_ANNOTATION_ID:
+        result.isNotification = true;
+        break;
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
 class JsonRpc::CapabilityImpl final: public DynamicCapability::Server {
 public:
   CapabilityImpl(JsonRpc& parent, InterfaceSchema schema)
@@ -35,19 +59,12 @@ public:
 
   kj::Promise<void> call(InterfaceSchema::Method method,
                          CallContext<DynamicStruct, DynamicStruct> context) override {
-    auto proto = method.getProto();
-    bool isNotification = false;
-    kj::StringPtr name = proto.getName();
-    for (auto annotation: proto.getAnnotations()) {
-      switch (annotation.getId()) {
-        case JSON_NAME_ANNOTATION_ID:
-          name = annotation.getValue().getText();
-          break;
-        case JSON_NOTIFICATION_ANNOTATION_ID:
-          isNotification = true;
-          break;
-      }
-    }
+    // Scanning annotations on every call adds up for chatty peers, so remember what we found.
+    auto& info = methodInfo.findOrCreate(method, [&]() -> decltype(methodInfo)::Entry {
+      return { method, getMethodInfo(method) };
+    });
+    kj::StringPtr name = info.name;
+    bool isNotification = info.isNotification;
 
     capnp::MallocMessageBuilder message;
     auto value = message.getRoot<json::Value>();
@@ -95,6 +112,7 @@ public:
 
 private:
   JsonRpc& parent;
+  kj::HashMap<InterfaceSchema::Method, MethodInfo> methodInfo;
 };
 
 JsonRpc::JsonRpc(Transport& transport, DynamicCapability::Client interface)
@@ -113,21 +131,12 @@ JsonRpc::JsonRpc(Transport& transport, DynamicCapability::Client interfaceParam,
   codec.handleByAnnotation<json::RpcMessage>();
 
   for (auto method: interface.getSchema().getMethods()) {
-    auto proto = method.getProto();
-    kj::StringPtr name = proto.getName();
-    for (auto annotation: proto.getAnnotations()) {
-      switch (annotation.getId()) {
-        case JSON_NAME_ANNOTATION_ID:
-          name = annotation.getValue().getText();
-          break;
-      }
-    }
-    methodMap.insert(name, method);
+    methodMap.insert(getMethodInfo(method).name, method);
   }
 }
 
 DynamicCapability::Client JsonRpc::getPeer(InterfaceSchema schema) {
-  codec.handleByAnnotation(interface.getSchema());
+  codec.handleByAnnotation(schema);
   return kj::heap<CapabilityImpl>(*this, schema);
 }
 
@@ -147,7 +156,8 @@ kj::Promise<void> JsonRpc::queueWrite(kj::String text) {
   return fork.addBranch();
 }
 
-void JsonRpc::queueError(kj::Maybe<json::Value::Reader> id, int code, kj::StringPtr message) {
+kj::String JsonRpc::encodeError(
+    kj::Maybe<json::Value::Reader> id, int code, kj::StringPtr message) {
   MallocMessageBuilder capnpMessage;
   auto jsonResponse = capnpMessage.getRoot<json::RpcMessage>();
   jsonResponse.setJsonrpc("2.0");
@@ -159,13 +169,27 @@ void JsonRpc::queueError(kj::Maybe<json::Value::Reader> id, int code, kj::String
   auto error = jsonResponse.initError();
   error.setCode(code);
   error.setMessage(message);
+  return codec.encode(jsonResponse);
+}
 
+void JsonRpc::queueError(kj::Maybe<json::Value::Reader> id, int code, kj::StringPtr message) {
   // OK to discard result of queueWrite() since it's just one branch of a fork.
-  queueWrite(codec.encode(jsonResponse));
+  queueWrite(encodeError(id, code, message));
 }
 
 kj::Promise<void> JsonRpc::readLoop() {
   return transport.receive().then([this](kj::String message) -> kj::Promise<void> {
+    kj::ArrayPtr<const char> trimmed = message;
+    while (trimmed.size() > 0 && (trimmed[0] == ' ' || trimmed[0] == '\t' ||
+                                  trimmed[0] == '\r' || trimmed[0] == '\n')) {
+      trimmed = trimmed.slice(1, trimmed.size());
+    }
+
+    if (trimmed.size() > 0 && trimmed[0] == '[') {
+      handleBatch(message);
+      return readLoop();
+    }
+
     MallocMessageBuilder capnpMessage;
     auto rpcMessageBuilder = capnpMessage.getRoot<json::RpcMessage>();
 
@@ -178,138 +202,211 @@ kj::Promise<void> JsonRpc::readLoop() {
 
     KJ_CONTEXT("decoding JSON-RPC message", message);
 
-    auto rpcMessage = rpcMessageBuilder.asReader();
+    tasks.add(handleMessage(rpcMessageBuilder.asReader())
+        .then([this](kj::Maybe<kj::String> response) -> kj::Promise<void> {
+      KJ_IF_MAYBE(r, response) {
+        return queueWrite(kj::mv(*r));
+      } else {
+        return kj::READY_NOW;
+      }
+    }));
 
-    if (!rpcMessage.hasJsonrpc()) {
-      queueError(nullptr, -32700, kj::str("Missing 'jsonrpc' field."));
-      return readLoop();
-    } else if (rpcMessage.getJsonrpc() != "2.0") {
-      queueError(nullptr, -32700,
-          kj::str("Unknown JSON-RPC version. This peer implements version '2.0'."));
-      return readLoop();
+    return readLoop();
+  });
+}
+
+void JsonRpc::handleBatch(kj::StringPtr message) {
+  // A JSON-RPC 2.0 batch: an array of messages, to be answered with an array of responses once
+  // all of them have completed. The calls themselves all run concurrently.
+
+  MallocMessageBuilder batchMessage;
+  auto batch = batchMessage.getRoot<JsonValue>();
+
+  KJ_IF_MAYBE(exception, kj::runCatchingExceptions([&]() {
+    codec.decodeRaw(message, batch);
+  })) {
+    queueError(nullptr, -32700, kj::str("Parse error: ", exception->getDescription()));
+    return;
+  }
+
+  KJ_CONTEXT("decoding JSON-RPC batch", message);
+
+  auto elements = batch.asReader().getArray();
+  if (elements.size() == 0) {
+    queueError(nullptr, -32600, "Invalid Request: empty batch");
+    return;
+  }
+
+  auto responses = kj::heapArrayBuilder<kj::Promise<kj::Maybe<kj::String>>>(elements.size());
+  for (auto element: elements) {
+    if (!element.isObject()) {
+      responses.add(kj::Maybe<kj::String>(encodeError(nullptr, -32600, "Invalid Request")));
+      continue;
     }
 
-    switch (rpcMessage.which()) {
-      case json::RpcMessage::NONE:
-        queueError(nullptr, -32700, kj::str("message has none of params, result, or error"));
-        break;
+    MallocMessageBuilder capnpMessage;
+    auto rpcMessageBuilder = capnpMessage.getRoot<json::RpcMessage>();
 
-      case json::RpcMessage::PARAMS: {
-        // a call
-        KJ_IF_MAYBE(method, methodMap.find(rpcMessage.getMethod())) {
-          auto req = interface.newRequest(*method);
-          KJ_IF_MAYBE(exception, kj::runCatchingExceptions([&]() {
-            codec.decode(rpcMessage.getParams(), req);
-          })) {
-            kj::Maybe<JsonValue::Reader> id;
-            if (rpcMessage.hasId()) id = rpcMessage.getId();
-            queueError(id, -32602,
-                kj::str("Type error in method params: ", exception->getDescription()));
-            break;
-          }
-
-          if (rpcMessage.hasId()) {
-            auto id = rpcMessage.getId();
-            auto idCopy = kj::heapArray<word>(id.totalSize().wordCount + 1);
-            memset(idCopy.begin(), 0, idCopy.asBytes().size());
-            copyToUnchecked(id, idCopy);
-            auto idPtr = readMessageUnchecked<json::Value>(idCopy.begin());
-
-            auto promise = req.send()
-                .then([this,idPtr](Response<DynamicStruct> response) mutable {
-              MallocMessageBuilder capnpMessage;
-              auto jsonResponse = capnpMessage.getRoot<json::RpcMessage>();
-              jsonResponse.setJsonrpc("2.0");
-              jsonResponse.setId(idPtr);
-              codec.encode(DynamicStruct::Reader(response), jsonResponse.initResult());
-              return queueWrite(codec.encode(jsonResponse));
-            }, [this,idPtr](kj::Exception&& e) {
-              MallocMessageBuilder capnpMessage;
-              auto jsonResponse = capnpMessage.getRoot<json::RpcMessage>();
-              jsonResponse.setJsonrpc("2.0");
-              jsonResponse.setId(idPtr);
-              auto error = jsonResponse.initError();
-              switch (e.getType()) {
-                case kj::Exception::Type::FAILED:
-                  error.setCode(-32000);
-                  break;
-                case kj::Exception::Type::DISCONNECTED:
-                  error.setCode(-32001);
-                  break;
-                case kj::Exception::Type::OVERLOADED:
-                  error.setCode(-32002);
-                  break;
-                case kj::Exception::Type::UNIMPLEMENTED:
-                  error.setCode(-32601);  // method not found
-                  break;
-              }
-              error.setMessage(e.getDescription());
-              return queueWrite(codec.encode(jsonResponse));
-            });
-            tasks.add(promise.attach(kj::mv(idCopy)));
-          } else {
-            // No 'id', so this is a notification.
-            tasks.add(req.send().ignoreResult().catch_([](kj::Exception&& exception) {
-              if (exception.getType() != kj::Exception::Type::UNIMPLEMENTED) {
-                KJ_LOG(ERROR, "JSON-RPC notification threw exception into the abyss", exception);
-              }
-            }));
-          }
-        } else {
-          if (rpcMessage.hasId()) {
-            queueError(rpcMessage.getId(), -32601, "Method not found");
-          } else {
-            // Ignore notification for unknown method.
-          }
-        }
-        break;
+    KJ_IF_MAYBE(exception, kj::runCatchingExceptions([&]() {
+      codec.decode(element, rpcMessageBuilder);
+    })) {
+      responses.add(kj::Maybe<kj::String>(encodeError(nullptr, -32600,
+          kj::str("Invalid Request: ", exception->getDescription()))));
+      continue;
+    }
+
+    responses.add(handleMessage(rpcMessageBuilder.asReader()));
+  }
+
+  tasks.add(kj::joinPromises(responses.finish())
+      .then([this](kj::Array<kj::Maybe<kj::String>> results) -> kj::Promise<void> {
+    kj::Vector<kj::String> texts(results.size());
+    for (auto& result: results) {
+      KJ_IF_MAYBE(text, result) {
+        texts.add(kj::mv(*text));
       }
+    }
+
+    if (texts.empty()) {
+      // A batch consisting only of notifications gets no response at all.
+      return kj::READY_NOW;
+    }
+
+    return queueWrite(kj::str('[', kj::strArray(texts, ","), ']'));
+  }));
+}
 
-      case json::RpcMessage::RESULT: {
-        auto id = rpcMessage.getId();
-        if (!id.isNumber()) {
-          // JSON-RPC doesn't define what to do if receiving a response with an invalid id.
-          KJ_LOG(ERROR, "JSON-RPC response has invalid ID");
-        } else KJ_IF_MAYBE(awaited, awaitedResponses.find((uint)id.getNumber())) {
-          KJ_IF_MAYBE(exception, kj::runCatchingExceptions([&]() {
-            codec.decode(rpcMessage.getResult(), awaited->context.getResults());
-            awaited->fulfiller->fulfill();
-          })) {
-            // Errors always propagate from callee to caller, so we don't want to throw this error
-            // back to the server.
-            awaited->fulfiller->reject(kj::mv(*exception));
-          }
+kj::Promise<kj::Maybe<kj::String>> JsonRpc::handleMessage(json::RpcMessage::Reader rpcMessage) {
+  // Dispatches a single message, returning the encoded response, if any.
+
+  if (!rpcMessage.hasJsonrpc()) {
+    return kj::Maybe<kj::String>(encodeError(nullptr, -32700, "Missing 'jsonrpc' field."));
+  } else if (rpcMessage.getJsonrpc() != "2.0") {
+    return kj::Maybe<kj::String>(encodeError(nullptr, -32700,
+        "Unknown JSON-RPC version. This peer implements version '2.0'."));
+  }
+
+  switch (rpcMessage.which()) {
+    case json::RpcMessage::NONE:
+      return kj::Maybe<kj::String>(encodeError(nullptr, -32700,
+          "message has none of params, result, or error"));
+
+    case json::RpcMessage::PARAMS: {
+      // a call
+      KJ_IF_MAYBE(method, methodMap.find(rpcMessage.getMethod())) {
+        auto req = interface.newRequest(*method);
+        KJ_IF_MAYBE(exception, kj::runCatchingExceptions([&]() {
+          codec.decode(rpcMessage.getParams(), req);
+        })) {
+          kj::Maybe<JsonValue::Reader> id;
+          if (rpcMessage.hasId()) id = rpcMessage.getId();
+          return kj::Maybe<kj::String>(encodeError(id, -32602,
+              kj::str("Type error in method params: ", exception->getDescription())));
+        }
+
+        if (rpcMessage.hasId()) {
+          auto id = rpcMessage.getId();
+          auto idCopy = kj::heapArray<word>(id.totalSize().wordCount + 1);
+          memset(idCopy.begin(), 0, idCopy.asBytes().size());
+          copyToUnchecked(id, idCopy);
+          auto idPtr = readMessageUnchecked<json::Value>(idCopy.begin());
+
+          auto promise = req.send()
+              .then([this,idPtr](Response<DynamicStruct> response) mutable
+                  -> kj::Maybe<kj::String> {
+            MallocMessageBuilder capnpMessage;
+            auto jsonResponse = capnpMessage.getRoot<json::RpcMessage>();
+            jsonResponse.setJsonrpc("2.0");
+            jsonResponse.setId(idPtr);
+            codec.encode(DynamicStruct::Reader(response), jsonResponse.initResult());
+            return codec.encode(jsonResponse);
+          }, [this,idPtr](kj::Exception&& e) -> kj::Maybe<kj::String> {
+            MallocMessageBuilder capnpMessage;
+            auto jsonResponse = capnpMessage.getRoot<json::RpcMessage>();
+            jsonResponse.setJsonrpc("2.0");
+            jsonResponse.setId(idPtr);
+            auto error = jsonResponse.initError();
+            switch (e.getType()) {
+              case kj::Exception::Type::FAILED:
+                error.setCode(-32000);
+                break;
+              case kj::Exception::Type::DISCONNECTED:
+                error.setCode(-32001);
+                break;
+              case kj::Exception::Type::OVERLOADED:
+                error.setCode(-32002);
+                break;
+              case kj::Exception::Type::UNIMPLEMENTED:
+                error.setCode(-32601);  // method not found
+                break;
+            }
+            error.setMessage(e.getDescription());
+            return codec.encode(jsonResponse);
+          });
+          return promise.attach(kj::mv(idCopy));
         } else {
-          // Probably, this is the response to a call that was canceled.
+          // No 'id', so this is a notification.
+          tasks.add(req.send().ignoreResult().catch_([](kj::Exception&& exception) {
+            if (exception.getType() != kj::Exception::Type::UNIMPLEMENTED) {
+              KJ_LOG(ERROR, "JSON-RPC notification threw exception into the abyss", exception);
+            }
+          }));
+        }
+      } else {
+        if (rpcMessage.hasId()) {
+          return kj::Maybe<kj::String>(
+              encodeError(rpcMessage.getId(), -32601, "Method not found"));
+        } else {
+          // Ignore notification for unknown method.
         }
-        break;
       }
+      break;
+    }
 
-      case json::RpcMessage::ERROR: {
-        auto id = rpcMessage.getId();
-        if (id.isNull()) {
-          // Error message will be logged by KJ_CONTEXT, above.
-          KJ_LOG(ERROR, "peer reports JSON-RPC protocol error");
-        } else if (!id.isNumber()) {
-          // JSON-RPC doesn't define what to do if receiving a response with an invalid id.
-          KJ_LOG(ERROR, "JSON-RPC response has invalid ID");
-        } else KJ_IF_MAYBE(awaited, awaitedResponses.find((uint)id.getNumber())) {
-          auto error = rpcMessage.getError();
-          auto code = error.getCode();
-          kj::Exception::Type type =
-              code == -32601 ? kj::Exception::Type::UNIMPLEMENTED
-                             : kj::Exception::Type::FAILED;
-          awaited->fulfiller->reject(kj::Exception(
-              type, __FILE__, __LINE__, kj::str(error.getMessage())));
-        } else {
-          // Probably, this is the response to a call that was canceled.
+    case json::RpcMessage::RESULT: {
+      auto id = rpcMessage.getId();
+      if (!id.isNumber()) {
+        // JSON-RPC doesn't define what to do if receiving a response with an invalid id.
+        KJ_LOG(ERROR, "JSON-RPC response has invalid ID");
+      } else KJ_IF_MAYBE(awaited, awaitedResponses.find((uint)id.getNumber())) {
+        KJ_IF_MAYBE(exception, kj::runCatchingExceptions([&]() {
+          codec.decode(rpcMessage.getResult(), awaited->context.getResults());
+          awaited->fulfiller->fulfill();
+        })) {
+          // Errors always propagate from callee to caller, so we don't want to throw this error
+          // back to the server.
+          awaited->fulfiller->reject(kj::mv(*exception));
         }
-        break;
+      } else {
+        // Probably, this is the response to a call that was canceled.
       }
+      break;
     }
 
-    return readLoop();
-  });
+    case json::RpcMessage::ERROR: {
+      auto id = rpcMessage.getId();
+      if (id.isNull()) {
+        // Error message will be logged by KJ_CONTEXT, above.
+        KJ_LOG(ERROR, "peer reports JSON-RPC protocol error");
+      } else if (!id.isNumber()) {
+        // JSON-RPC doesn't define what to do if receiving a response with an invalid id.
+        KJ_LOG(ERROR, "JSON-RPC response has invalid ID");
+      } else KJ_IF_MAYBE(awaited, awaitedResponses.find((uint)id.getNumber())) {
+        auto error = rpcMessage.getError();
+        auto code = error.getCode();
+        kj::Exception::Type type =
+            code == -32601 ? kj::Exception::Type::UNIMPLEMENTED
+                           : kj::Exception::Type::FAILED;
+        awaited->fulfiller->reject(kj::Exception(
+            type, __FILE__, __LINE__, kj::str(error.getMessage())));
+      } else {
+        // Probably, this is the response to a call that was canceled.
+      }
+      break;
+    }
+  }
+
+  return kj::Maybe<kj::String>(nullptr);
 }
 
 void JsonRpc::taskFailed(kj::Exception&& exception) {
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "json.h"
+#include <capnp/compat/json-rpc.capnp.h>
 #include <kj/async-io.h>
 #include <capnp/capability.h>
 #include <kj/map.h>
@@ -77,9 +78,12 @@ private:
   class CapabilityImpl;
 
   kj::Promise<void> queueWrite(kj::String text);
+  kj::String encodeError(kj::Maybe<json::Value::Reader> id, int code, kj::StringPtr message);
   void queueError(kj::Maybe<json::Value::Reader> id, int code, kj::StringPtr message);
 
   kj::Promise<void> readLoop();
+  void handleBatch(kj::StringPtr message);
+  kj::Promise<kj::Maybe<kj::String>> handleMessage(json::RpcMessage::Reader rpcMessage);
 
   void taskFailed(kj::Exception&& exception) override;
 
@@ -168,9 +168,10 @@ static const ::capnp::_::RawSchema* const d_a3fa7845f919dd83[] = {
 };
 static const uint16_t m_a3fa7845f919dd83[] = {4, 1, 6, 0, 2, 5, 7, 3};
 static const uint16_t i_a3fa7845f919dd83[] = {0, 1, 2, 3, 4, 5, 6, 7};
+static const uint16_t h_a3fa7845f919dd83[] = {20, 0, 10, 7, 3, 1, 6, 4, 5, 7, 0, 2};
 const ::capnp::_::RawSchema s_a3fa7845f919dd83 = {
   0xa3fa7845f919dd83, b_a3fa7845f919dd83.words, 152, d_a3fa7845f919dd83, m_a3fa7845f919dd83,
-  3, 8, i_a3fa7845f919dd83, nullptr, nullptr, { &s_a3fa7845f919dd83, nullptr, nullptr, 0, 0, nullptr }, false
+  3, 8, i_a3fa7845f919dd83, nullptr, nullptr, { &s_a3fa7845f919dd83, nullptr, nullptr, 0, 0, nullptr }, false, h_a3fa7845f919dd83
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<49> b_e31026e735d69ddf = {
@@ -231,9 +232,10 @@ static const ::capnp::_::RawSchema* const d_e31026e735d69ddf[] = {
 };
 static const uint16_t m_e31026e735d69ddf[] = {0, 1};
 static const uint16_t i_e31026e735d69ddf[] = {0, 1};
+static const uint16_t h_e31026e735d69ddf[] = {1, 0, 1};
 const ::capnp::_::RawSchema s_e31026e735d69ddf = {
   0xe31026e735d69ddf, b_e31026e735d69ddf.words, 49, d_e31026e735d69ddf, m_e31026e735d69ddf,
-  1, 2, i_e31026e735d69ddf, nullptr, nullptr, { &s_e31026e735d69ddf, nullptr, nullptr, 0, 0, nullptr }, false
+  1, 2, i_e31026e735d69ddf, nullptr, nullptr, { &s_e31026e735d69ddf, nullptr, nullptr, 0, 0, nullptr }, false, h_e31026e735d69ddf
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<54> b_a0d9f6eca1c93d48 = {
@@ -299,9 +301,10 @@ static const ::capnp::_::RawSchema* const d_a0d9f6eca1c93d48[] = {
 };
 static const uint16_t m_a0d9f6eca1c93d48[] = {0, 1};
 static const uint16_t i_a0d9f6eca1c93d48[] = {0, 1};
+static const uint16_t h_a0d9f6eca1c93d48[] = {0, 0, 1};
 const ::capnp::_::RawSchema s_a0d9f6eca1c93d48 = {
   0xa0d9f6eca1c93d48, b_a0d9f6eca1c93d48.words, 54, d_a0d9f6eca1c93d48, m_a0d9f6eca1c93d48,
-  1, 2, i_a0d9f6eca1c93d48, nullptr, nullptr, { &s_a0d9f6eca1c93d48, nullptr, nullptr, 0, 0, nullptr }, false
+  1, 2, i_a0d9f6eca1c93d48, nullptr, nullptr, { &s_a0d9f6eca1c93d48, nullptr, nullptr, 0, 0, nullptr }, false, h_a0d9f6eca1c93d48
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<21> b_fa5b1fd61c2e7c3d = {
@@ -331,7 +334,7 @@ static const ::capnp::_::AlignedData<21> b_fa5b1fd61c2e7c3d = {
 #if !CAPNP_LITE
 const ::capnp::_::RawSchema s_fa5b1fd61c2e7c3d = {
   0xfa5b1fd61c2e7c3d, b_fa5b1fd61c2e7c3d.words, 21, nullptr, nullptr,
-  0, 0, nullptr, nullptr, nullptr, { &s_fa5b1fd61c2e7c3d, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 0, nullptr, nullptr, nullptr, { &s_fa5b1fd61c2e7c3d, nullptr, nullptr, 0, 0, nullptr }, false, nullptr
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<21> b_82d3e852af0336bf = {
@@ -361,7 +364,7 @@ static const ::capnp::_::AlignedData<21> b_82d3e852af0336bf = {
 #if !CAPNP_LITE
 const ::capnp::_::RawSchema s_82d3e852af0336bf = {
   0x82d3e852af0336bf, b_82d3e852af0336bf.words, 21, nullptr, nullptr,
-  0, 0, nullptr, nullptr, nullptr, { &s_82d3e852af0336bf, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 0, nullptr, nullptr, nullptr, { &s_82d3e852af0336bf, nullptr, nullptr, 0, 0, nullptr }, false, nullptr
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<35> b_c4df13257bc2ea61 = {
@@ -405,9 +408,10 @@ static const ::capnp::_::AlignedData<35> b_c4df13257bc2ea61 = {
 #if !CAPNP_LITE
 static const uint16_t m_c4df13257bc2ea61[] = {0};
 static const uint16_t i_c4df13257bc2ea61[] = {0};
+static const uint16_t h_c4df13257bc2ea61[] = {0, 0};
 const ::capnp::_::RawSchema s_c4df13257bc2ea61 = {
   0xc4df13257bc2ea61, b_c4df13257bc2ea61.words, 35, nullptr, m_c4df13257bc2ea61,
-  0, 1, i_c4df13257bc2ea61, nullptr, nullptr, { &s_c4df13257bc2ea61, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 1, i_c4df13257bc2ea61, nullptr, nullptr, { &s_c4df13257bc2ea61, nullptr, nullptr, 0, 0, nullptr }, false, h_c4df13257bc2ea61
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<22> b_cfa794e8d19a0162 = {
@@ -438,7 +442,7 @@ static const ::capnp::_::AlignedData<22> b_cfa794e8d19a0162 = {
 #if !CAPNP_LITE
 const ::capnp::_::RawSchema s_cfa794e8d19a0162 = {
   0xcfa794e8d19a0162, b_cfa794e8d19a0162.words, 22, nullptr, nullptr,
-  0, 0, nullptr, nullptr, nullptr, { &s_cfa794e8d19a0162, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 0, nullptr, nullptr, nullptr, { &s_cfa794e8d19a0162, nullptr, nullptr, 0, 0, nullptr }, false, nullptr
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<51> b_c2f8c20c293e5319 = {
@@ -498,9 +502,10 @@ static const ::capnp::_::AlignedData<51> b_c2f8c20c293e5319 = {
 #if !CAPNP_LITE
 static const uint16_t m_c2f8c20c293e5319[] = {0, 1};
 static const uint16_t i_c2f8c20c293e5319[] = {0, 1};
+static const uint16_t h_c2f8c20c293e5319[] = {0, 0, 1};
 const ::capnp::_::RawSchema s_c2f8c20c293e5319 = {
   0xc2f8c20c293e5319, b_c2f8c20c293e5319.words, 51, nullptr, m_c2f8c20c293e5319,
-  0, 2, i_c2f8c20c293e5319, nullptr, nullptr, { &s_c2f8c20c293e5319, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 2, i_c2f8c20c293e5319, nullptr, nullptr, { &s_c2f8c20c293e5319, nullptr, nullptr, 0, 0, nullptr }, false, h_c2f8c20c293e5319
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<21> b_d7d879450a253e4b = {
@@ -530,7 +535,7 @@ static const ::capnp::_::AlignedData<21> b_d7d879450a253e4b = {
 #if !CAPNP_LITE
 const ::capnp::_::RawSchema s_d7d879450a253e4b = {
   0xd7d879450a253e4b, b_d7d879450a253e4b.words, 21, nullptr, nullptr,
-  0, 0, nullptr, nullptr, nullptr, { &s_d7d879450a253e4b, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 0, nullptr, nullptr, nullptr, { &s_d7d879450a253e4b, nullptr, nullptr, 0, 0, nullptr }, false, nullptr
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<21> b_f061e22f0ae5c7b5 = {
@@ -560,7 +565,7 @@ static const ::capnp::_::AlignedData<21> b_f061e22f0ae5c7b5 = {
 #if !CAPNP_LITE
 const ::capnp::_::RawSchema s_f061e22f0ae5c7b5 = {
   0xf061e22f0ae5c7b5, b_f061e22f0ae5c7b5.words, 21, nullptr, nullptr,
-  0, 0, nullptr, nullptr, nullptr, { &s_f061e22f0ae5c7b5, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 0, nullptr, nullptr, nullptr, { &s_f061e22f0ae5c7b5, nullptr, nullptr, 0, 0, nullptr }, false, nullptr
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<22> b_a0a054dea32fd98c = {
@@ -591,7 +596,7 @@ static const ::capnp::_::AlignedData<22> b_a0a054dea32fd98c = {
 #if !CAPNP_LITE
 const ::capnp::_::RawSchema s_a0a054dea32fd98c = {
   0xa0a054dea32fd98c, b_a0a054dea32fd98c.words, 22, nullptr, nullptr,
-  0, 0, nullptr, nullptr, nullptr, { &s_a0a054dea32fd98c, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 0, nullptr, nullptr, nullptr, { &s_a0a054dea32fd98c, nullptr, nullptr, 0, 0, nullptr }, false, nullptr
 };
 #endif  // !CAPNP_LITE
 }  // namespace schemas
@@ -127,3 +127,26 @@ $CAPNP compile --no-standard-import --src-prefix="$PREFIX" -ofoo $TESTDATA/error
 
 $CAPNP compile --no-standard-import --src-prefix="$PREFIX" -ofoo $TESTDATA/errors2.capnp.nobuild 2>&1 | sed -e "s,^.*errors2[.]capnp[.]nobuild:,file:,g" | tr -d '\r' |
     diff -u $TESTDATA/errors2.txt - || fail error2 output
+
+# Parsing in parallel must not change errors or output.
+$CAPNP compile -j2 --no-standard-import --src-prefix="$PREFIX" -ofoo $TESTDATA/errors.capnp.nobuild $TESTDATA/errors.capnp.nobuild 2>&1 | sed -e "s,^.*errors[.]capnp[.]nobuild:,file:,g" | tr -d '\r' |
+    diff -u $TESTDATA/errors.txt - || fail error output with -j2
+# A file's missing ID is only reported if no other errors came first, even if it was parsed early.
+NO_ID_AFTER_ERRORS="$TESTDATA/errors.capnp.nobuild $TESTDATA/no-file-id.capnp.nobuild"
+$CAPNP compile --no-standard-import --src-prefix="$PREFIX" -ofoo $NO_ID_AFTER_ERRORS > capnp-test-j1.tmp 2>&1 || true
+$CAPNP compile -j2 --no-standard-import --src-prefix="$PREFIX" -ofoo $NO_ID_AFTER_ERRORS > capnp-test-j2.tmp 2>&1 || true
+cmp capnp-test-j1.tmp capnp-test-j2.tmp || fail errors after earlier errors differ with -j2
+JOBS_SCHEMAS="$SRCDIR/capnp/schema.capnp $SRCDIR/capnp/rpc.capnp $SRCDIR/capnp/persistent.capnp $SRCDIR/capnp/compat/json.capnp"
+$CAPNP compile --no-standard-import -I"$SRCDIR" -o- $JOBS_SCHEMAS > capnp-test-j1.tmp
+$CAPNP compile -j4 --no-standard-import -I"$SRCDIR" -o- $JOBS_SCHEMAS > capnp-test-j4.tmp
+cmp capnp-test-j1.tmp capnp-test-j4.tmp || fail compile -j4 output differs from -j1
+
+# So must reading parsed files back from the cache.
+rm -rf capnp-test-cache.tmp
+$CAPNP compile --cache-dir=capnp-test-cache.tmp --no-standard-import -I"$SRCDIR" -o- $JOBS_SCHEMAS > capnp-test-j4.tmp
+cmp capnp-test-j1.tmp capnp-test-j4.tmp || fail compile output differs when filling cache
+$CAPNP compile --cache-dir=capnp-test-cache.tmp --no-standard-import -I"$SRCDIR" -o- $JOBS_SCHEMAS > capnp-test-j4.tmp
+cmp capnp-test-j1.tmp capnp-test-j4.tmp || fail compile output differs when reading cache
+$CAPNP compile --cache-dir=capnp-test-cache.tmp --no-standard-import --src-prefix="$PREFIX" -ofoo $TESTDATA/errors.capnp.nobuild 2>&1 | sed -e "s,^.*errors[.]capnp[.]nobuild:,file:,g" | tr -d '\r' |
+    diff -u $TESTDATA/errors.txt - || fail error output with cache
+rm -rf capnp-test-j1.tmp capnp-test-j2.tmp capnp-test-j4.tmp capnp-test-cache.tmp
@@ -306,6 +306,10 @@ public:
   }
 
   void addCompileOptions(kj::MainBuilder& builder) {
+    // Sources are only compiled once all arguments have been seen, so that -j applies to all of
+    // them regardless of where it appears.
+    deferSources = true;
+
     builder.addOptionWithArg({'o', "output"}, KJ_BIND_METHOD(*this, addOutput), "<lang>[:<dir>]",
                              "Generate source code for language <lang> in directory <dir> "
                              "(default: current directory).  <lang> actually specifies a plugin "
@@ -320,6 +324,15 @@ public:
                              "For example, the following command:\n"
                              "    capnp compile --src-prefix=foo/bar -oc++:corge foo/bar/baz/qux.capnp\n"
                              "would generate the files corge/baz/qux.capnp.{h,c++}.")
+           .addOptionWithArg({'j', "jobs"}, KJ_BIND_METHOD(*this, setJobs), "<n>",
+                             "Parse up to <n> of the listed source files at once.  Files are "
+                             "still cross-linked and translated one at a time, so output is the "
+                             "same as with -j1 (the default).")
+           .addOptionWithArg({"cache-dir"}, KJ_BIND_METHOD(*this, setCacheDir), "<dir>",
+                             "Cache parsed source files in <dir>, creating it if needed, so that "
+                             "files which have not changed since a previous run with the same "
+                             "<dir> are not parsed again.  Entries are keyed by file content and "
+                             "compiler version, so one <dir> may be shared between projects.")
            .expectOneOrMoreArgs("<source>", KJ_BIND_METHOD(*this, addSource))
            .callAfterParsing(KJ_BIND_METHOD(*this, generateOutput));
   }
@@ -368,9 +381,11 @@ public:
 
     auto dirPathPair = interpretSourceFile(file);
     KJ_IF_MAYBE(module, loader.loadModule(dirPathPair.dir, dirPathPair.path)) {
-      auto compiled = compiler->add(*module);
-      compiler->eagerlyCompile(compiled.getId(), compileEagerness);
-      sourceFiles.add(SourceFile { compiled.getId(), compiled, module->getSourceName(), &*module });
+      if (deferSources) {
+        pendingSources.add(&*module);
+      } else {
+        compileSource(*module);
+      }
     } else {
       return "no such file";
     }
@@ -378,6 +393,22 @@ public:
     return true;
   }
 
+  void compileSource(Module& module) {
+    auto compiled = compiler->add(module);
+    compiler->eagerlyCompile(compiled.getId(), compileEagerness);
+    sourceFiles.add(SourceFile { compiled.getId(), compiled, module.getSourceName(), &module });
+  }
+
+  void compilePendingSources() {
+    if (jobs > 1) {
+      loader.preload(pendingSources, jobs);
+    }
+    for (auto module: pendingSources) {
+      compileSource(*module);
+    }
+    pendingSources.clear();
+  }
+
 public:
   // =====================================================================================
   // "id" command
@@ -465,7 +496,30 @@ public:
     }
   }
 
+  kj::MainBuilder::Validity setCacheDir(kj::StringPtr dir) {
+    KJ_IF_MAYBE(exception, kj::runCatchingExceptions([&]() {
+      loader.setCacheDirectory(disk->getRoot().openSubdir(
+          disk->getCurrentPath().evalNative(dir),
+          kj::WriteMode::CREATE | kj::WriteMode::MODIFY | kj::WriteMode::CREATE_PARENT));
+    })) {
+      return "could not open or create directory";
+    }
+    return true;
+  }
+
+  kj::MainBuilder::Validity setJobs(kj::StringPtr count) {
+    char* end;
+    long n = strtol(count.cStr(), &end, 10);
+    if (count.size() == 0 || *end != '\0' || n < 1 || n > 1024) {
+      return "expected a number of jobs between 1 and 1024";
+    }
+    jobs = n;
+    return true;
+  }
+
   kj::MainBuilder::Validity generateOutput() {
+    compilePendingSources();
+
     if (hadErrors()) {
       // Skip output if we had any errors.
       return true;
@@ -1890,6 +1944,12 @@ private:
 
   kj::Vector<SourceFile> sourceFiles;
 
+  bool deferSources = false;
+  kj::Vector<Module*> pendingSources;
+  uint jobs = 1;
+  // For the "compile" command: sources named on the command line, in order, which have been
+  // located but not yet compiled, and how many of them may be parsed in parallel.
+
   struct OutputDirective {
     kj::ArrayPtr<const char> name;
     kj::Maybe<kj::Path> dir;
@@ -138,6 +138,12 @@ kj::Array<uint> makeMembersByName(MemberList&& members) {
   return KJ_MAP(member, sorted) { return member.getIndex(); };
 }
 
+template <typename MemberList>
+kj::Array<uint16_t> makeMembersByHash(MemberList&& members) {
+  auto names = KJ_MAP(member, members) -> kj::StringPtr { return member.getProto().getName(); };
+  return _::makeMemberHashTable(names);
+}
+
 kj::StringPtr baseName(kj::StringPtr path) {
   KJ_IF_MAYBE(slashPos, path.findLast('/')) {
     return path.slice(*slashPos + 1);
@@ -2767,11 +2773,13 @@ private:
     enumerateDeps(proto, deps);
 
     kj::Array<uint> membersByName;
+    kj::Array<uint16_t> membersByHash;
     kj::Array<uint> membersByDiscrim;
     switch (proto.which()) {
       case schema::Node::STRUCT: {
         auto structSchema = schema.asStruct();
         membersByName = makeMembersByName(structSchema.getFields());
+        membersByHash = makeMembersByHash(structSchema.getFields());
         auto builder = kj::heapArrayBuilder<uint>(structSchema.getFields().size());
         for (auto field: structSchema.getUnionFields()) {
           builder.add(field.getIndex());
@@ -2784,9 +2792,11 @@ private:
       }
       case schema::Node::ENUM:
         membersByName = makeMembersByName(schema.asEnum().getEnumerants());
+        membersByHash = makeMembersByHash(schema.asEnum().getEnumerants());
         break;
       case schema::Node::INTERFACE:
         membersByName = makeMembersByName(schema.asInterface().getMethods());
+        membersByHash = makeMembersByHash(schema.asInterface().getMethods());
         break;
       default:
         break;
@@ -2817,6 +2827,10 @@ private:
             "static const uint16_t i_", hexId, "[] = {",
             kj::StringTree(KJ_MAP(index, membersByDiscrim) { return kj::strTree(index); }, ", "),
             "};\n"),
+        membersByHash.size() == 0 ? kj::strTree() : kj::strTree(
+            "static const uint16_t h_", hexId, "[] = {",
+            kj::StringTree(KJ_MAP(index, membersByHash) { return kj::strTree(index); }, ", "),
+            "};\n"),
         brandDeps.size() == 0 ? kj::strTree() : kj::strTree(
             "KJ_CONSTEXPR(const) ::capnp::_::RawBrandedSchema::Dependency bd_", hexId, "[] = ",
             kj::mv(brandDeps), ";\n"),
@@ -2829,7 +2843,8 @@ private:
         ", nullptr, nullptr, { &s_", hexId, ", nullptr, ",
         brandDeps.size() == 0 ? kj::strTree("nullptr, 0, 0") : kj::strTree(
             "bd_", hexId, ", 0, " "sizeof(bd_", hexId, ") / sizeof(bd_", hexId, "[0])"),
-        ", nullptr }, ", mayContainCapabilities, "\n"
+        ", nullptr }, ", mayContainCapabilities, ", ",
+        membersByHash.size() == 0 ? kj::strTree("nullptr") : kj::strTree("h_", hexId), "\n"
         "};\n"
         "#endif  // !CAPNP_LITE\n");
 
@@ -22,12 +22,17 @@
 #include "module-loader.h"
 #include "lexer.h"
 #include "parser.h"
+#include "type-id.h"
 #include <kj/vector.h>
+#include <kj/map.h>
 #include <kj/mutex.h>
 #include <kj/debug.h>
 #include <kj/io.h>
+#include <kj/thread.h>
 #include <capnp/message.h>
+#include <capnp/serialize-packed.h>
 #include <unordered_map>
+#include <atomic>
 
 namespace capnp {
 namespace compiler {
@@ -140,11 +145,21 @@ public:
   void setFileIdsRequired(bool value) { fileIdsRequired = value; }
   bool areFileIdsRequired() { return fileIdsRequired; }
 
+  void setCacheDirectory(kj::Own<const kj::Directory> dir) { cacheDir = kj::mv(dir); }
+  bool hasCache() { return cacheDir != nullptr; }
+
+  bool readCache(kj::StringPtr key, MessageBuilder& into);
+  void writeCache(kj::StringPtr key, MessageBuilder& message);
+  // Thread-safe. Failures are not errors; they only mean that the file will be parsed again.
+
+  void preload(kj::ArrayPtr<Module* const> modules, uint threadCount);
+
 private:
   GlobalErrorReporter& errorReporter;
   kj::Vector<const kj::ReadableDirectory*> searchPath;
   std::unordered_map<FileKey, kj::Own<Module>, FileKeyHash> modules;
   bool fileIdsRequired = true;
+  kj::Maybe<kj::Own<const kj::Directory>> cacheDir;
 };
 
 class ModuleLoader::ModuleImpl final: public Module {
@@ -164,12 +179,39 @@ public:
     return sourceNameStr;
   }
 
+  void preload(bool hadErrorsBefore) {
+    // Called by ModuleLoader::preload(), possibly on another thread. Must not touch anything
+    // shared except the file and the cache.
+
+    kj::Array<const char> content = file->mmap(0, file->stat().size).releaseAsChars();
+    preloaded = parse(content, hadErrorsBefore);
+  }
+
   Orphan<ParsedFile> loadContent(Orphanage orphanage) override {
     kj::Array<const char> content = file->mmap(0, file->stat().size).releaseAsChars();
 
     lineBreaks = nullptr;  // In case loadContent() is called multiple times.
     lineBreaks = lineBreaksSpace.construct(content);
 
+    if (preloaded == nullptr && loader.hasCache()) {
+      preloaded = parse(content, loader.getErrorReporter().hadErrors());
+    }
+
+    KJ_IF_MAYBE(p, preloaded) {
+      auto ownPreloaded = kj::mv(*p);
+      preloaded = nullptr;
+
+      // The parser stays quiet about some problems, like a missing file ID, when there are errors
+      // already. If it relied on there being none, but other files have reported errors since
+      // preloading started, parse again below so that we report what a serial run would.
+      if (!ownPreloaded->errors.assumedNoErrors || !loader.getErrorReporter().hadErrors()) {
+        for (auto& error: ownPreloaded->errors.errors) {
+          addError(error.startByte, error.endByte, error.message);
+        }
+        return orphanage.newOrphanCopy(ownPreloaded->message.getRoot<ParsedFile>().asReader());
+      }
+    }
+
     MallocMessageBuilder lexedBuilder;
     auto statements = lexedBuilder.initRoot<LexedStatements>();
     lex(content, statements, *this);
@@ -216,6 +258,75 @@ private:
 
   kj::SpaceFor<LineBreakTable> lineBreaksSpace;
   kj::Maybe<kj::Own<LineBreakTable>> lineBreaks;
+
+  class ErrorBuffer final: public ErrorReporter {
+    // Holds errors found while preloading until loadContent() can report them.
+
+  public:
+    explicit ErrorBuffer(bool hadErrorsBefore): hadErrorsBefore(hadErrorsBefore) {}
+
+    struct Error {
+      uint32_t startByte;
+      uint32_t endByte;
+      kj::String message;
+    };
+    kj::Vector<Error> errors;
+
+    bool assumedNoErrors = false;
+    // Whether hadErrors() ever returned false, i.e. the parse depended on nothing having gone
+    // wrong yet, which may no longer be true by the time the errors are reported.
+
+    void addError(uint32_t startByte, uint32_t endByte, kj::StringPtr message) override {
+      errors.add(Error { startByte, endByte, kj::heapString(message) });
+    }
+
+    bool hadErrors() override {
+      bool result = hadErrorsBefore || errors.size() > 0;
+      if (!result) assumedNoErrors = true;
+      return result;
+    }
+
+  private:
+    bool hadErrorsBefore;
+  };
+
+  struct Preloaded {
+    MallocMessageBuilder message;
+    ErrorBuffer errors;
+
+    explicit Preloaded(bool hadErrorsBefore): errors(hadErrorsBefore) {}
+  };
+  kj::Maybe<kj::Own<Preloaded>> preloaded;
+
+  kj::Own<Preloaded> parse(kj::ArrayPtr<const char> content, bool hadErrorsBefore) {
+    auto result = kj::heap<Preloaded>(hadErrorsBefore);
+
+    kj::String cacheKey;
+    if (loader.hasCache()) {
+      cacheKey = hashContent(
+          kj::str("capnp ", CAPNP_VERSION, loader.areFileIdsRequired() ? " ids" : " no-ids"),
+          content.asBytes());
+      if (loader.readCache(cacheKey, result->message)) {
+        return result;
+      }
+    }
+
+    MallocMessageBuilder lexedBuilder;
+    auto statements = lexedBuilder.initRoot<LexedStatements>();
+    lex(content, statements, result->errors);
+
+    parseFile(statements.getStatements(), result->message.initRoot<ParsedFile>(),
+              result->errors, loader.areFileIdsRequired());
+
+    // Don't cache after errors, not even earlier ones: the parser stays quiet about some
+    // problems, like a missing file ID, when there are errors already.
+    if (cacheKey != nullptr && !result->errors.hadErrors()) {
+      loader.writeCache(cacheKey, result->message);
+    }
+    return result;
+  }
+
+  friend class ModuleLoader::Impl;
 };
 
 // =======================================================================================
@@ -272,6 +383,76 @@ kj::Maybe<kj::Array<const byte>> ModuleLoader::Impl::readEmbedFromSearchPath(kj:
   return nullptr;
 }
 
+bool ModuleLoader::Impl::readCache(kj::StringPtr key, MessageBuilder& into) {
+  KJ_IF_MAYBE(dir, cacheDir) {
+    KJ_IF_MAYBE(file, (*dir)->tryOpenFile(kj::Path(kj::str(key, ".parsed")))) {
+      KJ_IF_MAYBE(exception, kj::runCatchingExceptions([&]() {
+        auto bytes = (*file)->mmap(0, (*file)->stat().size);
+        kj::ArrayInputStream input(bytes);
+        PackedMessageReader reader(input);
+        into.setRoot(reader.getRoot<ParsedFile>());
+      })) {
+        // Corrupt or truncated (e.g. by a concurrent writer on a filesystem without atomic
+        // rename). Fall back to parsing, which will overwrite the entry.
+        return false;
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+void ModuleLoader::Impl::writeCache(kj::StringPtr key, MessageBuilder& message) {
+  KJ_IF_MAYBE(dir, cacheDir) {
+    KJ_IF_MAYBE(exception, kj::runCatchingExceptions([&]() {
+      kj::VectorOutputStream output;
+      writePackedMessage(output, message);
+      auto replacer = (*dir)->replaceFile(kj::Path(kj::str(key, ".parsed")),
+                                          kj::WriteMode::CREATE | kj::WriteMode::MODIFY);
+      replacer->get().writeAll(output.getArray());
+      replacer->commit();
+    })) {
+      // Read-only or full cache directory; just don't cache.
+    }
+  }
+}
+
+void ModuleLoader::Impl::preload(kj::ArrayPtr<Module* const> modules, uint threadCount) {
+  // Skip duplicates, and modules which were already preloaded, so that no module is parsed by
+  // two threads at once.
+  kj::Vector<ModuleImpl*> todo(modules.size());
+  kj::HashSet<ModuleImpl*> seen;
+  for (auto module: modules) {
+    auto impl = static_cast<ModuleImpl*>(module);
+    if (impl->preloaded == nullptr && seen.find(impl) == nullptr) {
+      seen.insert(impl);
+      todo.add(impl);
+    }
+  }
+
+  bool hadErrorsBefore = errorReporter.hadErrors();
+  std::atomic<size_t> next(0);
+  auto work = [&]() {
+    for (;;) {
+      size_t i = next.fetch_add(1, std::memory_order_relaxed);
+      if (i >= todo.size()) return;
+      KJ_IF_MAYBE(exception, kj::runCatchingExceptions([&]() {
+        todo[i]->preload(hadErrorsBefore);
+      })) {
+        // loadContent() will parse the module again, and throw again, on the calling thread.
+      }
+    }
+  };
+
+  {
+    kj::Vector<kj::Own<kj::Thread>> threads;
+    for (uint i = 1; i < kj::min(threadCount, todo.size()); i++) {
+      threads.add(kj::heap<kj::Thread>(work));
+    }
+    work();
+  }
+}
+
 // =======================================================================================
 
 ModuleLoader::ModuleLoader(GlobalErrorReporter& errorReporter)
@@ -290,5 +471,13 @@ void ModuleLoader::setFileIdsRequired(bool value) {
   return impl->setFileIdsRequired(value);
 }
 
+void ModuleLoader::setCacheDirectory(kj::Own<const kj::Directory> dir) {
+  impl->setCacheDirectory(kj::mv(dir));
+}
+
+void ModuleLoader::preload(kj::ArrayPtr<Module* const> modules, uint threadCount) {
+  impl->preload(modules, threadCount);
+}
+
 }  // namespace compiler
 }  // namespace capnp
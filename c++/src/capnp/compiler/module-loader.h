@@ -53,6 +53,19 @@ public:
   // Same as SchemaParser::setFileIdsRequired(). If set false, files will not be required to have
   // a top-level file ID; if missing a random one will be assigned.
 
+  void setCacheDirectory(kj::Own<const kj::Directory> dir);
+  // Keep a cache of parsed files in `dir`. Each entry is named for a hash of the file's content
+  // and the compiler version, so unchanged files are not lexed or parsed again by a later run,
+  // whatever their path. Only files which parsed without errors are cached. Entries are never
+  // deleted; it is safe to remove any of them at any time, including concurrently with a run.
+
+  void preload(kj::ArrayPtr<Module* const> modules, uint threadCount);
+  // Lexes and parses the given modules, which must have been returned by this loader, using up to
+  // `threadCount` threads. Each module's next loadContent() then only copies the result. Parse
+  // errors are held until that call, so they are reported on the calling thread in the same order
+  // as without preloading. Parsing is the only part of compilation that is independent per file;
+  // cross-linking and translation still happen in the Compiler, one module at a time.
+
 private:
   class Impl;
   kj::Own<Impl> impl;
@@ -21,6 +21,7 @@
 
 #include "type-id.h"
 #include <kj/debug.h>
+#include <kj/encoding.h>
 #include <string.h>
 
 namespace capnp {
@@ -136,6 +137,13 @@ uint64_t generateMethodParamsId(uint64_t parentId, uint16_t methodOrdinal, bool
   return result | (1ull << 63);
 }
 
+kj::String hashContent(kj::StringPtr salt, kj::ArrayPtr<const kj::byte> content) {
+  TypeIdGenerator generator;
+  generator.update(salt);
+  generator.update(content);
+  return kj::encodeHex(generator.finish());
+}
+
 // The remainder of this file was derived from code placed in the public domain.
 // The original code bore the following notice:
 
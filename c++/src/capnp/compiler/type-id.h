@@ -40,6 +40,10 @@ uint64_t generateMethodParamsId(uint64_t parentId, uint16_t methodOrdinal, bool
 // pseudo-randomly from the input using an algorithm that should produce a uniform distribution of
 // IDs.
 
+kj::String hashContent(kj::StringPtr salt, kj::ArrayPtr<const kj::byte> content);
+// Returns a hex digest of `salt` followed by `content`, using the same (non-cryptographic) hash
+// as the ID generators above. Used to name cached compiler outputs.
+
 }  // namespace compiler
 }  // namespace capnp
 
@@ -511,6 +511,166 @@ TEST(DynamicApi, SetGroup) {
   EXPECT_EQ("howdy", dstGroup.get("corge").as<DynamicStruct>().get("plugh").as<Text>());
 }
 
+TEST(CompiledStructAccessor, ReadsLikeDynamicStruct) {
+  MallocMessageBuilder builder;
+  initTestMessage(builder.initRoot<TestAllTypes>());
+  StructSchema schema = Schema::from<TestAllTypes>();
+  DynamicStruct::Reader reader = builder.getRoot<TestAllTypes>().asReader();
+  CompiledStructAccessor accessor(schema);
+
+  ASSERT_EQ(schema.getFields().size(), accessor.size());
+  for (auto field: schema.getFields()) {
+    KJ_CONTEXT(field.getProto().getName());
+    EXPECT_EQ(kj::str(reader.get(field)), kj::str(accessor.get(reader, field.getIndex())));
+  }
+
+  auto index = [&](kj::StringPtr name) { return schema.getFieldByName(name).getIndex(); };
+  EXPECT_EQ(true, accessor.get<bool>(reader, index("boolField")));
+  EXPECT_EQ(-123, accessor.get<int8_t>(reader, index("int8Field")));
+  EXPECT_EQ(-12345678, accessor.get<int32_t>(reader, index("int32Field")));
+  EXPECT_EQ(12345678901234567890ull, accessor.get<uint64_t>(reader, index("uInt64Field")));
+  EXPECT_FLOAT_EQ(1234.5f, accessor.get<float>(reader, index("float32Field")));
+  EXPECT_EQ("foo", accessor.get<Text::Reader>(reader, index("textField")));
+  EXPECT_EQ(data("bar"), accessor.get<Data::Reader>(reader, index("dataField")));
+  EXPECT_EQ(uint16_t(TestEnum::CORGE), accessor.get<uint16_t>(reader, index("enumField")));
+
+  // Wrong type, wrong struct, or out of range.
+  EXPECT_ANY_THROW(accessor.get<int16_t>(reader, index("int8Field")));
+  EXPECT_ANY_THROW(accessor.get<Text::Reader>(reader, index("dataField")));
+  EXPECT_ANY_THROW(accessor.get<bool>(reader, schema.getFields().size()));
+  EXPECT_ANY_THROW(accessor.get(reader, schema.getFields().size()));
+  MallocMessageBuilder otherBuilder;
+  auto other = otherBuilder.initRoot<DynamicStruct>(Schema::from<TestDefaults>()).asReader();
+  EXPECT_ANY_THROW(accessor.get<bool>(other, index("boolField")));
+}
+
+TEST(CompiledStructAccessor, Defaults) {
+  MallocMessageBuilder builder;
+  StructSchema schema = Schema::from<TestDefaults>();
+  DynamicStruct::Reader reader = builder.initRoot<TestDefaults>().asReader();
+  CompiledStructAccessor accessor(schema);
+
+  for (auto field: schema.getFields()) {
+    KJ_CONTEXT(field.getProto().getName());
+    EXPECT_EQ(kj::str(reader.get(field)), kj::str(accessor.get(reader, field.getIndex())));
+  }
+
+  EXPECT_EQ(-123, accessor.get<int8_t>(reader, schema.getFieldByName("int8Field").getIndex()));
+  EXPECT_EQ("foo", accessor.get<Text::Reader>(
+      reader, schema.getFieldByName("textField").getIndex()));
+}
+
+TEST(CompiledStructAccessor, Writes) {
+  MallocMessageBuilder builder;
+  StructSchema schema = Schema::from<TestDefaults>();
+  auto root = builder.initRoot<DynamicStruct>(schema);
+  CompiledStructAccessor accessor(schema);
+  auto index = [&](kj::StringPtr name) { return schema.getFieldByName(name).getIndex(); };
+
+  accessor.set<int8_t>(root, index("int8Field"), 12);
+  accessor.set<double>(root, index("float64Field"), 2.5);
+  accessor.set<Text::Reader>(root, index("textField"), "baz");
+  accessor.set(root, index("uInt16Field"), 1234);
+  accessor.set(root, index("dataField"), data("qux"));
+  accessor.set(root, index("enumField"), TestEnum::GRAULT);
+
+  auto typed = root.as<TestDefaults>();
+  EXPECT_EQ(12, typed.getInt8Field());
+  EXPECT_EQ(2.5, typed.getFloat64Field());
+  EXPECT_EQ("baz", typed.getTextField());
+  EXPECT_EQ(1234u, typed.getUInt16Field());
+  EXPECT_EQ(data("qux"), typed.getDataField());
+  EXPECT_EQ(TestEnum::GRAULT, typed.getEnumField());
+
+  // Setting back to the default value encodes as zero, as with generated code.
+  accessor.set<int8_t>(root, index("int8Field"), -123);
+  EXPECT_EQ(-123, typed.getInt8Field());
+  EXPECT_FALSE(root.has("int8Field", HasMode::NON_DEFAULT));
+
+  EXPECT_ANY_THROW(accessor.set<int16_t>(root, index("int8Field"), 1));
+  EXPECT_ANY_THROW(accessor.set(root, index("uInt8Field"), 1000));
+}
+
+TEST(CompiledStructAccessor, Unions) {
+  MallocMessageBuilder builder;
+  StructSchema schema = Schema::from<test::TestUnnamedUnion>();
+  auto root = builder.initRoot<DynamicStruct>(schema);
+  CompiledStructAccessor accessor(schema);
+  uint foo = schema.getFieldByName("foo").getIndex();
+  uint bar = schema.getFieldByName("bar").getIndex();
+  uint middle = schema.getFieldByName("middle").getIndex();
+
+  accessor.set<uint32_t>(root, bar, 321);
+  accessor.set<uint16_t>(root, middle, 7);
+  EXPECT_EQ(schema.getFieldByName("bar"), KJ_ASSERT_NONNULL(root.which()));
+  EXPECT_EQ(321u, accessor.get<uint32_t>(root.asReader(), bar));
+  EXPECT_ANY_THROW(accessor.get<uint16_t>(root.asReader(), foo));
+  EXPECT_ANY_THROW(accessor.get(root.asReader(), foo));
+
+  uint fields[] = { foo, bar, middle };
+  DynamicValue::Reader values[3];
+  accessor.getMany(root.asReader(), fields, values);
+  EXPECT_EQ(DynamicValue::VOID, values[0].getType());
+  EXPECT_EQ(321u, values[1].as<uint>());
+  EXPECT_EQ(7u, values[2].as<uint>());
+
+  accessor.set<uint16_t>(root, foo, 123);
+  EXPECT_EQ(schema.getFieldByName("foo"), KJ_ASSERT_NONNULL(root.which()));
+  EXPECT_EQ(123u, accessor.get<uint16_t>(root.asReader(), foo));
+  EXPECT_ANY_THROW(accessor.get<uint32_t>(root.asReader(), bar));
+}
+
+TEST(CompiledStructAccessor, Groups) {
+  MallocMessageBuilder builder;
+  StructSchema schema = Schema::from<test::TestGroups>();
+  auto root = builder.initRoot<test::TestGroups>();
+  root.getGroups().initBar().setCorge(12);
+  CompiledStructAccessor accessor(schema);
+
+  DynamicStruct::Reader reader = root.asReader();
+  auto groups = accessor.get(reader, schema.getFieldByName("groups").getIndex())
+      .as<DynamicStruct>();
+  StructSchema groupsSchema = groups.getSchema();
+  CompiledStructAccessor groupsAccessor(groupsSchema);
+  auto bar = groupsAccessor.get(groups, groupsSchema.getFieldByName("bar").getIndex())
+      .as<DynamicStruct>();
+  CompiledStructAccessor barAccessor(bar.getSchema());
+  EXPECT_EQ(12, barAccessor.get<int32_t>(
+      bar, bar.getSchema().getFieldByName("corge").getIndex()));
+  EXPECT_ANY_THROW(groupsAccessor.get(groups, groupsSchema.getFieldByName("foo").getIndex()));
+  EXPECT_ANY_THROW(accessor.get<bool>(reader, schema.getFieldByName("groups").getIndex()));
+}
+
+KJ_TEST("benchmark: CompiledStructAccessor vs. DynamicStruct::Reader::get()") {
+  MallocMessageBuilder builder;
+  initTestMessage(builder.initRoot<TestAllTypes>());
+  StructSchema schema = Schema::from<TestAllTypes>();
+  DynamicStruct::Reader reader = builder.getRoot<TestAllTypes>().asReader();
+  CompiledStructAccessor accessor(schema);
+  uint int32Field = schema.getFieldByName("int32Field").getIndex();
+  uint textField = schema.getFieldByName("textField").getIndex();
+  auto int32Schema = schema.getFieldByName("int32Field");
+  auto textSchema = schema.getFieldByName("textField");
+
+  doBenchmark([&]() {
+    int64_t sum = 0;
+    for (uint i = 0; i < 10000; i++) {
+      sum += accessor.get<int32_t>(reader, int32Field);
+      sum += accessor.get<Text::Reader>(reader, textField).size();
+    }
+    KJ_ASSERT(sum == (-12345678 + 3) * 10000ll);
+  });
+
+  doBenchmark([&]() {
+    int64_t sum = 0;
+    for (uint i = 0; i < 10000; i++) {
+      sum += reader.get(int32Schema).as<int32_t>();
+      sum += reader.get(textSchema).as<Text>().size();
+    }
+    KJ_ASSERT(sum == (-12345678 + 3) * 10000ll);
+  });
+}
+
 }  // namespace
 }  // namespace _ (private)
 }  // namespace capnp
@@ -1038,6 +1038,249 @@ void DynamicStruct::Builder::clear(kj::StringPtr name) {
 
 // =======================================================================================
 
+CompiledStructAccessor::CompiledStructAccessor(StructSchema schema)
+    : schema(schema),
+      discriminantOffset(schema.getProto().getStruct().getDiscriminantOffset()) {
+  auto fields = schema.getFields();
+  auto builder = kj::heapArrayBuilder<Slot>(fields.size());
+
+  for (auto field: fields) {
+    auto proto = field.getProto();
+    Slot slot;
+    slot.type = field.getType();
+    slot.isGroup = false;
+    slot.discriminantValue = proto.getDiscriminantValue();
+    slot.offset = 0;
+    slot.defaultBits = 0;
+    slot.defaultPointer = nullptr;
+    slot.defaultSize = 0;
+    slot.field = field;
+
+    switch (proto.which()) {
+      case schema::Field::SLOT: {
+        auto fieldSlot = proto.getSlot();
+        slot.offset = fieldSlot.getOffset();
+
+        // As in DynamicStruct::Reader::get(), a pointer field's default may be "anyPointer" when
+        // the field's type is a bound generic parameter.
+        auto dval = fieldSlot.getDefaultValue();
+        switch (slot.type.which()) {
+          case schema::Type::VOID: break;
+          case schema::Type::BOOL: slot.defaultBits = dval.getBool(); break;
+          case schema::Type::INT8: slot.defaultBits = bitCast<uint8_t>(dval.getInt8()); break;
+          case schema::Type::INT16: slot.defaultBits = bitCast<uint16_t>(dval.getInt16()); break;
+          case schema::Type::INT32: slot.defaultBits = bitCast<uint32_t>(dval.getInt32()); break;
+          case schema::Type::INT64: slot.defaultBits = bitCast<uint64_t>(dval.getInt64()); break;
+          case schema::Type::UINT8: slot.defaultBits = dval.getUint8(); break;
+          case schema::Type::UINT16: slot.defaultBits = dval.getUint16(); break;
+          case schema::Type::UINT32: slot.defaultBits = dval.getUint32(); break;
+          case schema::Type::UINT64: slot.defaultBits = dval.getUint64(); break;
+          case schema::Type::FLOAT32:
+            slot.defaultBits = bitCast<uint32_t>(dval.getFloat32());
+            break;
+          case schema::Type::FLOAT64:
+            slot.defaultBits = bitCast<uint64_t>(dval.getFloat64());
+            break;
+          case schema::Type::ENUM: slot.defaultBits = dval.getEnum(); break;
+
+          case schema::Type::TEXT:
+            if (!dval.isAnyPointer()) {
+              auto text = dval.getText();
+              slot.defaultPointer = text.begin();
+              slot.defaultSize = text.size();
+            }
+            break;
+          case schema::Type::DATA:
+            if (!dval.isAnyPointer()) {
+              auto data = dval.getData();
+              slot.defaultPointer = data.begin();
+              slot.defaultSize = data.size();
+            }
+            break;
+          case schema::Type::LIST:
+            if (!dval.isAnyPointer()) {
+              slot.defaultPointer = dval.getList().getAs<_::UncheckedMessage>();
+            }
+            break;
+          case schema::Type::STRUCT:
+            if (!dval.isAnyPointer()) {
+              slot.defaultPointer = dval.getStruct().getAs<_::UncheckedMessage>();
+            }
+            break;
+
+          case schema::Type::ANY_POINTER:
+          case schema::Type::INTERFACE:
+            break;
+        }
+        break;
+      }
+
+      case schema::Field::GROUP:
+        slot.isGroup = true;
+        break;
+    }
+
+    builder.add(slot);
+  }
+
+  slots = builder.finish();
+}
+
+DynamicValue::Reader CompiledStructAccessor::readSlot(
+    _::StructReader reader, const Slot& slot) const {
+  if (slot.isGroup) {
+    return DynamicStruct::Reader(slot.type.asStruct(), reader);
+  }
+
+  switch (slot.type.which()) {
+#define HANDLE_TYPE(discrim, type) \
+    case schema::Type::discrim: \
+      return TypedAccess<type>::get(reader, slot);
+
+    HANDLE_TYPE(VOID, Void)
+    HANDLE_TYPE(BOOL, bool)
+    HANDLE_TYPE(INT8, int8_t)
+    HANDLE_TYPE(INT16, int16_t)
+    HANDLE_TYPE(INT32, int32_t)
+    HANDLE_TYPE(INT64, int64_t)
+    HANDLE_TYPE(UINT8, uint8_t)
+    HANDLE_TYPE(UINT16, uint16_t)
+    HANDLE_TYPE(UINT32, uint32_t)
+    HANDLE_TYPE(UINT64, uint64_t)
+    HANDLE_TYPE(FLOAT32, float)
+    HANDLE_TYPE(FLOAT64, double)
+    HANDLE_TYPE(TEXT, Text::Reader)
+    HANDLE_TYPE(DATA, Data::Reader)
+
+#undef HANDLE_TYPE
+
+    case schema::Type::ENUM:
+      return DynamicEnum(slot.type.asEnum(), TypedAccess<uint16_t>::get(reader, slot));
+
+    case schema::Type::LIST: {
+      auto listType = slot.type.asList();
+      return DynamicList::Reader(listType,
+          reader.getPointerField(assumePointerOffset(slot.offset))
+                .getList(elementSizeFor(listType.whichElementType()),
+                         reinterpret_cast<const word*>(slot.defaultPointer)));
+    }
+
+    case schema::Type::STRUCT:
+      return DynamicStruct::Reader(slot.type.asStruct(),
+          reader.getPointerField(assumePointerOffset(slot.offset))
+                .getStruct(reinterpret_cast<const word*>(slot.defaultPointer)));
+
+    case schema::Type::ANY_POINTER:
+      return AnyPointer::Reader(reader.getPointerField(assumePointerOffset(slot.offset)));
+
+    case schema::Type::INTERFACE:
+      return DynamicCapability::Client(slot.type.asInterface(),
+          reader.getPointerField(assumePointerOffset(slot.offset)).getCapability());
+  }
+
+  KJ_UNREACHABLE;
+}
+
+DynamicValue::Reader CompiledStructAccessor::get(
+    DynamicStruct::Reader reader, uint fieldIndex) const {
+  KJ_REQUIRE(reader.schema == schema, "struct is not of the type this accessor was compiled for",
+             reader.schema.getProto().getDisplayName(), schema.getProto().getDisplayName());
+  KJ_REQUIRE(fieldIndex < slots.size(), "field index out of range", fieldIndex, slots.size());
+  auto& slot = slots[fieldIndex];
+  if (!isSet(reader.reader, slot)) notSetInUnion(slot);
+  return readSlot(reader.reader, slot);
+}
+
+void CompiledStructAccessor::getMany(
+    DynamicStruct::Reader reader, kj::ArrayPtr<const uint> fieldIndexes,
+    kj::ArrayPtr<DynamicValue::Reader> out) const {
+  KJ_REQUIRE(reader.schema == schema, "struct is not of the type this accessor was compiled for",
+             reader.schema.getProto().getDisplayName(), schema.getProto().getDisplayName());
+  KJ_REQUIRE(fieldIndexes.size() == out.size(), "output array must match field list");
+
+  for (auto i: kj::indices(fieldIndexes)) {
+    uint fieldIndex = fieldIndexes[i];
+    KJ_REQUIRE(fieldIndex < slots.size(), "field index out of range", fieldIndex, slots.size());
+    auto& slot = slots[fieldIndex];
+    out[i] = isSet(reader.reader, slot) ? readSlot(reader.reader, slot)
+                                        : DynamicValue::Reader(VOID);
+  }
+}
+
+void CompiledStructAccessor::set(
+    DynamicStruct::Builder builder, uint fieldIndex, const DynamicValue::Reader& value) const {
+  KJ_REQUIRE(builder.schema == schema, "struct is not of the type this accessor was compiled for",
+             builder.schema.getProto().getDisplayName(), schema.getProto().getDisplayName());
+  KJ_REQUIRE(fieldIndex < slots.size(), "field index out of range", fieldIndex, slots.size());
+  auto& slot = slots[fieldIndex];
+
+  if (slot.isGroup) {
+    builder.set(slot.field, value);
+    return;
+  }
+
+  switch (slot.type.which()) {
+#define HANDLE_TYPE(discrim, type, asType) \
+    case schema::Type::discrim: \
+      set<type>(builder, fieldIndex, value.as<asType>()); \
+      return;
+
+    HANDLE_TYPE(VOID, Void, Void)
+    HANDLE_TYPE(BOOL, bool, bool)
+    HANDLE_TYPE(INT8, int8_t, int8_t)
+    HANDLE_TYPE(INT16, int16_t, int16_t)
+    HANDLE_TYPE(INT32, int32_t, int32_t)
+    HANDLE_TYPE(INT64, int64_t, int64_t)
+    HANDLE_TYPE(UINT8, uint8_t, uint8_t)
+    HANDLE_TYPE(UINT16, uint16_t, uint16_t)
+    HANDLE_TYPE(UINT32, uint32_t, uint32_t)
+    HANDLE_TYPE(UINT64, uint64_t, uint64_t)
+    HANDLE_TYPE(FLOAT32, float, float)
+    HANDLE_TYPE(FLOAT64, double, double)
+    HANDLE_TYPE(TEXT, Text::Reader, Text)
+    HANDLE_TYPE(DATA, Data::Reader, Data)
+
+#undef HANDLE_TYPE
+
+    case schema::Type::ENUM:
+    case schema::Type::LIST:
+    case schema::Type::STRUCT:
+    case schema::Type::ANY_POINTER:
+    case schema::Type::INTERFACE:
+      // These need the same conversions and type checks as DynamicStruct, and their cost is
+      // dominated by the copy anyway.
+      builder.set(slot.field, value);
+      return;
+  }
+
+  KJ_UNREACHABLE;
+}
+
+void CompiledStructAccessor::badField(
+    StructSchema actual, uint fieldIndex, schema::Type::Which type) const {
+  if (actual != schema) {
+    KJ_FAIL_REQUIRE("struct is not of the type this accessor was compiled for",
+                    actual.getProto().getDisplayName(), schema.getProto().getDisplayName());
+  } else if (fieldIndex >= slots.size()) {
+    KJ_FAIL_REQUIRE("field index out of range", fieldIndex, slots.size());
+  } else {
+    auto& slot = slots[fieldIndex];
+    KJ_FAIL_REQUIRE("field does not have the requested type",
+                    slot.field.getProto().getName(), schema.getProto().getDisplayName(),
+                    slot.isGroup ? uint(schema::Type::STRUCT) : uint(slot.type.which()),
+                    uint(type));
+  }
+  KJ_UNREACHABLE;
+}
+
+void CompiledStructAccessor::notSetInUnion(const Slot& slot) const {
+  KJ_FAIL_REQUIRE("Tried to get() a union member which is not currently initialized.",
+                  slot.field.getProto().getName(), schema.getProto().getDisplayName());
+  KJ_UNREACHABLE;
+}
+
+// =======================================================================================
+
 DynamicValue::Reader DynamicList::Reader::operator[](uint index) const {
   KJ_REQUIRE(index < size(), "List index out-of-bounds.");
 
@@ -248,6 +248,7 @@ private:
   friend class Orphan<DynamicValue>;
   friend class Orphan<AnyPointer>;
   friend class AnyStruct::Reader;
+  friend class CompiledStructAccessor;
 };
 
 class DynamicStruct::Builder {
@@ -339,6 +340,7 @@ private:
   friend class Orphan<DynamicValue>;
   friend class Orphan<AnyPointer>;
   friend class AnyStruct::Builder;
+  friend class CompiledStructAccessor;
 };
 
 class DynamicStruct::Pipeline {
@@ -407,6 +409,7 @@ private:
   friend struct _::PointerHelpers;
   friend struct DynamicStruct;
   friend class DynamicList::Builder;
+  friend class CompiledStructAccessor;
   template <typename T, ::capnp::Kind k>
   friend struct ::capnp::ToDynamic_;
   friend class Orphanage;
@@ -518,6 +521,7 @@ private:
   friend class Orphan<AnyPointer>;
   template <typename T, Kind k>
   friend struct _::PointerHelpers;
+  friend class CompiledStructAccessor;
 };
 
 class DynamicCapability::Server: public Capability::Server {
@@ -839,6 +843,88 @@ kj::StringTree KJ_STRINGIFY(const DynamicStruct::Builder& value);
 kj::StringTree KJ_STRINGIFY(const DynamicList::Reader& value);
 kj::StringTree KJ_STRINGIFY(const DynamicList::Builder& value);
 
+// -------------------------------------------------------------------
+// Precompiled field access
+
+class CompiledStructAccessor {
+  // Reads and writes fields of one struct type like DynamicStruct::Reader::get() and
+  // DynamicStruct::Builder::set() do, but with each field's type, offset, default value, and
+  // union discriminant looked up once, at construction, instead of decoded from the schema on
+  // every call. Build one per StructSchema and reuse it for every message; it is immutable, so it
+  // may be shared between threads.
+  //
+  // Fields are identified by index, as in StructSchema::Field::getIndex(). The typed get<T>() and
+  // set<T>() compile down to the same loads and stores as generated code, plus checks that the
+  // struct and field type match.
+
+public:
+  explicit CompiledStructAccessor(StructSchema schema);
+
+  inline StructSchema getSchema() const { return schema; }
+  inline uint size() const { return slots.size(); }
+
+  template <typename T>
+  T get(DynamicStruct::Reader reader, uint fieldIndex) const;
+  template <typename T>
+  void set(DynamicStruct::Builder builder, uint fieldIndex, kj::NoInfer<T> value) const;
+  // Read or write a field whose type is exactly T, which must be one of Void, bool, the integer
+  // types, float, double, Text::Reader, or Data::Reader. An enum field may be accessed as its
+  // raw uint16_t value. T must be given explicitly. As with DynamicStruct, reading a union member
+  // that isn't set throws, and writing one sets the union's discriminant.
+
+  DynamicValue::Reader get(DynamicStruct::Reader reader, uint fieldIndex) const;
+  void set(DynamicStruct::Builder builder, uint fieldIndex,
+           const DynamicValue::Reader& value) const;
+  // Same as DynamicStruct's get() and set(), for a field of any type.
+
+  void getMany(DynamicStruct::Reader reader, kj::ArrayPtr<const uint> fieldIndexes,
+               kj::ArrayPtr<DynamicValue::Reader> out) const;
+  // Reads the fields at `fieldIndexes` into the corresponding elements of `out`, as if by calling
+  // get() for each. A field which is a union member that isn't set reads as Void instead of
+  // throwing, so that a fixed projection can be applied to every message.
+
+private:
+  struct Slot {
+    Type type;
+    // Resolved type of the field, with brand bindings applied. For a group, the group's struct
+    // type.
+
+    bool isGroup;
+    uint16_t discriminantValue;
+    // schema::Field::NO_DISCRIMINANT unless the field is a member of the struct's union.
+
+    uint32_t offset;
+    // Offset of the field, in multiples of its size, as in the schema.
+
+    uint64_t defaultBits;
+    // XOR mask (i.e. the default value's bits) for data fields.
+
+    const void* defaultPointer;
+    uint32_t defaultSize;
+    // Default value of a pointer field, or null: for blobs, the bytes and their size, and for
+    // lists and structs, an unchecked message.
+
+    StructSchema::Field field;
+  };
+
+  StructSchema schema;
+  uint32_t discriminantOffset;
+  kj::Array<Slot> slots;
+
+  inline const Slot& checkField(StructSchema actual, uint fieldIndex,
+                                schema::Type::Which type) const;
+  inline bool isSet(_::StructReader reader, const Slot& slot) const;
+  DynamicValue::Reader readSlot(_::StructReader reader, const Slot& slot) const;
+
+  KJ_NORETURN(void badField(StructSchema actual, uint fieldIndex,
+                            schema::Type::Which type) const);
+  KJ_NORETURN(void notSetInUnion(const Slot& slot) const);
+  // Out of line, so that the checks in the inline methods cost only a compare and branch.
+
+  template <typename T> struct TypedAccess;
+  // Specialized for each type accepted by get<T>() / set<T>().
+};
+
 // -------------------------------------------------------------------
 // Orphan <-> Dynamic glue
 
@@ -1684,6 +1770,106 @@ inline DynamicCapability::Client CapabilityServerSet<DynamicCapability>::add(
 
 // -------------------------------------------------------------------
 
+#define CAPNP_DECLARE_ACCESS(T, which) \
+template <> \
+struct CompiledStructAccessor::TypedAccess<T> { \
+  static constexpr schema::Type::Which TYPE = schema::Type::which; \
+  static inline T get(_::StructReader reader, const Slot& slot) { \
+    return reader.getDataField<T>(assumeDataOffset(slot.offset), \
+                                  static_cast<_::Mask<T>>(slot.defaultBits)); \
+  } \
+  static inline void set(_::StructBuilder builder, const Slot& slot, T value) { \
+    builder.setDataField<T>(assumeDataOffset(slot.offset), value, \
+                            static_cast<_::Mask<T>>(slot.defaultBits)); \
+  } \
+}
+
+CAPNP_DECLARE_ACCESS(bool, BOOL);
+CAPNP_DECLARE_ACCESS(int8_t, INT8);
+CAPNP_DECLARE_ACCESS(int16_t, INT16);
+CAPNP_DECLARE_ACCESS(int32_t, INT32);
+CAPNP_DECLARE_ACCESS(int64_t, INT64);
+CAPNP_DECLARE_ACCESS(uint8_t, UINT8);
+CAPNP_DECLARE_ACCESS(uint16_t, UINT16);
+CAPNP_DECLARE_ACCESS(uint32_t, UINT32);
+CAPNP_DECLARE_ACCESS(uint64_t, UINT64);
+CAPNP_DECLARE_ACCESS(float, FLOAT32);
+CAPNP_DECLARE_ACCESS(double, FLOAT64);
+
+#undef CAPNP_DECLARE_ACCESS
+
+template <>
+struct CompiledStructAccessor::TypedAccess<Void> {
+  static constexpr schema::Type::Which TYPE = schema::Type::VOID;
+  static inline Void get(_::StructReader reader, const Slot& slot) { return VOID; }
+  static inline void set(_::StructBuilder builder, const Slot& slot, Void value) {}
+};
+
+template <>
+struct CompiledStructAccessor::TypedAccess<Text::Reader> {
+  static constexpr schema::Type::Which TYPE = schema::Type::TEXT;
+  static inline Text::Reader get(_::StructReader reader, const Slot& slot) {
+    return reader.getPointerField(assumePointerOffset(slot.offset))
+        .getBlob<Text>(slot.defaultPointer, assumeMax<MAX_TEXT_SIZE>(slot.defaultSize) * BYTES);
+  }
+  static inline void set(_::StructBuilder builder, const Slot& slot, Text::Reader value) {
+    builder.getPointerField(assumePointerOffset(slot.offset)).setBlob<Text>(value);
+  }
+};
+
+template <>
+struct CompiledStructAccessor::TypedAccess<Data::Reader> {
+  static constexpr schema::Type::Which TYPE = schema::Type::DATA;
+  static inline Data::Reader get(_::StructReader reader, const Slot& slot) {
+    return reader.getPointerField(assumePointerOffset(slot.offset))
+        .getBlob<Data>(slot.defaultPointer,
+                       assumeBits<BLOB_SIZE_BITS>(slot.defaultSize) * BYTES);
+  }
+  static inline void set(_::StructBuilder builder, const Slot& slot, Data::Reader value) {
+    builder.getPointerField(assumePointerOffset(slot.offset)).setBlob<Data>(value);
+  }
+};
+
+inline const CompiledStructAccessor::Slot& CompiledStructAccessor::checkField(
+    StructSchema actual, uint fieldIndex, schema::Type::Which type) const {
+  // `type` is the type requested by get<T>() or set<T>(). Enum fields may be accessed as uint16_t.
+  if (KJ_UNLIKELY(actual != schema || fieldIndex >= slots.size())) {
+    badField(actual, fieldIndex, type);
+  }
+  const Slot& slot = slots.begin()[fieldIndex];
+  if (KJ_UNLIKELY(slot.isGroup || (slot.type.which() != type &&
+      !(type == schema::Type::UINT16 && slot.type.which() == schema::Type::ENUM)))) {
+    badField(actual, fieldIndex, type);
+  }
+  return slot;
+}
+
+inline bool CompiledStructAccessor::isSet(_::StructReader reader, const Slot& slot) const {
+  return slot.discriminantValue == schema::Field::NO_DISCRIMINANT ||
+      reader.getDataField<uint16_t>(assumeDataOffset(discriminantOffset)) ==
+          slot.discriminantValue;
+}
+
+template <typename T>
+inline T CompiledStructAccessor::get(DynamicStruct::Reader reader, uint fieldIndex) const {
+  auto& slot = checkField(reader.schema, fieldIndex, TypedAccess<T>::TYPE);
+  if (KJ_UNLIKELY(!isSet(reader.reader, slot))) notSetInUnion(slot);
+  return TypedAccess<T>::get(reader.reader, slot);
+}
+
+template <typename T>
+inline void CompiledStructAccessor::set(
+    DynamicStruct::Builder builder, uint fieldIndex, kj::NoInfer<T> value) const {
+  auto& slot = checkField(builder.schema, fieldIndex, TypedAccess<T>::TYPE);
+  if (slot.discriminantValue != schema::Field::NO_DISCRIMINANT) {
+    builder.builder.setDataField<uint16_t>(assumeDataOffset(discriminantOffset),
+                                           slot.discriminantValue);
+  }
+  TypedAccess<T>::set(builder.builder, slot, value);
+}
+
+// -------------------------------------------------------------------
+
 template <typename T>
 ReaderFor<T> ConstSchema::as() const {
   return DynamicValue::Reader(*this).as<T>();
@@ -2102,6 +2102,106 @@ KJ_TEST("Copying ListList downgraded from ListStruct does not get corrupted") {
   // out-of-bounds 0xbb bytes from `data` above, which should be impossible.
 }
 
+KJ_TEST("getFlatTarget() / copyFromFlat()") {
+  MallocMessageBuilder source;
+  initTestMessage(source.initRoot<test::TestAnyPointer>()
+      .getAnyPointerField().initAs<TestAllTypes>());
+  auto sourceSegments = source.getSegmentsForOutput();
+  KJ_ASSERT(sourceSegments.size() == 1);
+
+  SegmentArrayMessageReader reader(sourceSegments);
+  auto field = reader.getRoot<test::TestAnyPointer>().getAnyPointerField();
+  auto flat = PointerHelpers<AnyPointer>::getInternalReader(field).getFlatTarget();
+  KJ_IF_MAYBE(f, flat) {
+    KJ_EXPECT(f->size.asPublic().wordCount == field.targetSize().wordCount);
+    KJ_EXPECT(f->capPointers.size() == 0);
+
+    MallocMessageBuilder builder;
+    auto root = builder.initRoot<test::TestAnyPointer>();
+    PointerHelpers<AnyPointer>::getInternalBuilder(root.getAnyPointerField()).copyFromFlat(*f);
+    checkTestMessage(root.asReader().getAnyPointerField().getAs<TestAllTypes>());
+    KJ_EXPECT(root.asReader().getAnyPointerField() == field);
+  } else {
+    KJ_FAIL_EXPECT("expected contiguous layout");
+  }
+
+  // A message with objects scattered across segments has far pointers, so can't be flat-copied.
+  MallocMessageBuilder scattered(0, AllocationStrategy::FIXED_SIZE);
+  initTestMessage(scattered.initRoot<TestAllTypes>());
+  KJ_EXPECT(scattered.getSegmentsForOutput().size() > 1);
+  SegmentArrayMessageReader scatteredReader(scattered.getSegmentsForOutput());
+  KJ_EXPECT(PointerHelpers<AnyPointer>::getInternalReader(
+      scatteredReader.getRoot<AnyPointer>()).getFlatTarget() == nullptr);
+}
+
+KJ_TEST("getFlatTarget() rejects trees with gaps") {
+  AlignedData<5> data = {{
+    // struct, 1 pointer
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+
+    // list of bytes, 8 elements, skipping one word
+    0x05, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x00,
+
+    // bytes that aren't part of the tree
+    0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb,
+
+    // list content
+    0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  }};
+
+  kj::ArrayPtr<const word> segments[1] = { kj::arrayPtr(data.words, 5) };
+  SegmentArrayMessageReader reader(kj::arrayPtr(segments, 1));
+  auto root = reader.getRoot<AnyPointer>();
+  KJ_EXPECT(PointerHelpers<AnyPointer>::getInternalReader(root).getFlatTarget() == nullptr);
+
+  // Without the gap, it works.
+  data.words[2] = data.words[3];
+  data.bytes[8] = 0x01;
+  KJ_EXPECT(PointerHelpers<AnyPointer>::getInternalReader(root).getFlatTarget() != nullptr);
+}
+
+KJ_TEST("getFlatTarget() rejects aliased objects, even when they cancel out a gap") {
+  AlignedData<5> data = {{
+    // struct, 2 pointers
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
+
+    // list of bytes, 8 elements, skipping one word
+    0x09, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x00,
+
+    // the same list again
+    0x05, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x00,
+
+    // bytes that aren't part of the tree
+    0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb,
+
+    // list content
+    0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+  }};
+
+  // The tree spans four words and its objects add up to four words, but only because the aliased
+  // list is counted twice.
+  kj::ArrayPtr<const word> segments[1] = { kj::arrayPtr(data.words, 5) };
+  SegmentArrayMessageReader reader(kj::arrayPtr(segments, 1));
+  auto root = reader.getRoot<AnyPointer>();
+  KJ_EXPECT(PointerHelpers<AnyPointer>::getInternalReader(root).getFlatTarget() == nullptr);
+
+  // A regular copy expands the aliasing and leaves out the gap.
+  MallocMessageBuilder builder;
+  builder.setRoot(root);
+  auto outputSegments = builder.getSegmentsForOutput();
+  KJ_ASSERT(outputSegments.size() == 1);
+  KJ_EXPECT(outputSegments[0].size() == 5, outputSegments[0].size());
+  for (byte b: outputSegments[0].asBytes()) {
+    KJ_EXPECT(b != 0xbb);
+  }
+
+  auto copy = builder.getRoot<AnyStruct>().asReader().getPointerSection();
+  KJ_EXPECT(copy[0].getAs<Data>() == copy[1].getAs<Data>());
+  KJ_EXPECT(copy[0].getAs<Data>().begin() != copy[1].getAs<Data>().begin());
+}
+
 }  // namespace
 }  // namespace _ (private)
 }  // namespace capnp
@@ -24,6 +24,8 @@
 #include "ez-rpc.h"
 #include "test-util.h"
 #include <kj/compat/gtest.h>
+#include <kj/mutex.h>
+#include <stdio.h>
 
 namespace capnp {
 namespace _ {
@@ -70,6 +72,66 @@ TEST(EzRpc, DeprecatedNames) {
       .getCallSequenceRequest().send().wait(server.getWaitScope()).getN());
 }
 
+#if __linux__
+uint countListenSockets(uint port) {
+  // Counts the IPv4 sockets in the LISTEN state bound to `port`, according to /proc/net/tcp.
+
+  FILE* file = fopen("/proc/net/tcp", "r");
+  KJ_ASSERT(file != nullptr);
+  KJ_DEFER(fclose(file));
+
+  uint count = 0;
+  char line[256];
+  while (fgets(line, sizeof(line), file) != nullptr) {
+    uint localPort, state;
+    if (sscanf(line, " %*u: %*x:%x %*x:%*x %x", &localPort, &state) == 2 &&
+        localPort == port && state == 0x0A /* TCP_LISTEN */) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+TEST(EzRpc, MultiThreaded) {
+  constexpr uint THREADS = 3;
+  constexpr uint CONNECTIONS = 30;
+
+  // One call counter per thread, each only touched by its own thread until the server is gone.
+  int callCounts[THREADS] = {};
+  kj::MutexGuarded<uint> threadsStarted(0);
+
+  {
+    EzRpcServer server([&]() -> Capability::Client {
+      auto lock = threadsStarted.lockExclusive();
+      KJ_ASSERT(*lock < THREADS);
+      return kj::heap<TestInterfaceImpl>(callCounts[(*lock)++]);
+    }, "127.0.0.1", 0, THREADS);
+
+    uint port = server.getPort().wait(server.getWaitScope());
+
+    // Every thread has its own socket bound to the port and listening, so the kernel may hand
+    // connections to any of them, and every worker is running an accept loop.
+    EXPECT_EQ(THREADS, countListenSockets(port));
+    threadsStarted.when([](const uint& n) { return n == THREADS; }, [](uint&) {});
+
+    for (uint i = 0; i < CONNECTIONS; i++) {
+      EzRpcClient client("127.0.0.1", port);
+      auto request = client.getMain<test::TestInterface>().fooRequest();
+      request.setI(123);
+      request.setJ(true);
+      EXPECT_EQ("foo", request.send().wait(server.getWaitScope()).getX());
+    }
+  }
+
+  // Whichever threads the kernel picked, every call was served exactly once.
+  int total = 0;
+  for (auto count: callCounts) {
+    total += count;
+  }
+  EXPECT_EQ(CONNECTIONS, total);
+}
+#endif
+
 }  // namespace
 }  // namespace _
 }  // namespace capnp
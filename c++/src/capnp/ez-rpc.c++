@@ -24,9 +24,16 @@
 #include <capnp/rpc.capnp.h>
 #include <kj/async-io.h>
 #include <kj/debug.h>
+#include <kj/mutex.h>
+#include <kj/thread.h>
 #include <kj/threadlocal.h>
 #include <map>
 
+#if !_WIN32
+#include <sys/socket.h>
+#include <netinet/in.h>
+#endif
+
 namespace capnp {
 
 KJ_THREADLOCAL_PTR(EzRpcContext) threadEzContext = nullptr;
@@ -209,6 +216,39 @@ public:
 
 static DummyFilter DUMMY_FILTER;
 
+#if __linux__ && defined(SO_REUSEPORT)
+#define CAPNP_EZ_RPC_REUSEPORT SO_REUSEPORT
+#elif defined(SO_REUSEPORT_LB)
+// On FreeBSD, SO_REUSEPORT only lets sockets share a port; one of them still gets every
+// connection. SO_REUSEPORT_LB is the variant which spreads connections across them.
+#define CAPNP_EZ_RPC_REUSEPORT SO_REUSEPORT_LB
+#endif
+// Other platforms (e.g. macOS) either lack a load-balancing SO_REUSEPORT or make no promises
+// about it, so there the multi-threaded EzRpcServer constructor serves on one thread.
+
+#ifdef CAPNP_EZ_RPC_REUSEPORT
+kj::AutoCloseFd listenReusePort(const struct sockaddr* addr, uint addrSize) {
+  // Create a listen socket bound to `addr` with CAPNP_EZ_RPC_REUSEPORT, so that several sockets
+  // may listen on the same address.
+
+  int fd;
+  KJ_SYSCALL(fd = socket(addr->sa_family, SOCK_STREAM, 0));
+  kj::AutoCloseFd result(fd);
+
+  int optval = 1;
+  KJ_SYSCALL(setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval)));
+  KJ_SYSCALL(setsockopt(fd, SOL_SOCKET, CAPNP_EZ_RPC_REUSEPORT, &optval, sizeof(optval)));
+  if (addr->sa_family == AF_INET6) {
+    // Match kj::Network, which accepts both IPv4 and IPv6 connections on IPv6 sockets.
+    optval = 0;
+    KJ_SYSCALL(setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &optval, sizeof(optval)));
+  }
+  KJ_SYSCALL(bind(fd, addr, addrSize));
+  KJ_SYSCALL(listen(fd, SOMAXCONN));
+  return result;
+}
+#endif
+
 }  // namespace
 
 struct EzRpcServer::Impl final: public SturdyRefRestorer<AnyPointer>,
@@ -237,6 +277,13 @@ struct EzRpcServer::Impl final: public SturdyRefRestorer<AnyPointer>,
 
   kj::TaskSet tasks;
 
+  typedef kj::MutexGuarded<kj::Function<Capability::Client()>> MainInterfaceFactory;
+  kj::Maybe<kj::Own<MainInterfaceFactory>> mainInterfaceFactory;
+
+  class WorkerThread;
+  kj::Vector<kj::Own<WorkerThread>> workers;
+  // Declared last so that the workers are stopped before anything they use is destroyed.
+
   struct ServerContext {
     kj::Own<kj::AsyncIoStream> stream;
     TwoPartyVatNetwork network;
@@ -250,6 +297,12 @@ struct EzRpcServer::Impl final: public SturdyRefRestorer<AnyPointer>,
           network(*this->stream, rpc::twoparty::Side::SERVER, readerOpts),
           rpcSystem(makeRpcServer(network, restorer)) {}
 #pragma GCC diagnostic pop
+
+    ServerContext(kj::Own<kj::AsyncIoStream>&& stream, Capability::Client mainInterface,
+                  ReaderOptions readerOpts)
+        : stream(kj::mv(stream)),
+          network(*this->stream, rpc::twoparty::Side::SERVER, readerOpts),
+          rpcSystem(makeRpcServer(network, kj::mv(mainInterface))) {}
   };
 
   Impl(Capability::Client mainInterface, kj::StringPtr bindAddress, uint defaultPort,
@@ -277,6 +330,48 @@ struct EzRpcServer::Impl final: public SturdyRefRestorer<AnyPointer>,
     acceptLoop(kj::mv(listener), readerOpts);
   }
 
+  Impl(kj::Function<Capability::Client()> factory, kj::StringPtr bindAddress, uint defaultPort,
+       uint threadCount, ReaderOptions readerOpts)
+      : mainInterface(nullptr), context(EzRpcContext::getThreadLocal()), portPromise(nullptr),
+        tasks(*this), mainInterfaceFactory(kj::heap<MainInterfaceFactory>(kj::mv(factory))) {
+    KJ_REQUIRE(threadCount > 0, "EzRpcServer needs at least one thread");
+    mainInterface = newMainInterface();
+
+    auto paf = kj::newPromiseAndFulfiller<uint>();
+    portPromise = paf.promise.fork();
+
+    tasks.add(context->getIoProvider().getNetwork().parseAddress(bindAddress, defaultPort)
+        .then([this, portFulfiller=kj::mv(paf.fulfiller), threadCount, readerOpts]
+              (kj::Own<kj::NetworkAddress>&& addr) mutable {
+      auto listener = addr->listen();
+
+#ifdef CAPNP_EZ_RPC_REUSEPORT
+      // Turn on port reuse for this thread's socket so that the workers' sockets can bind to the
+      // same address -- including the port, if the kernel chose it.
+      int optval = 1;
+      listener->setsockopt(SOL_SOCKET, CAPNP_EZ_RPC_REUSEPORT, &optval, sizeof(optval));
+      struct sockaddr_storage boundAddr;
+      uint boundAddrSize = sizeof(boundAddr);
+      listener->getsockname(reinterpret_cast<struct sockaddr*>(&boundAddr), &boundAddrSize);
+
+      for (uint i = 1; i < threadCount; i++) {
+        workers.add(kj::heap<WorkerThread>(*this,
+            listenReusePort(reinterpret_cast<struct sockaddr*>(&boundAddr), boundAddrSize),
+            readerOpts));
+      }
+#else
+      if (threadCount > 1) {
+        KJ_LOG(WARNING, "this platform can't spread connections across several listen sockets; "
+                        "EzRpcServer will serve all connections on the calling thread",
+                        threadCount);
+      }
+#endif
+
+      portFulfiller->fulfill(listener->getPort());
+      acceptLoop(kj::mv(listener), readerOpts);
+    }));
+  }
+
   Impl(Capability::Client mainInterface, int socketFd, uint port, ReaderOptions readerOpts)
       : mainInterface(kj::mv(mainInterface)),
         context(EzRpcContext::getThreadLocal()),
@@ -317,8 +412,78 @@ struct EzRpcServer::Impl final: public SturdyRefRestorer<AnyPointer>,
   void taskFailed(kj::Exception&& exception) override {
     kj::throwFatalException(kj::mv(exception));
   }
+
+  Capability::Client newMainInterface() {
+    auto lock = KJ_ASSERT_NONNULL(mainInterfaceFactory)->lockExclusive();
+    return (*lock)();
+  }
 };
 
+#ifdef CAPNP_EZ_RPC_REUSEPORT
+class EzRpcServer::Impl::WorkerThread final: private kj::TaskSet::ErrorHandler {
+  // Accepts and serves connections on one port-sharing listen socket, on its own thread.
+
+public:
+  WorkerThread(Impl& parent, kj::AutoCloseFd listenFd, ReaderOptions readerOpts)
+      : thread([this, &parent, listenFd = kj::mv(listenFd), readerOpts]() mutable {
+          run(parent, kj::mv(listenFd), readerOpts);
+        }) {}
+
+  ~WorkerThread() noexcept(false) {
+    auto lock = state.lockExclusive();
+    lock->stopped = true;
+    KJ_IF_MAYBE(fulfiller, lock->stopFulfiller) {
+      (*fulfiller)->fulfill();
+    }
+    // `thread`'s destructor, which runs next, joins the thread.
+  }
+
+private:
+  struct State {
+    bool stopped = false;
+    kj::Maybe<kj::Own<kj::CrossThreadPromiseFulfiller<void>>> stopFulfiller;
+  };
+  kj::MutexGuarded<State> state;
+
+  kj::Thread thread;
+
+  void run(Impl& parent, kj::AutoCloseFd listenFd, ReaderOptions readerOpts) {
+    auto context = EzRpcContext::getThreadLocal();
+
+    auto stopPaf = kj::newPromiseAndCrossThreadFulfiller<void>();
+    {
+      auto lock = state.lockExclusive();
+      if (lock->stopped) return;
+      lock->stopFulfiller = kj::mv(stopPaf.fulfiller);
+    }
+
+    Capability::Client mainInterface = parent.newMainInterface();
+    kj::TaskSet tasks(*this);
+    acceptLoop(tasks, context->getLowLevelIoProvider().wrapListenSocketFd(kj::mv(listenFd)),
+               mainInterface, readerOpts);
+    stopPaf.promise.wait(context->getWaitScope());
+  }
+
+  void acceptLoop(kj::TaskSet& tasks, kj::Own<kj::ConnectionReceiver>&& listener,
+                  Capability::Client mainInterface, ReaderOptions readerOpts) {
+    auto ptr = listener.get();
+    tasks.add(ptr->accept().then([this, &tasks, listener=kj::mv(listener),
+                                  mainInterface=kj::mv(mainInterface), readerOpts]
+                                 (kj::Own<kj::AsyncIoStream>&& connection) mutable {
+      auto server = kj::heap<ServerContext>(kj::mv(connection), mainInterface, readerOpts);
+      acceptLoop(tasks, kj::mv(listener), kj::mv(mainInterface), readerOpts);
+      tasks.add(server->network.onDisconnect().attach(kj::mv(server)));
+    }));
+  }
+
+  void taskFailed(kj::Exception&& exception) override {
+    kj::throwFatalException(kj::mv(exception));
+  }
+};
+#else
+class EzRpcServer::Impl::WorkerThread {};
+#endif
+
 EzRpcServer::EzRpcServer(Capability::Client mainInterface, kj::StringPtr bindAddress,
                          uint defaultPort, ReaderOptions readerOpts)
     : impl(kj::heap<Impl>(kj::mv(mainInterface), bindAddress, defaultPort, readerOpts)) {}
@@ -331,6 +496,12 @@ EzRpcServer::EzRpcServer(Capability::Client mainInterface, int socketFd, uint po
                          ReaderOptions readerOpts)
     : impl(kj::heap<Impl>(kj::mv(mainInterface), socketFd, port, readerOpts)) {}
 
+EzRpcServer::EzRpcServer(kj::Function<Capability::Client()> mainInterfaceFactory,
+                         kj::StringPtr bindAddress, uint defaultPort, uint threadCount,
+                         ReaderOptions readerOpts)
+    : impl(kj::heap<Impl>(kj::mv(mainInterfaceFactory), bindAddress, defaultPort, threadCount,
+                          readerOpts)) {}
+
 EzRpcServer::EzRpcServer(kj::StringPtr bindAddress, uint defaultPort,
                          ReaderOptions readerOpts)
     : EzRpcServer(nullptr, bindAddress, defaultPort, readerOpts) {}
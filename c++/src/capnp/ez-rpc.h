@@ -23,6 +23,7 @@
 
 #include "rpc.h"
 #include "message.h"
+#include <kj/function.h>
 
 CAPNP_BEGIN_HEADER
 
@@ -193,6 +194,26 @@ public:
   // called).  `port` is returned by `getPort()` -- it serves no other purpose.
   // `readerOpts` acts as in the other two above constructors.
 
+  EzRpcServer(kj::Function<Capability::Client()> mainInterfaceFactory, kj::StringPtr bindAddress,
+              uint defaultPort, uint threadCount, ReaderOptions readerOpts = ReaderOptions());
+  // Like the first constructor, but serves connections on `threadCount` threads: the calling
+  // thread, whose event loop you must run as usual, plus `threadCount - 1` threads which the
+  // server starts (and joins when it is destroyed). Each thread has its own event loop and its own
+  // listen socket, all bound to the same address with SO_REUSEPORT (SO_REUSEPORT_LB on FreeBSD), so
+  // that the kernel spreads incoming connections across them.
+  //
+  // Capabilities belong to the thread which created them, so rather than a main interface, you
+  // pass a factory which is called once on each thread to create that thread's main interface.
+  // Calls to the factory are serialized, but any state it shares with the interfaces it creates
+  // must be thread-safe. Each connection is served entirely by the thread which accepted it.
+  //
+  // `bindAddress` must resolve to a single address. Capabilities exported with `exportCap()` are
+  // only available to connections accepted on the calling thread.
+  //
+  // Only Linux and FreeBSD are known to balance connections across sockets sharing a port. On
+  // other platforms, the server logs a warning and serves every connection on the calling thread,
+  // calling the factory only once.
+
   explicit EzRpcServer(kj::StringPtr bindAddress, uint defaultPort = 0,
                        ReaderOptions readerOpts = ReaderOptions())
       CAPNP_DEPRECATED("Please specify a main interface for your server.");
@@ -0,0 +1,241 @@
+// Copyright (c) 2026 Cloudflare, Inc. and contributors
+// Licensed under the MIT License:
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "field-mask.h"
+#include "message.h"
+#include "dynamic.h"
+#include <kj/test.h>
+#include "test-util.h"
+
+namespace capnp {
+namespace _ {  // private
+namespace {
+
+KJ_TEST("FieldMask copies selected fields") {
+  MallocMessageBuilder source;
+  initTestMessage(source.initRoot<TestAllTypes>());
+  auto input = source.getRoot<TestAllTypes>().asReader();
+
+  FieldMask mask(Schema::from<TestAllTypes>(), {
+    "boolField", "int32Field", "textField", "structField.uInt8Field", "structList.textField"
+  });
+
+  MallocMessageBuilder projected;
+  mask.copy(input, projected.initRoot<AnyPointer>());
+  auto output = projected.getRoot<AnyStruct>().asReader().as<TestAllTypes>();
+
+  KJ_EXPECT(output.getBoolField() == input.getBoolField());
+  KJ_EXPECT(output.getInt32Field() == input.getInt32Field());
+  KJ_EXPECT(output.getTextField() == input.getTextField());
+  KJ_EXPECT(output.getStructField().getUInt8Field() == input.getStructField().getUInt8Field());
+  KJ_EXPECT(output.getStructList().size() == input.getStructList().size());
+  for (auto i: kj::indices(output.getStructList())) {
+    KJ_EXPECT(output.getStructList()[i].getTextField() == input.getStructList()[i].getTextField());
+    KJ_EXPECT(output.getStructList()[i].getInt32Field() == 0);
+  }
+
+  // Everything else was left out.
+  KJ_EXPECT(output.getInt8Field() == 0);
+  KJ_EXPECT(output.getInt64Field() == 0);
+  KJ_EXPECT(output.getFloat64Field() == 0);
+  KJ_EXPECT(!output.hasDataField());
+  KJ_EXPECT(!output.getStructField().hasTextField());
+  KJ_EXPECT(output.getStructField().getInt32Field() == 0);
+  KJ_EXPECT(!output.hasInt32List());
+  KJ_EXPECT(!output.hasTextList());
+
+  // The copy is trimmed down to the last selected pointer, the struct list.
+  AnyStruct::Reader root = projected.getRoot<AnyStruct>().asReader();
+  KJ_EXPECT(root.getPointerSection().size() ==
+            Schema::from<TestAllTypes>().getFieldByName("structList")
+                .getProto().getSlot().getOffset() + 1);
+  KJ_EXPECT(root.getDataSection().size() < AnyStruct::Reader(input).getDataSection().size());
+
+  // totalSize() predicts the size of the copy.
+  KJ_EXPECT(mask.totalSize(input).wordCount == root.totalSize().wordCount);
+  KJ_EXPECT(mask.totalSize(input).wordCount < input.totalSize().wordCount);
+}
+
+KJ_TEST("FieldMask copies whole subtrees") {
+  MallocMessageBuilder source;
+  initTestMessage(source.initRoot<TestAllTypes>());
+  auto input = source.getRoot<TestAllTypes>().asReader();
+
+  // Selecting a field also selects everything within it, even if a subfield was selected first.
+  FieldMask mask(Schema::from<TestAllTypes>(), {"structField.int32Field", "structField"});
+
+  MallocMessageBuilder projected;
+  mask.copy(input, projected.initRoot<AnyPointer>());
+  auto output = projected.getRoot<AnyStruct>().asReader().as<TestAllTypes>();
+
+  KJ_EXPECT(AnyStruct::Reader(output.getStructField()) ==
+            AnyStruct::Reader(input.getStructField()));
+  KJ_EXPECT(output.getInt32Field() == 0);
+  KJ_EXPECT(!output.hasStructList());
+  KJ_EXPECT(mask.totalSize(input).wordCount ==
+            projected.getRoot<AnyStruct>().asReader().totalSize().wordCount);
+}
+
+KJ_TEST("FieldMask copies into an existing struct") {
+  MallocMessageBuilder source;
+  initTestMessage(source.initRoot<TestAllTypes>());
+  auto input = source.getRoot<TestAllTypes>().asReader();
+
+  MallocMessageBuilder destination;
+  auto output = destination.initRoot<TestAllTypes>();
+  output.setInt64Field(5);
+  output.setTextField("old");
+  output.setStructField(input.getStructField());
+
+  FieldMask mask(Schema::from<TestAllTypes>(), {"textField", "structField.int32Field"});
+  mask.copy(input, destination.getRoot<AnyStruct>());
+
+  KJ_EXPECT(output.asReader().getTextField() == input.getTextField());
+  KJ_EXPECT(output.getInt64Field() == 5);
+  KJ_EXPECT(output.getStructField().getInt32Field() == input.getStructField().getInt32Field());
+  KJ_EXPECT(!output.getStructField().hasTextField());
+}
+
+KJ_TEST("FieldMask copies only the union member that is set") {
+  FieldMask mask(Schema::from<TestUnion>(), {"union0.u0f0s32", "union0.u0f1sp"});
+
+  {
+    MallocMessageBuilder source;
+    source.initRoot<TestUnion>().initUnion0().setU0f0s32(123);
+
+    MallocMessageBuilder projected;
+    mask.copy(source.getRoot<TestUnion>().asReader(), projected.initRoot<AnyPointer>());
+    auto output = projected.getRoot<AnyStruct>().asReader().as<TestUnion>().getUnion0();
+    KJ_EXPECT(output.which() == TestUnion::Union0::U0F0S32);
+    KJ_EXPECT(output.getU0f0s32() == 123);
+  }
+
+  {
+    // u0f1s64 shares its storage with u0f0s32, but isn't selected.
+    MallocMessageBuilder source;
+    source.initRoot<TestUnion>().initUnion0().setU0f1s64(0x123456789abcdefll);
+
+    MallocMessageBuilder projected;
+    mask.copy(source.getRoot<TestUnion>().asReader(), projected.initRoot<AnyPointer>());
+    auto output = projected.getRoot<AnyStruct>().asReader().as<TestUnion>().getUnion0();
+    KJ_EXPECT(output.which() == TestUnion::Union0::U0F1S64);
+    KJ_EXPECT(output.getU0f1s64() == 0);
+  }
+
+  {
+    MallocMessageBuilder source;
+    source.initRoot<TestUnion>().initUnion0().setU0f1sp("foo");
+    auto input = source.getRoot<TestUnion>().asReader();
+
+    MallocMessageBuilder projected;
+    mask.copy(input, projected.initRoot<AnyPointer>());
+    auto output = projected.getRoot<AnyStruct>().asReader().as<TestUnion>().getUnion0();
+    KJ_EXPECT(output.which() == TestUnion::Union0::U0F1SP);
+    KJ_EXPECT(output.getU0f1sp() == "foo");
+    KJ_EXPECT(mask.totalSize(input).wordCount ==
+              projected.getRoot<AnyStruct>().asReader().totalSize().wordCount);
+  }
+}
+
+KJ_TEST("FieldMask selects within groups") {
+  MallocMessageBuilder source;
+  auto bar = source.initRoot<test::TestGroups>().initGroups().initBar();
+  bar.setCorge(12);
+  bar.setGrault("foo");
+  bar.setGarply(34);
+  auto input = source.getRoot<test::TestGroups>().asReader();
+
+  {
+    FieldMask mask(Schema::from<test::TestGroups>(), {"groups.bar"});
+    MallocMessageBuilder projected;
+    mask.copy(input, projected.initRoot<AnyPointer>());
+    auto output = projected.getRoot<AnyStruct>().asReader().as<test::TestGroups>().getGroups();
+    KJ_EXPECT(output.which() == test::TestGroups::Groups::BAR);
+    KJ_EXPECT(output.getBar().getCorge() == 12);
+    KJ_EXPECT(output.getBar().getGrault() == "foo");
+    KJ_EXPECT(output.getBar().getGarply() == 34);
+  }
+
+  {
+    FieldMask mask(Schema::from<test::TestGroups>(), {"groups.bar.grault", "groups.foo.corge"});
+    MallocMessageBuilder projected;
+    mask.copy(input, projected.initRoot<AnyPointer>());
+    auto output = projected.getRoot<AnyStruct>().asReader().as<test::TestGroups>().getGroups();
+    KJ_EXPECT(output.which() == test::TestGroups::Groups::BAR);
+    KJ_EXPECT(output.getBar().getCorge() == 0);
+    KJ_EXPECT(output.getBar().getGrault() == "foo");
+    KJ_EXPECT(output.getBar().getGarply() == 0);
+  }
+}
+
+KJ_TEST("FieldMask rejects bad paths") {
+  StructSchema schema = Schema::from<TestAllTypes>();
+  KJ_EXPECT_THROW_MESSAGE("doesn't exist", FieldMask(schema, {"noSuchField"}));
+  KJ_EXPECT_THROW_MESSAGE("doesn't exist", FieldMask(schema, {"structField.noSuchField"}));
+  KJ_EXPECT_THROW_MESSAGE("isn't a group, struct", FieldMask(schema, {"int32List.foo"}));
+
+  // Paths under an already-selected field are still validated.
+  KJ_EXPECT_THROW_MESSAGE("doesn't exist",
+      FieldMask(schema, {"structField", "structField.noSuchField"}));
+}
+
+KJ_TEST("benchmark: FieldMask vs. dynamic field copy") {
+  MallocMessageBuilder source;
+  auto root = source.initRoot<TestAllTypes>();
+  initTestMessage(root);
+  auto list = root.initStructList(100);
+  for (auto element: list) {
+    initTestMessage(element);
+  }
+  auto input = source.getRoot<TestAllTypes>().asReader();
+
+  FieldMask mask(Schema::from<TestAllTypes>(), {"int32Field", "structList.textField"});
+
+  doBenchmark([&]() {
+    for (uint i = 0; i < 1000; i++) {
+      MallocMessageBuilder projected(mask.totalSize(input).wordCount + 1);
+      mask.copy(input, projected.initRoot<AnyPointer>());
+      KJ_ASSERT(projected.getRoot<AnyStruct>().asReader().as<TestAllTypes>()
+                    .getStructList().size() == 100);
+    }
+  });
+
+  doBenchmark([&]() {
+    for (uint i = 0; i < 1000; i++) {
+      MallocMessageBuilder projected;
+      auto from = DynamicStruct::Reader(input);
+      auto to = projected.initRoot<DynamicStruct>(Schema::from<TestAllTypes>());
+      to.set("int32Field", from.get("int32Field"));
+      auto fromList = from.get("structList").as<DynamicList>();
+      auto toList = to.init("structList", fromList.size()).as<DynamicList>();
+      for (auto j: kj::indices(fromList)) {
+        toList[j].as<DynamicStruct>().set("textField",
+            fromList[j].as<DynamicStruct>().get("textField"));
+      }
+      KJ_ASSERT(projected.getRoot<AnyStruct>().asReader().as<TestAllTypes>()
+                    .getStructList().size() == 100);
+    }
+  });
+}
+
+}  // namespace
+}  // namespace _ (private)
+}  // namespace capnp
@@ -0,0 +1,282 @@
+// Copyright (c) 2026 Cloudflare, Inc. and contributors
+// Licensed under the MIT License:
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "field-mask.h"
+#include <kj/debug.h>
+#include <kj/map.h>
+#include <kj/vector.h>
+#include <algorithm>
+
+namespace capnp {
+
+namespace {
+
+struct Selection {
+  // The fields selected within one struct or group, by index.
+
+  bool all = false;
+  // If true, every field is selected, along with everything it contains, and `fields` is empty.
+
+  kj::TreeMap<uint, kj::Own<Selection>> fields;
+};
+
+kj::Maybe<StructSchema> getSubfieldScope(StructSchema::Field field) {
+  // Returns the struct whose fields a path may go on to name after naming `field`.
+
+  Type type = field.getType();
+  if (type.isStruct()) {
+    // Includes groups.
+    return type.asStruct();
+  } else if (type.isList()) {
+    Type elementType = type.asList().getElementType();
+    if (elementType.isStruct()) return elementType.asStruct();
+  }
+  return nullptr;
+}
+
+uint dataBitsPerField(Type type) {
+  switch (type.which()) {
+    case schema::Type::VOID: return 0;
+    case schema::Type::BOOL: return 1;
+    case schema::Type::INT8: return 8;
+    case schema::Type::INT16: return 16;
+    case schema::Type::INT32: return 32;
+    case schema::Type::INT64: return 64;
+    case schema::Type::UINT8: return 8;
+    case schema::Type::UINT16: return 16;
+    case schema::Type::UINT32: return 32;
+    case schema::Type::UINT64: return 64;
+    case schema::Type::FLOAT32: return 32;
+    case schema::Type::FLOAT64: return 64;
+    case schema::Type::ENUM: return 16;
+
+    case schema::Type::TEXT:
+    case schema::Type::DATA:
+    case schema::Type::LIST:
+    case schema::Type::STRUCT:
+    case schema::Type::INTERFACE:
+    case schema::Type::ANY_POINTER:
+      KJ_FAIL_ASSERT("not a data field", type.which());
+  }
+  KJ_UNREACHABLE;
+}
+
+class MaskCompiler {
+  // Turns a Selection into a tree of _::StructMasks allocated in an arena.
+
+public:
+  explicit MaskCompiler(kj::Arena& arena): arena(arena) {}
+
+  const _::StructMask& compile(StructSchema schema, const Selection& selection) {
+    Builder builder;
+    uint dataWordCount = 0;
+    uint pointerCount = 0;
+    addFields(builder, schema, selection, dataWordCount, pointerCount);
+
+    _::StructMask& result = finish(builder);
+    result.dataWordCount = dataWordCount;
+    result.pointerCount = pointerCount;
+    return result;
+  }
+
+private:
+  kj::Arena& arena;
+
+  struct Builder {
+    kj::Vector<uint64_t> dataMask;
+    kj::Vector<_::StructMask::Pointer> pointers;
+
+    struct UnionMember {
+      uint32_t discriminantOffset;
+      uint16_t discriminantValue;
+      kj::Own<Builder> builder;
+    };
+    kj::Vector<UnionMember> unionMembers;
+
+    Builder& getUnionMember(uint32_t discriminantOffset, uint16_t discriminantValue) {
+      for (auto& member: unionMembers) {
+        if (member.discriminantOffset == discriminantOffset &&
+            member.discriminantValue == discriminantValue) {
+          return *member.builder;
+        }
+      }
+      return *unionMembers.add(
+          UnionMember { discriminantOffset, discriminantValue, kj::heap<Builder>() }).builder;
+    }
+
+    void selectBits(uint offset, uint count, uint& dataWordCount) {
+      // Fields are naturally aligned, so never straddle words.
+      uint index = offset / 64;
+      while (dataMask.size() <= index) dataMask.add(0);
+      uint64_t bits = count == 64 ? ~uint64_t(0) : (uint64_t(1) << count) - 1;
+      dataMask[index] |= bits << (offset % 64);
+      dataWordCount = kj::max(dataWordCount, index + 1);
+    }
+  };
+
+  void addFields(Builder& builder, StructSchema schema, const Selection& selection,
+                 uint& dataWordCount, uint& pointerCount) {
+    if (selection.all) {
+      for (auto field: schema.getFields()) {
+        addField(builder, schema, field, nullptr, dataWordCount, pointerCount);
+      }
+    } else {
+      auto fields = schema.getFields();
+      for (auto& entry: selection.fields) {
+        addField(builder, schema, fields[entry.key], entry.value->all ? nullptr : entry.value.get(),
+                 dataWordCount, pointerCount);
+      }
+    }
+  }
+
+  void addField(Builder& builder, StructSchema schema, StructSchema::Field field,
+                const Selection* subfields, uint& dataWordCount, uint& pointerCount) {
+    // Select `field`: all of it if `subfields` is null, otherwise just the given subfields.
+
+    Builder* target = &builder;
+    auto proto = field.getProto();
+    if (proto.getDiscriminantValue() != schema::Field::NO_DISCRIMINANT) {
+      uint32_t discriminantOffset = schema.getProto().getStruct().getDiscriminantOffset();
+      builder.selectBits(discriminantOffset * 16, 16, dataWordCount);
+      target = &builder.getUnionMember(discriminantOffset, proto.getDiscriminantValue());
+    }
+
+    switch (proto.which()) {
+      case schema::Field::SLOT: {
+        Type type = field.getType();
+        uint32_t offset = proto.getSlot().getOffset();
+        if (type.isText() || type.isData() || type.isList() || type.isStruct() ||
+            type.isInterface() || type.isAnyPointer()) {
+          const _::StructMask* child = nullptr;
+          if (subfields != nullptr) {
+            child = &compile(KJ_ASSERT_NONNULL(getSubfieldScope(field)), *subfields);
+          }
+          target->pointers.add(_::StructMask::Pointer { static_cast<uint16_t>(offset), child });
+          pointerCount = kj::max(pointerCount, offset + 1);
+        } else {
+          uint bits = dataBitsPerField(type);
+          if (bits > 0) target->selectBits(offset * bits, bits, dataWordCount);
+        }
+        break;
+      }
+
+      case schema::Field::GROUP: {
+        Selection all;
+        all.all = true;
+        addFields(*target, field.getType().asStruct(), subfields == nullptr ? all : *subfields,
+                  dataWordCount, pointerCount);
+        break;
+      }
+    }
+  }
+
+  _::StructMask& finish(Builder& builder) {
+    _::StructMask& result = arena.allocate<_::StructMask>();
+
+    auto dataMask = arena.allocateArray<uint64_t>(builder.dataMask.size());
+    std::copy(builder.dataMask.begin(), builder.dataMask.end(), dataMask.begin());
+    result.dataMask = dataMask;
+
+    auto pointers = arena.allocateArray<_::StructMask::Pointer>(builder.pointers.size());
+    std::copy(builder.pointers.begin(), builder.pointers.end(), pointers.begin());
+    result.pointers = pointers;
+
+    auto unionMembers =
+        arena.allocateArray<_::StructMask::UnionMember>(builder.unionMembers.size());
+    for (auto i: kj::indices(builder.unionMembers)) {
+      auto& member = builder.unionMembers[i];
+      unionMembers[i] = _::StructMask::UnionMember {
+        member.discriminantOffset, member.discriminantValue, &finish(*member.builder)
+      };
+    }
+    result.unionMembers = unionMembers;
+
+    return result;
+  }
+};
+
+}  // namespace
+
+FieldMask::FieldMask(StructSchema schema, kj::ArrayPtr<const kj::StringPtr> paths)
+    : schema(schema), arena(kj::heap<kj::Arena>()) {
+  Selection root;
+
+  for (auto path: paths) {
+    Selection* selection = &root;
+    StructSchema scope = schema;
+    kj::StringPtr remaining = path;
+
+    for (;;) {
+      kj::String name;
+      bool last = true;
+      KJ_IF_MAYBE(dot, remaining.findFirst('.')) {
+        name = kj::heapString(remaining.slice(0, *dot));
+        remaining = remaining.slice(*dot + 1);
+        last = false;
+      } else {
+        name = kj::heapString(remaining);
+      }
+
+      StructSchema::Field field = KJ_REQUIRE_NONNULL(scope.findFieldByName(name),
+          "FieldMask path names a field which doesn't exist", path, name,
+          scope.getProto().getDisplayName());
+
+      if (selection != nullptr && !selection->all) {
+        uint index = field.getIndex();
+        selection = selection->fields.findOrCreate(index, [&]() {
+          return kj::TreeMap<uint, kj::Own<Selection>>::Entry { index, kj::heap<Selection>() };
+        }).get();
+      } else {
+        // An earlier path already selected all of this; just validate the rest of this one.
+        selection = nullptr;
+      }
+
+      if (last) {
+        if (selection != nullptr) {
+          selection->all = true;
+          selection->fields.clear();
+        }
+        break;
+      }
+
+      scope = KJ_REQUIRE_NONNULL(getSubfieldScope(field),
+          "FieldMask path continues past a field which isn't a group, struct, or list of structs",
+          path, name);
+    }
+  }
+
+  mask = &MaskCompiler(*arena).compile(schema, root);
+}
+
+MessageSize FieldMask::totalSize(AnyStruct::Reader value) const {
+  return value._reader.maskedTotalSize(*mask).asPublic();
+}
+
+void FieldMask::copy(AnyStruct::Reader from, AnyPointer::Builder to) const {
+  _::PointerHelpers<AnyPointer>::getInternalBuilder(kj::mv(to))
+      .setStructMasked(from._reader, *mask);
+}
+
+void FieldMask::copy(AnyStruct::Reader from, AnyStruct::Builder to) const {
+  to._builder.copyMaskedContentFrom(from._reader, *mask);
+}
+
+}  // namespace capnp
@@ -0,0 +1,82 @@
+// Copyright (c) 2026 Cloudflare, Inc. and contributors
+// Licensed under the MIT License:
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "any.h"
+#include "schema.h"
+#include <kj/arena.h>
+
+CAPNP_BEGIN_HEADER
+
+namespace capnp {
+
+class FieldMask {
+  // Selects some of a struct type's fields -- and, within fields of struct type, some of theirs --
+  // so that just that part of a message can be copied or measured.  This is useful for trimming a
+  // response down to what the client asked for: the masked copy works directly on the encoded
+  // message and never visits unselected subtrees, so it is much cheaper than building the
+  // projection field-by-field through the dynamic API.
+  //
+  // Paths are resolved against the schema once, when the FieldMask is constructed; copying does not
+  // consult the schema at all.  It follows that a FieldMask cannot check that the structs passed to
+  // it are of the type it was built for -- that is up to the caller.
+
+public:
+  FieldMask(StructSchema schema, kj::ArrayPtr<const kj::StringPtr> paths);
+  inline FieldMask(StructSchema schema, std::initializer_list<kj::StringPtr> paths)
+      : FieldMask(schema, kj::arrayPtr(paths.begin(), paths.size())) {}
+  // Each path is a sequence of field names separated by '.', starting from `schema`, such as
+  // "author.name".  A path selects the field it names along with everything that field contains.
+  // Every name but the last must name a group, a struct field, or a list-of-structs field, in which
+  // case the rest of the path applies to each element.  Throws if a path cannot be resolved.
+  //
+  // Selecting a union member also selects the union's discriminant, so that the copy has the same
+  // member set as the original.  The member itself is only copied when it is the one set.
+
+  inline StructSchema getSchema() const { return schema; }
+
+  MessageSize totalSize(AnyStruct::Reader value) const;
+  // Returns the size of the projection of `value`, i.e. the space that copying it will allocate.
+  // Useful as a first-segment size hint for the message the projection is copied into.
+
+  void copy(AnyStruct::Reader from, AnyPointer::Builder to) const;
+  // Sets `to` to a new struct holding just the selected parts of `from`.  The new struct is only as
+  // large as needed to hold the selected fields; when read as the original type, the fields past
+  // its end read as their defaults, as they would from a message written by an older version.
+  // (Note that getting the struct from a builder as its original type, e.g. with
+  // MessageBuilder::getRoot<T>(), enlarges it back to the type's full size.)
+
+  void copy(AnyStruct::Reader from, AnyStruct::Builder to) const;
+  // Overwrites just the selected parts of `to` with those of `from`, leaving the rest of `to` as
+  // is.  `to` would typically be a freshly-initialized struct of the same type, such as a call's
+  // results.
+
+private:
+  StructSchema schema;
+  kj::Own<kj::Arena> arena;
+  const _::StructMask* mask;
+  // The compiled mask, allocated in `arena` along with the masks of nested structs.
+};
+
+}  // namespace capnp
+
+CAPNP_END_HEADER
@@ -626,6 +626,9 @@ struct WireHelpers {
     // Zero out the pointed-to object.  Use when the pointer is about to be overwritten making the
     // target object no longer reachable.
 
+    // Null pointers own nothing. Checked first since pointer sections are often mostly null.
+    if (ref->isNull()) return;
+
     // We shouldn't zero out external data linked into the message.
     if (!segment->isWritable()) return;
 
@@ -914,6 +917,339 @@ struct WireHelpers {
     return result;
   }
 
+  // -----------------------------------------------------------------
+  // Find flat (contiguous, far-pointer-free) object trees.
+
+  struct FlatWalk {
+    const word* begin = nullptr;
+    const word* end = nullptr;
+    const word* nextFree = nullptr;
+    MessageSizeCounts size = { ZERO * WORDS, 0 };
+    kj::Vector<const WirePointer*> capPointers;
+
+    template <typename Amount>
+    bool addObject(const word* ptr, Amount amount) {
+      // Fails if the object overlaps one seen earlier, or lies before it. Requiring objects to
+      // appear in the order the walk visits them (as they do when a message is built or copied
+      // depth-first) rules out overlaps, including aliasing, cheaply. Without overlaps, the span
+      // covered by the tree equals the sum of the objects' sizes exactly when it has no gaps.
+      //
+      // Zero-sized objects can't overlap anything, but they still extend the span to cover their
+      // location, so that the relative pointers to them remain in-bounds after a copy.
+      const word* objectEnd = ptr + amount;
+      if (ptr != objectEnd) {
+        if (nextFree != nullptr && ptr < nextFree) return false;
+        nextFree = objectEnd;
+      }
+      if (begin == nullptr) {
+        begin = ptr;
+        end = objectEnd;
+      } else {
+        if (ptr < begin) begin = ptr;
+        if (objectEnd > end) end = objectEnd;
+      }
+      size.addWords(amount);
+      return true;
+    }
+  };
+
+  static bool walkFlatPointer(SegmentReader* segment, const WirePointer* ref,
+                              int nestingLimit, FlatWalk& walk) {
+    // Like totalSize(), but fails (returning false, without reporting an error) on far pointers
+    // and malformed input rather than skipping them.
+
+    if (ref->isNull()) return true;
+
+    switch (ref->kind()) {
+      case WirePointer::STRUCT:
+      case WirePointer::LIST:
+        return walkFlatObject(segment, ref, ref->target(segment), nestingLimit, walk);
+      case WirePointer::FAR:
+        return false;
+      case WirePointer::OTHER:
+        if (ref->isCapability()) {
+          walk.size.capCount++;
+          walk.capPointers.add(ref);
+          return true;
+        } else {
+          return false;
+        }
+    }
+
+    KJ_UNREACHABLE;
+  }
+
+  static bool walkFlatObject(SegmentReader* segment, const WirePointer* tag, const word* ptr,
+                             int nestingLimit, FlatWalk& walk) {
+    if (nestingLimit <= 0) return false;
+    --nestingLimit;
+
+    if (tag->kind() == WirePointer::STRUCT) {
+      if (!boundsCheck(segment, ptr, tag->structRef.wordSize())) return false;
+      if (!walk.addObject(ptr, tag->structRef.wordSize())) return false;
+
+      const WirePointer* pointerSection =
+          reinterpret_cast<const WirePointer*>(ptr + tag->structRef.dataSize.get());
+      for (auto i: kj::zeroTo(tag->structRef.ptrCount.get())) {
+        if (!walkFlatPointer(segment, pointerSection + i, nestingLimit, walk)) return false;
+      }
+      return true;
+    }
+
+    KJ_DASSERT(tag->kind() == WirePointer::LIST);
+    switch (tag->listRef.elementSize()) {
+      case ElementSize::VOID:
+        return walk.addObject(ptr, ZERO * WORDS);
+      case ElementSize::BIT:
+      case ElementSize::BYTE:
+      case ElementSize::TWO_BYTES:
+      case ElementSize::FOUR_BYTES:
+      case ElementSize::EIGHT_BYTES: {
+        auto totalWords = roundBitsUpToWords(
+            upgradeBound<uint64_t>(tag->listRef.elementCount()) *
+            dataBitsPerElement(tag->listRef.elementSize()));
+        if (!boundsCheck(segment, ptr, totalWords)) return false;
+        return walk.addObject(ptr, totalWords);
+      }
+      case ElementSize::POINTER: {
+        auto count = tag->listRef.elementCount() * (POINTERS / ELEMENTS);
+        if (!boundsCheck(segment, ptr, count * WORDS_PER_POINTER)) return false;
+        if (!walk.addObject(ptr, count * WORDS_PER_POINTER)) return false;
+
+        for (auto i: kj::zeroTo(count)) {
+          if (!walkFlatPointer(segment, reinterpret_cast<const WirePointer*>(ptr) + i,
+                               nestingLimit, walk)) {
+            return false;
+          }
+        }
+        return true;
+      }
+      case ElementSize::INLINE_COMPOSITE: {
+        auto wordCount = tag->listRef.inlineCompositeWordCount();
+        if (!boundsCheck(segment, ptr, wordCount + POINTER_SIZE_IN_WORDS)) return false;
+
+        const WirePointer* elementTag = reinterpret_cast<const WirePointer*>(ptr);
+        auto count = elementTag->inlineCompositeListElementCount();
+        if (elementTag->kind() != WirePointer::STRUCT) return false;
+
+        auto actualSize = elementTag->structRef.wordSize() / ELEMENTS *
+                          upgradeBound<uint64_t>(count);
+        if (actualSize > wordCount) return false;
+
+        // Unlike totalSize(), count the claimed word count, since that's what we'll copy.
+        if (!walk.addObject(ptr, wordCount + POINTER_SIZE_IN_WORDS)) return false;
+
+        WordCount dataSize = elementTag->structRef.dataSize.get();
+        WirePointerCount pointerCount = elementTag->structRef.ptrCount.get();
+
+        if (pointerCount > ZERO * POINTERS) {
+          const word* pos = ptr + POINTER_SIZE_IN_WORDS;
+          for (auto i KJ_UNUSED: kj::zeroTo(count)) {
+            pos += dataSize;
+
+            for (auto j KJ_UNUSED: kj::zeroTo(pointerCount)) {
+              if (!walkFlatPointer(segment, reinterpret_cast<const WirePointer*>(pos),
+                                   nestingLimit, walk)) {
+                return false;
+              }
+              pos += POINTER_SIZE_IN_WORDS;
+            }
+          }
+        }
+        return true;
+      }
+    }
+
+    KJ_UNREACHABLE;
+  }
+
+  // -----------------------------------------------------------------
+  // Validate object trees up front so they can be read unchecked.
+
+  static bool validateForUncheckedRead(SegmentReader* segment, const WirePointer* ref,
+                                       int nestingLimit, MessageSizeCounts& size) {
+    // Applies the bounds, nesting, and read limit checks which a checked reader would apply to
+    // every object in the tree. Fails (returning false, without reporting an error) on malformed
+    // input and on far pointers, since unchecked readers can't follow them.
+
+    if (ref->isNull()) return true;
+
+    switch (ref->kind()) {
+      case WirePointer::STRUCT:
+      case WirePointer::LIST:
+        break;
+      case WirePointer::FAR:
+        return false;
+      case WirePointer::OTHER:
+        if (ref->isCapability()) {
+          size.capCount++;
+          return true;
+        } else {
+          return false;
+        }
+    }
+
+    if (nestingLimit <= 0) return false;
+    --nestingLimit;
+
+    const word* ptr = ref->target(segment);
+
+    if (ref->kind() == WirePointer::STRUCT) {
+      if (!boundsCheck(segment, ptr, ref->structRef.wordSize())) return false;
+      size.addWords(ref->structRef.wordSize());
+
+      const WirePointer* pointerSection =
+          reinterpret_cast<const WirePointer*>(ptr + ref->structRef.dataSize.get());
+      for (auto i: kj::zeroTo(ref->structRef.ptrCount.get())) {
+        if (!validateForUncheckedRead(segment, pointerSection + i, nestingLimit, size)) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    switch (ref->listRef.elementSize()) {
+      case ElementSize::VOID:
+        // Lists of void can claim to be arbitrarily large without having sent actual data.
+        return amplifiedRead(segment, ref->listRef.elementCount() * (ONE * WORDS / ELEMENTS));
+      case ElementSize::BIT:
+      case ElementSize::BYTE:
+      case ElementSize::TWO_BYTES:
+      case ElementSize::FOUR_BYTES:
+      case ElementSize::EIGHT_BYTES: {
+        auto totalWords = roundBitsUpToWords(
+            upgradeBound<uint64_t>(ref->listRef.elementCount()) *
+            dataBitsPerElement(ref->listRef.elementSize()));
+        if (!boundsCheck(segment, ptr, totalWords)) return false;
+        size.addWords(totalWords);
+        return true;
+      }
+      case ElementSize::POINTER: {
+        auto count = ref->listRef.elementCount() * (POINTERS / ELEMENTS);
+        if (!boundsCheck(segment, ptr, count * WORDS_PER_POINTER)) return false;
+        size.addWords(count * WORDS_PER_POINTER);
+
+        for (auto i: kj::zeroTo(count)) {
+          if (!validateForUncheckedRead(segment, reinterpret_cast<const WirePointer*>(ptr) + i,
+                                        nestingLimit, size)) {
+            return false;
+          }
+        }
+        return true;
+      }
+      case ElementSize::INLINE_COMPOSITE: {
+        auto wordCount = ref->listRef.inlineCompositeWordCount();
+        if (!boundsCheck(segment, ptr, wordCount + POINTER_SIZE_IN_WORDS)) return false;
+
+        const WirePointer* elementTag = reinterpret_cast<const WirePointer*>(ptr);
+        auto count = elementTag->inlineCompositeListElementCount();
+        if (elementTag->kind() != WirePointer::STRUCT) return false;
+
+        auto wordsPerElement = elementTag->structRef.wordSize() / ELEMENTS;
+        auto actualSize = wordsPerElement * upgradeBound<uint64_t>(count);
+        if (actualSize > wordCount) return false;
+
+        if (wordsPerElement * (ONE * ELEMENTS) == ZERO * WORDS) {
+          // Lists of zero-sized structs can likewise claim to be arbitrarily large.
+          if (!amplifiedRead(segment, count * (ONE * WORDS / ELEMENTS))) return false;
+        }
+        size.addWords(actualSize + POINTER_SIZE_IN_WORDS);
+
+        WordCount dataSize = elementTag->structRef.dataSize.get();
+        WirePointerCount pointerCount = elementTag->structRef.ptrCount.get();
+
+        if (pointerCount > ZERO * POINTERS) {
+          const word* pos = ptr + POINTER_SIZE_IN_WORDS;
+          for (auto i KJ_UNUSED: kj::zeroTo(count)) {
+            pos += dataSize;
+
+            for (auto j KJ_UNUSED: kj::zeroTo(pointerCount)) {
+              if (!validateForUncheckedRead(segment, reinterpret_cast<const WirePointer*>(pos),
+                                            nestingLimit, size)) {
+                return false;
+              }
+              pos += POINTER_SIZE_IN_WORDS;
+            }
+          }
+        }
+        return true;
+      }
+    }
+
+    KJ_UNREACHABLE;
+  }
+
+  static kj::Maybe<FlatPointerTarget> getFlatTarget(
+      SegmentReader* segment, CapTableReader* capTable, const WirePointer* ref,
+      int nestingLimit) {
+    // Unchecked messages have no segment to bound the walk against; don't bother with them.
+    if (segment == nullptr || ref->isNull()) return nullptr;
+
+    // The walk below fails silently, but a far pointer at the root is followed the usual way, so
+    // if it is malformed, the error is reported here just as a regular copy would report it.
+    const word* ptr;
+    KJ_IF_MAYBE(p, followFars(ref, ref->target(segment), segment)) {
+      ptr = p;
+    } else {
+      return nullptr;
+    }
+    if (!ref->isPositional()) return nullptr;
+
+    FlatWalk walk;
+    if (!walkFlatObject(segment, ref, ptr, nestingLimit, walk)) return nullptr;
+
+    // The tree must exactly fill [begin, end): any gap would mean copying bytes which aren't
+    // part of the tree. The walk already rejected overlaps, which could otherwise hide a gap.
+    if (walk.begin == walk.end ||
+        static_cast<uint64_t>(walk.end - walk.begin) != unbound(walk.size.wordCount / WORDS) ||
+        static_cast<uint64_t>(walk.end - walk.begin) >=
+            kj::maxValueForBits<SEGMENT_WORD_COUNT_BITS>()) {
+      return nullptr;
+    }
+
+#if CAPNP_LITE
+    if (walk.capPointers.size() > 0) return nullptr;
+#else
+    if (walk.capPointers.size() > 0 && capTable == nullptr) return nullptr;
+#endif
+
+    return FlatPointerTarget {
+      walk.size,
+      kj::arrayPtr(walk.begin, walk.end),
+      ref, ptr, capTable,
+      walk.capPointers.releaseAsArray()
+    };
+  }
+
+  static void copyFlat(SegmentBuilder* segment, CapTableBuilder* capTable,
+                       WirePointer* ref, const FlatPointerTarget& src) {
+    auto kind = src.tag->kind();
+    word* dst = allocate(ref, segment, capTable,
+        assertMaxBits<SEGMENT_WORD_COUNT_BITS>(bounded(src.words.size()) * WORDS, []() {
+          KJ_FAIL_ASSERT("flat target too big to fit in a segment");
+        }), kind, nullptr);
+    copyMemory(dst, src.words);
+
+    // allocate() pointed `ref` at the start of the run, but the root may be elsewhere within it.
+    ref->setKindAndTarget(kind, dst + (src.root - src.words.begin()), segment);
+    copyMemory(&ref->upper32Bits, &src.tag->upper32Bits);
+
+#if !CAPNP_LITE
+    for (const WirePointer* srcCap: src.capPointers) {
+      WirePointer* dstCap = reinterpret_cast<WirePointer*>(
+          dst + (reinterpret_cast<const word*>(srcCap) - src.words.begin()));
+      KJ_IF_MAYBE(cap, src.capTable->extractCap(srcCap->capRef.index.get())) {
+        dstCap->setCap(capTable->injectCap(kj::mv(*cap)));
+      } else {
+        KJ_FAIL_REQUIRE("Message contained invalid capability pointer.") {
+          zeroMemory(dstCap);
+          break;
+        }
+      }
+    }
+#endif  // !CAPNP_LITE
+  }
+
   // -----------------------------------------------------------------
   // Copy from an unchecked message.
 
@@ -2681,6 +3017,37 @@ void PointerBuilder::copyFrom(PointerReader other, bool canonical) {
   }
 }
 
+void PointerBuilder::copyFromFlat(const FlatPointerTarget& other) {
+  WireHelpers::copyFlat(segment, capTable, pointer, other);
+}
+
+void PointerBuilder::setStructMasked(const StructReader& value, const StructMask& mask) {
+  initStruct(mask.size()).copyMaskedContentFrom(value, mask);
+}
+
+void PointerBuilder::copyMaskedFrom(PointerReader other, const StructMask& mask) {
+  switch (other.getPointerType()) {
+    case PointerType::STRUCT:
+      setStructMasked(other.getStruct(nullptr), mask);
+      return;
+    case PointerType::LIST: {
+      ListReader list = other.getListAnySize(nullptr);
+      if (list.getElementSize() != ElementSize::INLINE_COMPOSITE) break;
+
+      ListBuilder builder = initStructList(list.size(), mask.size());
+      for (auto i: kj::zeroTo(list.size())) {
+        builder.getStructElement(i).copyMaskedContentFrom(list.getStructElement(i), mask);
+      }
+      return;
+    }
+    case PointerType::NULL_:
+    case PointerType::CAPABILITY:
+      break;
+  }
+
+  copyFrom(other);
+}
+
 PointerReader PointerBuilder::asReader() const {
   return PointerReader(segment, capTable, pointer, kj::maxValue);
 }
@@ -2760,6 +3127,45 @@ MessageSizeCounts PointerReader::targetSize() const {
                             : WireHelpers::totalSize(segment, pointer, nestingLimit);
 }
 
+MessageSizeCounts PointerReader::maskedTargetSize(const StructMask& mask) const {
+  switch (getPointerType()) {
+    case PointerType::STRUCT:
+      return getStruct(nullptr).maskedTotalSize(mask);
+    case PointerType::LIST: {
+      ListReader list = getListAnySize(nullptr);
+      if (list.getElementSize() != ElementSize::INLINE_COMPOSITE) break;
+
+      MessageSizeCounts result = { POINTER_SIZE_IN_WORDS, 0 };  // the list tag
+      for (auto i: kj::zeroTo(list.size())) {
+        result += list.getStructElement(i).maskedTotalSize(mask);
+      }
+      return result;
+    }
+    case PointerType::NULL_:
+    case PointerType::CAPABILITY:
+      break;
+  }
+
+  return targetSize();
+}
+
+kj::Maybe<MessageSizeCounts> PointerReader::validateForUncheckedRead() const {
+  // An unchecked message has no segment to validate against.
+  if (segment == nullptr) return nullptr;
+
+  MessageSizeCounts size = { ZERO * WORDS, 0 };
+  if (pointer != nullptr &&
+      !WireHelpers::validateForUncheckedRead(segment, pointer, nestingLimit, size)) {
+    return nullptr;
+  }
+  return size;
+}
+
+kj::Maybe<FlatPointerTarget> PointerReader::getFlatTarget() const {
+  if (pointer == nullptr) return nullptr;
+  return WireHelpers::getFlatTarget(segment, capTable, pointer, nestingLimit);
+}
+
 PointerType PointerReader::getPointerType() const {
   if(pointer == nullptr || pointer->isNull()) {
     return PointerType::NULL_;
@@ -2950,6 +3356,71 @@ void StructBuilder::copyContentFrom(StructReader other) {
   }
 }
 
+void StructBuilder::copyMaskedContentFrom(StructReader other, const StructMask& mask) {
+  if (other.data == data && other.pointers == pointers) {
+    // `other` is a reader for this same struct, so there is nothing to copy.
+    return;
+  }
+
+  // Copy the selected data bits.
+  if (dataSize == ONE * BITS) {
+    if (mask.dataMask.size() > 0 && (mask.dataMask[0] & 1)) {
+      setDataField<bool>(ZERO * ELEMENTS, other.getDataField<bool>(ZERO * ELEMENTS));
+    }
+  } else {
+    kj::ArrayPtr<byte> dst = getDataSectionAsBlob();
+    kj::ArrayPtr<const byte> src = other.getDataSectionAsBlob();
+    byte boolByte;
+    if (other.dataSize == ONE * BITS) {
+      boolByte = other.getDataField<bool>(ZERO * ELEMENTS);
+      src = kj::arrayPtr(&boolByte, 1);
+    }
+
+    for (auto i: kj::indices(mask.dataMask)) {
+      uint64_t bits = mask.dataMask[i];
+      if (bits == 0) continue;
+
+      size_t offset = i * sizeof(uint64_t);
+      if (offset >= dst.size()) break;
+
+      if (offset + sizeof(uint64_t) <= kj::min(dst.size(), src.size())) {
+        WireValue<uint64_t>& to = reinterpret_cast<WireValue<uint64_t>*>(dst.begin())[i];
+        uint64_t from = reinterpret_cast<const WireValue<uint64_t>*>(src.begin())[i].get();
+        to.set((to.get() & ~bits) | (from & bits));
+      } else {
+        // A partial word, as found in struct lists encoded with less than a word per element and
+        // at the end of smaller structs.
+        for (size_t j = 0; j < sizeof(uint64_t) && offset + j < dst.size(); j++) {
+          byte byteBits = bits >> (j * 8);
+          byte from = offset + j < src.size() ? src[offset + j] : 0;
+          dst[offset + j] = (dst[offset + j] & ~byteBits) | (from & byteBits);
+        }
+      }
+    }
+  }
+
+  // Copy the selected pointers.
+  for (auto& pointer: mask.pointers) {
+    if (pointer.index >= unbound(pointerCount / POINTERS)) continue;
+
+    PointerBuilder target = getPointerField(assumePointerOffset(pointer.index));
+    PointerReader source = other.getPointerField(assumePointerOffset(pointer.index));
+    if (pointer.child == nullptr) {
+      target.copyFrom(source);
+    } else {
+      target.copyMaskedFrom(source, *pointer.child);
+    }
+  }
+
+  // Copy whichever selected union members are set.
+  for (auto& member: mask.unionMembers) {
+    if (other.getDataField<uint16_t>(assumeDataOffset(member.discriminantOffset)) ==
+        member.discriminantValue) {
+      copyMaskedContentFrom(other, *member.mask);
+    }
+  }
+}
+
 StructReader StructBuilder::asReader() const {
   return StructReader(segment, capTable, data, pointers,
       dataSize, pointerCount, kj::maxValue);
@@ -2989,6 +3460,28 @@ MessageSizeCounts StructReader::totalSize() const {
   return result;
 }
 
+static void addMaskedPointerSizes(const StructReader& reader, const StructMask& mask,
+                                  MessageSizeCounts& result) {
+  for (auto& pointer: mask.pointers) {
+    PointerReader target = reader.getPointerField(assumePointerOffset(pointer.index));
+    result += pointer.child == nullptr ? target.targetSize()
+                                       : target.maskedTargetSize(*pointer.child);
+  }
+
+  for (auto& member: mask.unionMembers) {
+    if (reader.getDataField<uint16_t>(assumeDataOffset(member.discriminantOffset)) ==
+        member.discriminantValue) {
+      addMaskedPointerSizes(reader, *member.mask, result);
+    }
+  }
+}
+
+MessageSizeCounts StructReader::maskedTotalSize(const StructMask& mask) const {
+  MessageSizeCounts result = { mask.size().total(), 0 };
+  addMaskedPointerSizes(*this, mask, result);
+  return result;
+}
+
 kj::Array<word> StructReader::canonicalize() {
   auto size = totalSize().wordCount + POINTER_SIZE_IN_WORDS;
   kj::Array<word> backing = kj::heapArray<word>(unbound(size / WORDS));
@@ -3752,21 +4245,38 @@ bool OrphanBuilder::truncate(ElementCount uncheckedSize, bool isText) {
         ref->listRef.setInlineComposite(sizeWords);
         tag->setKindAndInlineCompositeListElementCount(WirePointer::STRUCT, size);
       } else {
-        // Need to re-allocate and transfer.
+        // Need to re-allocate and transfer. The new list is freshly zero'd and has the same
+        // element layout, so rather than going through StructBuilder::transferContentFrom() we
+        // copy each element's data section and move only its non-null pointers, then zero the
+        // old elements in one go. This keeps repeated growth (e.g. GrowableList) cheap.
         OrphanBuilder replacement = initStructList(segment->getArena(), capTable, size, structSize);
 
         ListBuilder newList = replacement.asStructList(structSize);
+        word* newTarget = reinterpret_cast<word*>(newList.ptr);
         for (auto i: kj::zeroTo(oldSize)) {
           // assumeBits() safe because we checked that both sizeWords and oldSizeWords are in-range
           // above.
-          word* element = target +
+          auto offset =
               assumeBits<SEGMENT_WORD_COUNT_BITS>(upgradeBound<uint64_t>(i) * elementStep);
-          newList.getStructElement(i).transferContentFrom(
-              StructBuilder(segment, capTable, element,
-                            reinterpret_cast<WirePointer*>(element + structSize.data),
-                            structSize.data * BITS_PER_WORD, structSize.pointers));
+          word* src = target + offset;
+          word* dst = newTarget + offset;
+          WireHelpers::copyMemory(dst, src, structSize.data);
+
+          WirePointer* srcPointers = reinterpret_cast<WirePointer*>(src + structSize.data);
+          WirePointer* dstPointers = reinterpret_cast<WirePointer*>(dst + structSize.data);
+          for (auto j: kj::zeroTo(structSize.pointers)) {
+            if (!srcPointers[j].isNull()) {
+              WireHelpers::transferPointer(newList.segment, dstPointers + j,
+                                           segment, srcPointers + j);
+            }
+          }
         }
 
+        // The old elements no longer own anything. Zero them and mark the old list empty so that
+        // discarding it below doesn't walk them again.
+        WireHelpers::zeroMemory(target, oldSizeWords);
+        tag->setKindAndInlineCompositeListElementCount(WirePointer::STRUCT, ZERO * ELEMENTS);
+
         *this = kj::mv(replacement);
       }
     }
@@ -327,6 +327,74 @@ public:
 
 // -------------------------------------------------------------------
 
+struct FlatPointerTarget {
+  // Describes an object tree which occupies a single gap-free run of words within one segment and
+  // contains no far pointers.  Since all other pointers are relative, such a tree can be copied
+  // to a new location with a single memcpy(), rewriting only capability indexes.  Returned by
+  // PointerReader::getFlatTarget() and consumed by PointerBuilder::copyFromFlat().
+
+  MessageSizeCounts size;
+  // Total size of the tree, suitable for use as a size hint when allocating the destination.
+
+  kj::ArrayPtr<const word> words;
+  // The run of words containing the whole tree.
+
+  const WirePointer* tag;
+  // Pointer describing the root object (after following any far pointer leading to it).
+
+  const word* root;
+  // Location of the root object within `words`.
+
+  CapTableReader* capTable;
+  kj::Array<const WirePointer*> capPointers;
+  // Capability pointers found within `words`, and the table against which their indexes are to
+  // be interpreted.
+};
+
+// -------------------------------------------------------------------
+
+struct StructMask {
+  // Selects parts of a struct -- and, through its pointers, of the structs it points to -- without
+  // reference to its schema.  Consumed by PointerBuilder::copyMaskedFrom() and friends.  Built
+  // from a schema by capnp::FieldMask, which owns the arrays referenced here.
+
+  kj::ArrayPtr<const uint64_t> dataMask;
+  // One mask per word of the data section; the set bits are copied.  Bit N of the data section
+  // (counting from the least-significant bit of the first byte, as on the wire) is bit N % 64 of
+  // dataMask[N / 64].  May be shorter than the data section.
+
+  struct Pointer {
+    uint16_t index;
+    // Index of the pointer within the pointer section.
+
+    const StructMask* child;
+    // If non-null and the pointer targets a struct or a list of structs, only the parts of the
+    // target(s) selected by `child` are copied.  Otherwise the whole target is copied.
+  };
+  kj::ArrayPtr<const Pointer> pointers;
+
+  struct UnionMember {
+    uint32_t discriminantOffset;
+    // Offset of the union's discriminant, in multiples of 16 bits.
+
+    uint16_t discriminantValue;
+    const StructMask* mask;
+    // Further parts of the same struct, selected only when the discriminant has this value.
+  };
+  kj::ArrayPtr<const UnionMember> unionMembers;
+
+  uint16_t dataWordCount;
+  uint16_t pointerCount;
+  // Size of the structs created when copying through this mask: just large enough to cover every
+  // selected part, including those of union members.  Unused on UnionMember masks.
+
+  inline StructSize size() const {
+    return StructSize(bounded(dataWordCount) * WORDS, bounded(pointerCount) * POINTERS);
+  }
+};
+
+// -------------------------------------------------------------------
+
 class PointerBuilder: public kj::DisallowConstCopy {
   // Represents a single pointer, usually embedded in a struct or a list.
 
@@ -387,6 +455,19 @@ public:
   // If you set the canonical flag, it will attempt to lay the target out
   // canonically, provided enough space is available.
 
+  void copyFromFlat(const FlatPointerTarget& other);
+  // Equivalent to `copyFrom()` on the pointer from which `other` was obtained, but copies the
+  // target with a single memcpy() instead of walking it.
+
+  void setStructMasked(const StructReader& value, const StructMask& mask);
+  // Initialize the pointer to a new struct of size `mask.size()` holding just the parts of `value`
+  // selected by `mask`.
+
+  void copyMaskedFrom(PointerReader other, const StructMask& mask);
+  // If `other` points to a struct, equivalent to `setStructMasked()`.  If it points to a list of
+  // structs, copies the list, applying `mask` to each element.  Otherwise equivalent to
+  // `copyFrom()`.
+
   PointerReader asReader() const;
 
   BuilderArena* getArena() const;
@@ -431,6 +512,27 @@ public:
   // use the result as a hint for allocating the first segment, do the copy, and then throw an
   // exception if it overruns.
 
+  MessageSizeCounts maskedTargetSize(const StructMask& mask) const;
+  // Like targetSize(), but returns the size of what PointerBuilder::copyMaskedFrom() would
+  // allocate.  Unlike targetSize(), this counts against the message's read limit.
+
+  kj::Maybe<MessageSizeCounts> validateForUncheckedRead() const;
+  // Walks the target and everything it points to, applying every bounds, nesting, and read limit
+  // check that reading it would apply. If all of it lies in this pointer's segment, with no far
+  // pointers, returns its total size; the pointer may then be read through getRootUnchecked(),
+  // which skips those checks. Otherwise -- including when the target is malformed -- returns
+  // null, and the caller should fall back to a checked copy, which will report any errors.
+
+  kj::Maybe<FlatPointerTarget> getFlatTarget() const;
+  // If the target is a non-empty struct or list which, together with everything it points to,
+  // exactly fills a single contiguous run of words in one segment (as is usually the case for
+  // messages written by a MessageBuilder and then read back off the wire), returns a description
+  // of that run which can be passed to PointerBuilder::copyFromFlat().  Otherwise -- including
+  // when the target is malformed -- returns null, and the caller should fall back to a regular
+  // copy, which will report any errors.  (The exception is a malformed far pointer at the root,
+  // which is reported here, exactly as the regular copy would report it.)  This walks the tree
+  // once, so it is about as expensive as targetSize(), whose result it also provides.
+
   inline bool isNull() const { return getPointerType() == PointerType::NULL_; }
   PointerType getPointerType() const;
 
@@ -541,6 +643,10 @@ public:
   // copied, meaning there is a risk of data loss when copying from messages built with future
   // versions of the protocol.
 
+  void copyMaskedContentFrom(StructReader other, const StructMask& mask);
+  // Overwrite just the parts of this struct selected by `mask` with those of `other`, leaving the
+  // rest as is.  Selected parts which lie beyond the end of this struct are dropped.
+
   StructReader asReader() const;
   // Gets a StructReader pointing at the same memory.
 
@@ -619,6 +725,11 @@ public:
   // pointer overhead.  This is useful for deciding how much space is needed to copy the struct
   // into a flat array.
 
+  MessageSizeCounts maskedTotalSize(const StructMask& mask) const;
+  // Like totalSize(), but returns the size of a struct holding just the parts of this one selected
+  // by `mask`, as created by PointerBuilder::setStructMasked().  Unlike totalSize(), this counts
+  // against the message's read limit.
+
   CapTableReader* getCapTable();
   // Gets the capability context in which this object is operating.
 
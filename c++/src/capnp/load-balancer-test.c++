@@ -0,0 +1,255 @@
+// Copyright (c) 2026 Cloudflare, Inc. and contributors
+// Licensed under the MIT License:
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "load-balancer.h"
+#include "test-util.h"
+#include <kj/debug.h>
+#include <kj/test.h>
+#include <kj/timer.h>
+#include "rpc-twoparty.h"
+
+namespace capnp {
+namespace _ {
+namespace {
+
+class TestBackend final: public test::TestInterface::Server {
+public:
+  TestBackend(uint id, uint generation, uint& callCount)
+      : id(id), generation(generation), callCount(callCount) {}
+
+  void setError(kj::Exception e) {
+    error = kj::mv(e);
+  }
+
+  kj::Own<kj::PromiseFulfiller<void>> block() {
+    auto paf = kj::newPromiseAndFulfiller<void>();
+    blocker = paf.promise.fork();
+    return kj::mv(paf.fulfiller);
+  }
+
+protected:
+  kj::Promise<void> foo(FooContext context) override {
+    ++callCount;
+    KJ_IF_MAYBE(e, error) {
+      return kj::cp(*e);
+    }
+    context.initResults().setX(kj::str(id, ' ', generation));
+    return blocker.addBranch();
+  }
+
+private:
+  uint id;
+  uint generation;
+  uint& callCount;
+  kj::Maybe<kj::Exception> error;
+  kj::ForkedPromise<void> blocker = kj::Promise<void>(kj::READY_NOW).fork();
+};
+
+struct TestBackends {
+  // Connect functions for `count` backends, which track the server currently representing each
+  // backend and how many times it has been (re)connected.
+
+  static constexpr uint MAX = 4;
+  TestBackend* current[MAX] = {};
+  uint connectCount[MAX] = {};
+  uint callCount[MAX] = {};
+
+  kj::Array<kj::Function<Capability::Client()>> connectFuncs(uint count) {
+    KJ_ASSERT(count <= MAX);
+    auto result = kj::heapArrayBuilder<kj::Function<Capability::Client()>>(count);
+    for (uint i = 0; i < count; i++) {
+      result.add([this, i]() {
+        auto server = kj::heap<TestBackend>(i, connectCount[i]++, callCount[i]);
+        current[i] = server;
+        return test::TestInterface::Client(kj::mv(server));
+      });
+    }
+    return result.finish();
+  }
+};
+
+RemotePromise<test::TestInterface::FooResults> callFoo(test::TestInterface::Client& client) {
+  auto req = client.fooRequest();
+  req.setI(123);
+  req.setJ(true);
+  return req.send();
+}
+
+KJ_TEST("LoadBalancer spreads outstanding calls across backends") {
+  kj::EventLoop loop;
+  kj::WaitScope ws(loop);
+
+  TestBackends backends;
+  LoadBalancer balancer(backends.connectFuncs(3));
+  auto client = balancer.getClient<test::TestInterface>();
+
+  kj::Own<kj::PromiseFulfiller<void>> fulfillers[3];
+  for (uint i = 0; i < 3; i++) {
+    fulfillers[i] = backends.current[i]->block();
+  }
+
+  auto promises = kj::heapArrayBuilder<RemotePromise<test::TestInterface::FooResults>>(6);
+  for (uint i = 0; i < 6; i++) {
+    promises.add(callFoo(client));
+  }
+  for (auto& promise: promises) {
+    KJ_EXPECT(!promise.poll(ws));
+  }
+
+  for (uint i = 0; i < 3; i++) {
+    KJ_EXPECT(balancer.getStats(i).inFlight == 2, i);
+    KJ_EXPECT(backends.callCount[i] == 2, i);
+  }
+
+  for (auto& fulfiller: fulfillers) fulfiller->fulfill();
+  for (auto& promise: promises) promise.wait(ws);
+
+  for (uint i = 0; i < 3; i++) {
+    KJ_EXPECT(balancer.getStats(i).inFlight == 0, i);
+    KJ_EXPECT(!balancer.getStats(i).ejected, i);
+  }
+}
+
+KJ_TEST("LoadBalancer ejects disconnected backends and reconnects them") {
+  kj::EventLoop loop;
+  kj::WaitScope ws(loop);
+  kj::TimerImpl timer(kj::origin<kj::TimePoint>());
+
+  TestBackends backends;
+  LoadBalancerOptions options;
+  options.timer = timer;
+  options.ejectionTime = 10 * kj::SECONDS;
+  LoadBalancer balancer(backends.connectFuncs(2), kj::mv(options));
+  auto client = balancer.getClient<test::TestInterface>();
+
+  // Make backend 0 fail. Ties are broken round-robin starting from backend 0, so that's where
+  // the first call goes.
+  backends.current[0]->setError(KJ_EXCEPTION(DISCONNECTED, "backend 0 disconnected"));
+  KJ_EXPECT_THROW_RECOVERABLE_MESSAGE("backend 0 disconnected",
+      callFoo(client).ignoreResult().wait(ws));
+  KJ_EXPECT(backends.callCount[0] == 1);
+  KJ_EXPECT(balancer.getStats(0).ejected);
+  KJ_EXPECT(backends.connectCount[0] == 2);
+
+  // Even though backend 1 is busy, new calls avoid the ejected backend.
+  auto fulfiller = backends.current[1]->block();
+  auto blocked1 = callFoo(client);
+  auto blocked2 = callFoo(client);
+  KJ_EXPECT(!blocked1.poll(ws));
+  KJ_EXPECT(!blocked2.poll(ws));
+  KJ_EXPECT(backends.callCount[0] == 1);
+  KJ_EXPECT(backends.callCount[1] == 2);
+
+  // After the ejection time, backend 0 -- now reconnected -- is used again.
+  timer.advanceTo(timer.now() + 10 * kj::SECONDS);
+  ws.poll();
+  KJ_EXPECT(!balancer.getStats(0).ejected);
+  KJ_EXPECT(callFoo(client).wait(ws).getX() == "0 1");
+
+  fulfiller->fulfill();
+  KJ_EXPECT(blocked1.wait(ws).getX() == "1 0");
+  KJ_EXPECT(blocked2.wait(ws).getX() == "1 0");
+}
+
+KJ_TEST("LoadBalancer keeps tracking calls whose callers only use the pipeline") {
+  kj::EventLoop loop;
+  kj::WaitScope ws(loop);
+
+  TestBackends backends;
+  LoadBalancer balancer(backends.connectFuncs(1));
+  auto client = balancer.getClient<test::TestInterface>();
+
+  auto fulfiller = backends.current[0]->block();
+  test::TestInterface::FooResults::Pipeline pipeline = callFoo(client);
+  ws.poll();
+  KJ_EXPECT(balancer.getStats(0).inFlight == 1);
+
+  // Nobody is waiting for the response, but its failure is still noticed.
+  fulfiller->reject(KJ_EXCEPTION(DISCONNECTED, "backend 0 disconnected"));
+  ws.poll();
+  KJ_EXPECT(balancer.getStats(0).inFlight == 0);
+  KJ_EXPECT(balancer.getStats(0).ejected);
+}
+
+KJ_TEST("LoadBalancer uses ejected backends as a last resort") {
+  kj::EventLoop loop;
+  kj::WaitScope ws(loop);
+
+  TestBackends backends;
+  LoadBalancer balancer(backends.connectFuncs(1));
+  auto client = balancer.getClient<test::TestInterface>();
+
+  backends.current[0]->setError(KJ_EXCEPTION(DISCONNECTED, "backend 0 disconnected"));
+  KJ_EXPECT_THROW_RECOVERABLE_MESSAGE("backend 0 disconnected",
+      callFoo(client).ignoreResult().wait(ws));
+  KJ_EXPECT(balancer.getStats(0).ejected);
+
+  // With no timer, a successful call readmits the backend.
+  KJ_EXPECT(callFoo(client).wait(ws).getX() == "0 1");
+  KJ_EXPECT(!balancer.getStats(0).ejected);
+  KJ_EXPECT(balancer.getStats(0).latency > 0 * kj::NANOSECONDS);
+}
+
+KJ_TEST("LoadBalancer power-of-two-choices through RPC") {
+  kj::EventLoop loop;
+  kj::WaitScope ws(loop);
+
+  TestBackends backends;
+  LoadBalancerOptions options;
+  options.policy = LoadBalancePolicy::POWER_OF_TWO_CHOICES;
+  LoadBalancer balancer(backends.connectFuncs(4), kj::mv(options));
+
+  // Serve the balanced capability over RPC, so that calls arrive through call() rather than
+  // newCall().
+  auto pipe = kj::newTwoWayPipe();
+  TwoPartyClient client(*pipe.ends[0]);
+  TwoPartyClient server(*pipe.ends[1], balancer.getClient(), rpc::twoparty::Side::SERVER);
+  auto cap = client.bootstrap().castAs<test::TestInterface>();
+
+  kj::Own<kj::PromiseFulfiller<void>> fulfillers[4];
+  for (uint i = 0; i < 4; i++) {
+    fulfillers[i] = backends.current[i]->block();
+  }
+
+  auto promises = kj::heapArrayBuilder<RemotePromise<test::TestInterface::FooResults>>(40);
+  for (uint i = 0; i < 40; i++) {
+    promises.add(callFoo(cap));
+  }
+  for (auto& promise: promises) {
+    KJ_EXPECT(!promise.poll(ws));
+  }
+
+  // Load shouldn't be perfectly balanced, but no backend should be starved or swamped.
+  uint total = 0;
+  for (uint i = 0; i < 4; i++) {
+    KJ_EXPECT(backends.callCount[i] >= 5 && backends.callCount[i] <= 15, backends.callCount[i]);
+    KJ_EXPECT(balancer.getStats(i).inFlight == backends.callCount[i]);
+    total += backends.callCount[i];
+  }
+  KJ_EXPECT(total == 40);
+
+  for (auto& fulfiller: fulfillers) fulfiller->fulfill();
+  for (auto& promise: promises) promise.wait(ws);
+}
+
+}  // namespace
+}  // namespace _
+}  // namespace capnp
@@ -0,0 +1,374 @@
+// Copyright (c) 2026 Cloudflare, Inc. and contributors
+// Licensed under the MIT License:
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "load-balancer.h"
+#include "reconnect.h"
+#include <kj/debug.h>
+#include <kj/timer.h>
+
+namespace capnp {
+
+class LoadBalancer::Impl final: public ClientHook, public kj::Refcounted {
+public:
+  Impl(kj::Array<kj::Function<Capability::Client()>> connectFuncs, LoadBalancerOptions options)
+      : options(kj::mv(options)), randomState(this->options.randomSeed | 1),
+        backends(KJ_MAP(connect, connectFuncs) {
+          return Backend(ClientHook::from(autoReconnect(kj::mv(connect))));
+        }) {
+    KJ_REQUIRE(backends.size() > 0, "LoadBalancer needs at least one backend.");
+    KJ_REQUIRE(this->options.latencyWeight > 0 && this->options.latencyWeight <= 1,
+               "latencyWeight must be in (0, 1].", this->options.latencyWeight);
+  }
+
+  uint size() const { return backends.size(); }
+
+  LoadBalancer::BackendStats getStats(uint index) const {
+    KJ_REQUIRE(index < backends.size(), "backend index out-of-range", index);
+    auto& backend = backends[index];
+    return { backend.inFlight, backend.latency, backend.ejected };
+  }
+
+  Request<AnyPointer, AnyPointer> newCall(
+      uint64_t interfaceId, uint16_t methodId, kj::Maybe<MessageSize> sizeHint,
+      CallHints hints) override {
+    uint index = choose();
+    auto result = backends[index].cap->newCall(interfaceId, methodId, sizeHint, hints);
+    AnyPointer::Builder builder = result;
+    auto hook = kj::heap<RequestImpl>(kj::addRef(*this), index,
+                                      RequestHook::from(kj::mv(result)));
+    return { builder, kj::mv(hook) };
+  }
+
+  VoidPromiseAndPipeline call(uint64_t interfaceId, uint16_t methodId,
+                              kj::Own<CallContextHook>&& context, CallHints hints) override {
+    uint index = choose();
+    auto result = backends[index].cap->call(interfaceId, methodId, kj::mv(context), hints);
+    if (!hints.onlyPromisePipeline) {
+      track(result.promise, index);
+      auto forked = result.promise.fork();
+      result.promise = forked.addBranch();
+      result.pipeline = kj::refcounted<TrackedPipeline<void>>(kj::mv(result.pipeline),
+                                                                 kj::mv(forked));
+    }
+    return result;
+  }
+
+  kj::Maybe<ClientHook&> getResolved() override {
+    // Every call may go to a different backend, so we never resolve to any one of them.
+    return nullptr;
+  }
+
+  kj::Maybe<kj::Promise<kj::Own<ClientHook>>> whenMoreResolved() override {
+    return nullptr;
+  }
+
+  kj::Own<ClientHook> addRef() override {
+    return kj::addRef(*this);
+  }
+
+  const void* getBrand() override {
+    return nullptr;
+  }
+
+  kj::Maybe<int> getFd() override {
+    return nullptr;
+  }
+
+private:
+  struct Backend {
+    explicit Backend(kj::Own<ClientHook> cap): cap(kj::mv(cap)) {}
+
+    kj::Own<ClientHook> cap;
+    uint inFlight = 0;
+    kj::Duration latency = 0 * kj::NANOSECONDS;
+    bool ejected = false;
+    kj::Maybe<kj::Promise<void>> readmitTask;
+  };
+
+  LoadBalancerOptions options;
+  uint64_t randomState;
+  kj::Array<Backend> backends;
+  uint nextIndex = 0;
+
+  uint64_t random() {
+    // xorshift64*
+    randomState ^= randomState >> 12;
+    randomState ^= randomState << 25;
+    randomState ^= randomState >> 27;
+    return randomState * 0x2545f4914f6cdd1dull;
+  }
+
+  double cost(const Backend& backend) {
+    // Backends which haven't completed a call yet are treated as having a latency of 1ns, i.e.
+    // effectively zero, so that they get tried.
+    return (backend.inFlight + 1.0) * kj::max(backend.latency / kj::NANOSECONDS, 1);
+  }
+
+  bool better(const Backend& a, const Backend& b) {
+    switch (options.policy) {
+      case LoadBalancePolicy::LEAST_OUTSTANDING:
+        return a.inFlight < b.inFlight ||
+               (a.inFlight == b.inFlight && a.latency < b.latency);
+      case LoadBalancePolicy::POWER_OF_TWO_CHOICES:
+        return cost(a) < cost(b);
+    }
+    KJ_UNREACHABLE;
+  }
+
+  uint choose() {
+    uint healthy = 0;
+    for (auto& backend: backends) {
+      if (!backend.ejected) ++healthy;
+    }
+
+    // If every backend is ejected, fall back to choosing among all of them.
+    bool includeEjected = healthy == 0;
+    uint candidates = includeEjected ? backends.size() : healthy;
+
+    auto nthCandidate = [&](uint n) -> uint {
+      for (uint i: kj::indices(backends)) {
+        if (includeEjected || !backends[i].ejected) {
+          if (n-- == 0) return i;
+        }
+      }
+      KJ_UNREACHABLE;
+    };
+
+    if (options.policy == LoadBalancePolicy::POWER_OF_TWO_CHOICES && candidates > 2) {
+      uint a = random() % candidates;
+      uint b = random() % (candidates - 1);
+      if (b >= a) ++b;
+      uint i = nthCandidate(a);
+      uint j = nthCandidate(b);
+      return better(backends[j], backends[i]) ? j : i;
+    }
+
+    // Scan all candidates, starting from a rotating position so that ties are broken round-robin.
+    uint start = nextIndex++ % candidates;
+    uint best = nthCandidate(start);
+    for (uint n = 1; n < candidates; n++) {
+      uint i = nthCandidate((start + n) % candidates);
+      if (better(backends[i], backends[best])) best = i;
+    }
+    return best;
+  }
+
+  void eject(uint index) {
+    auto& backend = backends[index];
+    backend.ejected = true;
+    KJ_IF_MAYBE(timer, options.timer) {
+      backend.readmitTask = timer->afterDelay(options.ejectionTime).then([this, index]() {
+        backends[index].ejected = false;
+      }).eagerlyEvaluate(nullptr);
+    }
+  }
+
+  void readmit(uint index) {
+    auto& backend = backends[index];
+    backend.ejected = false;
+    backend.readmitTask = nullptr;
+  }
+
+  class CallTracker {
+    // Counts a call as in flight for as long as it exists, and records the call's outcome.
+
+  public:
+    CallTracker(kj::Own<Impl> parent, uint index)
+        : parent(kj::mv(parent)), index(index),
+          startTime(kj::systemPreciseMonotonicClock().now()) {
+      ++this->parent->backends[index].inFlight;
+    }
+    ~CallTracker() noexcept(false) {
+      finish();
+    }
+    KJ_DISALLOW_COPY_AND_MOVE(CallTracker);
+
+    void succeeded() {
+      if (finish()) {
+        auto& backend = parent->backends[index];
+        auto sample = kj::systemPreciseMonotonicClock().now() - startTime;
+        if (backend.latency == 0 * kj::NANOSECONDS) {
+          backend.latency = sample;
+        } else {
+          backend.latency += static_cast<int64_t>(parent->options.latencyWeight *
+              ((sample - backend.latency) / kj::NANOSECONDS)) * kj::NANOSECONDS;
+        }
+        if (backend.ejected) parent->readmit(index);
+      }
+    }
+
+    void failed(const kj::Exception& exception) {
+      if (finish() && exception.getType() == kj::Exception::Type::DISCONNECTED) {
+        // autoReconnect() will already have started reconnecting; stop routing calls here until
+        // that has had a chance to complete.
+        parent->eject(index);
+      }
+    }
+
+  private:
+    kj::Own<Impl> parent;
+    uint index;
+    kj::TimePoint startTime;
+    bool done = false;
+
+    bool finish() {
+      if (done) return false;
+      done = true;
+      --parent->backends[index].inFlight;
+      return true;
+    }
+  };
+
+  template <typename T>
+  void track(kj::Promise<T>& promise, uint index) {
+    auto tracker = kj::heap<CallTracker>(kj::addRef(*this), index);
+    auto& trackerRef = *tracker;
+    promise = promise.then([&trackerRef](T&& value) -> kj::Promise<T> {
+      trackerRef.succeeded();
+      return kj::mv(value);
+    }, [&trackerRef](kj::Exception&& exception) -> kj::Promise<T> {
+      trackerRef.failed(exception);
+      return kj::mv(exception);
+    }).attach(kj::mv(tracker));
+  }
+
+  void track(kj::Promise<void>& promise, uint index) {
+    auto tracker = kj::heap<CallTracker>(kj::addRef(*this), index);
+    auto& trackerRef = *tracker;
+    promise = promise.then([&trackerRef]() -> kj::Promise<void> {
+      trackerRef.succeeded();
+      return kj::READY_NOW;
+    }, [&trackerRef](kj::Exception&& exception) -> kj::Promise<void> {
+      trackerRef.failed(exception);
+      return kj::mv(exception);
+    }).attach(kj::mv(tracker));
+  }
+
+  template <typename T>
+  class TrackedPipeline final: public PipelineHook, public kj::Refcounted {
+    // A tracked call's pipeline, which keeps the tracking going even if the caller drops the
+    // promise and only uses the pipeline. Otherwise the call would stop counting as in flight, and
+    // a disconnect would go unnoticed.
+
+  public:
+    TrackedPipeline(kj::Own<PipelineHook> inner, kj::ForkedPromise<T> tracked)
+        : inner(kj::mv(inner)), tracked(kj::mv(tracked)) {}
+
+    kj::Own<PipelineHook> addRef() override {
+      return kj::addRef(*this);
+    }
+
+    kj::Own<ClientHook> getPipelinedCap(kj::ArrayPtr<const PipelineOp> ops) override {
+      return inner->getPipelinedCap(ops);
+    }
+
+    kj::Own<ClientHook> getPipelinedCap(kj::Array<PipelineOp>&& ops) override {
+      return inner->getPipelinedCap(kj::mv(ops));
+    }
+
+  private:
+    kj::Own<PipelineHook> inner;
+    kj::ForkedPromise<T> tracked;
+  };
+
+  class SharedResponse final: public ResponseHook, public kj::Refcounted {
+    // Lets a response be forked, so that both the caller and a TrackedPipeline can wait for it.
+
+  public:
+    explicit SharedResponse(Response<AnyPointer>&& response): response(kj::mv(response)) {}
+
+    kj::Own<SharedResponse> addRef() {
+      return kj::addRef(*this);
+    }
+
+    Response<AnyPointer> response;
+  };
+
+  class RequestImpl final: public RequestHook {
+  public:
+    RequestImpl(kj::Own<Impl> parent, uint index, kj::Own<RequestHook> inner)
+        : parent(kj::mv(parent)), index(index), inner(kj::mv(inner)) {}
+
+    RemotePromise<AnyPointer> send() override {
+      auto result = inner->send();
+      kj::Promise<Response<AnyPointer>> promise = kj::mv(result);
+      parent->track(promise, index);
+
+      auto forked = promise.then([](Response<AnyPointer>&& response) {
+        return kj::refcounted<SharedResponse>(kj::mv(response));
+      }).fork();
+      auto response = forked.addBranch().then([](kj::Own<SharedResponse>&& shared) {
+        AnyPointer::Reader reader = shared->response;
+        return Response<AnyPointer>(reader, kj::mv(shared));
+      });
+      auto pipeline = kj::refcounted<TrackedPipeline<kj::Own<SharedResponse>>>(
+          PipelineHook::from(AnyPointer::Pipeline(kj::mv(result))), kj::mv(forked));
+      return RemotePromise<AnyPointer>(kj::mv(response), AnyPointer::Pipeline(kj::mv(pipeline)));
+    }
+
+    kj::Promise<void> sendStreaming() override {
+      auto result = inner->sendStreaming();
+      parent->track(result, index);
+      return result;
+    }
+
+    AnyPointer::Pipeline sendForPipeline() override {
+      return inner->sendForPipeline();
+    }
+
+    const void* getBrand() override {
+      return nullptr;
+    }
+
+    void setDeadline(kj::TimePoint deadline) override {
+      inner->setDeadline(deadline);
+    }
+
+    void setTraceContext(const TraceContext& context) override {
+      inner->setTraceContext(context);
+    }
+
+  private:
+    kj::Own<Impl> parent;
+    uint index;
+    kj::Own<RequestHook> inner;
+  };
+};
+
+LoadBalancer::LoadBalancer(kj::Array<kj::Function<Capability::Client()>> connectFuncs,
+                           LoadBalancerOptions options)
+    : impl(kj::refcounted<Impl>(kj::mv(connectFuncs), kj::mv(options))) {}
+
+LoadBalancer::~LoadBalancer() noexcept(false) {}
+
+Capability::Client LoadBalancer::getClientInternal() {
+  return Capability::Client(impl->addRef());
+}
+
+uint LoadBalancer::size() const {
+  return impl->size();
+}
+
+LoadBalancer::BackendStats LoadBalancer::getStats(uint index) const {
+  return impl->getStats(index);
+}
+
+}  // namespace capnp
@@ -0,0 +1,124 @@
+// Copyright (c) 2026 Cloudflare, Inc. and contributors
+// Licensed under the MIT License:
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <capnp/capability.h>
+#include <kj/function.h>
+#include <kj/time.h>
+
+CAPNP_BEGIN_HEADER
+
+namespace kj {
+  class Timer;
+}
+
+namespace capnp {
+
+enum class LoadBalancePolicy: uint8_t {
+  LEAST_OUTSTANDING,
+  // Send each call to the backend with the fewest calls in flight, breaking ties in favor of the
+  // lowest latency.
+
+  POWER_OF_TWO_CHOICES
+  // Pick two backends at random and send the call to the one with the lower expected cost, where
+  // cost is (calls in flight + 1) * latency. This avoids herding onto whichever backend briefly
+  // looks best when many clients balance over the same set of backends.
+};
+
+struct LoadBalancerOptions {
+  LoadBalancePolicy policy = LoadBalancePolicy::LEAST_OUTSTANDING;
+
+  double latencyWeight = 0.3;
+  // Weight given to each new sample when updating a backend's latency EWMA. Must be in (0, 1].
+
+  kj::Maybe<kj::Timer&> timer;
+  kj::Duration ejectionTime = 10 * kj::SECONDS;
+  // A backend whose call fails with a DISCONNECTED exception is ejected: new calls are not routed
+  // to it while it reconnects. If `timer` is provided, the backend is readmitted `ejectionTime`
+  // later. In any case, it is readmitted as soon as a call to it succeeds, which can happen if
+  // every backend is ejected, since ejected backends are then used as a last resort.
+
+  uint64_t randomSeed = 0x9e3779b97f4a7c15ull;
+  // Seed for the random choices made by POWER_OF_TWO_CHOICES.
+};
+
+class LoadBalancer {
+  // Spreads calls across a set of equivalent backend capabilities.
+  //
+  // Each backend is given as a function which connects to it, and is wrapped with
+  // `autoReconnect()` (see reconnect.h), so a backend which becomes disconnected is reconnected
+  // automatically. As with `autoReconnect()`, calls which are in flight when a backend becomes
+  // disconnected fail with DISCONNECTED exceptions, and the caller should retry them -- the
+  // retry will be routed to a different backend.
+  //
+  // Example usage might look like:
+  //
+  //     auto connectFuncs = kj::heapArrayBuilder<kj::Function<Capability::Client()>>(n);
+  //     for (auto& addr: backendAddrs) {
+  //       connectFuncs.add([&]() { return connectTo(addr).castAs<Foo>(); });
+  //     }
+  //     LoadBalancer balancer(connectFuncs.finish());
+  //     Foo::Client foo = balancer.getClient<Foo>();
+
+public:
+  explicit LoadBalancer(kj::Array<kj::Function<Capability::Client()>> connectFuncs,
+                        LoadBalancerOptions options = LoadBalancerOptions());
+  KJ_DISALLOW_COPY_AND_MOVE(LoadBalancer);
+  ~LoadBalancer() noexcept(false);
+
+  template <typename T = Capability>
+  typename T::Client getClient();
+  // Get a capability which routes each call to one of the backends. The capability remains usable
+  // after the LoadBalancer is destroyed.
+
+  struct BackendStats {
+    uint inFlight;
+    // Number of calls currently outstanding.
+
+    kj::Duration latency;
+    // Exponentially-weighted moving average of the time from sending a call to receiving its
+    // result. Zero until the first call completes.
+
+    bool ejected;
+  };
+
+  uint size() const;
+  BackendStats getStats(uint index) const;
+
+private:
+  class Impl;
+  kj::Own<Impl> impl;
+
+  Capability::Client getClientInternal();
+};
+
+// =======================================================================================
+// inline implementation details
+
+template <typename T>
+inline typename T::Client LoadBalancer::getClient() {
+  return getClientInternal().castAs<T>();
+}
+
+}  // namespace capnp
+
+CAPNP_END_HEADER
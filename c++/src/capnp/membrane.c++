@@ -240,6 +240,14 @@ public:
     return MEMBRANE_BRAND;
   }
 
+  void setDeadline(kj::TimePoint deadline) override {
+    inner->setDeadline(deadline);
+  }
+
+  void setTraceContext(const TraceContext& context) override {
+    inner->setTraceContext(context);
+  }
+
 private:
   kj::Own<RequestHook> inner;
   kj::Own<MembranePolicy> policy;
@@ -312,6 +320,14 @@ public:
     return kj::addRef(*this);
   }
 
+  kj::Maybe<kj::TimePoint> getDeadline() override {
+    return inner->getDeadline();
+  }
+
+  kj::Maybe<TraceContext> getTraceContext() override {
+    return inner->getTraceContext();
+  }
+
 private:
   kj::Own<CallContextHook> inner;
   kj::Own<MembranePolicy> policy;
@@ -82,6 +82,31 @@ bool MessageReader::isCanonical() {
   return rootIsCanonical && allWordsConsumed;
 }
 
+ValidatedMessageReader::ValidatedMessageReader(MessageReader& message) {
+  auto rootReader = message.getRootInternal();
+  auto internal = _::PointerHelpers<AnyPointer>::getInternalReader(rootReader);
+
+  // getRootInternal() checked that segment zero exists and holds the root pointer.
+  if (message.arena()->tryGetSegment(_::SegmentId(1)) == nullptr) {
+    KJ_IF_MAYBE(size, internal.validateForUncheckedRead()) {
+      KJ_REQUIRE(size->capCount == 0,
+                 "ValidatedMessageReader doesn't support messages containing capabilities.");
+      root = message.arena()->tryGetSegment(_::SegmentId(0))->getStartPtr();
+      return;
+    }
+  }
+
+  // Multiple segments, far pointers, or invalid. Make a flat copy, which performs all the usual
+  // checks along the way.
+  auto size = rootReader.targetSize();
+  KJ_REQUIRE(size.capCount == 0,
+             "ValidatedMessageReader doesn't support messages containing capabilities.");
+  copy = kj::heapArray<word>(size.wordCount + 1);
+  memset(copy.begin(), 0, copy.asBytes().size());
+  copyToUnchecked(rootReader, copy);
+  root = copy.begin();
+}
+
 size_t MessageReader::sizeInWords() {
   return arena()->sizeInWords();
 }
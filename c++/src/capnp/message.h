@@ -142,6 +142,8 @@ private:
 
   _::ReaderArena* arena() { return reinterpret_cast<_::ReaderArena*>(arenaSpace); }
   AnyPointer::Reader getRootInternal();
+
+  friend class ValidatedMessageReader;
 };
 
 class MessageBuilder {
@@ -299,6 +301,37 @@ void copyToUnchecked(Reader&& reader, kj::ArrayPtr<word> uncheckedBuffer);
 // readMessageUnchecked().  The buffer's size must be exactly reader.totalSizeInWords() + 1,
 // otherwise an exception will be thrown.  The buffer must be zero'd before calling.
 
+class ValidatedMessageReader {
+  // Validates an entire message once, up front, and then provides readers which skip the bounds
+  // checks, far pointer handling, and read limit accounting that MessageReader applies on every
+  // access.  This is useful for messages which arrive from an untrusted source but are then
+  // traversed deeply or repeatedly:  the validation costs about as much as a single traversal.
+  //
+  // If the message is a single segment with no far pointers -- as messages written by a
+  // MallocMessageBuilder usually are -- the readers point directly into the original message, so
+  // the MessageReader must outlive this object and any readers obtained from it.  Otherwise, the
+  // message is copied once into a flat buffer owned by this object.
+  //
+  // Messages containing capabilities are not supported.
+
+public:
+  explicit ValidatedMessageReader(MessageReader& message);
+  // Validates `message` against its ReaderOptions.  Throws an exception if it is invalid.
+
+  template <typename RootType>
+  typename RootType::Reader getRoot();
+
+  template <typename RootType, typename SchemaType>
+  typename RootType::Reader getRoot(SchemaType schema);
+
+  inline bool isCopy() const { return copy != nullptr; }
+  // True if the message had to be copied because it wasn't flat.
+
+private:
+  const word* root;
+  kj::Array<word> copy;
+};
+
 template <typename RootType>
 typename RootType::Reader readDataStruct(kj::ArrayPtr<const word> data);
 // Interprets the given data as a single, data-only struct. Only primitive fields (booleans,
@@ -503,6 +536,16 @@ void copyToUnchecked(Reader&& reader, kj::ArrayPtr<word> uncheckedBuffer) {
   builder.requireFilled();
 }
 
+template <typename RootType>
+inline typename RootType::Reader ValidatedMessageReader::getRoot() {
+  return readMessageUnchecked<RootType>(root);
+}
+
+template <typename RootType, typename SchemaType>
+inline typename RootType::Reader ValidatedMessageReader::getRoot(SchemaType schema) {
+  return AnyPointer::Reader(_::PointerReader::getRootUnchecked(root)).getAs<RootType>(schema);
+}
+
 template <typename RootType>
 typename RootType::Reader readDataStruct(kj::ArrayPtr<const word> data) {
   return typename RootType::Reader(_::StructReader(data));
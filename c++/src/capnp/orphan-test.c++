@@ -21,6 +21,7 @@
 
 #include "message.h"
 #include <kj/debug.h>
+#include <kj/vector.h>
 #include <kj/compat/gtest.h>
 #include "test-util.h"
 
@@ -1747,6 +1748,113 @@ TEST(Orphans, ConcatenateStructListsUpgradeFromPrimitive) {
   EXPECT_FALSE(cat[3].hasOld2());
 }
 
+KJ_TEST("GrowableList of primitives grows in place") {
+  MallocMessageBuilder builder;
+  auto root = builder.initRoot<TestAllTypes>();
+
+  GrowableList<uint32_t> growable(builder.getOrphanage(), 1);
+  for (uint i: kj::zeroTo(1000)) {
+    growable.add(i * 3);
+  }
+  KJ_EXPECT(growable.size() == 1000);
+  KJ_EXPECT(growable.capacity() == 1024);
+  KJ_EXPECT(growable[999] == 2997);
+  root.adoptUInt32List(growable.finish());
+
+  auto list = root.asReader().getUInt32List();
+  KJ_ASSERT(list.size() == 1000);
+  for (uint i: kj::zeroTo(1000)) {
+    KJ_EXPECT(list[i] == i * 3);
+  }
+
+  // Nothing else was allocated while the list grew, so it was always at the end of the segment
+  // and the message is exactly as big as if the list had been allocated at its final size.
+  MallocMessageBuilder expected;
+  expected.initRoot<TestAllTypes>().initUInt32List(1000);
+  KJ_EXPECT(builder.sizeInWords() == expected.sizeInWords());
+}
+
+KJ_TEST("GrowableList of structs relocates") {
+  MallocMessageBuilder builder;
+  auto root = builder.initRoot<TestAllTypes>();
+
+  // Each element allocates text after the list, so growing has to move the list.
+  GrowableList<TestAllTypes> growable(builder.getOrphanage(), 2);
+  for (uint i: kj::zeroTo(100)) {
+    auto element = growable.add();
+    element.setInt32Field(i);
+    element.setTextField(kj::str("item", i));
+  }
+  growable[5].setUInt8Field(5);
+  root.adoptStructList(growable.finish());
+
+  auto list = root.asReader().getStructList();
+  KJ_ASSERT(list.size() == 100);
+  for (uint i: kj::zeroTo(100)) {
+    KJ_EXPECT(list[i].getInt32Field() == i);
+    KJ_EXPECT(list[i].getTextField() == kj::str("item", i));
+  }
+  KJ_EXPECT(list[5].getUInt8Field() == 5);
+}
+
+KJ_TEST("GrowableList of blobs and lists") {
+  MallocMessageBuilder builder;
+  auto root = builder.initRoot<TestAllTypes>();
+
+  GrowableList<Text> texts(builder.getOrphanage());
+  texts.add("foo");
+  memcpy(texts.add(3).begin(), "bar", 3);
+  texts.add(Text::Reader("baz"));
+  root.adoptTextList(texts.finish());
+  KJ_EXPECT(root.asReader().getTextList().size() == 3);
+  KJ_EXPECT(root.asReader().getTextList()[0] == "foo");
+  KJ_EXPECT(root.asReader().getTextList()[1] == "bar");
+  KJ_EXPECT(root.asReader().getTextList()[2] == "baz");
+
+  GrowableList<List<int32_t>> lists(builder.getOrphanage(), 1);
+  lists.add(2).set(1, 123);
+  root.setInt32List({4, 5, 6});
+  lists.add(root.asReader().getInt32List());
+  auto orphan = lists.finish();
+  auto reader = orphan.getReader();
+  KJ_ASSERT(reader.size() == 2);
+  KJ_EXPECT(reader[0].size() == 2);
+  KJ_EXPECT(reader[0][1] == 123);
+  KJ_EXPECT(reader[1].size() == 3);
+  KJ_EXPECT(reader[1][2] == 6);
+
+  // An empty GrowableList finishes as an empty list.
+  GrowableList<bool> bools(builder.getOrphanage());
+  KJ_EXPECT(bools.finish().getReader().size() == 0);
+}
+
+KJ_TEST("benchmark: GrowableList vs. kj::Vector then copy") {
+  constexpr uint COUNT = 10000;
+
+  doBenchmark([&]() {
+    MallocMessageBuilder builder;
+    auto root = builder.initRoot<TestAllTypes>();
+    GrowableList<uint64_t> growable(builder.getOrphanage());
+    for (uint i: kj::zeroTo(COUNT)) {
+      growable.add(i);
+    }
+    root.adoptUInt64List(growable.finish());
+  });
+
+  doBenchmark([&]() {
+    MallocMessageBuilder builder;
+    auto root = builder.initRoot<TestAllTypes>();
+    kj::Vector<uint64_t> vector;
+    for (uint i: kj::zeroTo(COUNT)) {
+      vector.add(i);
+    }
+    auto list = root.initUInt64List(vector.size());
+    for (uint i: kj::indices(vector)) {
+      list.set(i, vector[i]);
+    }
+  });
+}
+
 }  // namespace
 }  // namespace _ (private)
 }  // namespace capnp
@@ -190,6 +190,62 @@ private:
   friend struct _::OrphanageInternal;
 };
 
+template <typename T>
+class GrowableList {
+  // Builds a List<T> whose final length isn't known up front, one element at a time.
+  //
+  // The list is allocated as an orphan with some spare capacity. When it fills up, the capacity
+  // is doubled using Orphan::truncate(), so appending is amortized constant-time. If the list is
+  // still the last object in its segment (nothing else has been allocated since it last grew) and
+  // the segment has room, it grows in place; otherwise it is moved, leaving a zero'd hole behind.
+  // The total space wasted this way is bounded by the final list size.
+  // finish() trims the spare capacity, reclaiming it if the list is at the end of its segment.
+  //
+  // This replaces the pattern of collecting elements into a kj::Vector and then copying them into
+  // a list of the right size, which needs both a temporary buffer and a second pass.
+  //
+  // As with Orphan::truncate(), builders obtained from add() or operator[] are invalidated by the
+  // next call that grows the list.
+
+public:
+  explicit GrowableList(Orphanage orphanage, uint initialCapacity = 8);
+  KJ_DISALLOW_COPY(GrowableList);
+  GrowableList(GrowableList&&) = default;
+  GrowableList& operator=(GrowableList&&) = default;
+
+  inline uint size() const { return count; }
+  inline uint capacity() const { return list.size(); }
+
+  template <typename U = T, typename = kj::EnableIf<CAPNP_KIND(U) == Kind::STRUCT>>
+  BuilderFor<T> add();
+  // Append a default-initialized struct and return a builder for it.
+
+  template <typename U = T, typename = kj::EnableIf<CAPNP_KIND(U) != Kind::STRUCT>>
+  void add(ReaderFor<U> value);
+  // Append a copy of `value`.
+
+  template <typename U = T, typename = kj::EnableIf<
+      CAPNP_KIND(U) == Kind::BLOB || CAPNP_KIND(U) == Kind::LIST>>
+  BuilderFor<T> add(uint size);
+  // Append a new blob or list of the given size and return a builder for it.
+
+  inline auto operator[](uint index) {
+    KJ_IREQUIRE(index < count);
+    return list[index];
+  }
+
+  Orphan<List<T>> finish();
+  // Trim the list to its current size and return it, ready to be adopted. The GrowableList must
+  // not be used afterwards.
+
+private:
+  Orphan<List<T>> orphan;
+  typename List<T>::Builder list;
+  uint count = 0;
+
+  uint reserveOne();
+};
+
 // =======================================================================================
 // Inline implementation details.
 
@@ -432,6 +488,48 @@ inline Orphan<Data> Orphanage::referenceExternalData(Data::Reader data) const {
   return Orphan<Data>(_::OrphanBuilder::referenceExternalData(arena, data));
 }
 
+template <typename T>
+GrowableList<T>::GrowableList(Orphanage orphanage, uint initialCapacity)
+    : orphan(orphanage.newOrphan<List<T>>(kj::max(initialCapacity, 1u))),
+      list(orphan.get()) {}
+
+template <typename T>
+uint GrowableList<T>::reserveOne() {
+  if (count == list.size()) {
+    // Past half the maximum list size, grow one element at a time so that truncate() reports
+    // the overflow only once the list is really full.
+    constexpr uint MAX_SIZE = kj::maxValueForBits<LIST_ELEMENT_COUNT_BITS>();
+    orphan.truncate(count <= MAX_SIZE / 2 ? count * 2 : count + 1);
+    list = orphan.get();
+  }
+  return count++;
+}
+
+template <typename T>
+template <typename U, typename>
+BuilderFor<T> GrowableList<T>::add() {
+  return list[reserveOne()];
+}
+
+template <typename T>
+template <typename U, typename>
+void GrowableList<T>::add(ReaderFor<U> value) {
+  list.set(reserveOne(), value);
+}
+
+template <typename T>
+template <typename U, typename>
+BuilderFor<T> GrowableList<T>::add(uint size) {
+  return list.init(reserveOne(), size);
+}
+
+template <typename T>
+Orphan<List<T>> GrowableList<T>::finish() {
+  orphan.truncate(count);
+  list = nullptr;
+  return kj::mv(orphan);
+}
+
 }  // namespace capnp
 
 CAPNP_END_HEADER
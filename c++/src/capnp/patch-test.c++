@@ -0,0 +1,226 @@
+// Copyright (c) 2026 Cloudflare, Inc. and contributors
+// Licensed under the MIT License:
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "patch.h"
+#include "message.h"
+#include <kj/test.h>
+#include "test-util.h"
+
+namespace capnp {
+namespace _ {  // private
+namespace {
+
+bool roundTrip(AnyStruct::Reader oldValue, AnyStruct::Reader newValue,
+               MessageBuilder& patchMessage) {
+  // Diffs `oldValue` against `newValue`, applies the patch to a copy of `oldValue`, and checks
+  // that the result equals `newValue`.
+
+  bool changed = diff(oldValue, newValue, patchMessage.initRoot<StructPatch>());
+
+  MallocMessageBuilder replica;
+  replica.setRoot(oldValue);
+  applyPatch(replica.getRoot<AnyPointer>(), patchMessage.getRoot<StructPatch>().asReader());
+  KJ_EXPECT(replica.getRoot<AnyStruct>().asReader() == newValue);
+
+  return changed;
+}
+
+KJ_TEST("diff and patch") {
+  MallocMessageBuilder oldMessage;
+  initTestMessage(oldMessage.initRoot<TestAllTypes>());
+  auto oldValue = oldMessage.getRoot<TestAllTypes>().asReader();
+
+  MallocMessageBuilder newMessage;
+  newMessage.setRoot(oldValue);
+  auto newValue = newMessage.getRoot<TestAllTypes>();
+  newValue.setInt32Field(1234);
+  newValue.setTextField("changed");
+  newValue.getStructField().setInt8Field(12);
+  newValue.getStructList()[1].setTextField("changed too");
+  newValue.getTextList().set(0, "and this");
+  newValue.setInt32List({1, 2, 3});
+  newValue.disownDataField();
+
+  MallocMessageBuilder patchMessage;
+  KJ_EXPECT(roundTrip(oldValue, newValue.asReader(), patchMessage));
+
+  auto patch = patchMessage.getRoot<StructPatch>().asReader();
+  KJ_EXPECT(patch.getChangedWords().size() == 1);
+  auto pointers = patch.getChangedPointers();
+  KJ_ASSERT(pointers.size() == 6);
+
+  // textField and dataField are replaced.
+  KJ_EXPECT(pointers[0].isReplace());
+  KJ_EXPECT(pointers[0].getReplace().getAs<Text>() == "changed");
+  KJ_EXPECT(pointers[1].isReplace());
+  KJ_EXPECT(pointers[1].getReplace().isNull());
+
+  // structField is patched.
+  KJ_ASSERT(pointers[2].isStruct());
+  KJ_EXPECT(pointers[2].getStruct().getChangedWords().size() == 1);
+  KJ_EXPECT(pointers[2].getStruct().getChangedPointers().size() == 0);
+
+  // int32List, of a different length, is replaced.
+  KJ_EXPECT(pointers[3].isReplace());
+
+  // Just one element of each of textList and structList is patched.
+  KJ_ASSERT(pointers[4].isList());
+  KJ_ASSERT(pointers[4].getList().size() == 1);
+  KJ_EXPECT(pointers[4].getList()[0].getIndex() == 0);
+  KJ_EXPECT(pointers[4].getList()[0].isReplace());
+  KJ_ASSERT(pointers[5].isList());
+  KJ_ASSERT(pointers[5].getList().size() == 1);
+  KJ_EXPECT(pointers[5].getList()[0].getIndex() == 1);
+  KJ_EXPECT(pointers[5].getList()[0].isStruct());
+}
+
+KJ_TEST("diff of equal structs is empty") {
+  MallocMessageBuilder oldMessage;
+  initTestMessage(oldMessage.initRoot<TestAllTypes>());
+  MallocMessageBuilder newMessage;
+  newMessage.setRoot(oldMessage.getRoot<TestAllTypes>().asReader());
+
+  MallocMessageBuilder patchMessage;
+  KJ_EXPECT(!roundTrip(oldMessage.getRoot<TestAllTypes>().asReader(),
+                       newMessage.getRoot<TestAllTypes>().asReader(), patchMessage));
+  auto patch = patchMessage.getRoot<StructPatch>().asReader();
+  KJ_EXPECT(!patch.hasChangedWords());
+  KJ_EXPECT(!patch.hasChangedPointers());
+}
+
+KJ_TEST("patch enlarges and shrinks structs") {
+  MallocMessageBuilder oldMessage;
+  auto oldValue = oldMessage.initRoot<test::TestOldVersion>();
+  oldValue.setOld1(123);
+  oldValue.initOld3().setOld2("foo");
+
+  MallocMessageBuilder newMessage;
+  auto newValue = newMessage.initRoot<test::TestNewVersion>();
+  newValue.setOld1(123);
+  newValue.initOld3().setOld2("foo");
+  newValue.getOld3().setNew2("bar");
+  newValue.setNew1(456);
+
+  {
+    MallocMessageBuilder patchMessage;
+    KJ_EXPECT(roundTrip(oldValue.asReader(), newValue.asReader(), patchMessage));
+  }
+
+  {
+    MallocMessageBuilder patchMessage;
+    KJ_EXPECT(roundTrip(newValue.asReader(), oldValue.asReader(), patchMessage));
+  }
+}
+
+KJ_TEST("patch rejects mismatched targets") {
+  MallocMessageBuilder oldMessage;
+  initTestMessage(oldMessage.initRoot<TestAllTypes>());
+  MallocMessageBuilder newMessage;
+  newMessage.setRoot(oldMessage.getRoot<TestAllTypes>().asReader());
+  newMessage.getRoot<TestAllTypes>().getStructList()[2].setUInt8Field(1);
+
+  MallocMessageBuilder patchMessage;
+  KJ_ASSERT(diff(oldMessage.getRoot<TestAllTypes>().asReader(),
+                 newMessage.getRoot<TestAllTypes>().asReader(),
+                 patchMessage.initRoot<StructPatch>()));
+
+  MallocMessageBuilder target;
+  target.initRoot<TestAllTypes>().initStructList(2);
+  KJ_EXPECT_THROW_MESSAGE("does not fit", applyPatch(target.getRoot<AnyPointer>(),
+      patchMessage.getRoot<StructPatch>().asReader()));
+}
+
+#if !CAPNP_LITE
+KJ_TEST("diff rejects capabilities") {
+  int callCount = 0;
+  MallocMessageBuilder oldMessage;
+  oldMessage.initRoot<test::TestAnyPointer>();
+
+  // A capability which replaces null.
+  MallocMessageBuilder newMessage;
+  newMessage.initRoot<test::TestAnyPointer>().getAnyPointerField()
+      .setAs<test::TestInterface>(kj::heap<TestInterfaceImpl>(callCount));
+  MallocMessageBuilder patchMessage;
+  KJ_EXPECT_THROW_MESSAGE("doesn't support capabilities",
+      diff(oldMessage.getRoot<test::TestAnyPointer>().asReader(),
+           newMessage.getRoot<test::TestAnyPointer>().asReader(),
+           patchMessage.initRoot<StructPatch>()));
+
+  // A capability within an object which replaces another.
+  MallocMessageBuilder nestedMessage;
+  nestedMessage.initRoot<test::TestAnyPointer>().getAnyPointerField()
+      .initAs<test::TestAnyPointer>().getAnyPointerField()
+      .setAs<test::TestInterface>(kj::heap<TestInterfaceImpl>(callCount));
+  oldMessage.getRoot<test::TestAnyPointer>().getAnyPointerField().setAs<Text>("foo");
+  MallocMessageBuilder nestedPatchMessage;
+  KJ_EXPECT_THROW_MESSAGE("doesn't support capabilities",
+      diff(oldMessage.getRoot<test::TestAnyPointer>().asReader(),
+           nestedMessage.getRoot<test::TestAnyPointer>().asReader(),
+           nestedPatchMessage.initRoot<StructPatch>()));
+}
+#endif  // !CAPNP_LITE
+
+KJ_TEST("benchmark: patch vs. full copy") {
+  MallocMessageBuilder oldMessage;
+  auto list = oldMessage.initRoot<TestAllTypes>().initStructList(200);
+  for (auto element: list) {
+    initTestMessage(element);
+  }
+  auto oldValue = oldMessage.getRoot<TestAllTypes>().asReader();
+
+  MallocMessageBuilder newMessage;
+  newMessage.setRoot(oldValue);
+  newMessage.getRoot<TestAllTypes>().getStructList()[100].setInt32Field(1);
+  auto newValue = newMessage.getRoot<TestAllTypes>().asReader();
+
+  MallocMessageBuilder patchMessage;
+  KJ_ASSERT(diff(oldValue, newValue, patchMessage.initRoot<StructPatch>()));
+  auto patch = patchMessage.getRoot<StructPatch>().asReader();
+  KJ_EXPECT(patch.totalSize().wordCount * 100 < newValue.totalSize().wordCount,
+            patch.totalSize().wordCount, newValue.totalSize().wordCount);
+
+  doBenchmark([&]() {
+    for (uint i = 0; i < 10; i++) {
+      MallocMessageBuilder patchMessage;
+      KJ_ASSERT(diff(oldValue, newValue, patchMessage.initRoot<StructPatch>()));
+    }
+  });
+
+  MallocMessageBuilder replica;
+  replica.setRoot(oldValue);
+  doBenchmark([&]() {
+    for (uint i = 0; i < 10; i++) {
+      applyPatch(replica.getRoot<AnyPointer>(), patch);
+    }
+  });
+  KJ_EXPECT(replica.getRoot<AnyStruct>().asReader() == AnyStruct::Reader(newValue));
+
+  doBenchmark([&]() {
+    for (uint i = 0; i < 10; i++) {
+      MallocMessageBuilder copy(newValue.totalSize().wordCount + 1);
+      copy.setRoot(newValue);
+    }
+  });
+}
+
+}  // namespace
+}  // namespace _ (private)
+}  // namespace capnp
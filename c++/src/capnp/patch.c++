@@ -0,0 +1,304 @@
+// Copyright (c) 2026 Cloudflare, Inc. and contributors
+// Licensed under the MIT License:
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "patch.h"
+#include <kj/debug.h>
+#include <kj/vector.h>
+
+namespace capnp {
+
+namespace {
+
+// We first compute the changes into a tree of these, allocated only along paths that actually
+// changed, and then write them out to the patch with every list sized exactly.  Building the patch
+// directly would leave garbage behind in the patch message for every subtree found to be
+// unchanged only after recursing into it.
+
+struct PointerChange;
+
+struct StructChanges {
+  uint16_t dataWordCount;
+  uint16_t pointerCount;
+  kj::Vector<uint16_t> changedWords;
+  kj::Vector<uint64_t> newWords;
+  kj::Vector<PointerChange> changedPointers;
+
+  bool empty() const { return changedWords.empty() && changedPointers.empty(); }
+};
+
+struct PointerChange {
+  uint32_t index;
+  PointerPatch::Which which;
+  _::PointerReader replacement;         // for REPLACE
+  kj::Own<StructChanges> structChanges;  // for STRUCT
+  kj::Vector<PointerChange> elementChanges;  // for LIST
+};
+
+uint64_t getDataWord(kj::ArrayPtr<const byte> data, uint index) {
+  if ((index + 1) * sizeof(uint64_t) > data.size()) return 0;
+  return reinterpret_cast<const _::WireValue<uint64_t>*>(data.begin())[index].get();
+}
+
+void diffPointer(_::PointerReader oldValue, _::PointerReader newValue, uint32_t index,
+                 kj::Vector<PointerChange>& changes);
+
+bool diffStruct(_::StructReader oldValue, _::StructReader newValue, StructChanges& changes) {
+  // Returns true if anything changed.
+
+  uint newDataWords = unbound(newValue.getDataSectionSize() / BITS) / 64;
+  uint newPointers = unbound(newValue.getPointerSectionSize() / POINTERS);
+  changes.dataWordCount = newDataWords;
+  changes.pointerCount = newPointers;
+
+  // Words beyond the end of the new struct must read as zero once patched, as the struct being
+  // patched won't be shrunk.
+  uint dataWords = kj::max(newDataWords, unbound(oldValue.getDataSectionSize() / BITS) / 64);
+  auto oldData = oldValue.getDataSectionAsBlob();
+  auto newData = newValue.getDataSectionAsBlob();
+  for (uint i = 0; i < dataWords; i++) {
+    uint64_t word = getDataWord(newData, i);
+    if (word != getDataWord(oldData, i)) {
+      changes.changedWords.add(i);
+      changes.newWords.add(word);
+    }
+  }
+
+  uint pointers = kj::max(newPointers, unbound(oldValue.getPointerSectionSize() / POINTERS));
+  for (uint i = 0; i < pointers; i++) {
+    diffPointer(oldValue.getPointerField(assumePointerOffset(i)),
+                newValue.getPointerField(assumePointerOffset(i)), i,
+                changes.changedPointers);
+  }
+
+  return !changes.empty();
+}
+
+bool diffList(_::ListReader oldValue, _::ListReader newValue,
+              kj::Vector<PointerChange>& changes) {
+  // Diffs two lists element-by-element, if their length and element size allow. Returns false if
+  // they don't, in which case the whole list must be replaced.
+
+  if (oldValue.size() != newValue.size() ||
+      oldValue.getElementSize() != newValue.getElementSize()) {
+    return false;
+  }
+
+  switch (oldValue.getElementSize()) {
+    case ElementSize::INLINE_COMPOSITE: {
+      if (oldValue.size() == ZERO * ELEMENTS) return true;
+
+      // All elements of a struct list have the same size.
+      _::StructReader oldFirst = oldValue.getStructElement(ZERO * ELEMENTS);
+      _::StructReader newFirst = newValue.getStructElement(ZERO * ELEMENTS);
+      if (oldFirst.getDataSectionSize() != newFirst.getDataSectionSize() ||
+          oldFirst.getPointerSectionSize() != newFirst.getPointerSectionSize()) {
+        return false;
+      }
+
+      for (auto i: kj::zeroTo(oldValue.size())) {
+        StructChanges elementChanges;
+        if (diffStruct(oldValue.getStructElement(i), newValue.getStructElement(i),
+                       elementChanges)) {
+          changes.add(PointerChange { unbound(i / ELEMENTS), PointerPatch::STRUCT, {},
+                                      kj::heap(kj::mv(elementChanges)), {} });
+        }
+      }
+      return true;
+    }
+
+    case ElementSize::POINTER:
+      for (auto i: kj::zeroTo(oldValue.size())) {
+        diffPointer(oldValue.getPointerElement(i), newValue.getPointerElement(i),
+                    unbound(i / ELEMENTS), changes);
+      }
+      return true;
+
+    case ElementSize::VOID:
+    case ElementSize::BIT:
+    case ElementSize::BYTE:
+    case ElementSize::TWO_BYTES:
+    case ElementSize::FOUR_BYTES:
+    case ElementSize::EIGHT_BYTES:
+      // Not worth patching piecemeal; the list is either unchanged or replaced.
+      return oldValue.asRawBytes() == newValue.asRawBytes();
+  }
+  KJ_UNREACHABLE;
+}
+
+void diffPointer(_::PointerReader oldValue, _::PointerReader newValue, uint32_t index,
+                 kj::Vector<PointerChange>& changes) {
+  auto oldType = oldValue.getPointerType();
+  auto newType = newValue.getPointerType();
+
+  if (oldType == PointerType::NULL_ && newType == PointerType::NULL_) {
+    return;
+  } else if (oldType == PointerType::STRUCT && newType == PointerType::STRUCT) {
+    StructChanges structChanges;
+    if (diffStruct(oldValue.getStruct(nullptr), newValue.getStruct(nullptr), structChanges)) {
+      changes.add(PointerChange {
+          index, PointerPatch::STRUCT, {}, kj::heap(kj::mv(structChanges)), {} });
+    }
+    return;
+  } else if (oldType == PointerType::LIST && newType == PointerType::LIST) {
+    kj::Vector<PointerChange> elementChanges;
+    if (diffList(oldValue.getListAnySize(nullptr), newValue.getListAnySize(nullptr),
+                 elementChanges)) {
+      if (!elementChanges.empty()) {
+        changes.add(PointerChange { index, PointerPatch::LIST, {}, {}, kj::mv(elementChanges) });
+      }
+      return;
+    }
+  }
+
+  // A capability is never compared, so every one in `newValue` ends up here, directly or within a
+  // replaced object.
+  KJ_REQUIRE(newValue.targetSize().capCount == 0,
+      "diff() doesn't support capabilities, as a StructPatch has no cap table to carry them");
+
+  changes.add(PointerChange { index, PointerPatch::REPLACE, newValue, {}, {} });
+}
+
+void writePointerChange(PointerChange& change, PointerPatch::Builder patch);
+
+void writeStructChanges(StructChanges& changes, StructPatch::Builder patch) {
+  patch.setDataWordCount(changes.dataWordCount);
+  patch.setPointerCount(changes.pointerCount);
+
+  if (!changes.changedWords.empty()) {
+    patch.setChangedWords(changes.changedWords);
+    patch.setNewWords(changes.newWords);
+  }
+
+  if (!changes.changedPointers.empty()) {
+    auto pointers = patch.initChangedPointers(changes.changedPointers.size());
+    for (auto i: kj::indices(changes.changedPointers)) {
+      writePointerChange(changes.changedPointers[i], pointers[i]);
+    }
+  }
+}
+
+void writePointerChange(PointerChange& change, PointerPatch::Builder patch) {
+  patch.setIndex(change.index);
+  switch (change.which) {
+    case PointerPatch::REPLACE:
+      patch.initReplace().set(AnyPointer::Reader(change.replacement));
+      return;
+    case PointerPatch::STRUCT:
+      writeStructChanges(*change.structChanges, patch.initStruct());
+      return;
+    case PointerPatch::LIST: {
+      auto elements = patch.initList(change.elementChanges.size());
+      for (auto i: kj::indices(change.elementChanges)) {
+        writePointerChange(change.elementChanges[i], elements[i]);
+      }
+      return;
+    }
+  }
+  KJ_UNREACHABLE;
+}
+
+void applyToPointer(_::PointerBuilder target, PointerPatch::Reader patch);
+
+void applyToStruct(_::StructBuilder target, StructPatch::Reader patch) {
+  auto changedWords = patch.getChangedWords();
+  auto newWords = patch.getNewWords();
+  KJ_REQUIRE(changedWords.size() == newWords.size(), "malformed StructPatch");
+
+  auto data = target.getDataSectionAsBlob();
+  auto words = reinterpret_cast<_::WireValue<uint64_t>*>(data.begin());
+  for (auto i: kj::indices(changedWords)) {
+    uint index = changedWords[i];
+    KJ_REQUIRE((index + 1) * sizeof(uint64_t) <= data.size(),
+               "patch does not fit the struct being patched");
+    words[index].set(newWords[i]);
+  }
+
+  uint pointerCount = unbound(target.getPointerSectionSize() / POINTERS);
+  for (auto pointer: patch.getChangedPointers()) {
+    KJ_REQUIRE(pointer.getIndex() < pointerCount, "patch does not fit the struct being patched");
+    applyToPointer(target.getPointerField(assumePointerOffset(pointer.getIndex())), pointer);
+  }
+}
+
+void applyToStructPointer(_::PointerBuilder target, StructPatch::Reader patch) {
+  // Enlarges the struct first, if it is smaller than the new value.
+  applyToStruct(target.getStruct(_::StructSize(
+      bounded(patch.getDataWordCount()) * WORDS,
+      bounded(patch.getPointerCount()) * POINTERS), nullptr), patch);
+}
+
+void applyToPointer(_::PointerBuilder target, PointerPatch::Reader patch) {
+  switch (patch.which()) {
+    case PointerPatch::REPLACE:
+      target.copyFrom(_::PointerHelpers<AnyPointer>::getInternalReader(patch.getReplace()));
+      return;
+
+    case PointerPatch::STRUCT:
+      applyToStructPointer(target, patch.getStruct());
+      return;
+
+    case PointerPatch::LIST: {
+      _::ListBuilder list = target.getListAnySize(nullptr);
+      uint size = unbound(list.size() / ELEMENTS);
+      switch (list.getElementSize()) {
+        case ElementSize::INLINE_COMPOSITE:
+          for (auto element: patch.getList()) {
+            KJ_REQUIRE(element.getIndex() < size && element.isStruct(),
+                       "patch does not fit the list being patched");
+            applyToStruct(list.getStructElement(bounded(element.getIndex()) * ELEMENTS),
+                          element.getStruct());
+          }
+          return;
+
+        case ElementSize::POINTER:
+          for (auto element: patch.getList()) {
+            KJ_REQUIRE(element.getIndex() < size, "patch does not fit the list being patched");
+            applyToPointer(list.getPointerElement(bounded(element.getIndex()) * ELEMENTS),
+                           element);
+          }
+          return;
+
+        default:
+          KJ_FAIL_REQUIRE("patch does not fit the list being patched");
+      }
+    }
+  }
+
+  KJ_FAIL_REQUIRE("unknown PointerPatch type", (uint)patch.which());
+}
+
+}  // namespace
+
+bool diff(AnyStruct::Reader oldValue, AnyStruct::Reader newValue, StructPatch::Builder patch) {
+  StructChanges changes;
+  if (!diffStruct(_::PointerHelpers<AnyStruct>::getInternalReader(oldValue),
+                  _::PointerHelpers<AnyStruct>::getInternalReader(newValue), changes)) {
+    return false;
+  }
+  writeStructChanges(changes, patch);
+  return true;
+}
+
+void applyPatch(AnyPointer::Builder target, StructPatch::Reader patch) {
+  applyToStructPointer(_::PointerHelpers<AnyPointer>::getInternalBuilder(kj::mv(target)), patch);
+}
+
+}  // namespace capnp
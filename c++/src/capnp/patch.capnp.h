@@ -0,0 +1,601 @@
+// Generated by Cap'n Proto compiler, DO NOT EDIT
+// source: patch.capnp
+
+#pragma once
+
+#include <capnp/generated-header-support.h>
+#include <kj/windows-sanity.h>
+
+#ifndef CAPNP_VERSION
+#error "CAPNP_VERSION is not defined, is capnp/generated-header-support.h missing?"
+#elif CAPNP_VERSION != 1001000
+#error "Version mismatch between generated code and library headers.  You must use the same version of the Cap'n Proto compiler and library."
+#endif
+
+
+CAPNP_BEGIN_HEADER
+
+namespace capnp {
+namespace schemas {
+
+CAPNP_DECLARE_SCHEMA(f787478862493ff7);
+CAPNP_DECLARE_SCHEMA(98e19a6c7cfc4f2d);
+
+}  // namespace schemas
+}  // namespace capnp
+
+namespace capnp {
+
+struct StructPatch {
+  StructPatch() = delete;
+
+  class Reader;
+  class Builder;
+  class Pipeline;
+
+  struct _capnpPrivate {
+    CAPNP_DECLARE_STRUCT_HEADER(f787478862493ff7, 1, 3)
+    #if !CAPNP_LITE
+    static constexpr ::capnp::_::RawBrandedSchema const* brand() { return &schema->defaultBrand; }
+    #endif  // !CAPNP_LITE
+  };
+};
+
+struct PointerPatch {
+  PointerPatch() = delete;
+
+  class Reader;
+  class Builder;
+  class Pipeline;
+  enum Which: uint16_t {
+    REPLACE,
+    STRUCT,
+    LIST,
+  };
+
+  struct _capnpPrivate {
+    CAPNP_DECLARE_STRUCT_HEADER(98e19a6c7cfc4f2d, 1, 1)
+    #if !CAPNP_LITE
+    static constexpr ::capnp::_::RawBrandedSchema const* brand() { return &schema->defaultBrand; }
+    #endif  // !CAPNP_LITE
+  };
+};
+
+// =======================================================================================
+
+class StructPatch::Reader {
+public:
+  typedef StructPatch Reads;
+
+  Reader() = default;
+  inline explicit Reader(::capnp::_::StructReader base): _reader(base) {}
+
+  inline ::capnp::MessageSize totalSize() const {
+    return _reader.totalSize().asPublic();
+  }
+
+#if !CAPNP_LITE
+  inline ::kj::StringTree toString() const {
+    return ::capnp::_::structString(_reader, *_capnpPrivate::brand());
+  }
+#endif  // !CAPNP_LITE
+
+  inline  ::uint16_t getDataWordCount() const;
+
+  inline  ::uint16_t getPointerCount() const;
+
+  inline bool hasChangedWords() const;
+  inline  ::capnp::List< ::uint16_t,  ::capnp::Kind::PRIMITIVE>::Reader getChangedWords() const;
+
+  inline bool hasNewWords() const;
+  inline  ::capnp::List< ::uint64_t,  ::capnp::Kind::PRIMITIVE>::Reader getNewWords() const;
+
+  inline bool hasChangedPointers() const;
+  inline  ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>::Reader getChangedPointers() const;
+
+private:
+  ::capnp::_::StructReader _reader;
+  template <typename, ::capnp::Kind>
+  friend struct ::capnp::ToDynamic_;
+  template <typename, ::capnp::Kind>
+  friend struct ::capnp::_::PointerHelpers;
+  template <typename, ::capnp::Kind>
+  friend struct ::capnp::List;
+  friend class ::capnp::MessageBuilder;
+  friend class ::capnp::Orphanage;
+};
+
+class StructPatch::Builder {
+public:
+  typedef StructPatch Builds;
+
+  Builder() = delete;  // Deleted to discourage incorrect usage.
+                       // You can explicitly initialize to nullptr instead.
+  inline Builder(decltype(nullptr)) {}
+  inline explicit Builder(::capnp::_::StructBuilder base): _builder(base) {}
+  inline operator Reader() const { return Reader(_builder.asReader()); }
+  inline Reader asReader() const { return *this; }
+
+  inline ::capnp::MessageSize totalSize() const { return asReader().totalSize(); }
+#if !CAPNP_LITE
+  inline ::kj::StringTree toString() const { return asReader().toString(); }
+#endif  // !CAPNP_LITE
+
+  inline  ::uint16_t getDataWordCount();
+  inline void setDataWordCount( ::uint16_t value);
+
+  inline  ::uint16_t getPointerCount();
+  inline void setPointerCount( ::uint16_t value);
+
+  inline bool hasChangedWords();
+  inline  ::capnp::List< ::uint16_t,  ::capnp::Kind::PRIMITIVE>::Builder getChangedWords();
+  inline void setChangedWords( ::capnp::List< ::uint16_t,  ::capnp::Kind::PRIMITIVE>::Reader value);
+  inline void setChangedWords(::kj::ArrayPtr<const  ::uint16_t> value);
+  inline  ::capnp::List< ::uint16_t,  ::capnp::Kind::PRIMITIVE>::Builder initChangedWords(unsigned int size);
+  inline void adoptChangedWords(::capnp::Orphan< ::capnp::List< ::uint16_t,  ::capnp::Kind::PRIMITIVE>>&& value);
+  inline ::capnp::Orphan< ::capnp::List< ::uint16_t,  ::capnp::Kind::PRIMITIVE>> disownChangedWords();
+
+  inline bool hasNewWords();
+  inline  ::capnp::List< ::uint64_t,  ::capnp::Kind::PRIMITIVE>::Builder getNewWords();
+  inline void setNewWords( ::capnp::List< ::uint64_t,  ::capnp::Kind::PRIMITIVE>::Reader value);
+  inline void setNewWords(::kj::ArrayPtr<const  ::uint64_t> value);
+  inline  ::capnp::List< ::uint64_t,  ::capnp::Kind::PRIMITIVE>::Builder initNewWords(unsigned int size);
+  inline void adoptNewWords(::capnp::Orphan< ::capnp::List< ::uint64_t,  ::capnp::Kind::PRIMITIVE>>&& value);
+  inline ::capnp::Orphan< ::capnp::List< ::uint64_t,  ::capnp::Kind::PRIMITIVE>> disownNewWords();
+
+  inline bool hasChangedPointers();
+  inline  ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>::Builder getChangedPointers();
+  inline void setChangedPointers( ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>::Reader value);
+  inline  ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>::Builder initChangedPointers(unsigned int size);
+  inline void adoptChangedPointers(::capnp::Orphan< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>>&& value);
+  inline ::capnp::Orphan< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>> disownChangedPointers();
+
+private:
+  ::capnp::_::StructBuilder _builder;
+  template <typename, ::capnp::Kind>
+  friend struct ::capnp::ToDynamic_;
+  friend class ::capnp::Orphanage;
+  template <typename, ::capnp::Kind>
+  friend struct ::capnp::_::PointerHelpers;
+};
+
+#if !CAPNP_LITE
+class StructPatch::Pipeline {
+public:
+  typedef StructPatch Pipelines;
+
+  inline Pipeline(decltype(nullptr)): _typeless(nullptr) {}
+  inline explicit Pipeline(::capnp::AnyPointer::Pipeline&& typeless)
+      : _typeless(kj::mv(typeless)) {}
+
+private:
+  ::capnp::AnyPointer::Pipeline _typeless;
+  friend class ::capnp::PipelineHook;
+  template <typename, ::capnp::Kind>
+  friend struct ::capnp::ToDynamic_;
+};
+#endif  // !CAPNP_LITE
+
+class PointerPatch::Reader {
+public:
+  typedef PointerPatch Reads;
+
+  Reader() = default;
+  inline explicit Reader(::capnp::_::StructReader base): _reader(base) {}
+
+  inline ::capnp::MessageSize totalSize() const {
+    return _reader.totalSize().asPublic();
+  }
+
+#if !CAPNP_LITE
+  inline ::kj::StringTree toString() const {
+    return ::capnp::_::structString(_reader, *_capnpPrivate::brand());
+  }
+#endif  // !CAPNP_LITE
+
+  inline Which which() const;
+  inline  ::uint32_t getIndex() const;
+
+  inline bool isReplace() const;
+  inline bool hasReplace() const;
+  inline ::capnp::AnyPointer::Reader getReplace() const;
+
+  inline bool isStruct() const;
+  inline bool hasStruct() const;
+  inline  ::capnp::StructPatch::Reader getStruct() const;
+
+  inline bool isList() const;
+  inline bool hasList() const;
+  inline  ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>::Reader getList() const;
+
+private:
+  ::capnp::_::StructReader _reader;
+  template <typename, ::capnp::Kind>
+  friend struct ::capnp::ToDynamic_;
+  template <typename, ::capnp::Kind>
+  friend struct ::capnp::_::PointerHelpers;
+  template <typename, ::capnp::Kind>
+  friend struct ::capnp::List;
+  friend class ::capnp::MessageBuilder;
+  friend class ::capnp::Orphanage;
+};
+
+class PointerPatch::Builder {
+public:
+  typedef PointerPatch Builds;
+
+  Builder() = delete;  // Deleted to discourage incorrect usage.
+                       // You can explicitly initialize to nullptr instead.
+  inline Builder(decltype(nullptr)) {}
+  inline explicit Builder(::capnp::_::StructBuilder base): _builder(base) {}
+  inline operator Reader() const { return Reader(_builder.asReader()); }
+  inline Reader asReader() const { return *this; }
+
+  inline ::capnp::MessageSize totalSize() const { return asReader().totalSize(); }
+#if !CAPNP_LITE
+  inline ::kj::StringTree toString() const { return asReader().toString(); }
+#endif  // !CAPNP_LITE
+
+  inline Which which();
+  inline  ::uint32_t getIndex();
+  inline void setIndex( ::uint32_t value);
+
+  inline bool isReplace();
+  inline bool hasReplace();
+  inline ::capnp::AnyPointer::Builder getReplace();
+  inline ::capnp::AnyPointer::Builder initReplace();
+
+  inline bool isStruct();
+  inline bool hasStruct();
+  inline  ::capnp::StructPatch::Builder getStruct();
+  inline void setStruct( ::capnp::StructPatch::Reader value);
+  inline  ::capnp::StructPatch::Builder initStruct();
+  inline void adoptStruct(::capnp::Orphan< ::capnp::StructPatch>&& value);
+  inline ::capnp::Orphan< ::capnp::StructPatch> disownStruct();
+
+  inline bool isList();
+  inline bool hasList();
+  inline  ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>::Builder getList();
+  inline void setList( ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>::Reader value);
+  inline  ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>::Builder initList(unsigned int size);
+  inline void adoptList(::capnp::Orphan< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>>&& value);
+  inline ::capnp::Orphan< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>> disownList();
+
+private:
+  ::capnp::_::StructBuilder _builder;
+  template <typename, ::capnp::Kind>
+  friend struct ::capnp::ToDynamic_;
+  friend class ::capnp::Orphanage;
+  template <typename, ::capnp::Kind>
+  friend struct ::capnp::_::PointerHelpers;
+};
+
+#if !CAPNP_LITE
+class PointerPatch::Pipeline {
+public:
+  typedef PointerPatch Pipelines;
+
+  inline Pipeline(decltype(nullptr)): _typeless(nullptr) {}
+  inline explicit Pipeline(::capnp::AnyPointer::Pipeline&& typeless)
+      : _typeless(kj::mv(typeless)) {}
+
+private:
+  ::capnp::AnyPointer::Pipeline _typeless;
+  friend class ::capnp::PipelineHook;
+  template <typename, ::capnp::Kind>
+  friend struct ::capnp::ToDynamic_;
+};
+#endif  // !CAPNP_LITE
+
+// =======================================================================================
+
+inline  ::uint16_t StructPatch::Reader::getDataWordCount() const {
+  return _reader.getDataField< ::uint16_t>(
+      ::capnp::bounded<0>() * ::capnp::ELEMENTS);
+}
+
+inline  ::uint16_t StructPatch::Builder::getDataWordCount() {
+  return _builder.getDataField< ::uint16_t>(
+      ::capnp::bounded<0>() * ::capnp::ELEMENTS);
+}
+inline void StructPatch::Builder::setDataWordCount( ::uint16_t value) {
+  _builder.setDataField< ::uint16_t>(
+      ::capnp::bounded<0>() * ::capnp::ELEMENTS, value);
+}
+
+inline  ::uint16_t StructPatch::Reader::getPointerCount() const {
+  return _reader.getDataField< ::uint16_t>(
+      ::capnp::bounded<1>() * ::capnp::ELEMENTS);
+}
+
+inline  ::uint16_t StructPatch::Builder::getPointerCount() {
+  return _builder.getDataField< ::uint16_t>(
+      ::capnp::bounded<1>() * ::capnp::ELEMENTS);
+}
+inline void StructPatch::Builder::setPointerCount( ::uint16_t value) {
+  _builder.setDataField< ::uint16_t>(
+      ::capnp::bounded<1>() * ::capnp::ELEMENTS, value);
+}
+
+inline bool StructPatch::Reader::hasChangedWords() const {
+  return !_reader.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS).isNull();
+}
+inline bool StructPatch::Builder::hasChangedWords() {
+  return !_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS).isNull();
+}
+inline  ::capnp::List< ::uint16_t,  ::capnp::Kind::PRIMITIVE>::Reader StructPatch::Reader::getChangedWords() const {
+  return ::capnp::_::PointerHelpers< ::capnp::List< ::uint16_t,  ::capnp::Kind::PRIMITIVE>>::get(_reader.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS));
+}
+inline  ::capnp::List< ::uint16_t,  ::capnp::Kind::PRIMITIVE>::Builder StructPatch::Builder::getChangedWords() {
+  return ::capnp::_::PointerHelpers< ::capnp::List< ::uint16_t,  ::capnp::Kind::PRIMITIVE>>::get(_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS));
+}
+inline void StructPatch::Builder::setChangedWords( ::capnp::List< ::uint16_t,  ::capnp::Kind::PRIMITIVE>::Reader value) {
+  ::capnp::_::PointerHelpers< ::capnp::List< ::uint16_t,  ::capnp::Kind::PRIMITIVE>>::set(_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS), value);
+}
+inline void StructPatch::Builder::setChangedWords(::kj::ArrayPtr<const  ::uint16_t> value) {
+  ::capnp::_::PointerHelpers< ::capnp::List< ::uint16_t,  ::capnp::Kind::PRIMITIVE>>::set(_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS), value);
+}
+inline  ::capnp::List< ::uint16_t,  ::capnp::Kind::PRIMITIVE>::Builder StructPatch::Builder::initChangedWords(unsigned int size) {
+  return ::capnp::_::PointerHelpers< ::capnp::List< ::uint16_t,  ::capnp::Kind::PRIMITIVE>>::init(_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS), size);
+}
+inline void StructPatch::Builder::adoptChangedWords(
+    ::capnp::Orphan< ::capnp::List< ::uint16_t,  ::capnp::Kind::PRIMITIVE>>&& value) {
+  ::capnp::_::PointerHelpers< ::capnp::List< ::uint16_t,  ::capnp::Kind::PRIMITIVE>>::adopt(_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS), kj::mv(value));
+}
+inline ::capnp::Orphan< ::capnp::List< ::uint16_t,  ::capnp::Kind::PRIMITIVE>> StructPatch::Builder::disownChangedWords() {
+  return ::capnp::_::PointerHelpers< ::capnp::List< ::uint16_t,  ::capnp::Kind::PRIMITIVE>>::disown(_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS));
+}
+
+inline bool StructPatch::Reader::hasNewWords() const {
+  return !_reader.getPointerField(
+      ::capnp::bounded<1>() * ::capnp::POINTERS).isNull();
+}
+inline bool StructPatch::Builder::hasNewWords() {
+  return !_builder.getPointerField(
+      ::capnp::bounded<1>() * ::capnp::POINTERS).isNull();
+}
+inline  ::capnp::List< ::uint64_t,  ::capnp::Kind::PRIMITIVE>::Reader StructPatch::Reader::getNewWords() const {
+  return ::capnp::_::PointerHelpers< ::capnp::List< ::uint64_t,  ::capnp::Kind::PRIMITIVE>>::get(_reader.getPointerField(
+      ::capnp::bounded<1>() * ::capnp::POINTERS));
+}
+inline  ::capnp::List< ::uint64_t,  ::capnp::Kind::PRIMITIVE>::Builder StructPatch::Builder::getNewWords() {
+  return ::capnp::_::PointerHelpers< ::capnp::List< ::uint64_t,  ::capnp::Kind::PRIMITIVE>>::get(_builder.getPointerField(
+      ::capnp::bounded<1>() * ::capnp::POINTERS));
+}
+inline void StructPatch::Builder::setNewWords( ::capnp::List< ::uint64_t,  ::capnp::Kind::PRIMITIVE>::Reader value) {
+  ::capnp::_::PointerHelpers< ::capnp::List< ::uint64_t,  ::capnp::Kind::PRIMITIVE>>::set(_builder.getPointerField(
+      ::capnp::bounded<1>() * ::capnp::POINTERS), value);
+}
+inline void StructPatch::Builder::setNewWords(::kj::ArrayPtr<const  ::uint64_t> value) {
+  ::capnp::_::PointerHelpers< ::capnp::List< ::uint64_t,  ::capnp::Kind::PRIMITIVE>>::set(_builder.getPointerField(
+      ::capnp::bounded<1>() * ::capnp::POINTERS), value);
+}
+inline  ::capnp::List< ::uint64_t,  ::capnp::Kind::PRIMITIVE>::Builder StructPatch::Builder::initNewWords(unsigned int size) {
+  return ::capnp::_::PointerHelpers< ::capnp::List< ::uint64_t,  ::capnp::Kind::PRIMITIVE>>::init(_builder.getPointerField(
+      ::capnp::bounded<1>() * ::capnp::POINTERS), size);
+}
+inline void StructPatch::Builder::adoptNewWords(
+    ::capnp::Orphan< ::capnp::List< ::uint64_t,  ::capnp::Kind::PRIMITIVE>>&& value) {
+  ::capnp::_::PointerHelpers< ::capnp::List< ::uint64_t,  ::capnp::Kind::PRIMITIVE>>::adopt(_builder.getPointerField(
+      ::capnp::bounded<1>() * ::capnp::POINTERS), kj::mv(value));
+}
+inline ::capnp::Orphan< ::capnp::List< ::uint64_t,  ::capnp::Kind::PRIMITIVE>> StructPatch::Builder::disownNewWords() {
+  return ::capnp::_::PointerHelpers< ::capnp::List< ::uint64_t,  ::capnp::Kind::PRIMITIVE>>::disown(_builder.getPointerField(
+      ::capnp::bounded<1>() * ::capnp::POINTERS));
+}
+
+inline bool StructPatch::Reader::hasChangedPointers() const {
+  return !_reader.getPointerField(
+      ::capnp::bounded<2>() * ::capnp::POINTERS).isNull();
+}
+inline bool StructPatch::Builder::hasChangedPointers() {
+  return !_builder.getPointerField(
+      ::capnp::bounded<2>() * ::capnp::POINTERS).isNull();
+}
+inline  ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>::Reader StructPatch::Reader::getChangedPointers() const {
+  return ::capnp::_::PointerHelpers< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>>::get(_reader.getPointerField(
+      ::capnp::bounded<2>() * ::capnp::POINTERS));
+}
+inline  ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>::Builder StructPatch::Builder::getChangedPointers() {
+  return ::capnp::_::PointerHelpers< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>>::get(_builder.getPointerField(
+      ::capnp::bounded<2>() * ::capnp::POINTERS));
+}
+inline void StructPatch::Builder::setChangedPointers( ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>::Reader value) {
+  ::capnp::_::PointerHelpers< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>>::set(_builder.getPointerField(
+      ::capnp::bounded<2>() * ::capnp::POINTERS), value);
+}
+inline  ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>::Builder StructPatch::Builder::initChangedPointers(unsigned int size) {
+  return ::capnp::_::PointerHelpers< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>>::init(_builder.getPointerField(
+      ::capnp::bounded<2>() * ::capnp::POINTERS), size);
+}
+inline void StructPatch::Builder::adoptChangedPointers(
+    ::capnp::Orphan< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>>&& value) {
+  ::capnp::_::PointerHelpers< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>>::adopt(_builder.getPointerField(
+      ::capnp::bounded<2>() * ::capnp::POINTERS), kj::mv(value));
+}
+inline ::capnp::Orphan< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>> StructPatch::Builder::disownChangedPointers() {
+  return ::capnp::_::PointerHelpers< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>>::disown(_builder.getPointerField(
+      ::capnp::bounded<2>() * ::capnp::POINTERS));
+}
+
+inline  ::capnp::PointerPatch::Which PointerPatch::Reader::which() const {
+  return _reader.getDataField<Which>(
+      ::capnp::bounded<2>() * ::capnp::ELEMENTS);
+}
+inline  ::capnp::PointerPatch::Which PointerPatch::Builder::which() {
+  return _builder.getDataField<Which>(
+      ::capnp::bounded<2>() * ::capnp::ELEMENTS);
+}
+
+inline  ::uint32_t PointerPatch::Reader::getIndex() const {
+  return _reader.getDataField< ::uint32_t>(
+      ::capnp::bounded<0>() * ::capnp::ELEMENTS);
+}
+
+inline  ::uint32_t PointerPatch::Builder::getIndex() {
+  return _builder.getDataField< ::uint32_t>(
+      ::capnp::bounded<0>() * ::capnp::ELEMENTS);
+}
+inline void PointerPatch::Builder::setIndex( ::uint32_t value) {
+  _builder.setDataField< ::uint32_t>(
+      ::capnp::bounded<0>() * ::capnp::ELEMENTS, value);
+}
+
+inline bool PointerPatch::Reader::isReplace() const {
+  return which() == PointerPatch::REPLACE;
+}
+inline bool PointerPatch::Builder::isReplace() {
+  return which() == PointerPatch::REPLACE;
+}
+inline bool PointerPatch::Reader::hasReplace() const {
+  if (which() != PointerPatch::REPLACE) return false;
+  return !_reader.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS).isNull();
+}
+inline bool PointerPatch::Builder::hasReplace() {
+  if (which() != PointerPatch::REPLACE) return false;
+  return !_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS).isNull();
+}
+inline ::capnp::AnyPointer::Reader PointerPatch::Reader::getReplace() const {
+  KJ_IREQUIRE((which() == PointerPatch::REPLACE),
+              "Must check which() before get()ing a union member.");
+  return ::capnp::AnyPointer::Reader(_reader.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS));
+}
+inline ::capnp::AnyPointer::Builder PointerPatch::Builder::getReplace() {
+  KJ_IREQUIRE((which() == PointerPatch::REPLACE),
+              "Must check which() before get()ing a union member.");
+  return ::capnp::AnyPointer::Builder(_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS));
+}
+inline ::capnp::AnyPointer::Builder PointerPatch::Builder::initReplace() {
+  _builder.setDataField<PointerPatch::Which>(
+      ::capnp::bounded<2>() * ::capnp::ELEMENTS, PointerPatch::REPLACE);
+  auto result = ::capnp::AnyPointer::Builder(_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS));
+  result.clear();
+  return result;
+}
+
+inline bool PointerPatch::Reader::isStruct() const {
+  return which() == PointerPatch::STRUCT;
+}
+inline bool PointerPatch::Builder::isStruct() {
+  return which() == PointerPatch::STRUCT;
+}
+inline bool PointerPatch::Reader::hasStruct() const {
+  if (which() != PointerPatch::STRUCT) return false;
+  return !_reader.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS).isNull();
+}
+inline bool PointerPatch::Builder::hasStruct() {
+  if (which() != PointerPatch::STRUCT) return false;
+  return !_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS).isNull();
+}
+inline  ::capnp::StructPatch::Reader PointerPatch::Reader::getStruct() const {
+  KJ_IREQUIRE((which() == PointerPatch::STRUCT),
+              "Must check which() before get()ing a union member.");
+  return ::capnp::_::PointerHelpers< ::capnp::StructPatch>::get(_reader.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS));
+}
+inline  ::capnp::StructPatch::Builder PointerPatch::Builder::getStruct() {
+  KJ_IREQUIRE((which() == PointerPatch::STRUCT),
+              "Must check which() before get()ing a union member.");
+  return ::capnp::_::PointerHelpers< ::capnp::StructPatch>::get(_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS));
+}
+inline void PointerPatch::Builder::setStruct( ::capnp::StructPatch::Reader value) {
+  _builder.setDataField<PointerPatch::Which>(
+      ::capnp::bounded<2>() * ::capnp::ELEMENTS, PointerPatch::STRUCT);
+  ::capnp::_::PointerHelpers< ::capnp::StructPatch>::set(_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS), value);
+}
+inline  ::capnp::StructPatch::Builder PointerPatch::Builder::initStruct() {
+  _builder.setDataField<PointerPatch::Which>(
+      ::capnp::bounded<2>() * ::capnp::ELEMENTS, PointerPatch::STRUCT);
+  return ::capnp::_::PointerHelpers< ::capnp::StructPatch>::init(_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS));
+}
+inline void PointerPatch::Builder::adoptStruct(
+    ::capnp::Orphan< ::capnp::StructPatch>&& value) {
+  _builder.setDataField<PointerPatch::Which>(
+      ::capnp::bounded<2>() * ::capnp::ELEMENTS, PointerPatch::STRUCT);
+  ::capnp::_::PointerHelpers< ::capnp::StructPatch>::adopt(_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS), kj::mv(value));
+}
+inline ::capnp::Orphan< ::capnp::StructPatch> PointerPatch::Builder::disownStruct() {
+  KJ_IREQUIRE((which() == PointerPatch::STRUCT),
+              "Must check which() before get()ing a union member.");
+  return ::capnp::_::PointerHelpers< ::capnp::StructPatch>::disown(_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS));
+}
+
+inline bool PointerPatch::Reader::isList() const {
+  return which() == PointerPatch::LIST;
+}
+inline bool PointerPatch::Builder::isList() {
+  return which() == PointerPatch::LIST;
+}
+inline bool PointerPatch::Reader::hasList() const {
+  if (which() != PointerPatch::LIST) return false;
+  return !_reader.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS).isNull();
+}
+inline bool PointerPatch::Builder::hasList() {
+  if (which() != PointerPatch::LIST) return false;
+  return !_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS).isNull();
+}
+inline  ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>::Reader PointerPatch::Reader::getList() const {
+  KJ_IREQUIRE((which() == PointerPatch::LIST),
+              "Must check which() before get()ing a union member.");
+  return ::capnp::_::PointerHelpers< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>>::get(_reader.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS));
+}
+inline  ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>::Builder PointerPatch::Builder::getList() {
+  KJ_IREQUIRE((which() == PointerPatch::LIST),
+              "Must check which() before get()ing a union member.");
+  return ::capnp::_::PointerHelpers< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>>::get(_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS));
+}
+inline void PointerPatch::Builder::setList( ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>::Reader value) {
+  _builder.setDataField<PointerPatch::Which>(
+      ::capnp::bounded<2>() * ::capnp::ELEMENTS, PointerPatch::LIST);
+  ::capnp::_::PointerHelpers< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>>::set(_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS), value);
+}
+inline  ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>::Builder PointerPatch::Builder::initList(unsigned int size) {
+  _builder.setDataField<PointerPatch::Which>(
+      ::capnp::bounded<2>() * ::capnp::ELEMENTS, PointerPatch::LIST);
+  return ::capnp::_::PointerHelpers< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>>::init(_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS), size);
+}
+inline void PointerPatch::Builder::adoptList(
+    ::capnp::Orphan< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>>&& value) {
+  _builder.setDataField<PointerPatch::Which>(
+      ::capnp::bounded<2>() * ::capnp::ELEMENTS, PointerPatch::LIST);
+  ::capnp::_::PointerHelpers< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>>::adopt(_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS), kj::mv(value));
+}
+inline ::capnp::Orphan< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>> PointerPatch::Builder::disownList() {
+  KJ_IREQUIRE((which() == PointerPatch::LIST),
+              "Must check which() before get()ing a union member.");
+  return ::capnp::_::PointerHelpers< ::capnp::List< ::capnp::PointerPatch,  ::capnp::Kind::STRUCT>>::disown(_builder.getPointerField(
+      ::capnp::bounded<0>() * ::capnp::POINTERS));
+}
+
+}  // namespace
+
+CAPNP_END_HEADER
+
@@ -0,0 +1,59 @@
+// Copyright (c) 2026 Cloudflare, Inc. and contributors
+// Licensed under the MIT License:
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "any.h"
+#include <capnp/patch.capnp.h>
+
+CAPNP_BEGIN_HEADER
+
+namespace capnp {
+
+// Structural diff and patch, for replicating a large message which changes a little at a time:
+// rather than resending the whole message after each change, the sender computes a StructPatch
+// against the previous version, and the receivers apply it to their copy.
+//
+// Both work directly on the encoded messages, comparing data words and pointers by position and
+// recursing only into pointers whose targets differ, so they do not need the schema and work with
+// any struct type.  (Typed readers convert implicitly to AnyStruct::Reader.)  Changes to a struct
+// list of unchanged length and element size, or to a list of pointers of unchanged length, are
+// described element-by-element; any other change to a pointer replaces its whole target.
+//
+// Patches cannot carry capabilities, since a StructPatch is sent without a cap table.
+
+bool diff(AnyStruct::Reader oldValue, AnyStruct::Reader newValue, StructPatch::Builder patch);
+// Fills in `patch`, which should be freshly-initialized, with the changes which turn `oldValue`
+// into `newValue`.  Returns false, leaving `patch` empty, if there are none.  Throws if `newValue`
+// contains any capabilities.
+
+void applyPatch(AnyPointer::Builder target, StructPatch::Reader patch);
+// Applies `patch` to the struct which `target` points at, which must be equal to the `oldValue`
+// from which the patch was computed; the struct then equals the `newValue`.  Throws if the patch
+// does not fit the struct, in which case the struct may have been partially patched.
+//
+// `target` is a pointer rather than a struct so that the struct can be reallocated, should the
+// new value be larger than the existing struct.  To patch a message's root, pass
+// `message.getRoot<AnyPointer>()`.
+
+}  // namespace capnp
+
+CAPNP_END_HEADER
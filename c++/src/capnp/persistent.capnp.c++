@@ -68,13 +68,14 @@ static const ::capnp::_::RawSchema* const d_c8cb212fcd9f5691[] = {
   &s_f76fba59183073a5,
 };
 static const uint16_t m_c8cb212fcd9f5691[] = {0};
+static const uint16_t h_c8cb212fcd9f5691[] = {0, 0};
 KJ_CONSTEXPR(const) ::capnp::_::RawBrandedSchema::Dependency bd_c8cb212fcd9f5691[] = {
   { 33554432,  ::capnp::Persistent< ::capnp::AnyPointer,  ::capnp::AnyPointer>::SaveParams::_capnpPrivate::brand() },
   { 50331648,  ::capnp::Persistent< ::capnp::AnyPointer,  ::capnp::AnyPointer>::SaveResults::_capnpPrivate::brand() },
 };
 const ::capnp::_::RawSchema s_c8cb212fcd9f5691 = {
   0xc8cb212fcd9f5691, b_c8cb212fcd9f5691.words, 54, d_c8cb212fcd9f5691, m_c8cb212fcd9f5691,
-  2, 1, nullptr, nullptr, nullptr, { &s_c8cb212fcd9f5691, nullptr, bd_c8cb212fcd9f5691, 0, sizeof(bd_c8cb212fcd9f5691) / sizeof(bd_c8cb212fcd9f5691[0]), nullptr }, false
+  2, 1, nullptr, nullptr, nullptr, { &s_c8cb212fcd9f5691, nullptr, bd_c8cb212fcd9f5691, 0, sizeof(bd_c8cb212fcd9f5691) / sizeof(bd_c8cb212fcd9f5691[0]), nullptr }, false, h_c8cb212fcd9f5691
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<35> b_f76fba59183073a5 = {
@@ -118,9 +119,10 @@ static const ::capnp::_::AlignedData<35> b_f76fba59183073a5 = {
 #if !CAPNP_LITE
 static const uint16_t m_f76fba59183073a5[] = {0};
 static const uint16_t i_f76fba59183073a5[] = {0};
+static const uint16_t h_f76fba59183073a5[] = {0, 0};
 const ::capnp::_::RawSchema s_f76fba59183073a5 = {
   0xf76fba59183073a5, b_f76fba59183073a5.words, 35, nullptr, m_f76fba59183073a5,
-  0, 1, i_f76fba59183073a5, nullptr, nullptr, { &s_f76fba59183073a5, nullptr, nullptr, 0, 0, nullptr }, true
+  0, 1, i_f76fba59183073a5, nullptr, nullptr, { &s_f76fba59183073a5, nullptr, nullptr, 0, 0, nullptr }, true, h_f76fba59183073a5
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<36> b_b76848c18c40efbf = {
@@ -165,9 +167,10 @@ static const ::capnp::_::AlignedData<36> b_b76848c18c40efbf = {
 #if !CAPNP_LITE
 static const uint16_t m_b76848c18c40efbf[] = {0};
 static const uint16_t i_b76848c18c40efbf[] = {0};
+static const uint16_t h_b76848c18c40efbf[] = {0, 0};
 const ::capnp::_::RawSchema s_b76848c18c40efbf = {
   0xb76848c18c40efbf, b_b76848c18c40efbf.words, 36, nullptr, m_b76848c18c40efbf,
-  0, 1, i_b76848c18c40efbf, nullptr, nullptr, { &s_b76848c18c40efbf, nullptr, nullptr, 0, 0, nullptr }, true
+  0, 1, i_b76848c18c40efbf, nullptr, nullptr, { &s_b76848c18c40efbf, nullptr, nullptr, 0, 0, nullptr }, true, h_b76848c18c40efbf
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<22> b_f622595091cafb67 = {
@@ -198,7 +201,7 @@ static const ::capnp::_::AlignedData<22> b_f622595091cafb67 = {
 #if !CAPNP_LITE
 const ::capnp::_::RawSchema s_f622595091cafb67 = {
   0xf622595091cafb67, b_f622595091cafb67.words, 22, nullptr, nullptr,
-  0, 0, nullptr, nullptr, nullptr, { &s_f622595091cafb67, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 0, nullptr, nullptr, nullptr, { &s_f622595091cafb67, nullptr, nullptr, 0, 0, nullptr }, false, nullptr
 };
 #endif  // !CAPNP_LITE
 }  // namespace schemas
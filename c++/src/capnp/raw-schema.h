@@ -182,8 +182,8 @@ struct RawSchema {
   // TODO(someday):  Make this a hashtable.
 
   const uint16_t* membersByName;
-  // Indexes of members sorted by name.  Used to implement name lookup.
-  // TODO(someday):  Make this a hashtable.
+  // Indexes of members sorted by name.  Used to implement name lookup when `membersByHash` is
+  // not available.
 
   uint32_t dependencyCount;
   uint32_t memberCount;
@@ -229,8 +229,63 @@ struct RawSchema {
 
   bool mayContainCapabilities = true;
   // See StructSchema::mayContainCapabilities.
+
+  const uint16_t* membersByHash = nullptr;
+  // Minimal perfect hash table over member names, used to implement name lookup in constant
+  // time. Consists of memberHashSeedCount(memberCount) seeds followed by memberCount member
+  // indexes; see findMemberByHash(). Null if the table was not built (e.g. the code was generated
+  // by an older version of capnpc-c++), in which case lookups binary-search `membersByName`.
+  //
+  // This comes last so that code generated before it existed still initializes the other members
+  // correctly.
 };
 
+inline uint64_t hashMemberName(const char* name, size_t size) {
+  // Hash used to build and probe `RawSchema::membersByHash`. Since tables are generated at compile
+  // time and probed at runtime, possibly on another platform, this must never change.
+
+  // FNV-1a, followed by the MurmurHash3 finalizer so that all bits depend on every byte.
+  uint64_t h = 0xcbf29ce484222325ull;
+  for (size_t i = 0; i < size; i++) {
+    h = (h ^ static_cast<unsigned char>(name[i])) * 0x100000001b3ull;
+  }
+  h = (h ^ (h >> 33)) * 0xff51afd7ed558ccdull;
+  h = (h ^ (h >> 33)) * 0xc4ceb9fe1a85ec53ull;
+  return h ^ (h >> 33);
+}
+
+inline uint memberHashSeedCount(uint memberCount) {
+  // One seed per two members, which lets the table builder find seeds quickly.
+  return (memberCount + 1) / 2;
+}
+
+inline uint memberHashBucket(uint64_t hash, uint seedCount) {
+  // Maps the hash into [0, seedCount) with a multiply rather than a division.
+  return (static_cast<uint64_t>(static_cast<uint32_t>(hash >> 32)) * seedCount) >> 32;
+}
+
+inline uint memberHashSlot(uint64_t hash, uint16_t seed, uint memberCount) {
+  uint64_t h = hash + seed * 0x9e3779b97f4a7c15ull;
+  h = (h ^ (h >> 29)) * 0xbf58476d1ce4e5b9ull;
+  h ^= h >> 32;
+  return (static_cast<uint64_t>(static_cast<uint32_t>(h)) * memberCount) >> 32;
+}
+
+inline uint findMemberByHash(const RawSchema* raw, const char* name, size_t size) {
+  // Returns the index of the only member which could be named `name`. The caller must compare
+  // names, since `name` may not be a member at all. Requires raw->membersByHash to be non-null.
+
+  uint seedCount = memberHashSeedCount(raw->memberCount);
+  uint64_t hash = hashMemberName(name, size);
+  uint16_t seed = raw->membersByHash[memberHashBucket(hash, seedCount)];
+  return raw->membersByHash[seedCount + memberHashSlot(hash, seed, raw->memberCount)];
+}
+
+kj::Array<uint16_t> makeMemberHashTable(kj::ArrayPtr<const kj::StringPtr> memberNames);
+// Builds a table suitable for `RawSchema::membersByHash`, given the names of all members in index
+// order. Returns an empty array if no table could be built, which happens only if two names have
+// the same 64-bit hash. Used by capnpc-c++ and SchemaLoader. Defined in schema.c++.
+
 inline bool RawBrandedSchema::isUnbound() const {
   // The unbound schema is the only one that has no scopes but is not the default schema.
   return scopeCount == 0 && this != &generic->defaultBrand;
@@ -143,6 +143,14 @@ private:
       return nullptr;
     }
 
+    void setDeadline(kj::TimePoint deadline) override {
+      inner->setDeadline(deadline);
+    }
+
+    void setTraceContext(const TraceContext& context) override {
+      inner->setTraceContext(context);
+    }
+
   private:
     kj::Own<ReconnectHook> parent;
     kj::Own<RequestHook> inner;
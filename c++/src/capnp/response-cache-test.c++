@@ -0,0 +1,237 @@
+// Copyright (c) 2026 Cloudflare, Inc. and contributors
+// Licensed under the MIT License:
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "response-cache.h"
+#include "test-util.h"
+#include <kj/debug.h>
+#include <kj/test.h>
+#include <kj/timer.h>
+#include "rpc-twoparty.h"
+
+namespace capnp {
+namespace _ {
+namespace {
+
+class CountingServer final: public test::TestInterface::Server {
+public:
+  uint fooCount = 0;
+  uint barCount = 0;
+  kj::Maybe<kj::Exception> error;
+
+  kj::Own<kj::PromiseFulfiller<void>> block() {
+    auto paf = kj::newPromiseAndFulfiller<void>();
+    blocker = paf.promise.fork();
+    return kj::mv(paf.fulfiller);
+  }
+
+protected:
+  kj::Promise<void> foo(FooContext context) override {
+    ++fooCount;
+    KJ_IF_MAYBE(e, error) {
+      return kj::cp(*e);
+    }
+    context.initResults().setX(kj::str(context.getParams().getI(), " #", fooCount));
+    return blocker.addBranch();
+  }
+
+  kj::Promise<void> bar(BarContext context) override {
+    ++barCount;
+    return kj::READY_NOW;
+  }
+
+private:
+  kj::ForkedPromise<void> blocker = kj::Promise<void>(kj::READY_NOW).fork();
+};
+
+ResponseCacheOptions fooOnly() {
+  ResponseCacheOptions options;
+  options.isIdempotent = [](uint64_t interfaceId, uint16_t methodId) {
+    return interfaceId == typeId<test::TestInterface>() && methodId == 0;
+  };
+  return options;
+}
+
+RemotePromise<test::TestInterface::FooResults> callFoo(test::TestInterface::Client& client,
+                                                       uint i) {
+  auto req = client.fooRequest();
+  req.setI(i);
+  return req.send();
+}
+
+KJ_TEST("ResponseCache answers repeated calls from the cache") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  CountingServer server;
+  ResponseCache cache(kj::Own<CountingServer>(&server, kj::NullDisposer::instance), fooOnly());
+  auto client = cache.getClient<test::TestInterface>();
+
+  KJ_EXPECT(callFoo(client, 1).wait(waitScope).getX() == "1 #1");
+  KJ_EXPECT(callFoo(client, 1).wait(waitScope).getX() == "1 #1");
+  KJ_EXPECT(callFoo(client, 2).wait(waitScope).getX() == "2 #2");
+  KJ_EXPECT(callFoo(client, 1).wait(waitScope).getX() == "1 #1");
+  KJ_EXPECT(server.fooCount == 2);
+
+  // Methods which aren't idempotent are always passed through.
+  client.barRequest().send().wait(waitScope);
+  client.barRequest().send().wait(waitScope);
+  KJ_EXPECT(server.barCount == 2);
+
+  auto stats = cache.getStats();
+  KJ_EXPECT(stats.hits == 2);
+  KJ_EXPECT(stats.misses == 2);
+  KJ_EXPECT(stats.coalesced == 0);
+  KJ_EXPECT(stats.entries == 2);
+  KJ_EXPECT(stats.words > 0);
+
+  cache.clear();
+  KJ_EXPECT(cache.getStats().entries == 0);
+  KJ_EXPECT(cache.getStats().words == 0);
+  KJ_EXPECT(callFoo(client, 1).wait(waitScope).getX() == "1 #3");
+}
+
+KJ_TEST("ResponseCache coalesces identical calls in flight and doesn't cache failures") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  CountingServer server;
+  ResponseCache cache(kj::Own<CountingServer>(&server, kj::NullDisposer::instance), fooOnly());
+  auto client = cache.getClient<test::TestInterface>();
+
+  auto fulfiller = server.block();
+  auto promise1 = callFoo(client, 1);
+  auto promise2 = callFoo(client, 1);
+  auto promise3 = callFoo(client, 1);
+  KJ_EXPECT(!promise1.poll(waitScope));
+  KJ_EXPECT(!promise2.poll(waitScope));
+  KJ_EXPECT(server.fooCount == 1);
+  KJ_EXPECT(cache.getStats().coalesced == 2);
+
+  // A caller giving up doesn't affect the others.
+  { auto drop = kj::mv(promise3); }
+
+  fulfiller->fulfill();
+  KJ_EXPECT(promise1.wait(waitScope).getX() == "1 #1");
+  KJ_EXPECT(promise2.wait(waitScope).getX() == "1 #1");
+  KJ_EXPECT(server.fooCount == 1);
+
+  server.error = KJ_EXCEPTION(FAILED, "test failure");
+  KJ_EXPECT_THROW_MESSAGE("test failure", callFoo(client, 2).wait(waitScope));
+  KJ_EXPECT_THROW_MESSAGE("test failure", callFoo(client, 2).wait(waitScope));
+  KJ_EXPECT(server.fooCount == 3);
+
+  server.error = nullptr;
+  KJ_EXPECT(callFoo(client, 2).wait(waitScope).getX() == "2 #4");
+  KJ_EXPECT(callFoo(client, 2).wait(waitScope).getX() == "2 #4");
+}
+
+KJ_TEST("ResponseCache cancels abandoned calls when it's destroyed") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  class NeverReturnServer final: public test::TestMembrane::Server {
+  public:
+    bool canceled = false;
+
+  protected:
+    kj::Promise<void> waitForever(WaitForeverContext context) override {
+      return kj::Promise<void>(kj::NEVER_DONE).attach(kj::defer([this]() { canceled = true; }));
+    }
+  };
+
+  NeverReturnServer server;
+
+  {
+    ResponseCache cache(kj::Own<NeverReturnServer>(&server, kj::NullDisposer::instance));
+    auto client = cache.getClient<test::TestMembrane>();
+
+    // The call keeps running after its only caller gives up, so that its response can be cached...
+    { auto drop = client.waitForeverRequest().send(); }
+    waitScope.poll();
+    KJ_EXPECT(!server.canceled);
+  }
+
+  // ...but not once the cache is gone.
+  waitScope.poll();
+  KJ_EXPECT(server.canceled);
+}
+
+KJ_TEST("ResponseCache expires entries after the TTL and evicts the least recently used") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+  kj::TimerImpl timer(kj::origin<kj::TimePoint>());
+
+  CountingServer server;
+  auto options = fooOnly();
+  options.timer = timer;
+  options.ttl = 10 * kj::SECONDS;
+  options.maxEntries = 2;
+  ResponseCache cache(kj::Own<CountingServer>(&server, kj::NullDisposer::instance),
+                      kj::mv(options));
+  auto client = cache.getClient<test::TestInterface>();
+
+  KJ_EXPECT(callFoo(client, 1).wait(waitScope).getX() == "1 #1");
+  timer.advanceTo(timer.now() + 9 * kj::SECONDS);
+  KJ_EXPECT(callFoo(client, 1).wait(waitScope).getX() == "1 #1");
+  timer.advanceTo(timer.now() + 1 * kj::SECONDS);
+  KJ_EXPECT(callFoo(client, 1).wait(waitScope).getX() == "1 #2");
+
+  // 1 was just used, so caching 3 evicts 2.
+  KJ_EXPECT(callFoo(client, 2).wait(waitScope).getX() == "2 #3");
+  KJ_EXPECT(callFoo(client, 1).wait(waitScope).getX() == "1 #2");
+  KJ_EXPECT(callFoo(client, 3).wait(waitScope).getX() == "3 #4");
+  KJ_EXPECT(cache.getStats().entries == 2);
+  KJ_EXPECT(callFoo(client, 1).wait(waitScope).getX() == "1 #2");
+  KJ_EXPECT(callFoo(client, 3).wait(waitScope).getX() == "3 #4");
+  KJ_EXPECT(callFoo(client, 2).wait(waitScope).getX() == "2 #5");
+}
+
+KJ_TEST("ResponseCache in front of an RPC connection skips the network on hits") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  CountingServer server;
+  auto pipe = kj::newTwoWayPipe();
+  TwoPartyClient tpClient(*pipe.ends[0]);
+  TwoPartyClient tpServer(*pipe.ends[1],
+      kj::Own<CountingServer>(&server, kj::NullDisposer::instance), rpc::twoparty::Side::SERVER);
+
+  ResponseCache cache(tpClient.bootstrap(), fooOnly());
+  auto client = cache.getClient<test::TestInterface>();
+
+  KJ_EXPECT(callFoo(client, 7).wait(waitScope).getX() == "7 #1");
+  KJ_EXPECT(callFoo(client, 7).wait(waitScope).getX() == "7 #1");
+  KJ_EXPECT(server.fooCount == 1);
+  KJ_EXPECT(cache.getStats().hits == 1);
+
+  // The params' canonical form is the key, so equal params built differently still match.
+  {
+    auto req = client.fooRequest();
+    req.setJ(false);
+    req.setI(7);
+    KJ_EXPECT(req.send().wait(waitScope).getX() == "7 #1");
+  }
+  KJ_EXPECT(server.fooCount == 1);
+}
+
+}  // namespace
+}  // namespace _
+}  // namespace capnp
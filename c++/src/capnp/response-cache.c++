@@ -0,0 +1,436 @@
+// Copyright (c) 2026 Cloudflare, Inc. and contributors
+// Licensed under the MIT License:
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "response-cache.h"
+#include "message.h"
+#include <kj/debug.h>
+#include <kj/list.h>
+#include <kj/map.h>
+#include <kj/timer.h>
+#include <string.h>
+
+namespace capnp {
+
+namespace {
+
+class CachedResponse final: public ResponseHook, public kj::Refcounted {
+  // A copy of a call's results, shared by every caller it's delivered to. We copy rather than
+  // keep the original response so that the call's resources (e.g. its RPC question) are freed.
+
+public:
+  explicit CachedResponse(AnyPointer::Reader results)
+      : message(results.targetSize().wordCount + 1) {
+    capTable.imbue(message.getRoot<AnyPointer>()).set(results);
+  }
+
+  kj::Own<CachedResponse> addRef() {
+    return kj::addRef(*this);
+  }
+
+  AnyPointer::Reader get() {
+    return capTable.imbue(message.getRoot<AnyPointer>()).asReader();
+  }
+
+  bool hasCapabilities() {
+    return capTable.getTable().size() > 0;
+  }
+
+  size_t sizeInWords() {
+    return message.sizeInWords();
+  }
+
+private:
+  MallocMessageBuilder message;
+  BuilderCapabilityTable capTable;
+};
+
+class CachedPipeline final: public PipelineHook, public kj::Refcounted {
+public:
+  explicit CachedPipeline(kj::Own<CachedResponse> response): response(kj::mv(response)) {}
+
+  kj::Own<PipelineHook> addRef() override {
+    return kj::addRef(*this);
+  }
+
+  kj::Own<ClientHook> getPipelinedCap(kj::ArrayPtr<const PipelineOp> ops) override {
+    return response->get().getPipelinedCap(ops);
+  }
+
+private:
+  kj::Own<CachedResponse> response;
+};
+
+Response<AnyPointer> toResponse(kj::Own<CachedResponse>&& response) {
+  auto reader = response->get();
+  return Response<AnyPointer>(reader, kj::mv(response));
+}
+
+}  // namespace
+
+class ResponseCache::Impl final: public ClientHook, public kj::Refcounted,
+                                 private kj::TaskSet::ErrorHandler {
+public:
+  Impl(kj::Own<ClientHook> inner, ResponseCacheOptions options)
+      : inner(kj::mv(inner)), options(kj::mv(options)), tasks(*this) {}
+
+  ~Impl() noexcept(false) {
+    // Dropping the entries drops their calls, which cancels any that no caller is waiting for.
+    clear();
+  }
+
+  ResponseCache::Stats getStats() const {
+    return { hits, coalesced, misses, entries.size(), totalWords };
+  }
+
+  void clear() {
+    for (auto& row: entries) {
+      Entry& entry = *row.value;
+      if (entry.link.isLinked()) lru.remove(entry);
+    }
+    entries.clear();
+    totalWords = 0;
+  }
+
+  Request<AnyPointer, AnyPointer> newCall(
+      uint64_t interfaceId, uint16_t methodId, kj::Maybe<MessageSize> sizeHint,
+      CallHints hints) override {
+    auto result = inner->newCall(interfaceId, methodId, sizeHint, hints);
+    if (!isIdempotent(interfaceId, methodId)) {
+      return result;
+    }
+
+    AnyPointer::Builder builder = result;
+    auto hook = kj::heap<RequestImpl>(kj::addRef(*this), interfaceId, methodId, builder,
+                                      RequestHook::from(kj::mv(result)));
+    return { builder, kj::mv(hook) };
+  }
+
+  VoidPromiseAndPipeline call(uint64_t interfaceId, uint16_t methodId,
+                              kj::Own<CallContextHook>&& context, CallHints hints) override {
+    if (!isIdempotent(interfaceId, methodId)) {
+      return inner->call(interfaceId, methodId, kj::mv(context), hints);
+    }
+
+    // Go through newCall() so that the call can be answered from the cache.
+    auto params = context->getParams();
+    auto request = newCall(interfaceId, methodId, params.targetSize(), hints);
+    request.set(params);
+    request.setDeadline(context->getDeadline());
+    request.setTraceContext(context->getTraceContext());
+    context->releaseParams();
+
+    return context->directTailCall(RequestHook::from(kj::mv(request)));
+  }
+
+  kj::Maybe<ClientHook&> getResolved() override {
+    // Resolving to `inner` would let calls bypass the cache.
+    return nullptr;
+  }
+
+  kj::Maybe<kj::Promise<kj::Own<ClientHook>>> whenMoreResolved() override {
+    return nullptr;
+  }
+
+  kj::Own<ClientHook> addRef() override {
+    return kj::addRef(*this);
+  }
+
+  const void* getBrand() override {
+    return nullptr;
+  }
+
+  kj::Maybe<int> getFd() override {
+    return nullptr;
+  }
+
+private:
+  struct KeyRef {
+    uint64_t interfaceId;
+    uint16_t methodId;
+    kj::ArrayPtr<const word> params;
+    // Canonical form of the params.
+
+    inline bool operator==(const KeyRef& other) const {
+      return interfaceId == other.interfaceId && methodId == other.methodId &&
+             params.size() == other.params.size() &&
+             memcmp(params.begin(), other.params.begin(), params.size() * sizeof(word)) == 0;
+    }
+    inline uint hashCode() const {
+      return kj::hashCode(interfaceId, methodId, params.asBytes());
+    }
+  };
+
+  struct Entry;
+
+  struct EntryHandle: public kj::Refcounted {
+    // Held by an entry's call, so that it can find the entry when it returns without keeping the
+    // entry alive (which would be a cycle, since the entry holds the call). Null once the entry
+    // has been removed from `entries`, after which the call no longer updates it.
+
+    kj::Maybe<Entry&> entry;
+  };
+
+  struct Entry {
+    Entry(uint64_t interfaceId, uint16_t methodId, kj::Array<word> params)
+        : interfaceId(interfaceId), methodId(methodId), params(kj::mv(params)),
+          handle(kj::refcounted<EntryHandle>()) {
+      handle->entry = *this;
+    }
+    ~Entry() noexcept(false) {
+      handle->entry = nullptr;
+    }
+    KJ_DISALLOW_COPY_AND_MOVE(Entry);
+
+    uint64_t interfaceId;
+    uint16_t methodId;
+    kj::Array<word> params;
+    kj::Own<EntryHandle> handle;
+
+    kj::Maybe<kj::ForkedPromise<kj::Own<CachedResponse>>> pending;
+    // The call, until it returns. Identical calls join it in the meantime.
+
+    kj::Maybe<kj::Own<CachedResponse>> response;
+    kj::TimePoint expires = kj::origin<kj::TimePoint>();
+    size_t words = 0;
+    kj::ListLink<Entry> link;
+    // Set once the call has returned, at which point the entry is also in `lru`.
+
+    KeyRef key() const { return { interfaceId, methodId, params }; }
+  };
+
+  kj::Own<ClientHook> inner;
+  ResponseCacheOptions options;
+
+  kj::HashMap<KeyRef, kj::Own<Entry>> entries;
+  // Keys point into the entries themselves.
+
+  kj::List<Entry, &Entry::link> lru;
+  // Entries with responses, least recently used first.
+
+  size_t totalWords = 0;
+  uint64_t hits = 0;
+  uint64_t coalesced = 0;
+  uint64_t misses = 0;
+
+  kj::TaskSet tasks;
+
+  bool isIdempotent(uint64_t interfaceId, uint16_t methodId) {
+    KJ_IF_MAYBE(f, options.isIdempotent) {
+      return (*f)(interfaceId, methodId);
+    } else {
+      return true;
+    }
+  }
+
+  kj::TimePoint now() {
+    KJ_IF_MAYBE(t, options.timer) {
+      return t->now();
+    } else {
+      return kj::systemPreciseMonotonicClock().now();
+    }
+  }
+
+  RemotePromise<AnyPointer> send(uint64_t interfaceId, uint16_t methodId,
+                                 AnyPointer::Reader params, kj::Own<RequestHook> request) {
+    if (params.targetSize().capCount > 0) {
+      // Capabilities have no canonical form, so there's no telling whether two such calls match.
+      return request->send();
+    }
+
+    auto canonical = params.getAs<AnyStruct>().canonicalize();
+
+    KJ_IF_MAYBE(found, entries.find(KeyRef { interfaceId, methodId, canonical })) {
+      Entry& entry = **found;
+      KJ_IF_MAYBE(response, entry.response) {
+        if (now() < entry.expires) {
+          ++hits;
+          lru.remove(entry);
+          lru.add(entry);
+          return respond(response->get()->addRef());
+        }
+        erase(entry);
+      } else {
+        ++coalesced;
+        return respond(KJ_ASSERT_NONNULL(entry.pending).addBranch());
+      }
+    }
+
+    ++misses;
+    auto entry = kj::heap<Entry>(interfaceId, methodId, kj::mv(canonical));
+
+    // Update the cache before any caller sees the response, so that a call made in reaction to
+    // the response is answered from the cache. The continuations only touch `this` through a live
+    // entry, and entries don't outlive the cache.
+    auto result = request->send();
+    auto forked = result.then([this, handle = kj::addRef(*entry->handle)]
+                              (Response<AnyPointer>&& response)
+        -> kj::Promise<kj::Own<CachedResponse>> {
+      auto cached = kj::refcounted<CachedResponse>(response);
+      KJ_IF_MAYBE(e, handle->entry) {
+        complete(*e, cached->addRef());
+      }
+      return kj::mv(cached);
+    }, [this, handle = kj::addRef(*entry->handle)](kj::Exception&& exception)
+        -> kj::Promise<kj::Own<CachedResponse>> {
+      // Don't cache failures; let the next call try again.
+      KJ_IF_MAYBE(e, handle->entry) {
+        erase(*e);
+      }
+      return kj::mv(exception);
+    }).fork();
+    auto promise = forked.addBranch().then([](kj::Own<CachedResponse>&& response) {
+      return toResponse(kj::mv(response));
+    });
+
+    entry->pending = kj::mv(forked);
+    auto key = entry->key();
+    entries.insert(key, kj::mv(entry));
+
+    // The original caller keeps the real pipeline, so that pipelined calls don't have to wait
+    // for the response.
+    return RemotePromise<AnyPointer>(kj::mv(promise), AnyPointer::Pipeline(kj::mv(result)));
+  }
+
+  static RemotePromise<AnyPointer> respond(kj::Own<CachedResponse> response) {
+    auto pipeline = kj::refcounted<CachedPipeline>(response->addRef());
+    return RemotePromise<AnyPointer>(
+        kj::Promise<Response<AnyPointer>>(toResponse(kj::mv(response))),
+        AnyPointer::Pipeline(kj::mv(pipeline)));
+  }
+
+  static RemotePromise<AnyPointer> respond(kj::Promise<kj::Own<CachedResponse>> promise) {
+    auto forked = promise.fork();
+    auto pipeline = newLocalPromisePipeline(forked.addBranch().then(
+        [](kj::Own<CachedResponse>&& response) -> kj::Own<PipelineHook> {
+      return kj::refcounted<CachedPipeline>(kj::mv(response));
+    }));
+    auto result = forked.addBranch().then([](kj::Own<CachedResponse>&& response) {
+      return toResponse(kj::mv(response));
+    });
+    return RemotePromise<AnyPointer>(kj::mv(result), AnyPointer::Pipeline(kj::mv(pipeline)));
+  }
+
+  void complete(Entry& entry, kj::Own<CachedResponse> response) {
+    // From now on, identical calls get `response` rather than joining the call.
+    dropPending(entry);
+
+    entry.words = entry.params.size() + response->sizeInWords();
+    if (response->hasCapabilities() || options.ttl <= 0 * kj::NANOSECONDS ||
+        entry.words > options.maxWords) {
+      erase(entry);
+      return;
+    }
+
+    entry.response = kj::mv(response);
+    entry.expires = now() + options.ttl;
+    lru.add(entry);
+    totalWords += entry.words;
+
+    while (lru.size() > options.maxEntries || totalWords > options.maxWords) {
+      erase(lru.front());
+    }
+  }
+
+  void erase(Entry& entry) {
+    if (entry.link.isLinked()) {
+      lru.remove(entry);
+      totalWords -= entry.words;
+    }
+    dropPending(entry);
+
+    // Take ownership before erasing, since the key points into the entry.
+    auto key = entry.key();
+    auto owned = kj::mv(KJ_ASSERT_NONNULL(entries.find(key)));
+    KJ_ASSERT(entries.erase(key));
+  }
+
+  void dropPending(Entry& entry) {
+    KJ_IF_MAYBE(pending, entry.pending) {
+      // We may be running inside the call's own continuation, so drop it later. If nobody else is
+      // waiting for the call by then, this cancels it.
+      tasks.add(kj::evalLater([pending = kj::mv(*pending)]() {}));
+      entry.pending = nullptr;
+    }
+  }
+
+  void taskFailed(kj::Exception&& exception) override {
+    KJ_LOG(ERROR, exception);
+  }
+
+  class RequestImpl final: public RequestHook {
+  public:
+    RequestImpl(kj::Own<Impl> parent, uint64_t interfaceId, uint16_t methodId,
+                AnyPointer::Builder params, kj::Own<RequestHook> inner)
+        : parent(kj::mv(parent)), interfaceId(interfaceId), methodId(methodId),
+          params(params), inner(kj::mv(inner)) {}
+
+    RemotePromise<AnyPointer> send() override {
+      return parent->send(interfaceId, methodId, params.asReader(), kj::mv(inner));
+    }
+
+    kj::Promise<void> sendStreaming() override {
+      return inner->sendStreaming();
+    }
+
+    AnyPointer::Pipeline sendForPipeline() override {
+      // Nobody will see the results, so there's nothing to cache.
+      return inner->sendForPipeline();
+    }
+
+    const void* getBrand() override {
+      return nullptr;
+    }
+
+    void setDeadline(kj::TimePoint deadline) override {
+      inner->setDeadline(deadline);
+    }
+
+    void setTraceContext(const TraceContext& context) override {
+      inner->setTraceContext(context);
+    }
+
+  private:
+    kj::Own<Impl> parent;
+    uint64_t interfaceId;
+    uint16_t methodId;
+    AnyPointer::Builder params;
+    kj::Own<RequestHook> inner;
+  };
+};
+
+ResponseCache::ResponseCache(Capability::Client inner, ResponseCacheOptions options)
+    : impl(kj::refcounted<Impl>(ClientHook::from(kj::mv(inner)), kj::mv(options))) {}
+
+ResponseCache::~ResponseCache() noexcept(false) {}
+
+Capability::Client ResponseCache::getClientInternal() {
+  return Capability::Client(impl->addRef());
+}
+
+ResponseCache::Stats ResponseCache::getStats() const {
+  return impl->getStats();
+}
+
+void ResponseCache::clear() {
+  impl->clear();
+}
+
+}  // namespace capnp
@@ -0,0 +1,123 @@
+// Copyright (c) 2026 Cloudflare, Inc. and contributors
+// Licensed under the MIT License:
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <capnp/capability.h>
+#include <kj/function.h>
+#include <kj/time.h>
+
+CAPNP_BEGIN_HEADER
+
+namespace kj {
+  class Timer;
+}
+
+namespace capnp {
+
+struct ResponseCacheOptions {
+  kj::Maybe<kj::Function<bool(uint64_t interfaceId, uint16_t methodId)>> isIdempotent;
+  // Decides which methods may be cached. A method qualifies if calling it twice with the same
+  // params has the same effect as calling it once, and its results are the same for every caller.
+  // If null, every method qualifies. Calls to other methods pass through unchanged.
+
+  kj::Maybe<kj::Timer&> timer;
+  kj::Duration ttl = 1 * kj::SECONDS;
+  // How long a response stays cached after it arrives. If `timer` is null,
+  // `kj::systemPreciseMonotonicClock()` is used instead. With a TTL of zero, nothing is cached,
+  // but identical calls made while one is already in flight are still coalesced into it.
+
+  size_t maxEntries = 1024;
+  size_t maxWords = 1u << 20;
+  // Bounds on the number of cached responses and on their total size, including their keys. When
+  // either is exceeded, the least recently used responses are evicted.
+};
+
+class ResponseCache {
+  // Wraps a capability so that calls to its idempotent methods are answered from a cache of
+  // earlier responses, keyed by the method and the canonical form of the params. A call that
+  // is identical to one still in flight waits for that call's response rather than being sent
+  // again. Hot read paths thereby skip both the network and the server.
+  //
+  // Only successful responses are cached. Calls whose params contain capabilities are never
+  // cached, since they have no canonical form, and neither are responses which contain
+  // capabilities (though they are still shared among coalesced calls). Once a call has been sent,
+  // it runs to completion even if all of its callers cancel, so that its response can be cached.
+  //
+  // Example usage might look like:
+  //
+  //     ResponseCacheOptions options;
+  //     options.isIdempotent = [](uint64_t interfaceId, uint16_t methodId) {
+  //       return interfaceId == typeId<Directory>() && methodId == LOOKUP_METHOD_ID;
+  //     };
+  //     ResponseCache cache(directory, kj::mv(options));
+  //     Directory::Client cached = cache.getClient<Directory>();
+
+public:
+  explicit ResponseCache(Capability::Client inner,
+                         ResponseCacheOptions options = ResponseCacheOptions());
+  KJ_DISALLOW_COPY_AND_MOVE(ResponseCache);
+  ~ResponseCache() noexcept(false);
+
+  template <typename T = Capability>
+  typename T::Client getClient();
+  // Get a capability which forwards calls to `inner`, answering them from the cache where
+  // possible. The capability remains usable after the ResponseCache is destroyed.
+
+  struct Stats {
+    uint64_t hits;
+    // Calls answered from a cached response.
+
+    uint64_t coalesced;
+    // Calls which waited for an identical call already in flight.
+
+    uint64_t misses;
+    // Cacheable calls which had to be sent to `inner`.
+
+    size_t entries;
+    size_t words;
+    // Current number and total size of cached responses.
+  };
+
+  Stats getStats() const;
+
+  void clear();
+  // Discard all cached responses. Calls in flight are unaffected, but their responses won't be
+  // cached, and later calls won't be coalesced into them.
+
+private:
+  class Impl;
+  kj::Own<Impl> impl;
+
+  Capability::Client getClientInternal();
+};
+
+// =======================================================================================
+// inline implementation details
+
+template <typename T>
+inline typename T::Client ResponseCache::getClient() {
+  return getClientInternal().castAs<T>();
+}
+
+}  // namespace capnp
+
+CAPNP_END_HEADER
@@ -29,11 +29,17 @@
 
 CAPNP_BEGIN_HEADER
 
+namespace kj {
+  class Timer;
+}
+
 namespace capnp {
 
 class OutgoingRpcMessage;
 class IncomingRpcMessage;
 class RpcFlowController;
+class RpcCallScheduler;
+class RpcSpanExporter;
 
 template <typename SturdyRefHostId>
 class RpcSystem;
@@ -86,6 +92,9 @@ public:
   ~RpcSystemBase() noexcept(false);
 
   void setTraceEncoder(kj::Function<kj::String(const kj::Exception&)> func);
+  void setTimer(kj::Timer& timer);
+  void setCallScheduler(kj::Function<kj::Own<RpcCallScheduler>()> factory);
+  void setSpanExporter(RpcSpanExporter& exporter);
 
   kj::Promise<void> run();
 
@@ -101,6 +110,10 @@ private:
   friend class capnp::RpcSystem;
 };
 
+uint64_t flatPayloadCopiesForTest();
+// Counts the payloads this thread forwarded (e.g. through a proxy) with a flat copy, as opposed to
+// falling back to a deep copy.
+
 }  // namespace _ (private)
 }  // namespace capnp
 
@@ -201,7 +201,11 @@ public:
   TestNetworkAdapter(TestNetwork& network, kj::StringPtr self): network(network), self(self) {}
 
   ~TestNetworkAdapter() {
-    kj::Exception exception = KJ_EXCEPTION(FAILED, "Network was destroyed.");
+    disconnectAll(KJ_EXCEPTION(FAILED, "Network was destroyed."));
+  }
+
+  void disconnectAll(kj::Exception&& exception) {
+    // Fails every connection's receives with `exception`, as if the network had dropped them.
     for (auto& entry: connections) {
       entry.second->disconnect(kj::cp(exception));
     }
@@ -1303,6 +1307,44 @@ TEST(Rpc, Abort) {
   EXPECT_TRUE(conn->receiveIncomingMessage().wait(context.waitScope) == nullptr);
 }
 
+class SpanLog final: public RpcSpanExporter {
+public:
+  kj::Vector<RpcSpan> spans;
+
+  void exportSpan(const RpcSpan& span) override {
+    spans.add(span);
+  }
+};
+
+KJ_TEST("calls in flight when the connection drops still export their spans") {
+  TestContext context;
+  SpanLog log;
+  context.rpcClient.setSpanExporter(log);
+
+  auto client = context.connect(test::TestSturdyRefObjectId::Tag::TEST_MORE_STUFF)
+      .castAs<test::TestMoreStuff>();
+
+  int callCount = 0;
+  auto trace = TraceContext::newTrace();
+  auto request = client.neverReturnRequest();
+  request.setCap(kj::heap<TestInterfaceImpl>(callCount));
+  request.setTraceContext(trace);
+  auto promise = request.send();
+  KJ_EXPECT(!promise.poll(context.waitScope));
+  KJ_EXPECT(log.spans.size() == 0);
+
+  context.clientNetwork.disconnectAll(KJ_EXCEPTION(DISCONNECTED, "test disconnect"));
+  KJ_EXPECT_THROW_RECOVERABLE_MESSAGE("test disconnect",
+      promise.ignoreResult().wait(context.waitScope));
+
+  KJ_ASSERT(log.spans.size() == 1);
+  auto& span = log.spans[0];
+  KJ_EXPECT(span.kind == RpcSpan::Kind::CLIENT);
+  KJ_EXPECT(span.outcome == RpcSpan::Outcome::THREW);
+  KJ_EXPECT(span.parentSpanId == trace.spanId);
+  KJ_EXPECT(span.interfaceId == typeId<test::TestMoreStuff>());
+}
+
 KJ_TEST("loopback bootstrap()") {
   int callCount = 0;
   test::TestInterface::Client bootstrap = kj::heap<TestInterfaceImpl>(callCount);
@@ -32,9 +32,12 @@
 
 #include "rpc-twoparty.h"
 #include "test-util.h"
+#include "serialize-async.h"
+#include "serialize.h"
 #include <capnp/rpc.capnp.h>
 #include <kj/debug.h>
 #include <kj/thread.h>
+#include <kj/timer.h>
 #include <kj/compat/gtest.h>
 #include <kj/miniposix.h>
 
@@ -1266,6 +1269,539 @@ KJ_TEST("Two-hop embargo") {
   EXPECT_EQ(5, call5.wait(waitScope).getN());
 }
 
+KJ_TEST("Calls and returns forwarded through a proxy arrive intact") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  int callCount = 0, handleCount = 0;
+
+  // Set up two two-party RPC connections in series. The middle node just proxies requests through,
+  // so the payloads it forwards are copied from received messages.
+  auto frontPipe = kj::newTwoWayPipe();
+  auto backPipe = kj::newTwoWayPipe();
+  TwoPartyClient tpClient(*frontPipe.ends[0]);
+  TwoPartyClient proxyBack(*backPipe.ends[0]);
+  TwoPartyClient proxyFront(*frontPipe.ends[1], proxyBack.bootstrap(), rpc::twoparty::Side::SERVER);
+  TwoPartyClient tpServer(*backPipe.ends[1], kj::heap<TestMoreStuffImpl>(callCount, handleCount),
+      rpc::twoparty::Side::SERVER);
+
+  auto client = tpClient.bootstrap().castAs<test::TestMoreStuff>();
+  auto flatCopies = flatPayloadCopiesForTest();
+
+  {
+    auto request = client.callFooRequest();
+    request.setCap(kj::heap<TestInterfaceImpl>(callCount));
+    KJ_EXPECT(request.send().wait(waitScope).getS() == "bar");
+  }
+
+  // The proxy forwarded the params and the results without deep-copying them.
+  KJ_EXPECT(flatPayloadCopiesForTest() - flatCopies >= 2, flatPayloadCopiesForTest() - flatCopies);
+
+  {
+    auto request = client.echoRequest();
+    request.setCap(kj::heap<TestCallOrderImpl>());
+    auto cap = request.send().wait(waitScope).getCap();
+    KJ_EXPECT(getCallSequence(cap, 0).wait(waitScope).getN() == 0);
+  }
+
+  {
+    auto request = client.holdRequest();
+    request.setCap(kj::heap<TestInterfaceImpl>(callCount));
+    request.send().wait(waitScope);
+    KJ_EXPECT(client.callHeldRequest().send().wait(waitScope).getS() == "bar");
+
+    auto held = client.getHeldRequest().send().wait(waitScope).getCap();
+    auto fooRequest = held.fooRequest();
+    fooRequest.setI(123);
+    fooRequest.setJ(true);
+    KJ_EXPECT(fooRequest.send().wait(waitScope).getX() == "foo");
+  }
+}
+
+class DeadlineServer final: public test::TestMoreStuff::Server {
+public:
+  DeadlineServer(kj::Maybe<kj::TimePoint>& deadline, bool& canceled)
+      : deadline(deadline), canceled(canceled) {}
+
+protected:
+  kj::Promise<void> neverReturn(NeverReturnContext context) override {
+    deadline = context.getDeadline();
+    return kj::Promise<void>(kj::NEVER_DONE).attach(kj::defer([&canceled = canceled]() {
+      canceled = true;
+    }));
+  }
+
+private:
+  kj::Maybe<kj::TimePoint>& deadline;
+  bool& canceled;
+};
+
+KJ_TEST("Call deadlines pass through a proxy and cancel the call when they expire") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+  kj::TimerImpl timer(kj::origin<kj::TimePoint>());
+
+  kj::Maybe<kj::TimePoint> serverDeadline;
+  bool canceled = false;
+
+  auto frontPipe = kj::newTwoWayPipe();
+  auto backPipe = kj::newTwoWayPipe();
+  TwoPartyClient tpClient(*frontPipe.ends[0]);
+  TwoPartyClient proxyBack(*backPipe.ends[0]);
+  TwoPartyClient proxyFront(*frontPipe.ends[1], proxyBack.bootstrap(), rpc::twoparty::Side::SERVER);
+  TwoPartyClient tpServer(*backPipe.ends[1], kj::heap<DeadlineServer>(serverDeadline, canceled),
+      rpc::twoparty::Side::SERVER);
+  tpClient.setTimer(timer);
+  proxyBack.setTimer(timer);
+  proxyFront.setTimer(timer);
+  tpServer.setTimer(timer);
+
+  auto client = tpClient.bootstrap().castAs<test::TestMoreStuff>();
+
+  auto deadline = timer.now() + 1 * kj::SECONDS;
+  auto request = client.neverReturnRequest();
+  request.setDeadline(deadline);
+  auto promise = request.send();
+  KJ_EXPECT(!promise.poll(waitScope));
+
+  // All parties share one timer, so the deadline arrives at the server exactly as sent.
+  KJ_EXPECT(KJ_ASSERT_NONNULL(serverDeadline) == deadline);
+  KJ_EXPECT(!canceled);
+
+  timer.advanceTo(deadline - 1 * kj::NANOSECONDS);
+  KJ_EXPECT(!promise.poll(waitScope));
+  KJ_EXPECT(!canceled);
+
+  timer.advanceTo(deadline);
+  KJ_EXPECT_THROW_RECOVERABLE_MESSAGE("call deadline exceeded",
+      promise.ignoreResult().wait(waitScope));
+  waitScope.poll();
+  KJ_EXPECT(canceled);
+}
+
+class SpanLog final: public RpcSpanExporter {
+public:
+  kj::Vector<RpcSpan> spans;
+
+  void exportSpan(const RpcSpan& span) override {
+    spans.add(span);
+  }
+};
+
+class TracedBackend final: public test::TestInterface::Server {
+public:
+  TracedBackend(kj::Maybe<TraceContext>& seen): seen(seen) {}
+
+protected:
+  kj::Promise<void> foo(FooContext context) override {
+    seen = context.getTraceContext();
+    context.initResults().setX("backend");
+    return kj::READY_NOW;
+  }
+
+private:
+  kj::Maybe<TraceContext>& seen;
+};
+
+class TracedMiddle final: public test::TestInterface::Server {
+public:
+  TracedMiddle(test::TestInterface::Client backend): backend(kj::mv(backend)) {}
+
+protected:
+  kj::Promise<void> foo(FooContext context) override {
+    // Sent while the method runs, so it's attributed to this call's span.
+    return backend.fooRequest().send().then([context](auto&& response) mutable {
+      context.initResults().setX(response.getX());
+    });
+  }
+
+private:
+  test::TestInterface::Client backend;
+};
+
+KJ_TEST("Trace contexts cross connections and spans link parent to child") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  SpanLog log;
+  kj::Maybe<TraceContext> backendSeen;
+
+  auto frontPipe = kj::newTwoWayPipe();
+  auto backPipe = kj::newTwoWayPipe();
+  TwoPartyClient tpClient(*frontPipe.ends[0]);
+  TwoPartyClient middleBack(*backPipe.ends[0]);
+  TwoPartyClient middleFront(*frontPipe.ends[1],
+      kj::heap<TracedMiddle>(middleBack.bootstrap().castAs<test::TestInterface>()),
+      rpc::twoparty::Side::SERVER);
+  TwoPartyClient tpServer(*backPipe.ends[1], kj::heap<TracedBackend>(backendSeen),
+      rpc::twoparty::Side::SERVER);
+  tpClient.setSpanExporter(log);
+  middleBack.setSpanExporter(log);
+  middleFront.setSpanExporter(log);
+  tpServer.setSpanExporter(log);
+
+  auto client = tpClient.bootstrap().castAs<test::TestInterface>();
+
+  {
+    // Untraced calls record no spans and carry no context.
+    KJ_EXPECT(client.fooRequest().send().wait(waitScope).getX() == "backend");
+    KJ_EXPECT(backendSeen == nullptr);
+    KJ_EXPECT(log.spans.size() == 0);
+  }
+
+  auto trace = TraceContext::newTrace();
+  auto request = client.fooRequest();
+  request.setTraceContext(trace);
+  KJ_EXPECT(request.send().wait(waitScope).getX() == "backend");
+
+  // Spans end innermost first.
+  KJ_ASSERT(log.spans.size() == 4);
+  auto& backendSpan = log.spans[0];
+  auto& middleClientSpan = log.spans[1];
+  auto& middleServerSpan = log.spans[2];
+  auto& clientSpan = log.spans[3];
+
+  KJ_EXPECT(clientSpan.kind == RpcSpan::Kind::CLIENT);
+  KJ_EXPECT(middleServerSpan.kind == RpcSpan::Kind::SERVER);
+  KJ_EXPECT(middleClientSpan.kind == RpcSpan::Kind::CLIENT);
+  KJ_EXPECT(backendSpan.kind == RpcSpan::Kind::SERVER);
+
+  for (auto& span: log.spans) {
+    KJ_EXPECT(span.context.traceIdHigh == trace.traceIdHigh);
+    KJ_EXPECT(span.context.traceIdLow == trace.traceIdLow);
+    KJ_EXPECT(span.interfaceId == typeId<test::TestInterface>());
+    KJ_EXPECT(span.methodId == 0);
+    KJ_EXPECT(span.outcome == RpcSpan::Outcome::RETURNED);
+    KJ_EXPECT(span.startTime <= span.endTime);
+  }
+
+  KJ_EXPECT(clientSpan.parentSpanId == trace.spanId);
+  KJ_EXPECT(middleServerSpan.parentSpanId == clientSpan.context.spanId);
+  KJ_EXPECT(middleClientSpan.parentSpanId == middleServerSpan.context.spanId);
+  KJ_EXPECT(backendSpan.parentSpanId == middleClientSpan.context.spanId);
+
+  auto& seen = KJ_ASSERT_NONNULL(backendSeen);
+  KJ_EXPECT(seen.traceIdHigh == trace.traceIdHigh);
+  KJ_EXPECT(seen.traceIdLow == trace.traceIdLow);
+  KJ_EXPECT(seen.spanId == backendSpan.context.spanId);
+}
+
+class SchedulingServer final: public test::TestInterface::Server {
+public:
+  SchedulingServer(kj::Vector<kj::String>& log, kj::Promise<void>& blocker)
+      : log(log), blocker(blocker) {}
+
+protected:
+  kj::Promise<void> foo(FooContext context) override {
+    uint i = context.getParams().getI();
+    log.add(kj::str("foo ", i));
+    context.initResults().setX("foo");
+    return i == 1 ? kj::mv(blocker) : kj::READY_NOW;
+  }
+
+  kj::Promise<void> bar(BarContext context) override {
+    log.add(kj::str("bar"));
+    return kj::READY_NOW;
+  }
+
+private:
+  kj::Vector<kj::String>& log;
+  kj::Promise<void>& blocker;
+};
+
+KJ_TEST("Call scheduler limits concurrency, prioritizes and sheds queued calls") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  kj::Vector<kj::String> log;
+  auto paf = kj::newPromiseAndFulfiller<void>();
+
+  auto pipe = kj::newTwoWayPipe();
+  TwoPartyClient tpClient(*pipe.ends[0]);
+  TwoPartyClient tpServer(*pipe.ends[1], kj::heap<SchedulingServer>(log, paf.promise),
+      rpc::twoparty::Side::SERVER);
+  tpServer.setCallScheduler([]() {
+    RpcCallScheduler::PriorityOptions options;
+    options.maxConcurrentCalls = 1;
+    options.maxQueuedCalls = 2;
+    options.priority = [](uint64_t interfaceId, uint16_t methodId) {
+      // bar() skips ahead of foo().
+      return methodId == 1 ? 1 : 0;
+    };
+    return RpcCallScheduler::newPriorityScheduler(kj::mv(options));
+  });
+
+  auto client = tpClient.bootstrap().castAs<test::TestInterface>();
+  auto callFoo = [&](uint i) {
+    auto request = client.fooRequest();
+    request.setI(i);
+    return request.send();
+  };
+
+  auto foo1 = callFoo(1);
+  KJ_EXPECT(!foo1.poll(waitScope));
+
+  // The queue holds two calls. bar() displaces the last foo() rather than failing, but another
+  // foo() has nothing to displace.
+  auto foo2 = callFoo(2);
+  auto foo3 = callFoo(3);
+  auto bar = client.barRequest().send();
+  auto foo4 = callFoo(4);
+  KJ_EXPECT_THROW_RECOVERABLE_MESSAGE("shed from the queue", foo3.wait(waitScope));
+  KJ_EXPECT_THROW_RECOVERABLE_MESSAGE("too many calls queued", foo4.wait(waitScope));
+  KJ_EXPECT(!foo2.poll(waitScope));
+  KJ_EXPECT(!bar.poll(waitScope));
+
+  paf.fulfiller->fulfill();
+  foo1.wait(waitScope);
+  foo2.wait(waitScope);
+  bar.wait(waitScope);
+
+  KJ_EXPECT(kj::strArray(log, ", ") == "foo 1, bar, foo 2", kj::strArray(log, ", "));
+}
+
+class BulkServer final: public test::TestInterface::Server {
+public:
+  BulkServer(kj::StringPtr bulk, kj::Vector<kj::String>& log): bulk(bulk), log(log) {}
+
+protected:
+  kj::Promise<void> foo(FooContext context) override {
+    uint i = context.getParams().getI();
+    log.add(kj::str("foo ", i));
+    context.initResults().setX(i == 1 ? bulk : "small");
+    return kj::READY_NOW;
+  }
+
+  kj::Promise<void> baz(BazContext context) override {
+    KJ_EXPECT(context.getParams().getS().getTextField() == bulk);
+    log.add(kj::str("baz"));
+    return kj::READY_NOW;
+  }
+
+private:
+  kj::StringPtr bulk;
+  kj::Vector<kj::String>& log;
+};
+
+KJ_TEST("Fragmented large returns don't hold up small returns queued behind them") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  auto bulk = kj::heapString(1 << 20);
+  for (auto i: kj::indices(bulk)) {
+    bulk[i] = 'a' + i % 26;
+  }
+
+  auto runCalls = [&](bool fragment) {
+    kj::Vector<kj::String> serverLog;
+    auto pipe = kj::newTwoWayPipe();
+    TwoPartyClient tpClient(*pipe.ends[0]);
+    TwoPartyClient tpServer(*pipe.ends[1], kj::heap<BulkServer>(bulk, serverLog),
+        rpc::twoparty::Side::SERVER);
+    if (fragment) {
+      tpClient.enableFragmentation(4096);
+      tpServer.enableFragmentation(4096);
+    }
+
+    auto client = tpClient.bootstrap().castAs<test::TestInterface>();
+    client.whenResolved().wait(waitScope);
+
+    kj::Vector<kj::String> log;
+    auto callFoo = [&](uint i) {
+      auto request = client.fooRequest();
+      request.setI(i);
+      return request.send().then([&log, &bulk, i](Response<test::TestInterface::FooResults>&& r) {
+        KJ_EXPECT(r.getX() == (i == 1 ? bulk : kj::StringPtr("small")));
+        log.add(kj::str("foo ", i));
+      }).eagerlyEvaluate(nullptr);
+    };
+
+    auto big = callFoo(1);
+    auto small = callFoo(2);
+    big.wait(waitScope);
+    small.wait(waitScope);
+    KJ_EXPECT(tpServer.getCurrentQueueSize() == 0);
+    return kj::strArray(log, ", ");
+  };
+
+  KJ_EXPECT(runCalls(false) == "foo 1, foo 2");
+  KJ_EXPECT(runCalls(true) == "foo 2, foo 1");
+}
+
+KJ_TEST("Fragmented large calls stay ordered with later calls") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  auto bulk = kj::heapString(1 << 20);
+  for (auto i: kj::indices(bulk)) {
+    bulk[i] = 'a' + i % 26;
+  }
+
+  kj::Vector<kj::String> log;
+  auto pipe = kj::newTwoWayPipe();
+  TwoPartyClient tpClient(*pipe.ends[0]);
+  TwoPartyClient tpServer(*pipe.ends[1], kj::heap<BulkServer>(bulk, log),
+      rpc::twoparty::Side::SERVER);
+  tpClient.enableFragmentation(4096);
+  tpServer.enableFragmentation(4096);
+
+  auto client = tpClient.bootstrap().castAs<test::TestInterface>();
+  auto bazRequest = client.bazRequest();
+  bazRequest.initS().setTextField(bulk);
+  auto baz = bazRequest.send();
+  auto fooRequest = client.fooRequest();
+  fooRequest.setI(2);
+  auto foo = fooRequest.send();
+
+  foo.wait(waitScope);
+  baz.wait(waitScope);
+  KJ_EXPECT(kj::strArray(log, ", ") == "baz, foo 2", kj::strArray(log, ", "));
+}
+
+kj::Promise<void> writeFragment(kj::AsyncOutputStream& stream,
+                                uint32_t id, uint64_t totalSize, size_t dataSize) {
+  auto message = kj::heap<MallocMessageBuilder>();
+  auto fragment = message->initRoot<AnyPointer>().initAs<List<rpc::twoparty::Fragment>>(1)[0];
+  fragment.setId(id);
+  fragment.setTotalSize(totalSize);
+  fragment.initData(dataSize);
+  auto promise = writeMessage(stream, *message);
+  return promise.attach(kj::mv(message));
+}
+
+KJ_TEST("Fragments are rejected unless fragmentation is enabled") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  auto pipe = kj::newTwoWayPipe();
+  TwoPartyVatNetwork network(*pipe.ends[1], rpc::twoparty::Side::SERVER);
+  auto connection = network.accept().wait(waitScope);
+
+  auto write = writeFragment(*pipe.ends[0], 0, 1 << 20, 64).eagerlyEvaluate(nullptr);
+  KJ_EXPECT_THROW_MESSAGE("fragmentation isn't enabled",
+      connection->receiveIncomingMessage().wait(waitScope));
+}
+
+KJ_TEST("Fragment reassembly is bounded per connection") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  auto pipe = kj::newTwoWayPipe();
+  TwoPartyVatNetwork network(*pipe.ends[1], rpc::twoparty::Side::SERVER);
+  network.enableFragmentation();
+  auto connection = network.accept().wait(waitScope);
+
+  // One message may claim up to the traversal limit on its own; memory is only allocated as its
+  // data arrives. But a second one may not take the total past MAX_FRAGMENTED_BYTES_IN_FLIGHT.
+  auto half = rpc::twoparty::MAX_FRAGMENTED_BYTES_IN_FLIGHT / 2;
+  auto write = writeFragment(*pipe.ends[0], 0, half + 8, 64)
+      .then([&]() { return writeFragment(*pipe.ends[0], 1, half, 64); })
+      .eagerlyEvaluate(nullptr);
+  KJ_EXPECT_THROW_MESSAGE("too many fragmented bytes",
+      connection->receiveIncomingMessage().wait(waitScope));
+}
+
+KJ_TEST("Probe echoes are consumed even when they arrive fragmented") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  auto pipe = kj::newTwoWayPipe();
+  TwoPartyVatNetwork network(*pipe.ends[1], rpc::twoparty::Side::SERVER);
+  network.enableFragmentation();
+  auto connection = network.accept().wait(waitScope);
+
+  MallocMessageBuilder echo;
+  echo.initRoot<rpc::Message>().initUnimplemented().initObsoleteDelete()
+      .initAs<rpc::twoparty::Ping>().setId(1);
+  auto echoWords = messageToFlatArray(echo);
+  auto echoBytes = echoWords.asBytes();
+
+  MallocMessageBuilder fragmentMessage;
+  auto fragment = fragmentMessage.initRoot<AnyPointer>()
+      .initAs<List<rpc::twoparty::Fragment>>(1)[0];
+  fragment.setId(0);
+  fragment.setTotalSize(echoBytes.size());
+  fragment.setData(echoBytes);
+
+  MallocMessageBuilder next;
+  next.initRoot<rpc::Message>().initAbort().setReason("next");
+
+  auto write = writeMessage(*pipe.ends[0], fragmentMessage)
+      .then([&]() { return writeMessage(*pipe.ends[0], next); })
+      .eagerlyEvaluate(nullptr);
+
+  // The echo never reaches the RPC system, which would take it for a message it failed to handle.
+  auto message = KJ_ASSERT_NONNULL(connection->receiveIncomingMessage().wait(waitScope));
+  KJ_EXPECT(message->getBody().getAs<rpc::Message>().isAbort());
+}
+
+KJ_TEST("RTT probes are echoed by any peer and feed connection stats") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+  kj::TimerImpl timer(kj::origin<kj::TimePoint>());
+  TestMonotonicClock clock;
+  int callCount = 0;
+
+  auto pipe = kj::newTwoWayPipe();
+  TwoPartyVatNetwork clientNetwork(*pipe.ends[0], rpc::twoparty::Side::CLIENT,
+      capnp::ReaderOptions(), clock);
+  auto rpcClient = makeRpcClient(clientNetwork);
+
+  MallocMessageBuilder vatId;
+  vatId.getRoot<rpc::twoparty::VatId>().setSide(rpc::twoparty::Side::SERVER);
+  auto client = rpcClient.bootstrap(vatId.getRoot<rpc::twoparty::VatId>())
+      .castAs<test::TestInterface>();
+  clientNetwork.enableRttProbing(timer, 1 * kj::SECONDS);
+
+  // The bootstrap has been queued but not written; the stall grows with the clock.
+  clock.increment(3 * kj::MILLISECONDS);
+  auto stats = clientNetwork.getStats();
+  KJ_EXPECT(stats.smoothedRtt == nullptr);
+  KJ_EXPECT(stats.questionsInFlight == 1);
+  KJ_EXPECT(stats.queuedMessages == 1);
+  KJ_EXPECT(stats.currentWriteStall == 3 * kj::MILLISECONDS);
+
+  // Fire the first probe. Nobody is reading the other end yet, so it sits in the pipe.
+  timer.advanceTo(timer.now() + 1 * kj::SECONDS);
+  waitScope.poll();
+  stats = clientNetwork.getStats();
+  KJ_EXPECT(stats.queuedMessages == 0);
+  KJ_EXPECT(stats.currentWriteStall == 0 * kj::SECONDS);
+  KJ_EXPECT(stats.totalWriteStall == 3 * kj::MILLISECONDS);
+  KJ_EXPECT(stats.smoothedRtt == nullptr);
+
+  // Bring up a plain server, which knows nothing about probes and just echoes them back as
+  // `unimplemented`.
+  clock.increment(10 * kj::MILLISECONDS);
+  TwoPartyVatNetwork serverNetwork(*pipe.ends[1], rpc::twoparty::Side::SERVER);
+  auto server = makeRpcServer(serverNetwork, kj::heap<TestInterfaceImpl>(callCount));
+
+  client.whenResolved().wait(waitScope);
+  waitScope.poll();
+  stats = clientNetwork.getStats();
+  KJ_EXPECT(stats.questionsInFlight == 0);
+  KJ_EXPECT(KJ_ASSERT_NONNULL(stats.smoothedRtt) == 10 * kj::MILLISECONDS);
+  KJ_EXPECT(stats.rttVariation == 5 * kj::MILLISECONDS);
+
+  // A second, instantaneous sample is smoothed into the estimate.
+  timer.advanceTo(timer.now() + 1 * kj::SECONDS);
+  waitScope.poll();
+  stats = clientNetwork.getStats();
+  KJ_EXPECT(KJ_ASSERT_NONNULL(stats.smoothedRtt) == 8750 * kj::MICROSECONDS);
+  KJ_EXPECT(stats.rttVariation == 6250 * kj::MICROSECONDS);
+
+  // Calls are tracked as questions until their return arrives, and the echoed probes never
+  // confused the RPC system.
+  auto request = client.fooRequest();
+  request.setI(123);
+  request.setJ(true);
+  auto promise = request.send();
+  KJ_EXPECT(clientNetwork.getStats().questionsInFlight == 1);
+  KJ_EXPECT(promise.wait(waitScope).getX() == "foo");
+  KJ_EXPECT(clientNetwork.getStats().questionsInFlight == 0);
+  KJ_EXPECT(callCount == 1);
+}
+
 }  // namespace
 }  // namespace _
 }  // namespace capnp
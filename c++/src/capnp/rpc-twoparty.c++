@@ -21,11 +21,22 @@
 
 #include "rpc-twoparty.h"
 #include "serialize-async.h"
+#include "serialize.h"
+#include <capnp/rpc.capnp.h>
 #include <kj/debug.h>
 #include <kj/io.h>
 
 namespace capnp {
 
+static bool isShortLivedTwoPartyMessage(MessageReader& reader) {
+  auto root = reader.getRoot<AnyPointer>();
+  if (root.getPointerType() == PointerType::LIST) {
+    // A `Fragment`, which receiveFragment() copies out of immediately.
+    return true;
+  }
+  return IncomingRpcMessage::isShortLivedRpcMessage(root);
+}
+
 TwoPartyVatNetwork::TwoPartyVatNetwork(
     kj::OneOf<MessageStream*, kj::Own<MessageStream>>&& stream,
     uint maxFdsPerMessage,
@@ -40,7 +51,8 @@ TwoPartyVatNetwork::TwoPartyVatNetwork(
       receiveOptions(receiveOptions),
       previousWrite(kj::READY_NOW),
       clock(clock),
-      currentOutgoingMessageSendTime(clock.now()) {
+      currentOutgoingMessageSendTime(clock.now()),
+      writeStallStart(currentOutgoingMessageSendTime) {
   peerVatId.initRoot<rpc::twoparty::VatId>().setSide(
       side == rpc::twoparty::Side::CLIENT ? rpc::twoparty::Side::SERVER
                                           : rpc::twoparty::Side::CLIENT);
@@ -68,7 +80,7 @@ TwoPartyVatNetwork::TwoPartyVatNetwork(kj::AsyncIoStream& stream, rpc::twoparty:
                                        const kj::MonotonicClock& clock)
     : TwoPartyVatNetwork(
           kj::Own<MessageStream>(kj::heap<BufferedMessageStream>(
-              stream, IncomingRpcMessage::getShortLivedCallback())),
+              stream, isShortLivedTwoPartyMessage)),
           0, side, receiveOptions, clock) {}
 
 TwoPartyVatNetwork::TwoPartyVatNetwork(kj::AsyncCapabilityStream& stream, uint maxFdsPerMessage,
@@ -76,7 +88,7 @@ TwoPartyVatNetwork::TwoPartyVatNetwork(kj::AsyncCapabilityStream& stream, uint m
                                        const kj::MonotonicClock& clock)
     : TwoPartyVatNetwork(
           kj::Own<MessageStream>(kj::heap<BufferedMessageStream>(
-              stream, IncomingRpcMessage::getShortLivedCallback())),
+              stream, isShortLivedTwoPartyMessage)),
           maxFdsPerMessage, side, receiveOptions, clock) {}
 
 TwoPartyVatNetwork::~TwoPartyVatNetwork() noexcept(false) {};
@@ -155,6 +167,7 @@ public:
     }
 
     auto sendTime = network.clock.now();
+    this->sendTime = sendTime;
     if (network.queuedMessages.size() == 0) {
       // Optimistically set sendTime when there's no messages in the queue. Without this, sending
       // a message after a long delay could cause getOutgoingMessageWaitTime() to return excessively
@@ -162,6 +175,16 @@ public:
       // but before the write occurs, as we increment currentQueueCount synchronously, but
       // asynchronously update currentOutgoingMessageSendTime.
       network.currentOutgoingMessageSendTime = sendTime;
+      network.writeStallStart = sendTime;
+    }
+
+    switch (message.getRoot<AnyPointer>().asReader().getAs<rpc::Message>().which()) {
+      case rpc::Message::CALL:
+      case rpc::Message::BOOTSTRAP:
+        ++network.questionsInFlight;
+        break;
+      default:
+        break;
     }
 
     // Instead of sending each new message as soon as possible, we attempt to batch together small
@@ -178,6 +201,13 @@ public:
       return;
     }
 
+    if (network.fragmentSize > 0) {
+      network.previousWrite = previousWrite.then([&network = network]() {
+        return network.writeFragmentedBatch();
+      }).eagerlyEvaluate(nullptr);
+      return;
+    }
+
     // On the other hand, if pendingMessages was empty, then we should set up the delayed write.
     network.previousWrite = previousWrite.then([this, sendTime]() {
       return kj::evalLast([this, sendTime]() -> kj::Promise<void> {
@@ -185,6 +215,7 @@ public:
         // Swap out the connection's pending messages and write all of them together.
         auto ownMessages = kj::mv(network.queuedMessages);
         network.currentQueueSize = 0;
+        network.noteQueueDrained();
         auto messages =
           kj::heapArray<MessageAndFds>(ownMessages.size());
         for (int i = 0; i < messages.size(); ++i) {
@@ -193,14 +224,7 @@ public:
         }
         return network.getStream().writeMessages(messages).attach(kj::mv(ownMessages), kj::mv(messages));
       }).catch_([this](kj::Exception&& e) {
-        // Since no one checks write failures, we need to propagate them into read failures,
-        // otherwise we might get stuck sending all messages into a black hole and wondering why
-        // the peer never replies.
-        network.readCancelReason = kj::cp(e);
-        if (!network.readCanceler.isEmpty()) {
-          network.readCanceler.cancel(kj::cp(e));
-        }
-        kj::throwRecoverableException(kj::mv(e));
+        network.writeFailed(kj::mv(e));
       });
     }).attach(kj::addRef(*this))
       // Note that it's important that the eagerlyEvaluate() come *after* the attach() because
@@ -217,8 +241,152 @@ private:
   TwoPartyVatNetwork& network;
   MallocMessageBuilder message;
   kj::Array<int> fds;
+
+  // The rest is used only when fragmentation is enabled.
+
+  kj::TimePoint sendTime = kj::origin<kj::TimePoint>();
+
+  kj::Array<word> flat;
+  // The serialized message, once we've started sending it in fragments.
+
+  size_t flatOffset = 0;
+  // Number of bytes of `flat` sent so far.
+
+  uint32_t fragmentId = 0;
+
+  bool mayOvertakeReturns() {
+    // Calls and returns may be delivered ahead of a fragmented return sent before them, and only
+    // they are fragmented. See `Fragment` in rpc-twoparty.capnp.
+    switch (message.getRoot<AnyPointer>().asReader().getAs<rpc::Message>().which()) {
+      case rpc::Message::CALL:
+      case rpc::Message::BOOTSTRAP:
+      case rpc::Message::RETURN:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  bool isReturn() {
+    return message.getRoot<AnyPointer>().asReader().getAs<rpc::Message>().isReturn();
+  }
+
+  friend class TwoPartyVatNetwork;
 };
 
+void TwoPartyVatNetwork::writeFailed(kj::Exception&& e) {
+  // Since no one checks write failures, we need to propagate them into read failures,
+  // otherwise we might get stuck sending all messages into a black hole and wondering why
+  // the peer never replies.
+  readCancelReason = kj::cp(e);
+  if (!readCanceler.isEmpty()) {
+    readCanceler.cancel(kj::cp(e));
+  }
+  kj::throwRecoverableException(kj::mv(e));
+}
+
+void TwoPartyVatNetwork::enableFragmentation(size_t size) {
+  KJ_REQUIRE(size > 0, "fragment size must be positive");
+  fragmentSize = (size + sizeof(word) - 1) / sizeof(word) * sizeof(word);
+}
+
+kj::Promise<void> TwoPartyVatNetwork::writeFragmentedBatch() {
+  return kj::evalLast([this]() -> kj::Promise<void> {
+    currentOutgoingMessageSendTime = queuedMessages.front()->sendTime;
+
+    kj::Vector<MessageAndFds> batch;
+    kj::Vector<kj::Own<OutgoingMessageImpl>> written;
+    kj::Vector<kj::Own<MallocMessageBuilder>> fragments;
+    kj::Vector<kj::Own<OutgoingMessageImpl>> remaining;
+
+    bool blocked = false;
+    // An earlier message which nothing may overtake hasn't been completely sent.
+
+    bool behindReturn = false;
+    // An earlier return hasn't been completely sent, so only calls and returns may be sent.
+
+    for (auto& queued: queuedMessages) {
+      auto& message = *queued;
+      bool mayOvertake = message.mayOvertakeReturns();
+      if (blocked || (behindReturn && !mayOvertake)) {
+        remaining.add(kj::mv(queued));
+        continue;
+      }
+
+      size_t size = message.message.sizeInWords() * sizeof(word);
+      if (size <= fragmentSize || !mayOvertake || message.fds.size() > 0) {
+        // Send the whole message.
+        batch.add(MessageAndFds { message.message.getSegmentsForOutput(), message.fds });
+        currentQueueSize -= size;
+        written.add(kj::mv(queued));
+        continue;
+      }
+
+      if (message.flat == nullptr) {
+        if (fragmentingCount >= rpc::twoparty::MAX_FRAGMENTED_MESSAGES_IN_FLIGHT) {
+          // Can't start another fragmented message yet.
+          (message.isReturn() ? behindReturn : blocked) = true;
+          remaining.add(kj::mv(queued));
+          continue;
+        }
+        size_t flatSize = computeSerializedSizeInWords(message.message) * sizeof(word);
+        if (fragmentingCount > 0 &&
+            fragmentingBytes + flatSize > rpc::twoparty::MAX_FRAGMENTED_BYTES_IN_FLIGHT) {
+          // The receiver wouldn't accept this much at once; wait for others to finish.
+          (message.isReturn() ? behindReturn : blocked) = true;
+          remaining.add(kj::mv(queued));
+          continue;
+        }
+        message.flat = messageToFlatArray(message.message);
+        message.fragmentId = nextFragmentId++;
+        ++fragmentingCount;
+        fragmentingBytes += flatSize;
+      }
+
+      auto flatBytes = message.flat.asBytes();
+      auto chunk = flatBytes.slice(message.flatOffset,
+          kj::min(message.flatOffset + fragmentSize, flatBytes.size()));
+      message.flatOffset += chunk.size();
+
+      auto fragmentMessage = kj::heap<MallocMessageBuilder>(16);
+      auto fragment = fragmentMessage->initRoot<AnyPointer>()
+          .initAs<List<rpc::twoparty::Fragment>>(1)[0];
+      fragment.setId(message.fragmentId);
+      fragment.setTotalSize(flatBytes.size());
+      fragment.adoptData(fragmentMessage->getOrphanage().referenceExternalData(chunk));
+      batch.add(MessageAndFds { fragmentMessage->getSegmentsForOutput(), nullptr });
+      fragments.add(kj::mv(fragmentMessage));
+
+      if (message.flatOffset == flatBytes.size()) {
+        --fragmentingCount;
+        fragmentingBytes -= flatBytes.size();
+        currentQueueSize -= size;
+        written.add(kj::mv(queued));
+      } else {
+        (message.isReturn() ? behindReturn : blocked) = true;
+        written.add(kj::addRef(message));
+        remaining.add(kj::mv(queued));
+      }
+    }
+
+    queuedMessages = kj::mv(remaining);
+    if (queuedMessages.empty()) {
+      noteQueueDrained();
+    }
+
+    auto promise = getStream().writeMessages(batch)
+        .attach(kj::mv(batch), kj::mv(fragments), kj::mv(written));
+    if (queuedMessages.empty()) {
+      // Whatever is sent next will start a new write.
+      return kj::mv(promise);
+    } else {
+      return promise.then([this]() { return writeFragmentedBatch(); });
+    }
+  }).catch_([this](kj::Exception&& e) {
+    writeFailed(kj::mv(e));
+  });
+}
+
 kj::Duration TwoPartyVatNetwork::getOutgoingMessageWaitTime() {
   if (queuedMessages.size() > 0) {
     return clock.now() - currentOutgoingMessageSendTime;
@@ -227,6 +395,100 @@ kj::Duration TwoPartyVatNetwork::getOutgoingMessageWaitTime() {
   }
 }
 
+void TwoPartyVatNetwork::noteQueueDrained() {
+  totalWriteStall += clock.now() - writeStallStart;
+}
+
+TwoPartyVatNetwork::ConnectionStats TwoPartyVatNetwork::getStats() {
+  ConnectionStats stats;
+  stats.smoothedRtt = smoothedRtt;
+  stats.rttVariation = rttVariation;
+  stats.queuedBytes = currentQueueSize;
+  stats.queuedMessages = queuedMessages.size();
+  stats.questionsInFlight = questionsInFlight;
+  stats.currentWriteStall = getOutgoingMessageWaitTime();
+  stats.totalWriteStall = totalWriteStall;
+  if (queuedMessages.size() > 0) {
+    // Include the stall in progress.
+    stats.totalWriteStall += clock.now() - writeStallStart;
+  }
+  return stats;
+}
+
+void TwoPartyVatNetwork::enableRttProbing(kj::Timer& timer, kj::Duration interval) {
+  KJ_REQUIRE(interval > 0 * kj::NANOSECONDS, "RTT probe interval must be positive");
+  rttProbeTask = rttProbeLoop(timer, interval).eagerlyEvaluate([](kj::Exception&& e) {
+    KJ_LOG(ERROR, "RTT probing failed", e);
+  });
+}
+
+kj::Promise<void> TwoPartyVatNetwork::rttProbeLoop(kj::Timer& timer, kj::Duration interval) {
+  return timer.afterDelay(interval).then([this, &timer, interval]() -> kj::Promise<void> {
+    if (previousWrite == nullptr || readCancelReason != nullptr) {
+      // Shut down or disconnected; nothing more to measure.
+      return kj::READY_NOW;
+    }
+
+    if (outstandingPing == nullptr) {
+      // See `Ping` in rpc-twoparty.capnp for how the peer comes to echo this back.
+      auto message = newOutgoingMessage(8);
+      auto id = nextPingId++;
+      message->getBody().initAs<rpc::Message>().initObsoleteDelete()
+          .initAs<rpc::twoparty::Ping>().setId(id);
+      outstandingPing = OutstandingPing { id, clock.now() };
+      message->send();
+    } else {
+      // The previous probe hasn't come back yet. We could send another, but the RTT will be
+      // measured soon enough when it does return.
+    }
+
+    return rttProbeLoop(timer, interval);
+  });
+}
+
+bool TwoPartyVatNetwork::observeIncoming(MessageReader& reader) {
+  auto root = reader.getRoot<AnyPointer>();
+  if (root.getPointerType() != PointerType::STRUCT) {
+    return true;
+  }
+
+  auto message = root.getAs<rpc::Message>();
+  switch (message.which()) {
+    case rpc::Message::RETURN:
+      if (questionsInFlight > 0) --questionsInFlight;
+      return true;
+
+    case rpc::Message::UNIMPLEMENTED: {
+      auto echoed = message.getUnimplemented();
+      if (!echoed.isObsoleteDelete()) {
+        return true;
+      }
+
+      // The echo of an RTT probe. We never send `obsoleteDelete` otherwise.
+      auto id = echoed.getObsoleteDelete().getAs<rpc::twoparty::Ping>().getId();
+      KJ_IF_MAYBE(ping, outstandingPing) {
+        if (ping->id == id) {
+          // RFC 6298, section 2.
+          auto sample = clock.now() - ping->sendTime;
+          KJ_IF_MAYBE(srtt, smoothedRtt) {
+            auto deviation = sample > *srtt ? sample - *srtt : *srtt - sample;
+            rttVariation = (rttVariation * 3 + deviation) / 4;
+            *srtt = (*srtt * 7 + sample) / 8;
+          } else {
+            smoothedRtt = sample;
+            rttVariation = sample / 2;
+          }
+          outstandingPing = nullptr;
+        }
+      }
+      return false;
+    }
+
+    default:
+      return true;
+  }
+}
+
 class TwoPartyVatNetwork::IncomingMessageImpl final: public IncomingRpcMessage {
 public:
   IncomingMessageImpl(kj::Own<MessageReader> message): message(kj::mv(message)) {}
@@ -314,23 +576,94 @@ kj::Promise<kj::Maybe<kj::Own<IncomingRpcMessage>>> TwoPartyVatNetwork::receiveI
       fdSpace = kj::heapArray<kj::AutoCloseFd>(maxFdsPerMessage);
     }
     auto promise = readCanceler.wrap(getStream().tryReadMessage(fdSpace, receiveOptions));
-    return promise.then([fdSpace = kj::mv(fdSpace)]
+    return promise.then([this, fdSpace = kj::mv(fdSpace)]
                         (kj::Maybe<MessageReaderAndFds>&& messageAndFds) mutable
-                      -> kj::Maybe<kj::Own<IncomingRpcMessage>> {
+                      -> kj::Promise<kj::Maybe<kj::Own<IncomingRpcMessage>>> {
       KJ_IF_MAYBE(m, messageAndFds) {
-        if (m->fds.size() > 0) {
-          return kj::Own<IncomingRpcMessage>(
+        if (m->reader->getRoot<AnyPointer>().getPointerType() == PointerType::LIST) {
+          // A fragment. See `Fragment` in rpc-twoparty.capnp.
+          KJ_REQUIRE(fragmentSize > 0,
+              "peer sent a fragmented message, but fragmentation isn't enabled on this connection");
+          KJ_IF_MAYBE(complete, receiveFragment(*m->reader)) {
+            if (!observeIncoming(**complete)) {
+              return receiveIncomingMessage();
+            }
+            return kj::Maybe<kj::Own<IncomingRpcMessage>>(
+                kj::heap<IncomingMessageImpl>(kj::mv(*complete)));
+          } else {
+            return receiveIncomingMessage();
+          }
+        } else if (!observeIncoming(*m->reader)) {
+          return receiveIncomingMessage();
+        } else if (m->fds.size() > 0) {
+          return kj::Maybe<kj::Own<IncomingRpcMessage>>(
               kj::heap<IncomingMessageImpl>(kj::mv(*m), kj::mv(fdSpace)));
         } else {
-          return kj::Own<IncomingRpcMessage>(kj::heap<IncomingMessageImpl>(kj::mv(m->reader)));
+          return kj::Maybe<kj::Own<IncomingRpcMessage>>(
+              kj::heap<IncomingMessageImpl>(kj::mv(m->reader)));
         }
       } else {
-        return nullptr;
+        return kj::Maybe<kj::Own<IncomingRpcMessage>>(nullptr);
       }
     });
   });
 }
 
+kj::Maybe<kj::Own<MessageReader>> TwoPartyVatNetwork::receiveFragment(
+    MessageReader& fragmentMessage) {
+  auto list = fragmentMessage.getRoot<AnyPointer>().getAs<List<rpc::twoparty::Fragment>>();
+  KJ_REQUIRE(list.size() == 1, "fragment message must contain exactly one Fragment");
+  auto fragment = list[0];
+  auto id = fragment.getId();
+  auto totalSize = fragment.getTotalSize();
+  auto data = fragment.getData();
+
+  Reassembly* reassembly;
+  KJ_IF_MAYBE(r, reassemblies.find(id)) {
+    reassembly = r;
+  } else {
+    KJ_REQUIRE(reassemblies.size() < rpc::twoparty::MAX_FRAGMENTED_MESSAGES_IN_FLIGHT,
+               "peer sent too many fragmented messages at once");
+    // Allow room for the segment table, which can have up to 512 entries.
+    KJ_REQUIRE(totalSize % sizeof(word) == 0 &&
+               totalSize / sizeof(word) <= receiveOptions.traversalLimitInWords + 512,
+               "fragmented message has invalid size", totalSize);
+    KJ_REQUIRE(reassemblies.size() == 0 ||
+               reassemblyBytes + totalSize <= rpc::twoparty::MAX_FRAGMENTED_BYTES_IN_FLIGHT,
+               "peer sent too many fragmented bytes at once");
+    reassembly = &reassemblies.insert(id, Reassembly { totalSize, nullptr }).value;
+    reassemblyBytes += totalSize;
+  }
+
+  KJ_REQUIRE(totalSize == reassembly->totalSize, "fragments of one message disagree on its size");
+  KJ_REQUIRE(data.size() <= totalSize - reassembly->received,
+             "fragment extends past the end of its message");
+
+  // Don't trust `totalSize` for the allocation: the peer might never send that much. Grow the
+  // buffer geometrically as data actually arrives instead.
+  size_t needed = reassembly->received + data.size();
+  if (needed > reassembly->words.asBytes().size()) {
+    size_t newWords = kj::min(kj::max((needed + sizeof(word) - 1) / sizeof(word),
+                                      reassembly->words.size() * 2),
+                              totalSize / sizeof(word));
+    auto newArray = kj::heapArray<word>(newWords);
+    memcpy(newArray.begin(), reassembly->words.begin(), reassembly->received);
+    reassembly->words = kj::mv(newArray);
+  }
+  memcpy(reassembly->words.asBytes().begin() + reassembly->received, data.begin(), data.size());
+  reassembly->received = needed;
+  if (reassembly->received < totalSize) {
+    return nullptr;
+  }
+
+  auto words = kj::mv(reassembly->words);
+  reassemblies.erase(id);
+  reassemblyBytes -= totalSize;
+  auto reader = kj::heap<FlatArrayMessageReader>(words, receiveOptions);
+  KJ_REQUIRE(reader->getEnd() == words.end(), "fragmented message has trailing data");
+  return kj::Own<MessageReader>(reader.attach(kj::mv(words)));
+}
+
 kj::Promise<void> TwoPartyVatNetwork::shutdown() {
   kj::Promise<void> result = KJ_ASSERT_NONNULL(previousWrite, "already shut down").then([this]() {
     return getStream().end();
@@ -371,6 +704,9 @@ struct TwoPartyServer::AcceptedConnection {
   }
 
   void init(TwoPartyServer& parent) {
+    if (parent.fragmentSize > 0) {
+      network.enableFragmentation(parent.fragmentSize);
+    }
     KJ_IF_MAYBE(t, parent.traceEncoder) {
       rpcSystem.setTraceEncoder([&func = *t](const kj::Exception& e) {
         return func(e);
@@ -434,6 +770,11 @@ kj::Promise<void> TwoPartyServer::listenCapStreamReceiver(
   });
 }
 
+void TwoPartyServer::enableFragmentation(size_t size) {
+  KJ_REQUIRE(size > 0, "fragment size must be positive");
+  fragmentSize = size;
+}
+
 void TwoPartyServer::taskFailed(kj::Exception&& exception) {
   KJ_LOG(ERROR, exception);
 }
@@ -474,4 +815,24 @@ void TwoPartyClient::setTraceEncoder(kj::Function<kj::String(const kj::Exception
   rpcSystem.setTraceEncoder(kj::mv(func));
 }
 
+void TwoPartyClient::setTimer(kj::Timer& timer) {
+  rpcSystem.setTimer(timer);
+}
+
+void TwoPartyClient::setCallScheduler(kj::Function<kj::Own<RpcCallScheduler>()> factory) {
+  rpcSystem.setCallScheduler(kj::mv(factory));
+}
+
+void TwoPartyClient::setSpanExporter(RpcSpanExporter& exporter) {
+  rpcSystem.setSpanExporter(exporter);
+}
+
+void TwoPartyClient::enableFragmentation(size_t fragmentSize) {
+  network.enableFragmentation(fragmentSize);
+}
+
+void TwoPartyClient::enableRttProbing(kj::Timer& timer, kj::Duration interval) {
+  network.enableRttProbing(timer, interval);
+}
+
 }  // namespace capnp
@@ -36,9 +36,10 @@ static const ::capnp::_::AlignedData<26> b_9fd69ebc87b9719c = {
 ::capnp::word const* const bp_9fd69ebc87b9719c = b_9fd69ebc87b9719c.words;
 #if !CAPNP_LITE
 static const uint16_t m_9fd69ebc87b9719c[] = {1, 0};
+static const uint16_t h_9fd69ebc87b9719c[] = {0, 1, 0};
 const ::capnp::_::RawSchema s_9fd69ebc87b9719c = {
   0x9fd69ebc87b9719c, b_9fd69ebc87b9719c.words, 26, nullptr, m_9fd69ebc87b9719c,
-  0, 2, nullptr, nullptr, nullptr, { &s_9fd69ebc87b9719c, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 2, nullptr, nullptr, nullptr, { &s_9fd69ebc87b9719c, nullptr, nullptr, 0, 0, nullptr }, false, h_9fd69ebc87b9719c
 };
 #endif  // !CAPNP_LITE
 CAPNP_DEFINE_ENUM(Side_9fd69ebc87b9719c, 9fd69ebc87b9719c);
@@ -84,9 +85,10 @@ static const ::capnp::_::RawSchema* const d_d20b909fee733a8e[] = {
 };
 static const uint16_t m_d20b909fee733a8e[] = {0};
 static const uint16_t i_d20b909fee733a8e[] = {0};
+static const uint16_t h_d20b909fee733a8e[] = {0, 0};
 const ::capnp::_::RawSchema s_d20b909fee733a8e = {
   0xd20b909fee733a8e, b_d20b909fee733a8e.words, 33, d_d20b909fee733a8e, m_d20b909fee733a8e,
-  1, 1, i_d20b909fee733a8e, nullptr, nullptr, { &s_d20b909fee733a8e, nullptr, nullptr, 0, 0, nullptr }, false
+  1, 1, i_d20b909fee733a8e, nullptr, nullptr, { &s_d20b909fee733a8e, nullptr, nullptr, 0, 0, nullptr }, false, h_d20b909fee733a8e
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<34> b_b88d09a9c5f39817 = {
@@ -129,9 +131,10 @@ static const ::capnp::_::AlignedData<34> b_b88d09a9c5f39817 = {
 #if !CAPNP_LITE
 static const uint16_t m_b88d09a9c5f39817[] = {0};
 static const uint16_t i_b88d09a9c5f39817[] = {0};
+static const uint16_t h_b88d09a9c5f39817[] = {0, 0};
 const ::capnp::_::RawSchema s_b88d09a9c5f39817 = {
   0xb88d09a9c5f39817, b_b88d09a9c5f39817.words, 34, nullptr, m_b88d09a9c5f39817,
-  0, 1, i_b88d09a9c5f39817, nullptr, nullptr, { &s_b88d09a9c5f39817, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 1, i_b88d09a9c5f39817, nullptr, nullptr, { &s_b88d09a9c5f39817, nullptr, nullptr, 0, 0, nullptr }, false, h_b88d09a9c5f39817
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<18> b_89f389b6fd4082c1 = {
@@ -158,7 +161,7 @@ static const ::capnp::_::AlignedData<18> b_89f389b6fd4082c1 = {
 #if !CAPNP_LITE
 const ::capnp::_::RawSchema s_89f389b6fd4082c1 = {
   0x89f389b6fd4082c1, b_89f389b6fd4082c1.words, 18, nullptr, nullptr,
-  0, 0, nullptr, nullptr, nullptr, { &s_89f389b6fd4082c1, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 0, nullptr, nullptr, nullptr, { &s_89f389b6fd4082c1, nullptr, nullptr, 0, 0, nullptr }, false, nullptr
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<19> b_b47f4979672cb59d = {
@@ -186,7 +189,7 @@ static const ::capnp::_::AlignedData<19> b_b47f4979672cb59d = {
 #if !CAPNP_LITE
 const ::capnp::_::RawSchema s_b47f4979672cb59d = {
   0xb47f4979672cb59d, b_b47f4979672cb59d.words, 19, nullptr, nullptr,
-  0, 0, nullptr, nullptr, nullptr, { &s_b47f4979672cb59d, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 0, nullptr, nullptr, nullptr, { &s_b47f4979672cb59d, nullptr, nullptr, 0, 0, nullptr }, false, nullptr
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<65> b_95b29059097fca83 = {
@@ -260,9 +263,10 @@ static const ::capnp::_::AlignedData<65> b_95b29059097fca83 = {
 #if !CAPNP_LITE
 static const uint16_t m_95b29059097fca83[] = {0, 1, 2};
 static const uint16_t i_95b29059097fca83[] = {0, 1, 2};
+static const uint16_t h_95b29059097fca83[] = {0, 5, 1, 2, 0};
 const ::capnp::_::RawSchema s_95b29059097fca83 = {
   0x95b29059097fca83, b_95b29059097fca83.words, 65, nullptr, m_95b29059097fca83,
-  0, 3, i_95b29059097fca83, nullptr, nullptr, { &s_95b29059097fca83, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 3, i_95b29059097fca83, nullptr, nullptr, { &s_95b29059097fca83, nullptr, nullptr, 0, 0, nullptr }, false, h_95b29059097fca83
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<65> b_9d263a3630b7ebee = {
@@ -336,9 +340,204 @@ static const ::capnp::_::AlignedData<65> b_9d263a3630b7ebee = {
 #if !CAPNP_LITE
 static const uint16_t m_9d263a3630b7ebee[] = {2, 0, 1};
 static const uint16_t i_9d263a3630b7ebee[] = {0, 1, 2};
+static const uint16_t h_9d263a3630b7ebee[] = {0, 2, 1, 2, 0};
 const ::capnp::_::RawSchema s_9d263a3630b7ebee = {
   0x9d263a3630b7ebee, b_9d263a3630b7ebee.words, 65, nullptr, m_9d263a3630b7ebee,
-  0, 3, i_9d263a3630b7ebee, nullptr, nullptr, { &s_9d263a3630b7ebee, nullptr, nullptr, 0, 0, nullptr }, true
+  0, 3, i_9d263a3630b7ebee, nullptr, nullptr, { &s_9d263a3630b7ebee, nullptr, nullptr, 0, 0, nullptr }, true, h_9d263a3630b7ebee
+};
+#endif  // !CAPNP_LITE
+static const ::capnp::_::AlignedData<65> b_92915005e571d063 = {
+  {   0,   0,   0,   0,   5,   0,   6,   0,
+     99, 208, 113, 229,   5,  80, 145, 146,
+     25,   0,   0,   0,   1,   0,   2,   0,
+    161, 242, 218,  92, 136, 199, 132, 161,
+      1,   0,   7,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     21,   0,   0,   0,  18,   1,   0,   0,
+     37,   0,   0,   0,   7,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     33,   0,   0,   0, 175,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     99,  97, 112, 110, 112,  47, 114, 112,
+     99,  45, 116, 119, 111, 112,  97, 114,
+    116, 121,  46,  99,  97, 112, 110, 112,
+     58,  70, 114,  97, 103, 109, 101, 110,
+    116,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   1,   0,   1,   0,
+     12,   0,   0,   0,   3,   0,   4,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   1,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     69,   0,   0,   0,  26,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     64,   0,   0,   0,   3,   0,   1,   0,
+     76,   0,   0,   0,   2,   0,   1,   0,
+      1,   0,   0,   0,   1,   0,   0,   0,
+      0,   0,   1,   0,   1,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     73,   0,   0,   0,  82,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     72,   0,   0,   0,   3,   0,   1,   0,
+     84,   0,   0,   0,   2,   0,   1,   0,
+      2,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   1,   0,   2,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     81,   0,   0,   0,  42,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     76,   0,   0,   0,   3,   0,   1,   0,
+     88,   0,   0,   0,   2,   0,   1,   0,
+    105, 100,   0,   0,   0,   0,   0,   0,
+      8,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      8,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+    116, 111, 116,  97, 108,  83, 105, 122,
+    101,   0,   0,   0,   0,   0,   0,   0,
+      9,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      9,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+    100,  97, 116,  97,   0,   0,   0,   0,
+     13,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     13,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0, }
+};
+::capnp::word const* const bp_92915005e571d063 = b_92915005e571d063.words;
+#if !CAPNP_LITE
+static const uint16_t m_92915005e571d063[] = {2, 0, 1};
+static const uint16_t i_92915005e571d063[] = {0, 1, 2};
+static const uint16_t h_92915005e571d063[] = {0, 1, 1, 0, 2};
+const ::capnp::_::RawSchema s_92915005e571d063 = {
+  0x92915005e571d063, b_92915005e571d063.words, 65, nullptr, m_92915005e571d063,
+  0, 3, i_92915005e571d063, nullptr, nullptr, { &s_92915005e571d063, nullptr, nullptr, 0, 0, nullptr }, false, h_92915005e571d063
+};
+#endif  // !CAPNP_LITE
+static const ::capnp::_::AlignedData<27> b_d81eba89190a20f6 = {
+  {   0,   0,   0,   0,   5,   0,   6,   0,
+    246,  32,  10,  25, 137, 186,  30, 216,
+     25,   0,   0,   0,   4,   0,   0,   0,
+    161, 242, 218,  92, 136, 199, 132, 161,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     21,   0,   0,   0, 186,   1,   0,   0,
+     45,   0,   0,   0,   7,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     40,   0,   0,   0,   3,   0,   1,   0,
+     52,   0,   0,   0,   2,   0,   1,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     99,  97, 112, 110, 112,  47, 114, 112,
+     99,  45, 116, 119, 111, 112,  97, 114,
+    116, 121,  46,  99,  97, 112, 110, 112,
+     58, 109,  97, 120,  70, 114,  97, 103,
+    109, 101, 110, 116, 101, 100,  77, 101,
+    115, 115,  97, 103, 101, 115,  73, 110,
+     70, 108, 105, 103, 104, 116,   0,   0,
+      0,   0,   0,   0,   1,   0,   1,   0,
+      8,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      8,   0,   0,   0,   8,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0, }
+};
+::capnp::word const* const bp_d81eba89190a20f6 = b_d81eba89190a20f6.words;
+#if !CAPNP_LITE
+const ::capnp::_::RawSchema s_d81eba89190a20f6 = {
+  0xd81eba89190a20f6, b_d81eba89190a20f6.words, 27, nullptr, nullptr,
+  0, 0, nullptr, nullptr, nullptr, { &s_d81eba89190a20f6, nullptr, nullptr, 0, 0, nullptr }, false, nullptr
+};
+#endif  // !CAPNP_LITE
+static const ::capnp::_::AlignedData<27> b_8250904851da7386 = {
+  {   0,   0,   0,   0,   5,   0,   6,   0,
+    134, 115, 218,  81,  72, 144,  80, 130,
+     25,   0,   0,   0,   4,   0,   0,   0,
+    161, 242, 218,  92, 136, 199, 132, 161,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     21,   0,   0,   0, 162,   1,   0,   0,
+     45,   0,   0,   0,   7,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     40,   0,   0,   0,   3,   0,   1,   0,
+     52,   0,   0,   0,   2,   0,   1,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     99,  97, 112, 110, 112,  47, 114, 112,
+     99,  45, 116, 119, 111, 112,  97, 114,
+    116, 121,  46,  99,  97, 112, 110, 112,
+     58, 109,  97, 120,  70, 114,  97, 103,
+    109, 101, 110, 116, 101, 100,  66, 121,
+    116, 101, 115,  73, 110,  70, 108, 105,
+    103, 104, 116,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   1,   0,   1,   0,
+      9,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      9,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   1,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0, }
+};
+::capnp::word const* const bp_8250904851da7386 = b_8250904851da7386.words;
+#if !CAPNP_LITE
+const ::capnp::_::RawSchema s_8250904851da7386 = {
+  0x8250904851da7386, b_8250904851da7386.words, 27, nullptr, nullptr,
+  0, 0, nullptr, nullptr, nullptr, { &s_8250904851da7386, nullptr, nullptr, 0, 0, nullptr }, false, nullptr
+};
+#endif  // !CAPNP_LITE
+static const ::capnp::_::AlignedData<33> b_dd5d2c7d457fc827 = {
+  {   0,   0,   0,   0,   5,   0,   6,   0,
+     39, 200, 127,  69, 125,  44,  93, 221,
+     25,   0,   0,   0,   1,   0,   1,   0,
+    161, 242, 218,  92, 136, 199, 132, 161,
+      0,   0,   7,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     21,   0,   0,   0, 242,   0,   0,   0,
+     33,   0,   0,   0,   7,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     29,   0,   0,   0,  63,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     99,  97, 112, 110, 112,  47, 114, 112,
+     99,  45, 116, 119, 111, 112,  97, 114,
+    116, 121,  46,  99,  97, 112, 110, 112,
+     58,  80, 105, 110, 103,   0,   0,   0,
+      0,   0,   0,   0,   1,   0,   1,   0,
+      4,   0,   0,   0,   3,   0,   4,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   1,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     13,   0,   0,   0,  26,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      8,   0,   0,   0,   3,   0,   1,   0,
+     20,   0,   0,   0,   2,   0,   1,   0,
+    105, 100,   0,   0,   0,   0,   0,   0,
+      9,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      9,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0, }
+};
+::capnp::word const* const bp_dd5d2c7d457fc827 = b_dd5d2c7d457fc827.words;
+#if !CAPNP_LITE
+static const uint16_t m_dd5d2c7d457fc827[] = {0};
+static const uint16_t i_dd5d2c7d457fc827[] = {0};
+static const uint16_t h_dd5d2c7d457fc827[] = {0, 0};
+const ::capnp::_::RawSchema s_dd5d2c7d457fc827 = {
+  0xdd5d2c7d457fc827, b_dd5d2c7d457fc827.words, 33, nullptr, m_dd5d2c7d457fc827,
+  0, 1, i_dd5d2c7d457fc827, nullptr, nullptr, { &s_dd5d2c7d457fc827, nullptr, nullptr, 0, 0, nullptr }, false, h_dd5d2c7d457fc827
 };
 #endif  // !CAPNP_LITE
 }  // namespace schemas
@@ -422,6 +621,30 @@ constexpr ::capnp::_::RawSchema const* JoinResult::_capnpPrivate::schema;
 #endif  // !CAPNP_NEED_REDUNDANT_CONSTEXPR_DECL
 #endif  // !CAPNP_LITE
 
+// Fragment
+#if CAPNP_NEED_REDUNDANT_CONSTEXPR_DECL
+constexpr uint16_t Fragment::_capnpPrivate::dataWordSize;
+constexpr uint16_t Fragment::_capnpPrivate::pointerCount;
+#endif  // !CAPNP_NEED_REDUNDANT_CONSTEXPR_DECL
+#if !CAPNP_LITE
+#if CAPNP_NEED_REDUNDANT_CONSTEXPR_DECL
+constexpr ::capnp::Kind Fragment::_capnpPrivate::kind;
+constexpr ::capnp::_::RawSchema const* Fragment::_capnpPrivate::schema;
+#endif  // !CAPNP_NEED_REDUNDANT_CONSTEXPR_DECL
+#endif  // !CAPNP_LITE
+
+// Ping
+#if CAPNP_NEED_REDUNDANT_CONSTEXPR_DECL
+constexpr uint16_t Ping::_capnpPrivate::dataWordSize;
+constexpr uint16_t Ping::_capnpPrivate::pointerCount;
+#endif  // !CAPNP_NEED_REDUNDANT_CONSTEXPR_DECL
+#if !CAPNP_LITE
+#if CAPNP_NEED_REDUNDANT_CONSTEXPR_DECL
+constexpr ::capnp::Kind Ping::_capnpPrivate::kind;
+constexpr ::capnp::_::RawSchema const* Ping::_capnpPrivate::schema;
+#endif  // !CAPNP_NEED_REDUNDANT_CONSTEXPR_DECL
+#endif  // !CAPNP_LITE
+
 
 }  // namespace
 }  // namespace
@@ -27,6 +27,7 @@
 #include <capnp/serialize-async.h>
 #include <capnp/rpc-twoparty.capnp.h>
 #include <kj/one-of.h>
+#include <kj/map.h>
 
 CAPNP_BEGIN_HEADER
 
@@ -99,6 +100,60 @@ public:
   // Get how long the current outgoing message has been waiting to be sent on this connection.
   // Returns 0 if the queue is empty. This may be useful for backpressure.
 
+  struct ConnectionStats {
+    kj::Maybe<kj::Duration> smoothedRtt;
+    // Smoothed round trip time measured by RTT probes (see enableRttProbing()), computed as
+    // specified for TCP by RFC 6298. Null until the first probe returns. Includes any time the
+    // probe spent queued behind other messages at either end, since calls see that delay too.
+
+    kj::Duration rttVariation = 0 * kj::NANOSECONDS;
+    // Smoothed mean deviation of RTT samples, also per RFC 6298.
+
+    size_t queuedBytes = 0;
+    size_t queuedMessages = 0;
+    // Same as getCurrentQueueSize() and getCurrentQueueCount().
+
+    size_t questionsInFlight = 0;
+    // Number of calls (including bootstrap requests) sent on this connection whose returns have not
+    // yet arrived.
+
+    kj::Duration currentWriteStall = 0 * kj::NANOSECONDS;
+    // Same as getOutgoingMessageWaitTime().
+
+    kj::Duration totalWriteStall = 0 * kj::NANOSECONDS;
+    // Total time during which outgoing messages have been queued waiting to be written, over the
+    // life of the connection.
+  };
+
+  ConnectionStats getStats();
+  // Get health metrics for this connection, e.g. to let a load balancer prefer lightly-loaded
+  // connections, or to apply application-level backpressure.
+
+  static constexpr kj::Duration DEFAULT_RTT_PROBE_INTERVAL = 1 * kj::SECONDS;
+
+  void enableRttProbing(kj::Timer& timer, kj::Duration interval = DEFAULT_RTT_PROBE_INTERVAL);
+  // Send a small probe on this connection every `interval` to measure the round trip time reported
+  // by getStats(). Probing works with any peer; see `Ping` in rpc-twoparty.capnp. At most one probe
+  // is outstanding at a time.
+  //
+  // Times are measured with the clock passed to the constructor. The default clock is coarse (its
+  // resolution is typically a few milliseconds), so pass `kj::systemPreciseMonotonicClock()` if you
+  // need to measure shorter round trips.
+
+  static constexpr size_t DEFAULT_FRAGMENT_SIZE = 64 * 1024;
+
+  void enableFragmentation(size_t fragmentSize = DEFAULT_FRAGMENT_SIZE);
+  // Send calls and returns larger than `fragmentSize` bytes as a series of fragments of that
+  // size, interleaved with the other messages sent on this connection, so that a large message --
+  // such as a multi-megabyte `Return` -- doesn't delay small calls queued behind it. Small calls
+  // and returns may then be delivered ahead of a large return sent before them; see `Fragment` in
+  // rpc-twoparty.capnp for exactly which reorderings are allowed.
+  //
+  // This also allows the peer to send fragments to us; a connection which hasn't called this
+  // treats an incoming fragment as a protocol error. So both sides of a connection must enable
+  // fragmentation. Messages carrying file descriptors are never fragmented. `fragmentSize` is
+  // rounded up to a multiple of the word size.
+
   // implements VatNetwork -----------------------------------------------------
 
   kj::Maybe<kj::Own<TwoPartyVatNetworkBase::Connection>> connect(
@@ -141,6 +196,38 @@ private:
   const kj::MonotonicClock& clock;
   kj::TimePoint currentOutgoingMessageSendTime;
 
+  size_t fragmentSize = 0;
+  // If non-zero, large messages are sent in fragments of this size. See enableFragmentation().
+
+  uint32_t nextFragmentId = 0;
+  uint fragmentingCount = 0;
+  size_t fragmentingBytes = 0;
+  // Number and total size of outgoing messages which have been partially sent as fragments.
+
+  kj::TimePoint writeStallStart;
+  // When the outgoing queue last went from empty to non-empty.
+
+  kj::Duration totalWriteStall = 0 * kj::NANOSECONDS;
+  size_t questionsInFlight = 0;
+
+  struct OutstandingPing {
+    uint64_t id;
+    kj::TimePoint sendTime;
+  };
+  kj::Maybe<OutstandingPing> outstandingPing;
+  uint64_t nextPingId = 0;
+  kj::Maybe<kj::Duration> smoothedRtt;
+  kj::Duration rttVariation = 0 * kj::NANOSECONDS;
+
+  struct Reassembly {
+    size_t totalSize;       // in bytes, as claimed by the first fragment
+    kj::Array<word> words;  // grows as fragments arrive, up to totalSize
+    size_t received = 0;    // in bytes
+  };
+  kj::HashMap<uint32_t, Reassembly> reassemblies;
+  size_t reassemblyBytes = 0;
+  // Incoming fragmented messages, by fragment ID, and the sum of their `totalSize`s.
+
   class FulfillerDisposer: public kj::Disposer {
     // Hack:  TwoPartyVatNetwork is both a VatNetwork and a VatNetwork::Connection.  When the RPC
     //   system detects (or initiates) a disconnection, it drops its reference to the Connection.
@@ -156,6 +243,8 @@ private:
   };
   FulfillerDisposer disconnectFulfiller;
 
+  kj::Maybe<kj::Promise<void>> rttProbeTask;
+
 
   TwoPartyVatNetwork(
       kj::OneOf<MessageStream*, kj::Own<MessageStream>>&& stream,
@@ -166,6 +255,25 @@ private:
 
   MessageStream& getStream();
 
+  kj::Promise<void> writeFragmentedBatch();
+  // Used instead of writing all queued messages at once when fragmentation is enabled. Writes
+  // every queued message which may be sent now plus the next fragment of each large message,
+  // repeating until the queue is empty.
+
+  kj::Maybe<kj::Own<MessageReader>> receiveFragment(MessageReader& fragmentMessage);
+  // Absorbs an incoming fragment, returning the complete message if this was its last fragment.
+
+  void writeFailed(kj::Exception&& exception);
+
+  void noteQueueDrained();
+  // Called when the last queued outgoing message has been handed to the stream.
+
+  bool observeIncoming(MessageReader& message);
+  // Updates statistics for an incoming message. Returns false if the message is the echo of one of
+  // our RTT probes, in which case it must not be delivered to the RPC system.
+
+  kj::Promise<void> rttProbeLoop(kj::Timer& timer, kj::Duration interval);
+
   kj::Own<TwoPartyVatNetworkBase::Connection> asConnection();
   // Returns a pointer to this with the disposer set to disconnectFulfiller.
 
@@ -221,9 +329,14 @@ public:
   //
   // Only considers clients whose connections TwoPartyServer took ownership of.
 
+  void enableFragmentation(
+      size_t fragmentSize = TwoPartyVatNetwork::DEFAULT_FRAGMENT_SIZE);
+  // Calls `TwoPartyVatNetwork::enableFragmentation()` on connections accepted from now on.
+
 private:
   Capability::Client bootstrapInterface;
   kj::Maybe<kj::Function<kj::String(const kj::Exception&)>> traceEncoder;
+  size_t fragmentSize = 0;
   kj::TaskSet tasks;
 
   struct AcceptedConnection;
@@ -251,9 +364,27 @@ public:
   void setTraceEncoder(kj::Function<kj::String(const kj::Exception&)> func);
   // Forwarded to rpcSystem.setTraceEncoder().
 
+  void setTimer(kj::Timer& timer);
+  // Forwarded to rpcSystem.setTimer().
+
+  void setCallScheduler(kj::Function<kj::Own<RpcCallScheduler>()> factory);
+  // Forwarded to rpcSystem.setCallScheduler().
+
+  void setSpanExporter(RpcSpanExporter& exporter);
+  // Forwarded to rpcSystem.setSpanExporter().
+
+  void enableFragmentation(
+      size_t fragmentSize = TwoPartyVatNetwork::DEFAULT_FRAGMENT_SIZE);
+  // Forwarded to network.enableFragmentation().
+
   size_t getCurrentQueueSize() { return network.getCurrentQueueSize(); }
   size_t getCurrentQueueCount() { return network.getCurrentQueueCount(); }
   kj::Duration getOutgoingMessageWaitTime() { return network.getOutgoingMessageWaitTime(); }
+  TwoPartyVatNetwork::ConnectionStats getStats() { return network.getStats(); }
+
+  void enableRttProbing(kj::Timer& timer,
+      kj::Duration interval = TwoPartyVatNetwork::DEFAULT_RTT_PROBE_INTERVAL);
+  // Forwarded to network.enableRttProbing().
 
 private:
   TwoPartyVatNetwork network;
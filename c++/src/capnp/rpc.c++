@@ -26,6 +26,7 @@
 #include <kj/async.h>
 #include <kj/one-of.h>
 #include <kj/function.h>
+#include <kj/timer.h>
 #include <functional>  // std::greater
 #include <unordered_map>
 #include <map>
@@ -56,6 +57,8 @@ constexpr const uint CAP_DESCRIPTOR_SIZE_HINT = sizeInWords<rpc::CapDescriptor>(
 
 constexpr const uint64_t MAX_SIZE_HINT = 1 << 20;
 
+constexpr const uint64_t MAX_CALL_TIMEOUT_NANOS = 1ull << 60;  // ~36 years
+
 uint copySizeHint(MessageSize size) {
   uint64_t sizeHint = size.wordCount + size.capCount * CAP_DESCRIPTOR_SIZE_HINT
                     // if capCount > 0, the cap descriptor list has a 1-word tag
@@ -71,6 +74,40 @@ uint firstSegmentSize(kj::Maybe<MessageSize> sizeHint, uint additional) {
   }
 }
 
+static thread_local uint64_t threadFlatPayloadCopies = 0;
+
+class PayloadCopier {
+  // Copies a payload we received into a message we're about to send, as happens when a call or
+  // its return is forwarded through a proxy. A payload that came off the wire is usually laid out
+  // as one contiguous run of words, in which case we memcpy() it wholesale and only rewrite the
+  // cap table, rather than doing a deep copy.
+
+public:
+  explicit PayloadCopier(AnyPointer::Reader src)
+      : src(src), flat(PointerHelpers<AnyPointer>::getInternalReader(src).getFlatTarget()) {}
+
+  MessageSize sizeHint() {
+    KJ_IF_MAYBE(f, flat) {
+      return f->size.asPublic();
+    } else {
+      return src.targetSize();
+    }
+  }
+
+  void copyTo(AnyPointer::Builder dst) {
+    KJ_IF_MAYBE(f, flat) {
+      PointerHelpers<AnyPointer>::getInternalBuilder(kj::mv(dst)).copyFromFlat(*f);
+      ++threadFlatPayloadCopies;
+    } else {
+      dst.set(src);
+    }
+  }
+
+private:
+  AnyPointer::Reader src;
+  kj::Maybe<FlatPointerTarget> flat;
+};
+
 kj::Maybe<kj::Array<PipelineOp>> toPipelineOps(List<rpc::PromisedAnswer::Op>::Reader ops) {
   auto result = kj::heapArrayBuilder<PipelineOp>(ops.size());
   for (auto opReader: ops) {
@@ -344,10 +381,14 @@ public:
                      kj::Own<VatNetworkBase::Connection>&& connectionParam,
                      kj::Own<kj::PromiseFulfiller<DisconnectInfo>>&& disconnectFulfiller,
                      size_t flowLimit,
-                     kj::Maybe<kj::Function<kj::String(const kj::Exception&)>&> traceEncoder)
+                     kj::Maybe<kj::Function<kj::String(const kj::Exception&)>&> traceEncoder,
+                     kj::Maybe<kj::Timer&> timer,
+                     kj::Maybe<kj::Own<RpcCallScheduler>> callScheduler,
+                     kj::Maybe<RpcSpanExporter&> spanExporter)
       : bootstrapFactory(bootstrapFactory),
         restorer(restorer), disconnectFulfiller(kj::mv(disconnectFulfiller)), flowLimit(flowLimit),
-        traceEncoder(traceEncoder), tasks(*this) {
+        traceEncoder(traceEncoder), timer(timer), callScheduler(kj::mv(callScheduler)),
+        spanExporter(spanExporter), tasks(*this) {
     connection.init<Connected>(kj::mv(connectionParam));
     tasks.add(messageLoop());
   }
@@ -400,6 +441,7 @@ public:
     // reference, so null it out before we return from here. We don't need it anymore once
     // disconnected anyway.
     KJ_DEFER(traceEncoder = nullptr);
+    KJ_DEFER(timer = nullptr);
 
     if (!connection.is<Connected>()) {
       // Already disconnected.
@@ -437,6 +479,10 @@ public:
 
       // All current questions complete with exceptions.
       questions.forEach([&](QuestionId id, Question& question) {
+        // The call won't get a Return now, so its span ends here. These are the failures tracing
+        // most needs to show.
+        finishSpan(question.span, RpcSpan::Outcome::THREW);
+
         KJ_IF_MAYBE(questionRef, question.selfRef) {
           // QuestionRef still present.
           questionRef->reject(kj::cp(networkException));
@@ -530,6 +576,22 @@ public:
     maybeUnblockFlow();
   }
 
+  void setTimer(kj::Timer& newTimer) {
+    if (connection.is<Connected>()) {
+      timer = newTimer;
+    }
+  }
+
+  void setCallScheduler(kj::Own<RpcCallScheduler> scheduler) {
+    // Calls already admitted by the previous scheduler keep their slots there.
+    callScheduler = kj::mv(scheduler);
+  }
+
+  void setSpanExporter(RpcSpanExporter& exporter) {
+    // Spans already in progress are recorded only if they were started with an exporter.
+    spanExporter = exporter;
+  }
+
 private:
   class RpcClient;
   class ImportClient;
@@ -573,6 +635,10 @@ private:
     bool isTailCall = false;
     // Is this a tail call?  If so, we don't expect to receive results in the `Return`.
 
+    kj::Maybe<RpcSpan> span;
+    // If the call is traced and we have a span exporter, the CLIENT span to export when the
+    // `Return` arrives.
+
     bool skipFinish = false;
     // If true, don't send a Finish message.
     //
@@ -711,6 +777,56 @@ private:
 
   kj::Maybe<kj::Function<kj::String(const kj::Exception&)>&> traceEncoder;
 
+  kj::Maybe<kj::Timer&> timer;
+  // Used to cancel incoming calls whose deadline has passed. Deadlines are still measured and
+  // propagated if null, but not enforced.
+
+  kj::TimePoint now() {
+    KJ_IF_MAYBE(t, timer) {
+      return t->now();
+    } else {
+      return kj::systemPreciseMonotonicClock().now();
+    }
+  }
+
+  kj::Maybe<kj::Own<RpcCallScheduler>> callScheduler;
+  // If non-null, decides when incoming calls are delivered.
+
+  kj::Maybe<RpcSpanExporter&> spanExporter;
+  // If non-null, spans are recorded for traced calls.
+
+  kj::Maybe<RpcSpan> startSpan(RpcSpan::Kind kind, const TraceContext& parent,
+                               uint64_t interfaceId, uint16_t methodId) {
+    // Starts a span as a child of `parent`, if we have an exporter.
+    if (spanExporter == nullptr) return nullptr;
+
+    RpcSpan span;
+    span.kind = kind;
+    span.context = parent.newSpan();
+    span.parentSpanId = parent.spanId;
+    span.interfaceId = interfaceId;
+    span.methodId = methodId;
+    span.startTime = kj::systemPreciseCalendarClock().now();
+    return kj::mv(span);
+  }
+
+  void finishSpan(kj::Maybe<RpcSpan>& maybeSpan, RpcSpan::Outcome outcome) {
+    // Exports the span, if any, and clears it so that it isn't exported twice.
+    KJ_IF_MAYBE(span, maybeSpan) {
+      span->endTime = kj::systemPreciseCalendarClock().now();
+      span->outcome = outcome;
+      KJ_IF_MAYBE(e, spanExporter) {
+        e->exportSpan(*span);
+      }
+      maybeSpan = nullptr;
+    }
+  }
+
+  struct AdmittedCall: public kj::Refcounted {
+    kj::Own<void> slot;
+    // Returned by `callScheduler->admit()`; dropped when the call completes.
+  };
+
   kj::TaskSet tasks;
 
   bool gotReturnForHighQuestionId = false;
@@ -822,10 +938,12 @@ private:
                                            kj::Own<CallContextHook>&& context, CallHints hints) {
       // Implement call() by copying params and results messages.
 
-      auto params = context->getParams();
-      auto request = newCallNoIntercept(interfaceId, methodId, params.targetSize(), hints);
+      PayloadCopier params(context->getParams());
+      auto request = newCallNoIntercept(interfaceId, methodId, params.sizeHint(), hints);
 
-      request.set(params);
+      params.copyTo(request);
+      request.setDeadline(context->getDeadline());
+      request.setTraceContext(context->getTraceContext());
       context->releaseParams();
 
       return context->directTailCall(RequestHook::from(kj::mv(request)));
@@ -1742,7 +1860,8 @@ private:
               firstSegmentSize(sizeHint, messageSizeHint<rpc::Call>() +
                   sizeInWords<rpc::Payload>() + MESSAGE_TARGET_SIZE_HINT))),
           callBuilder(message->getBody().getAs<rpc::Message>().initCall()),
-          paramsBuilder(capTable.imbue(callBuilder.getParams().getContent())) {}
+          paramsBuilder(capTable.imbue(callBuilder.getParams().getContent())),
+          deadline(TraceContext::currentDeadline()), traceContext(TraceContext::current()) {}
 
     inline AnyPointer::Builder getRoot() {
       return paramsBuilder;
@@ -1769,6 +1888,8 @@ private:
             callBuilder.getInterfaceId(), callBuilder.getMethodId(), paramsBuilder.targetSize(),
             callHintsFromReader(callBuilder));
         replacement.set(paramsBuilder);
+        replacement.setDeadline(deadline);
+        replacement.setTraceContext(traceContext);
         return replacement.send();
       } else {
         bool noPromisePipelining = callBuilder.getNoPromisePipelining();
@@ -1815,6 +1936,8 @@ private:
             callBuilder.getInterfaceId(), callBuilder.getMethodId(), paramsBuilder.targetSize(),
             callHintsFromReader(callBuilder));
         replacement.set(paramsBuilder);
+        replacement.setDeadline(deadline);
+        replacement.setTraceContext(traceContext);
         return RequestHook::from(kj::mv(replacement))->sendStreaming();
       } else {
         return sendStreamingInternal(false);
@@ -1837,6 +1960,8 @@ private:
             callBuilder.getInterfaceId(), callBuilder.getMethodId(), paramsBuilder.targetSize(),
             callHintsFromReader(callBuilder));
         replacement.set(paramsBuilder);
+        replacement.setDeadline(deadline);
+        replacement.setTraceContext(traceContext);
         return replacement.sendForPipeline();
       } else if (connectionState->gotReturnForHighQuestionId) {
         // Peer doesn't implement our hints. Fall back to a regular send().
@@ -1898,6 +2023,17 @@ private:
       return connectionState.get();
     }
 
+    void setDeadline(kj::TimePoint newDeadline) override {
+      KJ_IF_MAYBE(d, deadline) {
+        if (*d <= newDeadline) return;
+      }
+      deadline = newDeadline;
+    }
+
+    void setTraceContext(const TraceContext& context) override {
+      traceContext = context;
+    }
+
   private:
     kj::Own<RpcConnectionState> connectionState;
 
@@ -1906,6 +2042,37 @@ private:
     BuilderCapabilityTable capTable;
     rpc::Call::Builder callBuilder;
     AnyPointer::Builder paramsBuilder;
+    kj::Maybe<kj::TimePoint> deadline;
+    kj::Maybe<TraceContext> traceContext;
+
+    void writeTraceContext(kj::Maybe<Question&> question) {
+      // Write the trace context, if any, recording a CLIENT span in `question` if we have an
+      // exporter. Calls which expect no `Return` get no span, as we'd never see them end.
+      KJ_IF_MAYBE(t, traceContext) {
+        TraceContext sent = *t;
+        KJ_IF_MAYBE(q, question) {
+          q->span = connectionState->startSpan(RpcSpan::Kind::CLIENT, *t,
+              callBuilder.getInterfaceId(), callBuilder.getMethodId());
+          KJ_IF_MAYBE(span, q->span) {
+            sent = span->context;
+          }
+        }
+
+        auto builder = callBuilder.initTraceContext();
+        builder.setTraceIdHigh(sent.traceIdHigh);
+        builder.setTraceIdLow(sent.traceIdLow);
+        builder.setSpanId(sent.spanId);
+      }
+    }
+
+    void writeTimeout() {
+      // Convert the deadline to the relative timeout that goes on the wire. A deadline which has
+      // already passed is sent as the smallest possible timeout, since zero means "no timeout".
+      KJ_IF_MAYBE(d, deadline) {
+        int64_t remaining = (*d - connectionState->now()) / kj::NANOSECONDS;
+        callBuilder.setTimeoutNanos(kj::max(remaining, int64_t(1)));
+      }
+    }
 
     struct SendInternalResult {
       kj::Own<QuestionRef> questionRef;
@@ -1922,6 +2089,8 @@ private:
     };
 
     SetupSendResult setupSend(bool isTailCall) {
+      writeTimeout();
+
       // Build the cap table.
       kj::Vector<int> fds;
       auto exports = connectionState->writeDescriptors(
@@ -1934,6 +2103,7 @@ private:
       question.isAwaitingReturn = true;
       question.paramExports = kj::mv(exports);
       question.isTailCall = isTailCall;
+      writeTraceContext(question);
 
       // Make the QuentionRef and result promise.
       SendInternalResult result;
@@ -1966,6 +2136,7 @@ private:
         //   is never created? See the approach in sendForPipelineInternal() below.
         result.question.isAwaitingReturn = false;
         result.question.skipFinish = true;
+        result.question.span = nullptr;
         connectionState->releaseExports(result.question.paramExports);
         result.questionRef->reject(kj::mv(*exception));
       }
@@ -1999,6 +2170,7 @@ private:
         // table state. We'll have to reject the promise instead.
         setup.question.isAwaitingReturn = false;
         setup.question.skipFinish = true;
+        setup.question.span = nullptr;
         setup.questionRef->reject(kj::cp(*exception));
         return kj::mv(*exception);
       }
@@ -2009,6 +2181,9 @@ private:
     kj::Own<QuestionRef> sendForPipelineInternal() {
       // Since must of setupSend() is subtly different for this case, we don't reuse it.
 
+      writeTimeout();
+      writeTraceContext(nullptr);
+
       // Build the cap table.
       kj::Vector<int> fds;
       auto exports = connectionState->writeDescriptors(
@@ -2385,10 +2560,14 @@ private:
                    kj::Array<kj::Maybe<kj::Own<ClientHook>>> capTableArray,
                    const AnyPointer::Reader& params,
                    bool redirectResults, uint64_t interfaceId, uint16_t methodId,
-                   ClientHook::CallHints hints)
+                   ClientHook::CallHints hints, kj::Maybe<kj::TimePoint> deadline,
+                   kj::Maybe<TraceContext> traceContext, kj::Maybe<RpcSpan> span)
         : connectionState(kj::addRef(connectionState)),
           answerId(answerId),
           hints(hints),
+          deadline(deadline),
+          traceContext(traceContext),
+          span(kj::mv(span)),
           interfaceId(interfaceId),
           methodId(methodId),
           requestSize(request->sizeInWords()),
@@ -2419,6 +2598,7 @@ private:
               // The reason we haven't sent a return is because the results were sent somewhere
               // else.
               builder.setResultsSentElsewhere();
+              connectionState->finishSpan(span, RpcSpan::Outcome::RETURNED);
 
               // The pipeline could still be valid and in-use in this case.
               shouldFreePipeline = false;
@@ -2432,6 +2612,10 @@ private:
           cleanupAnswerTable(nullptr, shouldFreePipeline);
         });
       }
+
+      // Covers cancellation as well as calls whose results were dropped because a `Finish` arrived
+      // first.
+      connectionState->finishSpan(span, RpcSpan::Outcome::CANCELED);
     }
 
     kj::Own<RpcResponse> consumeRedirectedResponse() {
@@ -2498,6 +2682,8 @@ private:
           });
         }
 
+        connectionState->finishSpan(span, RpcSpan::Outcome::RETURNED);
+
         KJ_IF_MAYBE(e, exports) {
           // Caps were returned, so we can't free the pipeline yet.
           cleanupAnswerTable(kj::mv(*e), false);
@@ -2529,6 +2715,8 @@ private:
           message->send();
         }
 
+        connectionState->finishSpan(span, RpcSpan::Outcome::THREW);
+
         // Do not allow releasing the pipeline because we want pipelined calls to propagate the
         // exception rather than fail with a "no such field" exception.
         cleanupAnswerTable(nullptr, false);
@@ -2553,6 +2741,7 @@ private:
 
         message->send();
 
+        connectionState->finishSpan(span, RpcSpan::Outcome::RETURNED);
         cleanupAnswerTable(nullptr, false);
       }
     }
@@ -2632,6 +2821,8 @@ private:
               message->send();
             }
 
+            connectionState->finishSpan(span, RpcSpan::Outcome::RETURNED);
+
             // There are no caps in our return message, but of course the tail results could have
             // caps, so we must continue to honor pipeline calls (and just bounce them back).
             cleanupAnswerTable(nullptr, false);
@@ -2655,8 +2846,10 @@ private:
       auto voidPromise = promise.then([this](Response<AnyPointer>&& tailResponse) {
         // Copy the response.
         // TODO(perf):  It would be nice if we could somehow make the response get built in-place
-        //   but requires some refactoring.
-        getResults(tailResponse.targetSize()).set(tailResponse);
+        //   but requires some refactoring. For now, PayloadCopier at least avoids a deep copy in
+        //   the common case.
+        PayloadCopier results(tailResponse);
+        results.copyTo(getResults(results.sizeHint()));
       });
 
       return { kj::mv(voidPromise), PipelineHook::from(kj::mv(promise)) };
@@ -2669,12 +2862,23 @@ private:
     kj::Own<CallContextHook> addRef() override {
       return kj::addRef(*this);
     }
+    kj::Maybe<kj::TimePoint> getDeadline() override {
+      return deadline;
+    }
+    kj::Maybe<TraceContext> getTraceContext() override {
+      return traceContext;
+    }
 
   private:
     kj::Own<RpcConnectionState> connectionState;
     AnswerId answerId;
 
     ClientHook::CallHints hints;
+    kj::Maybe<kj::TimePoint> deadline;
+
+    kj::Maybe<TraceContext> traceContext;
+    kj::Maybe<RpcSpan> span;
+    // `span` is the SERVER span recorded for this call, if any, exported when we respond.
 
     uint64_t interfaceId;
     uint16_t methodId;
@@ -3028,9 +3232,37 @@ private:
     // useful in practice and would be complicated to handle "correctly".
     if (redirectResults) hints.onlyPromisePipeline = false;
 
+    kj::Maybe<kj::TimePoint> deadline;
+    if (uint64_t timeout = call.getTimeoutNanos()) {
+      // Clamp absurdly long timeouts so that the deadline doesn't overflow.
+      deadline = now() + int64_t(kj::min(timeout, MAX_CALL_TIMEOUT_NANOS)) * kj::NANOSECONDS;
+    }
+
+    kj::Maybe<TraceContext> traceContext;
+    kj::Maybe<RpcSpan> span;
+    if (call.hasTraceContext()) {
+      auto reader = call.getTraceContext();
+      TraceContext received;
+      received.traceIdHigh = reader.getTraceIdHigh();
+      received.traceIdLow = reader.getTraceIdLow();
+      received.spanId = reader.getSpanId();
+
+      // An all-zero trace ID is invalid; treat the call as untraced.
+      if (received.traceIdHigh != 0 || received.traceIdLow != 0) {
+        span = startSpan(RpcSpan::Kind::SERVER, received,
+                         call.getInterfaceId(), call.getMethodId());
+        KJ_IF_MAYBE(s, span) {
+          traceContext = s->context;
+        } else {
+          traceContext = received;
+        }
+      }
+    }
+
     auto context = kj::refcounted<RpcCallContext>(
         *this, answerId, kj::mv(message), kj::mv(capTableArray), payload.getContent(),
-        redirectResults, call.getInterfaceId(), call.getMethodId(), hints);
+        redirectResults, call.getInterfaceId(), call.getMethodId(), hints, deadline,
+        traceContext, kj::mv(span));
 
     // No more using `call` after this point, as it now belongs to the context.
 
@@ -3045,12 +3277,45 @@ private:
       answer.callContext = *context;
     }
 
+    kj::Maybe<kj::Own<AdmittedCall>> admittedCall;
+    KJ_IF_MAYBE(scheduler, callScheduler) {
+      // Deliver the call to a promise which resolves to the real target once the scheduler admits
+      // the call. Pipelined calls queue up behind it meanwhile, and a Finish cancels it as usual.
+      auto admitted = kj::refcounted<AdmittedCall>();
+      capability = newLocalPromiseClient(
+          scheduler->get()->admit(call.getInterfaceId(), call.getMethodId())
+              .then([capability = kj::mv(capability), admitted = kj::addRef(*admitted)]
+                    (kj::Own<void>&& slot) mutable {
+        admitted->slot = kj::mv(slot);
+        return kj::mv(capability);
+      }));
+      admittedCall = kj::mv(admitted);
+    }
+
     auto promiseAndPipeline = startCall(
         call.getInterfaceId(), call.getMethodId(), kj::mv(capability), context->addRef(), hints);
 
+    KJ_IF_MAYBE(a, admittedCall) {
+      promiseAndPipeline.promise = promiseAndPipeline.promise.attach(kj::mv(*a));
+    }
+
     // Things may have changed -- in particular if startCall() immediately called
     // context->directTailCall().
 
+    KJ_IF_MAYBE(d, deadline) {
+      KJ_IF_MAYBE(t, timer) {
+        // Cancel the call once the caller has lost interest. (If the method doesn't allow
+        // cancellation, it keeps running, but the caller gets its error on time.) This isn't
+        // worth doing for onlyPromisePipeline calls, whose completion nobody waits for.
+        if (!hints.onlyPromisePipeline) {
+          promiseAndPipeline.promise = promiseAndPipeline.promise.exclusiveJoin(
+              t->atTime(*d).then([]() -> kj::Promise<void> {
+            return KJ_EXCEPTION(OVERLOADED, "call deadline exceeded");
+          }));
+        }
+      }
+    }
+
     {
       auto& answer = answers[answerId];
 
@@ -3190,6 +3455,18 @@ private:
         question->skipFinish = true;
       }
 
+      switch (ret.which()) {
+        case rpc::Return::EXCEPTION:
+          finishSpan(question->span, RpcSpan::Outcome::THREW);
+          break;
+        case rpc::Return::CANCELED:
+          finishSpan(question->span, RpcSpan::Outcome::CANCELED);
+          break;
+        default:
+          finishSpan(question->span, RpcSpan::Outcome::RETURNED);
+          break;
+      }
+
       KJ_IF_MAYBE(questionRef, question->selfRef) {
         switch (ret.which()) {
           case rpc::Return::RESULTS: {
@@ -3535,6 +3812,10 @@ private:
 
 }  // namespace
 
+uint64_t flatPayloadCopiesForTest() {
+  return threadFlatPayloadCopies;
+}
+
 class RpcSystemBase::Impl final: private BootstrapFactoryBase, private kj::TaskSet::ErrorHandler {
 public:
   Impl(VatNetworkBase& network, kj::Maybe<Capability::Client> bootstrapInterface)
@@ -3601,6 +3882,30 @@ public:
     traceEncoder = kj::mv(func);
   }
 
+  void setTimer(kj::Timer& newTimer) {
+    timer = newTimer;
+
+    for (auto& conn: connections) {
+      conn.second->setTimer(newTimer);
+    }
+  }
+
+  void setCallScheduler(kj::Function<kj::Own<RpcCallScheduler>()> factory) {
+    for (auto& conn: connections) {
+      conn.second->setCallScheduler(factory());
+    }
+
+    callSchedulerFactory = kj::mv(factory);
+  }
+
+  void setSpanExporter(RpcSpanExporter& exporter) {
+    spanExporter = exporter;
+
+    for (auto& conn: connections) {
+      conn.second->setSpanExporter(exporter);
+    }
+  }
+
   kj::Promise<void> run() { return kj::mv(acceptLoopPromise); }
 
 private:
@@ -3610,6 +3915,9 @@ private:
   kj::Maybe<SturdyRefRestorerBase&> restorer;
   size_t flowLimit = kj::maxValue;
   kj::Maybe<kj::Function<kj::String(const kj::Exception&)>> traceEncoder;
+  kj::Maybe<kj::Timer&> timer;
+  kj::Maybe<kj::Function<kj::Own<RpcCallScheduler>()>> callSchedulerFactory;
+  kj::Maybe<RpcSpanExporter&> spanExporter;
   kj::Promise<void> acceptLoopPromise = nullptr;
   kj::TaskSet tasks;
 
@@ -3631,7 +3939,10 @@ private:
       }));
       auto newState = kj::refcounted<RpcConnectionState>(
           bootstrapFactory, restorer, kj::mv(connection),
-          kj::mv(onDisconnect.fulfiller), flowLimit, traceEncoder);
+          kj::mv(onDisconnect.fulfiller), flowLimit, traceEncoder, timer,
+          callSchedulerFactory.map([](kj::Function<kj::Own<RpcCallScheduler>()>& factory) {
+            return factory();
+          }), spanExporter);
       RpcConnectionState& result = *newState;
       connections.insert(std::make_pair(connectionPtr, kj::mv(newState)));
       return result;
@@ -3694,6 +4005,18 @@ void RpcSystemBase::setTraceEncoder(kj::Function<kj::String(const kj::Exception&
   impl->setTraceEncoder(kj::mv(func));
 }
 
+void RpcSystemBase::setTimer(kj::Timer& timer) {
+  impl->setTimer(timer);
+}
+
+void RpcSystemBase::setCallScheduler(kj::Function<kj::Own<RpcCallScheduler>()> factory) {
+  impl->setCallScheduler(kj::mv(factory));
+}
+
+void RpcSystemBase::setSpanExporter(RpcSpanExporter& exporter) {
+  impl->setSpanExporter(exporter);
+}
+
 kj::Promise<void> RpcSystemBase::run() {
   return impl->run();
 }
@@ -3832,8 +4155,114 @@ private:
   WindowFlowController inner;
 };
 
+class PriorityCallScheduler final: public RpcCallScheduler, public kj::Refcounted {
+public:
+  PriorityCallScheduler(PriorityOptions options): options(kj::mv(options)) {}
+
+  kj::Promise<kj::Own<void>> admit(uint64_t interfaceId, uint16_t methodId) override {
+    int priority = 0;
+    KJ_IF_MAYBE(f, options.priority) {
+      priority = (*f)(interfaceId, methodId);
+    }
+
+    if (running < options.maxConcurrentCalls && queue.empty()) {
+      return startCall();
+    }
+
+    if (queue.size() >= options.maxQueuedCalls) {
+      if (!queue.empty() && std::prev(queue.end())->second->getPriority() < priority) {
+        // Shed the lowest-priority queued call to make room.
+        std::prev(queue.end())->second->shed();
+      } else {
+        return KJ_EXCEPTION(OVERLOADED, "too many calls queued on this connection",
+                            options.maxQueuedCalls);
+      }
+    }
+
+    return kj::newAdaptedPromise<kj::Own<void>, Waiter>(*this, priority);
+  }
+
+private:
+  PriorityOptions options;
+  uint running = 0;
+  uint64_t nextSequence = 0;
+
+  class Waiter;
+  std::map<std::pair<int, uint64_t>, Waiter*> queue;
+  // Keyed on (-priority, sequence), so the first entry is the next call to admit.
+
+  class Slot {
+  public:
+    Slot(kj::Own<PriorityCallScheduler> scheduler): scheduler(kj::mv(scheduler)) {
+      ++this->scheduler->running;
+    }
+    ~Slot() noexcept(false) {
+      --scheduler->running;
+      scheduler->pump();
+    }
+    KJ_DISALLOW_COPY_AND_MOVE(Slot);
+
+  private:
+    kj::Own<PriorityCallScheduler> scheduler;
+  };
+
+  class Waiter {
+  public:
+    Waiter(kj::PromiseFulfiller<kj::Own<void>>& fulfiller,
+           PriorityCallScheduler& scheduler, int priority)
+        : fulfiller(fulfiller), scheduler(kj::addRef(scheduler)), priority(priority),
+          iter(scheduler.queue.insert(std::make_pair(
+              std::make_pair(-priority, scheduler.nextSequence++), this)).first) {}
+    ~Waiter() noexcept(false) {
+      if (queued) {
+        scheduler->queue.erase(iter);
+      }
+    }
+    KJ_DISALLOW_COPY_AND_MOVE(Waiter);
+
+    void admit() {
+      dequeue();
+      fulfiller.fulfill(scheduler->startCall());
+    }
+
+    void shed() {
+      dequeue();
+      fulfiller.reject(KJ_EXCEPTION(OVERLOADED,
+          "call was shed from the queue in favor of a higher-priority call"));
+    }
+
+    int getPriority() { return priority; }
+
+  private:
+    kj::PromiseFulfiller<kj::Own<void>>& fulfiller;
+    kj::Own<PriorityCallScheduler> scheduler;
+    int priority;
+    std::map<std::pair<int, uint64_t>, Waiter*>::iterator iter;
+    bool queued = true;
+
+    void dequeue() {
+      scheduler->queue.erase(iter);
+      queued = false;
+    }
+  };
+
+  kj::Own<void> startCall() {
+    return kj::heap<Slot>(kj::addRef(*this));
+  }
+
+  void pump() {
+    while (running < options.maxConcurrentCalls && !queue.empty()) {
+      queue.begin()->second->admit();
+    }
+  }
+};
+
 }  // namespace
 
+kj::Own<RpcCallScheduler> RpcCallScheduler::newPriorityScheduler(PriorityOptions options) {
+  return kj::refcounted<PriorityCallScheduler>(kj::mv(options));
+}
+
 kj::Own<RpcFlowController> RpcFlowController::newFixedWindowController(size_t windowSize) {
   return kj::heap<FixedWindowFlowController>(windowSize);
 }
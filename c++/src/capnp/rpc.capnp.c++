@@ -257,9 +257,10 @@ static const ::capnp::_::RawSchema* const d_91b79f1f808db032[] = {
 };
 static const uint16_t m_91b79f1f808db032[] = {1, 11, 8, 2, 13, 4, 12, 9, 7, 10, 6, 5, 3, 0};
 static const uint16_t i_91b79f1f808db032[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13};
+static const uint16_t h_91b79f1f808db032[] = {0, 2, 0, 8, 20, 4, 4, 6, 4, 9, 2, 8, 1, 3, 13, 10, 11, 12, 0, 5, 7};
 const ::capnp::_::RawSchema s_91b79f1f808db032 = {
   0x91b79f1f808db032, b_91b79f1f808db032.words, 232, d_91b79f1f808db032, m_91b79f1f808db032,
-  12, 14, i_91b79f1f808db032, nullptr, nullptr, { &s_91b79f1f808db032, nullptr, nullptr, 0, 0, nullptr }, true
+  12, 14, i_91b79f1f808db032, nullptr, nullptr, { &s_91b79f1f808db032, nullptr, nullptr, 0, 0, nullptr }, true, h_91b79f1f808db032
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<51> b_e94ccf8031176ec4 = {
@@ -319,92 +320,107 @@ static const ::capnp::_::AlignedData<51> b_e94ccf8031176ec4 = {
 #if !CAPNP_LITE
 static const uint16_t m_e94ccf8031176ec4[] = {1, 0};
 static const uint16_t i_e94ccf8031176ec4[] = {0, 1};
+static const uint16_t h_e94ccf8031176ec4[] = {1, 0, 1};
 const ::capnp::_::RawSchema s_e94ccf8031176ec4 = {
   0xe94ccf8031176ec4, b_e94ccf8031176ec4.words, 51, nullptr, m_e94ccf8031176ec4,
-  0, 2, i_e94ccf8031176ec4, nullptr, nullptr, { &s_e94ccf8031176ec4, nullptr, nullptr, 0, 0, nullptr }, true
+  0, 2, i_e94ccf8031176ec4, nullptr, nullptr, { &s_e94ccf8031176ec4, nullptr, nullptr, 0, 0, nullptr }, true, h_e94ccf8031176ec4
 };
 #endif  // !CAPNP_LITE
-static const ::capnp::_::AlignedData<155> b_836a53ce789d4cd4 = {
+static const ::capnp::_::AlignedData<187> b_836a53ce789d4cd4 = {
   {   0,   0,   0,   0,   5,   0,   6,   0,
     212,  76, 157, 120, 206,  83, 106, 131,
-     16,   0,   0,   0,   1,   0,   3,   0,
+     16,   0,   0,   0,   1,   0,   4,   0,
      80, 162,  82,  37,  27, 152,  18, 179,
-      3,   0,   7,   0,   0,   0,   0,   0,
+      4,   0,   7,   0,   0,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
      21,   0,   0,   0, 170,   0,   0,   0,
      29,   0,   0,   0,   7,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
-     25,   0,   0,   0, 255,   1,   0,   0,
+     25,   0,   0,   0, 111,   2,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
      99,  97, 112, 110, 112,  47, 114, 112,
      99,  46,  99,  97, 112, 110, 112,  58,
      67,  97, 108, 108,   0,   0,   0,   0,
       0,   0,   0,   0,   1,   0,   1,   0,
-     36,   0,   0,   0,   3,   0,   4,   0,
+     44,   0,   0,   0,   3,   0,   4,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
       0,   0,   1,   0,   0,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
-    237,   0,   0,   0,  90,   0,   0,   0,
+     37,   1,   0,   0,  90,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
-    236,   0,   0,   0,   3,   0,   1,   0,
-    248,   0,   0,   0,   2,   0,   1,   0,
+     36,   1,   0,   0,   3,   0,   1,   0,
+     48,   1,   0,   0,   2,   0,   1,   0,
       1,   0,   0,   0,   0,   0,   0,   0,
       0,   0,   1,   0,   1,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
-    245,   0,   0,   0,  58,   0,   0,   0,
+     45,   1,   0,   0,  58,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
-    240,   0,   0,   0,   3,   0,   1,   0,
-    252,   0,   0,   0,   2,   0,   1,   0,
+     40,   1,   0,   0,   3,   0,   1,   0,
+     52,   1,   0,   0,   2,   0,   1,   0,
       2,   0,   0,   0,   1,   0,   0,   0,
       0,   0,   1,   0,   2,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
-    249,   0,   0,   0,  98,   0,   0,   0,
+     49,   1,   0,   0,  98,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
-    248,   0,   0,   0,   3,   0,   1,   0,
-      4,   1,   0,   0,   2,   0,   1,   0,
+     48,   1,   0,   0,   3,   0,   1,   0,
+     60,   1,   0,   0,   2,   0,   1,   0,
       3,   0,   0,   0,   2,   0,   0,   0,
       0,   0,   1,   0,   3,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
-      1,   1,   0,   0,  74,   0,   0,   0,
+     57,   1,   0,   0,  74,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
-      0,   1,   0,   0,   3,   0,   1,   0,
-     12,   1,   0,   0,   2,   0,   1,   0,
-      7,   0,   0,   0,   1,   0,   0,   0,
+     56,   1,   0,   0,   3,   0,   1,   0,
+     68,   1,   0,   0,   2,   0,   1,   0,
+      9,   0,   0,   0,   1,   0,   0,   0,
       0,   0,   1,   0,   4,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
-      9,   1,   0,   0,  58,   0,   0,   0,
+     65,   1,   0,   0,  58,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
-      4,   1,   0,   0,   3,   0,   1,   0,
-     16,   1,   0,   0,   2,   0,   1,   0,
-      8,   0,   0,   0,   0,   0,   0,   0,
+     60,   1,   0,   0,   3,   0,   1,   0,
+     72,   1,   0,   0,   2,   0,   1,   0,
+     10,   0,   0,   0,   0,   0,   0,   0,
       1,   0,   0,   0,   0,   0,   0,   0,
     153,  95, 171,  26, 246, 176, 232, 218,
-     13,   1,   0,   0, 114,   0,   0,   0,
+     69,   1,   0,   0, 114,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
       4,   0,   0,   0, 128,   0,   0,   0,
       0,   0,   1,   0,   8,   0,   0,   0,
       1,   0,   0,   0,   0,   0,   0,   0,
-    249,   0,   0,   0, 194,   0,   0,   0,
+     49,   1,   0,   0, 194,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
-    252,   0,   0,   0,   3,   0,   1,   0,
-      8,   1,   0,   0,   2,   0,   1,   0,
+     52,   1,   0,   0,   3,   0,   1,   0,
+     64,   1,   0,   0,   2,   0,   1,   0,
       5,   0,   0,   0, 129,   0,   0,   0,
       0,   0,   1,   0,   9,   0,   0,   0,
       1,   0,   0,   0,   0,   0,   0,   0,
-      5,   1,   0,   0, 162,   0,   0,   0,
+     61,   1,   0,   0, 162,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
-      8,   1,   0,   0,   3,   0,   1,   0,
-     20,   1,   0,   0,   2,   0,   1,   0,
+     64,   1,   0,   0,   3,   0,   1,   0,
+     76,   1,   0,   0,   2,   0,   1,   0,
       6,   0,   0,   0, 130,   0,   0,   0,
       0,   0,   1,   0,  10,   0,   0,   0,
       1,   0,   0,   0,   0,   0,   0,   0,
-     17,   1,   0,   0, 162,   0,   0,   0,
+     73,   1,   0,   0, 162,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     76,   1,   0,   0,   3,   0,   1,   0,
+     88,   1,   0,   0,   2,   0,   1,   0,
+      7,   0,   0,   0,   3,   0,   0,   0,
+      0,   0,   1,   0,  11,   0,   0,   0,
+      1,   0,   0,   0,   0,   0,   0,   0,
+     85,   1,   0,   0, 106,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     84,   1,   0,   0,   3,   0,   1,   0,
+     96,   1,   0,   0,   2,   0,   1,   0,
+      8,   0,   0,   0,   3,   0,   0,   0,
+      0,   0,   1,   0,  12,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     93,   1,   0,   0, 106,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
-     20,   1,   0,   0,   3,   0,   1,   0,
-     32,   1,   0,   0,   2,   0,   1,   0,
+     92,   1,   0,   0,   3,   0,   1,   0,
+    104,   1,   0,   0,   2,   0,   1,   0,
     113, 117, 101, 115, 116, 105, 111, 110,
      73, 100,   0,   0,   0,   0,   0,   0,
       8,   0,   0,   0,   0,   0,   0,   0,
@@ -478,6 +494,24 @@ static const ::capnp::_::AlignedData<155> b_836a53ce789d4cd4 = {
       0,   0,   0,   0,   0,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
       1,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+    116, 105, 109, 101, 111, 117, 116,  78,
+     97, 110, 111, 115,   0,   0,   0,   0,
+      9,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      9,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+    116, 114,  97,  99, 101,  67, 111, 110,
+    116, 101, 120, 116,   0,   0,   0,   0,
+     16,   0,   0,   0,   0,   0,   0,   0,
+    133, 160,  99, 128,  50, 251,   5, 156,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     16,   0,   0,   0,   0,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0, }
 };
@@ -486,21 +520,23 @@ static const ::capnp::_::AlignedData<155> b_836a53ce789d4cd4 = {
 static const ::capnp::_::RawSchema* const d_836a53ce789d4cd4[] = {
   &s_95bc14545813fbc1,
   &s_9a0e61223d96743b,
+  &s_9c05fb328063a085,
   &s_dae8b0f61aab5f99,
 };
-static const uint16_t m_836a53ce789d4cd4[] = {6, 2, 3, 7, 8, 4, 0, 5, 1};
-static const uint16_t i_836a53ce789d4cd4[] = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+static const uint16_t m_836a53ce789d4cd4[] = {6, 2, 3, 7, 8, 4, 0, 5, 1, 9, 10};
+static const uint16_t i_836a53ce789d4cd4[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+static const uint16_t h_836a53ce789d4cd4[] = {0, 0, 0, 8, 24, 22, 6, 8, 10, 3, 9, 0, 4, 5, 1, 7, 2};
 const ::capnp::_::RawSchema s_836a53ce789d4cd4 = {
-  0x836a53ce789d4cd4, b_836a53ce789d4cd4.words, 155, d_836a53ce789d4cd4, m_836a53ce789d4cd4,
-  3, 9, i_836a53ce789d4cd4, nullptr, nullptr, { &s_836a53ce789d4cd4, nullptr, nullptr, 0, 0, nullptr }, true
+  0x836a53ce789d4cd4, b_836a53ce789d4cd4.words, 187, d_836a53ce789d4cd4, m_836a53ce789d4cd4,
+  4, 11, i_836a53ce789d4cd4, nullptr, nullptr, { &s_836a53ce789d4cd4, nullptr, nullptr, 0, 0, nullptr }, true, h_836a53ce789d4cd4
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<65> b_dae8b0f61aab5f99 = {
   {   0,   0,   0,   0,   5,   0,   6,   0,
     153,  95, 171,  26, 246, 176, 232, 218,
-     21,   0,   0,   0,   1,   0,   3,   0,
+     21,   0,   0,   0,   1,   0,   4,   0,
     212,  76, 157, 120, 206,  83, 106, 131,
-      3,   0,   7,   0,   1,   0,   3,   0,
+      4,   0,   7,   0,   1,   0,   3,   0,
       3,   0,   0,   0,   0,   0,   0,   0,
      21,   0,   0,   0,  26,   1,   0,   0,
       0,   0,   0,   0,   0,   0,   0,   0,
@@ -569,9 +605,87 @@ static const ::capnp::_::RawSchema* const d_dae8b0f61aab5f99[] = {
 };
 static const uint16_t m_dae8b0f61aab5f99[] = {0, 2, 1};
 static const uint16_t i_dae8b0f61aab5f99[] = {0, 1, 2};
+static const uint16_t h_dae8b0f61aab5f99[] = {3, 0, 0, 1, 2};
 const ::capnp::_::RawSchema s_dae8b0f61aab5f99 = {
   0xdae8b0f61aab5f99, b_dae8b0f61aab5f99.words, 65, d_dae8b0f61aab5f99, m_dae8b0f61aab5f99,
-  1, 3, i_dae8b0f61aab5f99, nullptr, nullptr, { &s_dae8b0f61aab5f99, nullptr, nullptr, 0, 0, nullptr }, true
+  1, 3, i_dae8b0f61aab5f99, nullptr, nullptr, { &s_dae8b0f61aab5f99, nullptr, nullptr, 0, 0, nullptr }, true, h_dae8b0f61aab5f99
+};
+#endif  // !CAPNP_LITE
+static const ::capnp::_::AlignedData<65> b_9c05fb328063a085 = {
+  {   0,   0,   0,   0,   5,   0,   6,   0,
+    133, 160,  99, 128,  50, 251,   5, 156,
+     16,   0,   0,   0,   1,   0,   3,   0,
+     80, 162,  82,  37,  27, 152,  18, 179,
+      0,   0,   7,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     21,   0,   0,   0, 234,   0,   0,   0,
+     33,   0,   0,   0,   7,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     29,   0,   0,   0, 175,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     99,  97, 112, 110, 112,  47, 114, 112,
+     99,  46,  99,  97, 112, 110, 112,  58,
+     84, 114,  97,  99, 101,  67, 111, 110,
+    116, 101, 120, 116,   0,   0,   0,   0,
+      0,   0,   0,   0,   1,   0,   1,   0,
+     12,   0,   0,   0,   3,   0,   4,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   1,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     69,   0,   0,   0,  98,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     68,   0,   0,   0,   3,   0,   1,   0,
+     80,   0,   0,   0,   2,   0,   1,   0,
+      1,   0,   0,   0,   1,   0,   0,   0,
+      0,   0,   1,   0,   1,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     77,   0,   0,   0,  90,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     76,   0,   0,   0,   3,   0,   1,   0,
+     88,   0,   0,   0,   2,   0,   1,   0,
+      2,   0,   0,   0,   2,   0,   0,   0,
+      0,   0,   1,   0,   2,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     85,   0,   0,   0,  58,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+     80,   0,   0,   0,   3,   0,   1,   0,
+     92,   0,   0,   0,   2,   0,   1,   0,
+    116, 114,  97,  99, 101,  73, 100,  72,
+    105, 103, 104,   0,   0,   0,   0,   0,
+      9,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      9,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+    116, 114,  97,  99, 101,  73, 100,  76,
+    111, 119,   0,   0,   0,   0,   0,   0,
+      9,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      9,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+    115, 112,  97, 110,  73, 100,   0,   0,
+      9,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      9,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0, }
+};
+::capnp::word const* const bp_9c05fb328063a085 = b_9c05fb328063a085.words;
+#if !CAPNP_LITE
+static const uint16_t m_9c05fb328063a085[] = {2, 0, 1};
+static const uint16_t i_9c05fb328063a085[] = {0, 1, 2};
+static const uint16_t h_9c05fb328063a085[] = {0, 3, 2, 0, 1};
+const ::capnp::_::RawSchema s_9c05fb328063a085 = {
+  0x9c05fb328063a085, b_9c05fb328063a085.words, 65, nullptr, m_9c05fb328063a085,
+  0, 3, i_9c05fb328063a085, nullptr, nullptr, { &s_9c05fb328063a085, nullptr, nullptr, 0, 0, nullptr }, false, h_9c05fb328063a085
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<164> b_9e19b28d3db3573a = {
@@ -748,9 +862,10 @@ static const ::capnp::_::RawSchema* const d_9e19b28d3db3573a[] = {
 };
 static const uint16_t m_9e19b28d3db3573a[] = {7, 0, 4, 3, 8, 1, 2, 5, 6};
 static const uint16_t i_9e19b28d3db3573a[] = {2, 3, 4, 5, 6, 7, 0, 1, 8};
+static const uint16_t h_9e19b28d3db3573a[] = {0, 13, 0, 0, 3, 0, 5, 4, 2, 3, 7, 1, 8, 6};
 const ::capnp::_::RawSchema s_9e19b28d3db3573a = {
   0x9e19b28d3db3573a, b_9e19b28d3db3573a.words, 164, d_9e19b28d3db3573a, m_9e19b28d3db3573a,
-  2, 9, i_9e19b28d3db3573a, nullptr, nullptr, { &s_9e19b28d3db3573a, nullptr, nullptr, 0, 0, nullptr }, true
+  2, 9, i_9e19b28d3db3573a, nullptr, nullptr, { &s_9e19b28d3db3573a, nullptr, nullptr, 0, 0, nullptr }, true, h_9e19b28d3db3573a
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<69> b_d37d2eb2c2f80e63 = {
@@ -828,9 +943,10 @@ static const ::capnp::_::AlignedData<69> b_d37d2eb2c2f80e63 = {
 #if !CAPNP_LITE
 static const uint16_t m_d37d2eb2c2f80e63[] = {0, 1, 2};
 static const uint16_t i_d37d2eb2c2f80e63[] = {0, 1, 2};
+static const uint16_t h_d37d2eb2c2f80e63[] = {1, 3, 0, 2, 1};
 const ::capnp::_::RawSchema s_d37d2eb2c2f80e63 = {
   0xd37d2eb2c2f80e63, b_d37d2eb2c2f80e63.words, 69, nullptr, m_d37d2eb2c2f80e63,
-  0, 3, i_d37d2eb2c2f80e63, nullptr, nullptr, { &s_d37d2eb2c2f80e63, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 3, i_d37d2eb2c2f80e63, nullptr, nullptr, { &s_d37d2eb2c2f80e63, nullptr, nullptr, 0, 0, nullptr }, false, h_d37d2eb2c2f80e63
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<64> b_bbc29655fa89086e = {
@@ -907,9 +1023,10 @@ static const ::capnp::_::RawSchema* const d_bbc29655fa89086e[] = {
 };
 static const uint16_t m_bbc29655fa89086e[] = {1, 2, 0};
 static const uint16_t i_bbc29655fa89086e[] = {1, 2, 0};
+static const uint16_t h_bbc29655fa89086e[] = {7, 2, 0, 1, 2};
 const ::capnp::_::RawSchema s_bbc29655fa89086e = {
   0xbbc29655fa89086e, b_bbc29655fa89086e.words, 64, d_bbc29655fa89086e, m_bbc29655fa89086e,
-  2, 3, i_bbc29655fa89086e, nullptr, nullptr, { &s_bbc29655fa89086e, nullptr, nullptr, 0, 0, nullptr }, true
+  2, 3, i_bbc29655fa89086e, nullptr, nullptr, { &s_bbc29655fa89086e, nullptr, nullptr, 0, 0, nullptr }, true, h_bbc29655fa89086e
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<48> b_ad1a6c0d7dd07497 = {
@@ -966,9 +1083,10 @@ static const ::capnp::_::AlignedData<48> b_ad1a6c0d7dd07497 = {
 #if !CAPNP_LITE
 static const uint16_t m_ad1a6c0d7dd07497[] = {0, 1};
 static const uint16_t i_ad1a6c0d7dd07497[] = {0, 1};
+static const uint16_t h_ad1a6c0d7dd07497[] = {0, 1, 0};
 const ::capnp::_::RawSchema s_ad1a6c0d7dd07497 = {
   0xad1a6c0d7dd07497, b_ad1a6c0d7dd07497.words, 48, nullptr, m_ad1a6c0d7dd07497,
-  0, 2, i_ad1a6c0d7dd07497, nullptr, nullptr, { &s_ad1a6c0d7dd07497, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 2, i_ad1a6c0d7dd07497, nullptr, nullptr, { &s_ad1a6c0d7dd07497, nullptr, nullptr, 0, 0, nullptr }, false, h_ad1a6c0d7dd07497
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<41> b_f964368b0fbd3711 = {
@@ -1022,9 +1140,10 @@ static const ::capnp::_::RawSchema* const d_f964368b0fbd3711[] = {
 };
 static const uint16_t m_f964368b0fbd3711[] = {1, 0};
 static const uint16_t i_f964368b0fbd3711[] = {0, 1};
+static const uint16_t h_f964368b0fbd3711[] = {2, 0, 1};
 const ::capnp::_::RawSchema s_f964368b0fbd3711 = {
   0xf964368b0fbd3711, b_f964368b0fbd3711.words, 41, d_f964368b0fbd3711, m_f964368b0fbd3711,
-  2, 2, i_f964368b0fbd3711, nullptr, nullptr, { &s_f964368b0fbd3711, nullptr, nullptr, 0, 0, nullptr }, false
+  2, 2, i_f964368b0fbd3711, nullptr, nullptr, { &s_f964368b0fbd3711, nullptr, nullptr, 0, 0, nullptr }, false, h_f964368b0fbd3711
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<81> b_d562b4df655bdd4d = {
@@ -1117,9 +1236,10 @@ static const ::capnp::_::RawSchema* const d_d562b4df655bdd4d[] = {
 };
 static const uint16_t m_d562b4df655bdd4d[] = {2, 3, 1, 0};
 static const uint16_t i_d562b4df655bdd4d[] = {0, 1, 2, 3};
+static const uint16_t h_d562b4df655bdd4d[] = {1, 12, 3, 2, 1, 0};
 const ::capnp::_::RawSchema s_d562b4df655bdd4d = {
   0xd562b4df655bdd4d, b_d562b4df655bdd4d.words, 81, d_d562b4df655bdd4d, m_d562b4df655bdd4d,
-  1, 4, i_d562b4df655bdd4d, nullptr, nullptr, { &s_d562b4df655bdd4d, nullptr, nullptr, 0, 0, nullptr }, false
+  1, 4, i_d562b4df655bdd4d, nullptr, nullptr, { &s_d562b4df655bdd4d, nullptr, nullptr, 0, 0, nullptr }, false, h_d562b4df655bdd4d
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<64> b_9c6a046bfbc1ac5a = {
@@ -1195,9 +1315,10 @@ static const ::capnp::_::RawSchema* const d_9c6a046bfbc1ac5a[] = {
 };
 static const uint16_t m_9c6a046bfbc1ac5a[] = {0, 2, 1};
 static const uint16_t i_9c6a046bfbc1ac5a[] = {0, 1, 2};
+static const uint16_t h_9c6a046bfbc1ac5a[] = {0, 0, 1, 0, 2};
 const ::capnp::_::RawSchema s_9c6a046bfbc1ac5a = {
   0x9c6a046bfbc1ac5a, b_9c6a046bfbc1ac5a.words, 64, d_9c6a046bfbc1ac5a, m_9c6a046bfbc1ac5a,
-  1, 3, i_9c6a046bfbc1ac5a, nullptr, nullptr, { &s_9c6a046bfbc1ac5a, nullptr, nullptr, 0, 0, nullptr }, true
+  1, 3, i_9c6a046bfbc1ac5a, nullptr, nullptr, { &s_9c6a046bfbc1ac5a, nullptr, nullptr, 0, 0, nullptr }, true, h_9c6a046bfbc1ac5a
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<64> b_d4c9b56290554016 = {
@@ -1270,9 +1391,10 @@ static const ::capnp::_::AlignedData<64> b_d4c9b56290554016 = {
 #if !CAPNP_LITE
 static const uint16_t m_d4c9b56290554016[] = {2, 1, 0};
 static const uint16_t i_d4c9b56290554016[] = {0, 1, 2};
+static const uint16_t h_d4c9b56290554016[] = {0, 1, 2, 0, 1};
 const ::capnp::_::RawSchema s_d4c9b56290554016 = {
   0xd4c9b56290554016, b_d4c9b56290554016.words, 64, nullptr, m_d4c9b56290554016,
-  0, 3, i_d4c9b56290554016, nullptr, nullptr, { &s_d4c9b56290554016, nullptr, nullptr, 0, 0, nullptr }, true
+  0, 3, i_d4c9b56290554016, nullptr, nullptr, { &s_d4c9b56290554016, nullptr, nullptr, 0, 0, nullptr }, true, h_d4c9b56290554016
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<63> b_fbe1980490e001af = {
@@ -1347,9 +1469,10 @@ static const ::capnp::_::RawSchema* const d_fbe1980490e001af[] = {
 };
 static const uint16_t m_fbe1980490e001af[] = {2, 0, 1};
 static const uint16_t i_fbe1980490e001af[] = {0, 1, 2};
+static const uint16_t h_fbe1980490e001af[] = {2, 0, 1, 2, 0};
 const ::capnp::_::RawSchema s_fbe1980490e001af = {
   0xfbe1980490e001af, b_fbe1980490e001af.words, 63, d_fbe1980490e001af, m_fbe1980490e001af,
-  1, 3, i_fbe1980490e001af, nullptr, nullptr, { &s_fbe1980490e001af, nullptr, nullptr, 0, 0, nullptr }, true
+  1, 3, i_fbe1980490e001af, nullptr, nullptr, { &s_fbe1980490e001af, nullptr, nullptr, 0, 0, nullptr }, true, h_fbe1980490e001af
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<50> b_95bc14545813fbc1 = {
@@ -1411,9 +1534,10 @@ static const ::capnp::_::RawSchema* const d_95bc14545813fbc1[] = {
 };
 static const uint16_t m_95bc14545813fbc1[] = {0, 1};
 static const uint16_t i_95bc14545813fbc1[] = {0, 1};
+static const uint16_t h_95bc14545813fbc1[] = {0, 0, 1};
 const ::capnp::_::RawSchema s_95bc14545813fbc1 = {
   0x95bc14545813fbc1, b_95bc14545813fbc1.words, 50, d_95bc14545813fbc1, m_95bc14545813fbc1,
-  1, 2, i_95bc14545813fbc1, nullptr, nullptr, { &s_95bc14545813fbc1, nullptr, nullptr, 0, 0, nullptr }, false
+  1, 2, i_95bc14545813fbc1, nullptr, nullptr, { &s_95bc14545813fbc1, nullptr, nullptr, 0, 0, nullptr }, false, h_95bc14545813fbc1
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<52> b_9a0e61223d96743b = {
@@ -1477,9 +1601,10 @@ static const ::capnp::_::RawSchema* const d_9a0e61223d96743b[] = {
 };
 static const uint16_t m_9a0e61223d96743b[] = {1, 0};
 static const uint16_t i_9a0e61223d96743b[] = {0, 1};
+static const uint16_t h_9a0e61223d96743b[] = {1, 0, 1};
 const ::capnp::_::RawSchema s_9a0e61223d96743b = {
   0x9a0e61223d96743b, b_9a0e61223d96743b.words, 52, d_9a0e61223d96743b, m_9a0e61223d96743b,
-  1, 2, i_9a0e61223d96743b, nullptr, nullptr, { &s_9a0e61223d96743b, nullptr, nullptr, 0, 0, nullptr }, true
+  1, 2, i_9a0e61223d96743b, nullptr, nullptr, { &s_9a0e61223d96743b, nullptr, nullptr, 0, 0, nullptr }, true, h_9a0e61223d96743b
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<130> b_8523ddc40b86b8b0 = {
@@ -1622,9 +1747,10 @@ static const ::capnp::_::RawSchema* const d_8523ddc40b86b8b0[] = {
 };
 static const uint16_t m_8523ddc40b86b8b0[] = {6, 0, 4, 3, 1, 2, 5};
 static const uint16_t i_8523ddc40b86b8b0[] = {0, 1, 2, 3, 4, 5, 6};
+static const uint16_t h_8523ddc40b86b8b0[] = {0, 2, 5, 2, 1, 3, 4, 6, 0, 2, 5};
 const ::capnp::_::RawSchema s_8523ddc40b86b8b0 = {
   0x8523ddc40b86b8b0, b_8523ddc40b86b8b0.words, 130, d_8523ddc40b86b8b0, m_8523ddc40b86b8b0,
-  2, 7, i_8523ddc40b86b8b0, nullptr, nullptr, { &s_8523ddc40b86b8b0, nullptr, nullptr, 0, 0, nullptr }, true
+  2, 7, i_8523ddc40b86b8b0, nullptr, nullptr, { &s_8523ddc40b86b8b0, nullptr, nullptr, 0, 0, nullptr }, true, h_8523ddc40b86b8b0
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<57> b_d800b1d6cd6f1ca0 = {
@@ -1693,9 +1819,10 @@ static const ::capnp::_::RawSchema* const d_d800b1d6cd6f1ca0[] = {
 };
 static const uint16_t m_d800b1d6cd6f1ca0[] = {0, 1};
 static const uint16_t i_d800b1d6cd6f1ca0[] = {0, 1};
+static const uint16_t h_d800b1d6cd6f1ca0[] = {0, 0, 1};
 const ::capnp::_::RawSchema s_d800b1d6cd6f1ca0 = {
   0xd800b1d6cd6f1ca0, b_d800b1d6cd6f1ca0.words, 57, d_d800b1d6cd6f1ca0, m_d800b1d6cd6f1ca0,
-  1, 2, i_d800b1d6cd6f1ca0, nullptr, nullptr, { &s_d800b1d6cd6f1ca0, nullptr, nullptr, 0, 0, nullptr }, false
+  1, 2, i_d800b1d6cd6f1ca0, nullptr, nullptr, { &s_d800b1d6cd6f1ca0, nullptr, nullptr, 0, 0, nullptr }, false, h_d800b1d6cd6f1ca0
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<50> b_f316944415569081 = {
@@ -1754,9 +1881,10 @@ static const ::capnp::_::AlignedData<50> b_f316944415569081 = {
 #if !CAPNP_LITE
 static const uint16_t m_f316944415569081[] = {1, 0};
 static const uint16_t i_f316944415569081[] = {0, 1};
+static const uint16_t h_f316944415569081[] = {3, 1, 0};
 const ::capnp::_::RawSchema s_f316944415569081 = {
   0xf316944415569081, b_f316944415569081.words, 50, nullptr, m_f316944415569081,
-  0, 2, i_f316944415569081, nullptr, nullptr, { &s_f316944415569081, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 2, i_f316944415569081, nullptr, nullptr, { &s_f316944415569081, nullptr, nullptr, 0, 0, nullptr }, false, h_f316944415569081
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<49> b_d37007fde1f0027d = {
@@ -1814,9 +1942,10 @@ static const ::capnp::_::AlignedData<49> b_d37007fde1f0027d = {
 #if !CAPNP_LITE
 static const uint16_t m_d37007fde1f0027d[] = {0, 1};
 static const uint16_t i_d37007fde1f0027d[] = {0, 1};
+static const uint16_t h_d37007fde1f0027d[] = {0, 1, 0};
 const ::capnp::_::RawSchema s_d37007fde1f0027d = {
   0xd37007fde1f0027d, b_d37007fde1f0027d.words, 49, nullptr, m_d37007fde1f0027d,
-  0, 2, i_d37007fde1f0027d, nullptr, nullptr, { &s_d37007fde1f0027d, nullptr, nullptr, 0, 0, nullptr }, true
+  0, 2, i_d37007fde1f0027d, nullptr, nullptr, { &s_d37007fde1f0027d, nullptr, nullptr, 0, 0, nullptr }, true, h_d37007fde1f0027d
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<100> b_d625b7063acf691a = {
@@ -1928,9 +2057,10 @@ static const ::capnp::_::RawSchema* const d_d625b7063acf691a[] = {
 };
 static const uint16_t m_d625b7063acf691a[] = {2, 1, 0, 4, 3};
 static const uint16_t i_d625b7063acf691a[] = {0, 1, 2, 3, 4};
+static const uint16_t h_d625b7063acf691a[] = {0, 0, 2, 1, 4, 3, 0, 2};
 const ::capnp::_::RawSchema s_d625b7063acf691a = {
   0xd625b7063acf691a, b_d625b7063acf691a.words, 100, d_d625b7063acf691a, m_d625b7063acf691a,
-  1, 5, i_d625b7063acf691a, nullptr, nullptr, { &s_d625b7063acf691a, nullptr, nullptr, 0, 0, nullptr }, false
+  1, 5, i_d625b7063acf691a, nullptr, nullptr, { &s_d625b7063acf691a, nullptr, nullptr, 0, 0, nullptr }, false, h_d625b7063acf691a
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<37> b_b28c96e23f4cbd58 = {
@@ -1975,9 +2105,10 @@ static const ::capnp::_::AlignedData<37> b_b28c96e23f4cbd58 = {
 ::capnp::word const* const bp_b28c96e23f4cbd58 = b_b28c96e23f4cbd58.words;
 #if !CAPNP_LITE
 static const uint16_t m_b28c96e23f4cbd58[] = {2, 0, 1, 3};
+static const uint16_t h_b28c96e23f4cbd58[] = {0, 1, 2, 0, 3, 1};
 const ::capnp::_::RawSchema s_b28c96e23f4cbd58 = {
   0xb28c96e23f4cbd58, b_b28c96e23f4cbd58.words, 37, nullptr, m_b28c96e23f4cbd58,
-  0, 4, nullptr, nullptr, nullptr, { &s_b28c96e23f4cbd58, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 4, nullptr, nullptr, nullptr, { &s_b28c96e23f4cbd58, nullptr, nullptr, 0, 0, nullptr }, false, h_b28c96e23f4cbd58
 };
 #endif  // !CAPNP_LITE
 CAPNP_DEFINE_ENUM(Type_b28c96e23f4cbd58, b28c96e23f4cbd58);
@@ -2037,6 +2168,18 @@ constexpr ::capnp::_::RawSchema const* Call::SendResultsTo::_capnpPrivate::schem
 #endif  // !CAPNP_NEED_REDUNDANT_CONSTEXPR_DECL
 #endif  // !CAPNP_LITE
 
+// TraceContext
+#if CAPNP_NEED_REDUNDANT_CONSTEXPR_DECL
+constexpr uint16_t TraceContext::_capnpPrivate::dataWordSize;
+constexpr uint16_t TraceContext::_capnpPrivate::pointerCount;
+#endif  // !CAPNP_NEED_REDUNDANT_CONSTEXPR_DECL
+#if !CAPNP_LITE
+#if CAPNP_NEED_REDUNDANT_CONSTEXPR_DECL
+constexpr ::capnp::Kind TraceContext::_capnpPrivate::kind;
+constexpr ::capnp::_::RawSchema const* TraceContext::_capnpPrivate::schema;
+#endif  // !CAPNP_NEED_REDUNDANT_CONSTEXPR_DECL
+#endif  // !CAPNP_LITE
+
 // Return
 #if CAPNP_NEED_REDUNDANT_CONSTEXPR_DECL
 constexpr uint16_t Return::_capnpPrivate::dataWordSize;
@@ -22,6 +22,7 @@ CAPNP_DECLARE_SCHEMA(91b79f1f808db032);
 CAPNP_DECLARE_SCHEMA(e94ccf8031176ec4);
 CAPNP_DECLARE_SCHEMA(836a53ce789d4cd4);
 CAPNP_DECLARE_SCHEMA(dae8b0f61aab5f99);
+CAPNP_DECLARE_SCHEMA(9c05fb328063a085);
 CAPNP_DECLARE_SCHEMA(9e19b28d3db3573a);
 CAPNP_DECLARE_SCHEMA(d37d2eb2c2f80e63);
 CAPNP_DECLARE_SCHEMA(bbc29655fa89086e);
@@ -108,7 +109,7 @@ struct Call {
   struct SendResultsTo;
 
   struct _capnpPrivate {
-    CAPNP_DECLARE_STRUCT_HEADER(836a53ce789d4cd4, 3, 3)
+    CAPNP_DECLARE_STRUCT_HEADER(836a53ce789d4cd4, 4, 4)
     #if !CAPNP_LITE
     static constexpr ::capnp::_::RawBrandedSchema const* brand() { return &schema->defaultBrand; }
     #endif  // !CAPNP_LITE
@@ -128,7 +129,22 @@ struct Call::SendResultsTo {
   };
 
   struct _capnpPrivate {
-    CAPNP_DECLARE_STRUCT_HEADER(dae8b0f61aab5f99, 3, 3)
+    CAPNP_DECLARE_STRUCT_HEADER(dae8b0f61aab5f99, 4, 4)
+    #if !CAPNP_LITE
+    static constexpr ::capnp::_::RawBrandedSchema const* brand() { return &schema->defaultBrand; }
+    #endif  // !CAPNP_LITE
+  };
+};
+
+struct TraceContext {
+  TraceContext() = delete;
+
+  class Reader;
+  class Builder;
+  class Pipeline;
+
+  struct _capnpPrivate {
+    CAPNP_DECLARE_STRUCT_HEADER(9c05fb328063a085, 3, 0)
     #if !CAPNP_LITE
     static constexpr ::capnp::_::RawBrandedSchema const* brand() { return &schema->defaultBrand; }
     #endif  // !CAPNP_LITE
@@ -770,6 +786,11 @@ public:
 
   inline bool getOnlyPromisePipeline() const;
 
+  inline  ::uint64_t getTimeoutNanos() const;
+
+  inline bool hasTraceContext() const;
+  inline  ::capnp::rpc::TraceContext::Reader getTraceContext() const;
+
 private:
   ::capnp::_::StructReader _reader;
   template <typename, ::capnp::Kind>
@@ -833,6 +854,16 @@ public:
   inline bool getOnlyPromisePipeline();
   inline void setOnlyPromisePipeline(bool value);
 
+  inline  ::uint64_t getTimeoutNanos();
+  inline void setTimeoutNanos( ::uint64_t value);
+
+  inline bool hasTraceContext();
+  inline  ::capnp::rpc::TraceContext::Builder getTraceContext();
+  inline void setTraceContext( ::capnp::rpc::TraceContext::Reader value);
+  inline  ::capnp::rpc::TraceContext::Builder initTraceContext();
+  inline void adoptTraceContext(::capnp::Orphan< ::capnp::rpc::TraceContext>&& value);
+  inline ::capnp::Orphan< ::capnp::rpc::TraceContext> disownTraceContext();
+
 private:
   ::capnp::_::StructBuilder _builder;
   template <typename, ::capnp::Kind>
@@ -854,6 +885,7 @@ public:
   inline  ::capnp::rpc::MessageTarget::Pipeline getTarget();
   inline  ::capnp::rpc::Payload::Pipeline getParams();
   inline typename SendResultsTo::Pipeline getSendResultsTo();
+  inline  ::capnp::rpc::TraceContext::Pipeline getTraceContext();
 private:
   ::capnp::AnyPointer::Pipeline _typeless;
   friend class ::capnp::PipelineHook;
@@ -958,6 +990,92 @@ private:
 };
 #endif  // !CAPNP_LITE
 
+class TraceContext::Reader {
+public:
+  typedef TraceContext Reads;
+
+  Reader() = default;
+  inline explicit Reader(::capnp::_::StructReader base): _reader(base) {}
+
+  inline ::capnp::MessageSize totalSize() const {
+    return _reader.totalSize().asPublic();
+  }
+
+#if !CAPNP_LITE
+  inline ::kj::StringTree toString() const {
+    return ::capnp::_::structString(_reader, *_capnpPrivate::brand());
+  }
+#endif  // !CAPNP_LITE
+
+  inline  ::uint64_t getTraceIdHigh() const;
+
+  inline  ::uint64_t getTraceIdLow() const;
+
+  inline  ::uint64_t getSpanId() const;
+
+private:
+  ::capnp::_::StructReader _reader;
+  template <typename, ::capnp::Kind>
+  friend struct ::capnp::ToDynamic_;
+  template <typename, ::capnp::Kind>
+  friend struct ::capnp::_::PointerHelpers;
+  template <typename, ::capnp::Kind>
+  friend struct ::capnp::List;
+  friend class ::capnp::MessageBuilder;
+  friend class ::capnp::Orphanage;
+};
+
+class TraceContext::Builder {
+public:
+  typedef TraceContext Builds;
+
+  Builder() = delete;  // Deleted to discourage incorrect usage.
+                       // You can explicitly initialize to nullptr instead.
+  inline Builder(decltype(nullptr)) {}
+  inline explicit Builder(::capnp::_::StructBuilder base): _builder(base) {}
+  inline operator Reader() const { return Reader(_builder.asReader()); }
+  inline Reader asReader() const { return *this; }
+
+  inline ::capnp::MessageSize totalSize() const { return asReader().totalSize(); }
+#if !CAPNP_LITE
+  inline ::kj::StringTree toString() const { return asReader().toString(); }
+#endif  // !CAPNP_LITE
+
+  inline  ::uint64_t getTraceIdHigh();
+  inline void setTraceIdHigh( ::uint64_t value);
+
+  inline  ::uint64_t getTraceIdLow();
+  inline void setTraceIdLow( ::uint64_t value);
+
+  inline  ::uint64_t getSpanId();
+  inline void setSpanId( ::uint64_t value);
+
+private:
+  ::capnp::_::StructBuilder _builder;
+  template <typename, ::capnp::Kind>
+  friend struct ::capnp::ToDynamic_;
+  friend class ::capnp::Orphanage;
+  template <typename, ::capnp::Kind>
+  friend struct ::capnp::_::PointerHelpers;
+};
+
+#if !CAPNP_LITE
+class TraceContext::Pipeline {
+public:
+  typedef TraceContext Pipelines;
+
+  inline Pipeline(decltype(nullptr)): _typeless(nullptr) {}
+  inline explicit Pipeline(::capnp::AnyPointer::Pipeline&& typeless)
+      : _typeless(kj::mv(typeless)) {}
+
+private:
+  ::capnp::AnyPointer::Pipeline _typeless;
+  friend class ::capnp::PipelineHook;
+  template <typename, ::capnp::Kind>
+  friend struct ::capnp::ToDynamic_;
+};
+#endif  // !CAPNP_LITE
+
 class Return::Reader {
 public:
   typedef Return Reads;
@@ -3454,6 +3572,59 @@ inline void Call::Builder::setOnlyPromisePipeline(bool value) {
       ::capnp::bounded<130>() * ::capnp::ELEMENTS, value);
 }
 
+inline  ::uint64_t Call::Reader::getTimeoutNanos() const {
+  return _reader.getDataField< ::uint64_t>(
+      ::capnp::bounded<3>() * ::capnp::ELEMENTS);
+}
+
+inline  ::uint64_t Call::Builder::getTimeoutNanos() {
+  return _builder.getDataField< ::uint64_t>(
+      ::capnp::bounded<3>() * ::capnp::ELEMENTS);
+}
+inline void Call::Builder::setTimeoutNanos( ::uint64_t value) {
+  _builder.setDataField< ::uint64_t>(
+      ::capnp::bounded<3>() * ::capnp::ELEMENTS, value);
+}
+
+inline bool Call::Reader::hasTraceContext() const {
+  return !_reader.getPointerField(
+      ::capnp::bounded<3>() * ::capnp::POINTERS).isNull();
+}
+inline bool Call::Builder::hasTraceContext() {
+  return !_builder.getPointerField(
+      ::capnp::bounded<3>() * ::capnp::POINTERS).isNull();
+}
+inline  ::capnp::rpc::TraceContext::Reader Call::Reader::getTraceContext() const {
+  return ::capnp::_::PointerHelpers< ::capnp::rpc::TraceContext>::get(_reader.getPointerField(
+      ::capnp::bounded<3>() * ::capnp::POINTERS));
+}
+inline  ::capnp::rpc::TraceContext::Builder Call::Builder::getTraceContext() {
+  return ::capnp::_::PointerHelpers< ::capnp::rpc::TraceContext>::get(_builder.getPointerField(
+      ::capnp::bounded<3>() * ::capnp::POINTERS));
+}
+#if !CAPNP_LITE
+inline  ::capnp::rpc::TraceContext::Pipeline Call::Pipeline::getTraceContext() {
+  return  ::capnp::rpc::TraceContext::Pipeline(_typeless.getPointerField(3));
+}
+#endif  // !CAPNP_LITE
+inline void Call::Builder::setTraceContext( ::capnp::rpc::TraceContext::Reader value) {
+  ::capnp::_::PointerHelpers< ::capnp::rpc::TraceContext>::set(_builder.getPointerField(
+      ::capnp::bounded<3>() * ::capnp::POINTERS), value);
+}
+inline  ::capnp::rpc::TraceContext::Builder Call::Builder::initTraceContext() {
+  return ::capnp::_::PointerHelpers< ::capnp::rpc::TraceContext>::init(_builder.getPointerField(
+      ::capnp::bounded<3>() * ::capnp::POINTERS));
+}
+inline void Call::Builder::adoptTraceContext(
+    ::capnp::Orphan< ::capnp::rpc::TraceContext>&& value) {
+  ::capnp::_::PointerHelpers< ::capnp::rpc::TraceContext>::adopt(_builder.getPointerField(
+      ::capnp::bounded<3>() * ::capnp::POINTERS), kj::mv(value));
+}
+inline ::capnp::Orphan< ::capnp::rpc::TraceContext> Call::Builder::disownTraceContext() {
+  return ::capnp::_::PointerHelpers< ::capnp::rpc::TraceContext>::disown(_builder.getPointerField(
+      ::capnp::bounded<3>() * ::capnp::POINTERS));
+}
+
 inline  ::capnp::rpc::Call::SendResultsTo::Which Call::SendResultsTo::Reader::which() const {
   return _reader.getDataField<Which>(
       ::capnp::bounded<3>() * ::capnp::ELEMENTS);
@@ -3552,6 +3723,48 @@ inline ::capnp::AnyPointer::Builder Call::SendResultsTo::Builder::initThirdParty
   return result;
 }
 
+inline  ::uint64_t TraceContext::Reader::getTraceIdHigh() const {
+  return _reader.getDataField< ::uint64_t>(
+      ::capnp::bounded<0>() * ::capnp::ELEMENTS);
+}
+
+inline  ::uint64_t TraceContext::Builder::getTraceIdHigh() {
+  return _builder.getDataField< ::uint64_t>(
+      ::capnp::bounded<0>() * ::capnp::ELEMENTS);
+}
+inline void TraceContext::Builder::setTraceIdHigh( ::uint64_t value) {
+  _builder.setDataField< ::uint64_t>(
+      ::capnp::bounded<0>() * ::capnp::ELEMENTS, value);
+}
+
+inline  ::uint64_t TraceContext::Reader::getTraceIdLow() const {
+  return _reader.getDataField< ::uint64_t>(
+      ::capnp::bounded<1>() * ::capnp::ELEMENTS);
+}
+
+inline  ::uint64_t TraceContext::Builder::getTraceIdLow() {
+  return _builder.getDataField< ::uint64_t>(
+      ::capnp::bounded<1>() * ::capnp::ELEMENTS);
+}
+inline void TraceContext::Builder::setTraceIdLow( ::uint64_t value) {
+  _builder.setDataField< ::uint64_t>(
+      ::capnp::bounded<1>() * ::capnp::ELEMENTS, value);
+}
+
+inline  ::uint64_t TraceContext::Reader::getSpanId() const {
+  return _reader.getDataField< ::uint64_t>(
+      ::capnp::bounded<2>() * ::capnp::ELEMENTS);
+}
+
+inline  ::uint64_t TraceContext::Builder::getSpanId() {
+  return _builder.getDataField< ::uint64_t>(
+      ::capnp::bounded<2>() * ::capnp::ELEMENTS);
+}
+inline void TraceContext::Builder::setSpanId( ::uint64_t value) {
+  _builder.setDataField< ::uint64_t>(
+      ::capnp::bounded<2>() * ::capnp::ELEMENTS, value);
+}
+
 inline  ::capnp::rpc::Return::Which Return::Reader::which() const {
   return _reader.getDataField<Which>(
       ::capnp::bounded<3>() * ::capnp::ELEMENTS);
@@ -23,6 +23,7 @@
 
 #include <capnp/capability.h>
 #include "rpc-prelude.h"
+#include <kj/function.h>
 
 CAPNP_BEGIN_HEADER
 
@@ -154,6 +155,48 @@ public:
   // Stack traces can sometimes contain sensitive information, so you should think carefully about
   // what information you are willing to reveal to the remote party.
 
+  // void setTimer(kj::Timer& timer);
+  //
+  // (Inherited from _::RpcSystemBase)
+  //
+  // Enables enforcement of call deadlines (see `Request::setDeadline()`). Once set, an incoming
+  // call which carries a deadline fails with an OVERLOADED exception when the deadline passes,
+  // and its server-side promise is canceled if the method allows cancellation. The timer is also
+  // used to convert deadlines to and from the relative timeouts sent on the wire; without one,
+  // `kj::systemPreciseMonotonicClock()` is used and deadlines are propagated but not enforced.
+  // The timer must outlive the RpcSystem.
+
+  // void setCallScheduler(kj::Function<kj::Own<RpcCallScheduler>()> factory);
+  //
+  // (Inherited from _::RpcSystemBase)
+  //
+  // Calls `factory` for each new connection to create a scheduler which decides when calls
+  // received on that connection are delivered; see `RpcCallScheduler`. For example, to limit each
+  // connection to 16 concurrent calls while letting `Interactive` calls skip ahead of the rest:
+  //
+  //     rpcSystem.setCallScheduler([]() {
+  //       RpcCallScheduler::PriorityOptions options;
+  //       options.maxConcurrentCalls = 16;
+  //       options.maxQueuedCalls = 1024;
+  //       options.priority = [](uint64_t interfaceId, uint16_t methodId) {
+  //         return interfaceId == typeId<Interactive>() ? 1 : 0;
+  //       };
+  //       return RpcCallScheduler::newPriorityScheduler(kj::mv(options));
+  //     });
+  //
+  // Connections which already exist get a new scheduler too; calls which their previous scheduler
+  // already admitted or queued are unaffected.
+
+  // void setSpanExporter(RpcSpanExporter& exporter);
+  //
+  // (Inherited from _::RpcSystemBase)
+  //
+  // Records a span for each traced call (see `TraceContext`) sent or received by this RpcSystem
+  // and passes it to `exporter` once the call completes. A received call gets a new span ID, which
+  // the server sees as `CallContext::getTraceContext()`, so that calls it makes in turn are
+  // attributed to it. Without an exporter, trace contexts are passed along unchanged. The exporter
+  // must outlive the RpcSystem.
+
   kj::Promise<void> run() { return RpcSystemBase::run(); }
   // Listens for incoming RPC connections and handles them. Never returns normally, but could throw
   // an exception if the system becomes unable to accept new connections (e.g. because the
@@ -359,6 +402,86 @@ public:
   // The window size used by the default implementation of Connection::newStream().
 };
 
+class RpcCallScheduler {
+  // Decides when calls received on one connection are delivered to their targets. By default,
+  // each call is delivered as soon as it arrives. See `RpcSystem::setCallScheduler()`.
+
+public:
+  virtual kj::Promise<kj::Own<void>> admit(uint64_t interfaceId, uint16_t methodId) = 0;
+  // Called as each call arrives. The call is delivered when the returned promise resolves, and the
+  // object it resolves to is dropped once the call has completed or been canceled, which a
+  // scheduler that limits concurrency can use to notice that a slot has opened up. If the caller
+  // cancels the call while it is still queued, the promise is canceled. If the promise rejects,
+  // the call fails with that exception and is never delivered.
+  //
+  // Promise pipelining works as usual for calls that are still queued: pipelined calls wait with
+  // them. However, a scheduler that lets a later call overtake an earlier one breaks the usual
+  // guarantee that calls to the same object are delivered in the order they were sent, and
+  // embargoes cannot restore that order. Only give different treatment to methods whose relative
+  // order doesn't matter.
+
+  // ---------------------------------------------------------------------------
+  // Common implementations.
+
+  struct PriorityOptions {
+    uint maxConcurrentCalls = kj::maxValue;
+    // Calls beyond this many in progress wait in a queue.
+
+    uint maxQueuedCalls = kj::maxValue;
+    // When the queue is full, a new call displaces the lowest-priority queued call if it has a
+    // higher priority, and otherwise fails. Either way, the call that loses out fails with an
+    // OVERLOADED exception.
+
+    kj::Maybe<kj::Function<int(uint64_t interfaceId, uint16_t methodId)>> priority;
+    // Queued calls are delivered in order of decreasing priority, and in arrival order among
+    // calls with the same priority. If null, every call has priority zero, so calls are delivered
+    // in arrival order.
+  };
+
+  static kj::Own<RpcCallScheduler> newPriorityScheduler(PriorityOptions options);
+  // Constructs a scheduler which limits concurrency and prioritizes queued calls as described by
+  // `options`.
+};
+
+struct RpcSpan {
+  // A traced call as seen by one side of a connection. See `RpcSystem::setSpanExporter()`.
+
+  enum class Kind: uint8_t {
+    CLIENT,   // We sent the call.
+    SERVER    // We received the call.
+  };
+
+  enum class Outcome: uint8_t {
+    RETURNED,   // Returned results, or was redirected elsewhere (e.g. a tail call).
+    THREW,      // Returned an exception.
+    CANCELED    // Canceled before returning, e.g. because the connection was lost.
+  };
+
+  Kind kind = Kind::CLIENT;
+  TraceContext context;
+  // The span's own trace context. Calls attributed to this span carry it.
+
+  uint64_t parentSpanId = 0;
+  // Span ID of the context the call was made under. For a SERVER span, this is the caller's
+  // CLIENT span, if the caller records spans.
+
+  uint64_t interfaceId = 0;
+  uint16_t methodId = 0;
+
+  kj::Date startTime = kj::UNIX_EPOCH;
+  kj::Date endTime = kj::UNIX_EPOCH;
+  Outcome outcome = Outcome::RETURNED;
+};
+
+class RpcSpanExporter {
+  // Receives the spans recorded by an RpcSystem. See `RpcSystem::setSpanExporter()`.
+
+public:
+  virtual void exportSpan(const RpcSpan& span) = 0;
+  // Called on the RpcSystem's thread as each span ends. Must not throw; an exporter that sends
+  // spans over the network should queue them and return immediately.
+};
+
 template <typename VatId, typename ProvisionId, typename RecipientId,
           typename ThirdPartyCapId, typename JoinResult>
 class VatNetwork: public _::VatNetworkBase {
@@ -25,6 +25,8 @@
 #include <kj/compat/gtest.h>
 #include "test-util.h"
 #include <kj/debug.h>
+#include <kj/thread.h>
+#include <atomic>
 
 namespace capnp {
 namespace _ {  // private
@@ -430,6 +432,107 @@ KJ_TEST("SchemaLoader placeholders are assumed to have caps") {
   //   computed the hints.
 }
 
+KJ_TEST("SchemaLoader builds member name hash tables for dynamically-loaded schemas") {
+  SchemaLoader loader;
+  auto schema = loader.load(Schema::from<TestAllTypes>().getProto()).asStruct();
+
+  for (auto field: schema.getFields()) {
+    auto name = field.getProto().getName();
+    KJ_EXPECT(KJ_ASSERT_NONNULL(schema.findFieldByName(name)).getIndex() == field.getIndex(),
+              name);
+  }
+  KJ_EXPECT(schema.findFieldByName("noSuchField") == nullptr);
+
+  auto enumSchema = loader.load(Schema::from<TestEnum>().getProto()).asEnum();
+  for (auto enumerant: enumSchema.getEnumerants()) {
+    auto name = enumerant.getProto().getName();
+    KJ_EXPECT(KJ_ASSERT_NONNULL(enumSchema.findEnumerantByName(name)).getOrdinal() ==
+              enumerant.getOrdinal(), name);
+  }
+  KJ_EXPECT(enumSchema.findEnumerantByName("noSuchEnumerant") == nullptr);
+}
+
+KJ_TEST("SchemaLoader lookups may run concurrently with loading") {
+  // Load enough schemas that the lock-free index has to grow several times while a second thread
+  // is looking them up. IDs are sequential, and loaded in order, so once an ID is visible, all
+  // lower ones must be too.
+  SchemaLoader loader;
+  constexpr uint COUNT = 3000;
+  constexpr uint64_t BASE_ID = 0xc0de000000000000ull;
+  std::atomic<bool> done(false);
+
+  kj::Thread writer([&]() {
+    for (uint i = 0; i < COUNT; i++) {
+      loadUnderAlternateTypeId<TestEnum>(loader, BASE_ID + i);
+    }
+    done.store(true);
+  });
+
+  uint seen = 0;
+  for (;;) {
+    bool finished = done.load();
+    while (seen < COUNT) {
+      KJ_IF_MAYBE(schema, loader.tryGet(BASE_ID + seen)) {
+        KJ_ASSERT(schema->getProto().getId() == BASE_ID + seen);
+        KJ_ASSERT(schema->getProto().isEnum());
+        ++seen;
+      } else {
+        break;
+      }
+    }
+    for (uint i = 0; i < seen; i++) {
+      KJ_ASSERT(loader.tryGet(BASE_ID + i) != nullptr, i, seen);
+    }
+    if (finished) break;
+  }
+
+  KJ_EXPECT(seen == COUNT);
+  KJ_EXPECT(loader.tryGet(BASE_ID + COUNT) == nullptr);
+}
+
+KJ_TEST("SchemaLoader lookups never see half-loaded dependency cycles") {
+  // Loading TestCycleANoCaps natively loads TestCycleBNoCaps from inside it, and B points back at
+  // A. A lookup of B that doesn't take the lock must not succeed until A is complete as well.
+  for (uint round = 0; round < 50; round++) {
+    SchemaLoader loader;
+    kj::Thread writer([&]() {
+      loader.loadCompiledTypeAndDependencies<test::TestCycleANoCaps>();
+    });
+
+    for (;;) {
+      KJ_IF_MAYBE(schema, loader.tryGet(typeId<test::TestCycleBNoCaps>())) {
+        auto b = schema->asStruct();
+        auto a = b.getFieldByName("foo").getType().asList().getElementType().asStruct();
+        KJ_ASSERT(a.getProto().getId() == typeId<test::TestCycleANoCaps>());
+        KJ_ASSERT(a.getFieldByName("foo").getType().asStruct() == b);
+        break;
+      }
+    }
+  }
+}
+
+KJ_TEST("benchmark: SchemaLoader::get() from several threads") {
+  SchemaLoader loader;
+  loader.loadCompiledTypeAndDependencies<TestAllTypes>();
+  loader.loadCompiledTypeAndDependencies<test::TestInterface>();
+  auto schemas = loader.getAllLoaded();
+
+  auto lookUpAll = [&]() {
+    for (uint round = 0; round < 1000; round++) {
+      for (auto schema: schemas) {
+        KJ_ASSERT(loader.get(schema.getProto().getId()) == schema);
+      }
+    }
+  };
+
+  doBenchmark([&]() {
+    kj::Thread thread1(lookUpAll);
+    kj::Thread thread2(lookUpAll);
+    kj::Thread thread3(lookUpAll);
+    lookUpAll();
+  });
+}
+
 }  // namespace
 }  // namespace _ (private)
 }  // namespace capnp
@@ -31,9 +31,7 @@
 #include <kj/map.h>
 #include <capnp/stream.capnp.h>
 
-#if _MSC_VER && !defined(__clang__)
 #include <atomic>
-#endif
 
 namespace capnp {
 
@@ -51,6 +49,99 @@ struct SchemaBindingsPair {
   }
 };
 
+class SchemaIndex {
+  // Maps type IDs to loaded schemas for SchemaLoader::get() and tryGet(), without locking.
+  // Insertions must be serialized -- they happen under the loader's exclusive lock -- but lookups
+  // may run concurrently with insertions and with each other, and complete in a bounded number of
+  // steps.
+  //
+  // This is an insert-only open-addressed table of RawSchema pointers; the key is the schema's
+  // own (immutable) `id`. When it is half full, a table twice the size is built and published.
+  // Retired tables are kept until the index is destroyed because readers may still be probing
+  // them, which costs at most as much memory again as the current table.
+
+public:
+  const _::RawSchema* find(uint64_t id) const {
+    const Table* table = current.load(std::memory_order_acquire);
+    if (table == nullptr) return nullptr;
+    for (size_t i = table->slotFor(id);; i = (i + 1) & table->mask) {
+      const _::RawSchema* schema = table->slots[i].load(std::memory_order_acquire);
+      if (schema == nullptr || schema->id == id) return schema;
+    }
+  }
+
+  void insert(const _::RawSchema* schema) {
+    // `schema` must be fully initialized, since readers may find it as soon as this begins.
+
+    Table* table = current.load(std::memory_order_relaxed);
+    if (table == nullptr || (table->count + 1) * 2 > table->slots.size()) {
+      auto bigger = kj::heap<Table>(table == nullptr ? 6 : table->bits + 1);
+      if (table != nullptr) {
+        for (auto& slot: table->slots) {
+          const _::RawSchema* old = slot.load(std::memory_order_relaxed);
+          if (old != nullptr) bigger->add(old);
+        }
+      }
+      bigger->previous = kj::mv(tables);
+      tables = kj::mv(bigger);
+      table = tables.get();
+      current.store(table, std::memory_order_release);
+    }
+    table->add(schema);
+  }
+
+private:
+  struct Table {
+    kj::Array<std::atomic<const _::RawSchema*>> slots;
+    uint bits;
+    size_t mask;
+    size_t count = 0;
+    kj::Own<Table> previous;
+
+    explicit Table(uint bits)
+        : slots(kj::heapArray<std::atomic<const _::RawSchema*>>(size_t(1) << bits)),
+          bits(bits), mask(slots.size() - 1) {
+      for (auto& slot: slots) slot.store(nullptr, std::memory_order_relaxed);
+    }
+
+    inline size_t slotFor(uint64_t id) const {
+      // Fibonacci hashing, since IDs assigned by hand may be sequential.
+      return (id * 0x9e3779b97f4a7c15ull) >> (64 - bits);
+    }
+
+    void add(const _::RawSchema* schema) {
+      for (size_t i = slotFor(schema->id);; i = (i + 1) & mask) {
+        const _::RawSchema* existing = slots[i].load(std::memory_order_relaxed);
+        if (existing == nullptr) {
+          slots[i].store(schema, std::memory_order_release);
+          ++count;
+          return;
+        } else if (existing->id == schema->id) {
+          // Schemas are updated in place, so this is the same one.
+          return;
+        }
+      }
+    }
+  };
+
+  std::atomic<Table*> current { nullptr };
+  kj::Own<Table> tables;
+};
+
+inline bool isInitialized(const _::RawSchema* schema) {
+  // Like checking `lazyInitializer` under the loader's lock, for schemas found without it.
+#if __GNUC__ || defined(__clang__)
+  return __atomic_load_n(&schema->lazyInitializer, __ATOMIC_ACQUIRE) == nullptr;
+#elif _MSC_VER
+  const _::RawSchema::Initializer* i =
+      *static_cast<_::RawSchema::Initializer const* const volatile*>(&schema->lazyInitializer);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return i == nullptr;
+#else
+#error "Platform not supported"
+#endif
+}
+
 }  // namespace
 
 bool hasDiscriminantValue(const schema::Field::Reader& reader) {
@@ -125,7 +216,18 @@ public:
 
   kj::Arena arena;
 
+  SchemaIndex index;
+  // Every schema in `schemas`, once it has been filled in. Read without holding the lock.
+
 private:
+  class IndexDeferral;
+
+  uint loadDepth = 0;
+  kj::Vector<const _::RawSchema*> unindexed;
+  // Schemas loaded by the load() or loadNative() calls currently on the stack. Dependencies may
+  // be cyclic, so a schema returned by a nested call may point back at one that is still being
+  // filled in. None of them is added to `index` until the outermost call returns.
+
   kj::HashSet<kj::ArrayPtr<const byte>> dedupTable;
   // Records raw segments of memory in the arena against which we my want to de-dupe later
   // additions. Specifically, RawBrandedSchema binding tables are de-duped.
@@ -278,6 +380,19 @@ public:
     return result.begin();
   }
 
+  const uint16_t* makeMemberHashTable() {
+    auto names = kj::heapArray<kj::StringPtr>(members.size());
+    for (auto& member: members) {
+      if (member.value >= names.size()) return nullptr;
+      names[member.value] = member.key;
+    }
+    auto table = _::makeMemberHashTable(names);
+    if (table.size() == 0) return nullptr;
+    kj::ArrayPtr<uint16_t> result = loader.arena.allocateArray<uint16_t>(table.size());
+    memcpy(result.begin(), table.begin(), table.size() * sizeof(uint16_t));
+    return result.begin();
+  }
+
   const uint16_t* makeMembersByDiscriminantArray() {
     return membersByDiscriminant.begin();
   }
@@ -1228,7 +1343,33 @@ private:
 
 // =======================================================================================
 
+class SchemaLoader::Impl::IndexDeferral {
+  // Declared at the top of load() and loadNative(). When the outermost one goes out of scope,
+  // every schema loaded in the meantime is complete and can be published to `index`. If loading
+  // failed with an exception, they are left to the locked lookup path instead.
+
+public:
+  explicit IndexDeferral(Impl& impl): impl(impl) { ++impl.loadDepth; }
+  KJ_DISALLOW_COPY_AND_MOVE(IndexDeferral);
+
+  ~IndexDeferral() noexcept(false) {
+    if (--impl.loadDepth > 0) return;
+    KJ_DEFER(impl.unindexed.clear());
+    if (!unwindDetector.isUnwinding()) {
+      for (auto schema: impl.unindexed) {
+        impl.index.insert(schema);
+      }
+    }
+  }
+
+private:
+  Impl& impl;
+  kj::UnwindDetector unwindDetector;
+};
+
 _::RawSchema* SchemaLoader::Impl::load(const schema::Node::Reader& reader, bool isPlaceholder) {
+  IndexDeferral deferral(*this);
+
   // Make a copy of the node which can be used unchecked.
   kj::ArrayPtr<word> validated = makeUncheckedNodeEnforcingSizeRequirements(reader);
 
@@ -1284,6 +1425,7 @@ _::RawSchema* SchemaLoader::Impl::load(const schema::Node::Reader& reader, bool
     schema->encodedSize = validated.size();
     schema->dependencies = validator.makeDependencyArray(&schema->dependencyCount);
     schema->membersByName = validator.makeMemberInfoArray(&schema->memberCount);
+    schema->membersByHash = validator.makeMemberHashTable();
     schema->membersByDiscriminant = validator.makeMembersByDiscriminantArray();
 
     // Even though this schema isn't itself branded, it may have dependencies that are. So, we
@@ -1310,10 +1452,13 @@ _::RawSchema* SchemaLoader::Impl::load(const schema::Node::Reader& reader, bool
 #endif
   }
 
+  unindexed.add(schema);
   return schema;
 }
 
 _::RawSchema* SchemaLoader::Impl::loadNative(const _::RawSchema* nativeSchema) {
+  IndexDeferral deferral(*this);
+
   _::RawSchema* schema;
   bool shouldReplace;
   bool shouldClearInitializer;
@@ -1407,6 +1552,7 @@ _::RawSchema* SchemaLoader::Impl::loadNative(const _::RawSchema* nativeSchema) {
 #endif
   }
 
+  unindexed.add(schema);
   return schema;
 }
 
@@ -2148,6 +2294,14 @@ Schema SchemaLoader::get(uint64_t id, schema::Brand::Reader brand, Schema scope)
 
 kj::Maybe<Schema> SchemaLoader::tryGet(
     uint64_t id, schema::Brand::Reader brand, Schema scope) const {
+  if (brand.getScopes().size() == 0) {
+    // Fast path: an unbranded lookup of a schema that's already loaded needs no lock.
+    const _::RawSchema* schema = impl.getWithoutLock()->index.find(id);
+    if (schema != nullptr && isInitialized(schema)) {
+      return Schema(&schema->defaultBrand);
+    }
+  }
+
   auto getResult = impl.lockShared()->get()->tryGet(id);
   if (getResult.schema == nullptr || getResult.schema->lazyInitializer != nullptr) {
     // This schema couldn't be found or has yet to be lazily loaded. If we have a lazy loader
@@ -2176,6 +2330,10 @@ kj::Maybe<Schema> SchemaLoader::tryGet(
 
 Schema SchemaLoader::getUnbound(uint64_t id) const {
   auto schema = get(id);
+  if (!schema.getProto().getIsGeneric()) {
+    // Same as what Impl::getUnbound() would return, without taking the lock.
+    return schema;
+  }
   return Schema(impl.lockExclusive()->get()->getUnbound(schema.raw->generic));
 }
 
@@ -408,6 +408,64 @@ KJ_TEST("list-of-enum as generic type parameter has working schema") {
   KJ_ASSERT(elementType.asEnum() == Schema::from<TestEnum>());
 }
 
+KJ_TEST("generated schemas include perfect hash tables for member names") {
+  KJ_EXPECT(rawSchema<test::TestAllTypes>().membersByHash != nullptr);
+  KJ_EXPECT(rawSchema<TestEnum>().membersByHash != nullptr);
+  KJ_EXPECT(rawSchema<test::TestInterface>().membersByHash != nullptr);
+
+  auto schema = Schema::from<test::TestAllTypes>();
+  for (auto field: schema.getFields()) {
+    auto name = field.getProto().getName();
+    KJ_EXPECT(KJ_ASSERT_NONNULL(schema.findFieldByName(name)) == field, name);
+    KJ_EXPECT(schema.findFieldByName(kj::str(name, "x")) == nullptr, name);
+  }
+  KJ_EXPECT(schema.findFieldByName("") == nullptr);
+
+  auto enumSchema = Schema::from<TestEnum>();
+  for (auto enumerant: enumSchema.getEnumerants()) {
+    auto name = enumerant.getProto().getName();
+    KJ_EXPECT(KJ_ASSERT_NONNULL(enumSchema.findEnumerantByName(name)) == enumerant, name);
+  }
+
+  auto interfaceSchema = Schema::from<test::TestInterface>();
+  for (auto method: interfaceSchema.getMethods()) {
+    auto name = method.getProto().getName();
+    KJ_EXPECT(KJ_ASSERT_NONNULL(interfaceSchema.findMethodByName(name)) == method, name);
+  }
+  KJ_EXPECT(interfaceSchema.findMethodByName("qux") == nullptr);
+}
+
+KJ_TEST("makeMemberHashTable() is a minimal perfect hash") {
+  for (uint count: {1, 2, 3, 7, 16, 100, 1000, 10000}) {
+    auto names = KJ_MAP(i, kj::zeroTo(count)) { return kj::str("member", i); };
+    auto namePtrs = KJ_MAP(name, names) -> kj::StringPtr { return name; };
+    auto table = makeMemberHashTable(namePtrs);
+    uint seedCount = memberHashSeedCount(count);
+    KJ_ASSERT(table.size() == seedCount + count, count);
+
+    RawSchema raw = {};
+    raw.memberCount = count;
+    raw.membersByHash = table.begin();
+    for (auto i: kj::indices(names)) {
+      KJ_ASSERT(findMemberByHash(&raw, names[i].begin(), names[i].size()) == i, count, names[i]);
+    }
+  }
+
+  KJ_EXPECT(makeMemberHashTable(nullptr).size() == 0);
+}
+
+KJ_TEST("benchmark: field lookup by name") {
+  auto schema = Schema::from<test::TestAllTypes>();
+  auto names = KJ_MAP(field, schema.getFields()) {
+    return kj::heapString(field.getProto().getName());
+  };
+  doBenchmark([&]() {
+    for (auto& name: names) {
+      KJ_ASSERT(schema.findFieldByName(name) != nullptr);
+    }
+  });
+}
+
 }  // namespace
 }  // namespace _ (private)
 }  // namespace capnp
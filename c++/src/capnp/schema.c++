@@ -22,6 +22,8 @@
 #include "schema.h"
 #include "message.h"
 #include <kj/debug.h>
+#include <kj/vector.h>
+#include <algorithm>
 #include <capnp/stream.capnp.h>
 
 namespace capnp {
@@ -188,6 +190,70 @@ const RawSchema NULL_CONST_SCHEMA = {
   { &NULL_CONST_SCHEMA, nullptr, nullptr, 0, 0, nullptr }
 };
 
+kj::Array<uint16_t> makeMemberHashTable(kj::ArrayPtr<const kj::StringPtr> memberNames) {
+  // This is the "hash, displace" approach: hash each name to a bucket, then, visiting the largest
+  // buckets first, search for a seed which sends each name in the bucket to a distinct free slot.
+
+  uint memberCount = memberNames.size();
+  KJ_REQUIRE(memberCount <= 0xffffu, "too many members");
+  if (memberCount == 0) return nullptr;
+
+  uint seedCount = memberHashSeedCount(memberCount);
+  auto hashes = KJ_MAP(name, memberNames) { return hashMemberName(name.begin(), name.size()); };
+
+  kj::Vector<kj::Vector<uint>> buckets(seedCount);
+  buckets.resize(seedCount);
+  for (auto i: kj::indices(hashes)) {
+    buckets[memberHashBucket(hashes[i], seedCount)].add(i);
+  }
+
+  auto order = KJ_MAP(i, kj::zeroTo(seedCount)) { return i; };
+  std::stable_sort(order.begin(), order.end(), [&](uint a, uint b) {
+    return buckets[a].size() > buckets[b].size();
+  });
+
+  auto table = kj::heapArray<uint16_t>(seedCount + memberCount);
+  auto slots = table.slice(seedCount, table.size());
+  auto taken = kj::heapArray<bool>(memberCount);
+  memset(table.begin(), 0, table.size() * sizeof(uint16_t));
+  memset(taken.begin(), 0, taken.size());
+  kj::Vector<uint> bucketSlots;
+
+  for (uint b: order) {
+    auto& bucket = buckets[b];
+    if (bucket.empty()) break;
+
+    bool found = false;
+    for (uint seed = 0; seed <= 0xffffu && !found; seed++) {
+      bucketSlots.clear();
+      found = true;
+      for (uint member: bucket) {
+        uint slot = memberHashSlot(hashes[member], seed, memberCount);
+        if (taken[slot] || std::find(bucketSlots.begin(), bucketSlots.end(), slot)
+                                != bucketSlots.end()) {
+          found = false;
+          break;
+        }
+        bucketSlots.add(slot);
+      }
+      if (found) {
+        table[b] = seed;
+        for (auto i: kj::indices(bucket)) {
+          taken[bucketSlots[i]] = true;
+          slots[bucketSlots[i]] = bucket[i];
+        }
+      }
+    }
+
+    if (!found) {
+      // Two names have identical hashes.
+      return nullptr;
+    }
+  }
+
+  return table;
+}
+
 }  // namespace _ (private)
 
 // =======================================================================================
@@ -458,6 +524,15 @@ namespace {
 template <typename List>
 auto findSchemaMemberByName(const _::RawSchema* raw, kj::StringPtr name, List&& list)
     -> kj::Maybe<decltype(list[0])> {
+  if (raw->membersByHash != nullptr) {
+    auto candidate = list[_::findMemberByHash(raw, name.begin(), name.size())];
+    if (candidate.getProto().getName() == name) {
+      return candidate;
+    } else {
+      return nullptr;
+    }
+  }
+
   uint lower = 0;
   uint upper = raw->memberCount;
 
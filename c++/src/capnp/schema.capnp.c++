@@ -246,9 +246,10 @@ static const ::capnp::_::RawSchema* const d_e682ab4cf923a417[] = {
 };
 static const uint16_t m_e682ab4cf923a417[] = {11, 5, 10, 1, 2, 8, 6, 0, 9, 13, 4, 12, 3, 7};
 static const uint16_t i_e682ab4cf923a417[] = {6, 7, 8, 9, 10, 11, 0, 1, 2, 3, 4, 5, 12, 13};
+static const uint16_t h_e682ab4cf923a417[] = {1, 14, 0, 3, 1, 4, 15, 8, 13, 7, 4, 3, 5, 1, 9, 2, 10, 12, 11, 6, 0};
 const ::capnp::_::RawSchema s_e682ab4cf923a417 = {
   0xe682ab4cf923a417, b_e682ab4cf923a417.words, 225, d_e682ab4cf923a417, m_e682ab4cf923a417,
-  8, 14, i_e682ab4cf923a417, nullptr, nullptr, { &s_e682ab4cf923a417, nullptr, nullptr, 0, 0, nullptr }, true
+  8, 14, i_e682ab4cf923a417, nullptr, nullptr, { &s_e682ab4cf923a417, nullptr, nullptr, 0, 0, nullptr }, true, h_e682ab4cf923a417
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<34> b_b9521bccf10fa3b1 = {
@@ -291,9 +292,10 @@ static const ::capnp::_::AlignedData<34> b_b9521bccf10fa3b1 = {
 #if !CAPNP_LITE
 static const uint16_t m_b9521bccf10fa3b1[] = {0};
 static const uint16_t i_b9521bccf10fa3b1[] = {0};
+static const uint16_t h_b9521bccf10fa3b1[] = {0, 0};
 const ::capnp::_::RawSchema s_b9521bccf10fa3b1 = {
   0xb9521bccf10fa3b1, b_b9521bccf10fa3b1.words, 34, nullptr, m_b9521bccf10fa3b1,
-  0, 1, i_b9521bccf10fa3b1, nullptr, nullptr, { &s_b9521bccf10fa3b1, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 1, i_b9521bccf10fa3b1, nullptr, nullptr, { &s_b9521bccf10fa3b1, nullptr, nullptr, 0, 0, nullptr }, false, h_b9521bccf10fa3b1
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<49> b_debf55bbfa0fc242 = {
@@ -351,9 +353,10 @@ static const ::capnp::_::AlignedData<49> b_debf55bbfa0fc242 = {
 #if !CAPNP_LITE
 static const uint16_t m_debf55bbfa0fc242[] = {1, 0};
 static const uint16_t i_debf55bbfa0fc242[] = {0, 1};
+static const uint16_t h_debf55bbfa0fc242[] = {0, 0, 1};
 const ::capnp::_::RawSchema s_debf55bbfa0fc242 = {
   0xdebf55bbfa0fc242, b_debf55bbfa0fc242.words, 49, nullptr, m_debf55bbfa0fc242,
-  0, 2, i_debf55bbfa0fc242, nullptr, nullptr, { &s_debf55bbfa0fc242, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 2, i_debf55bbfa0fc242, nullptr, nullptr, { &s_debf55bbfa0fc242, nullptr, nullptr, 0, 0, nullptr }, false, h_debf55bbfa0fc242
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<72> b_f38e1de3041357ae = {
@@ -437,9 +440,10 @@ static const ::capnp::_::RawSchema* const d_f38e1de3041357ae[] = {
 };
 static const uint16_t m_f38e1de3041357ae[] = {1, 0, 2};
 static const uint16_t i_f38e1de3041357ae[] = {0, 1, 2};
+static const uint16_t h_f38e1de3041357ae[] = {8, 0, 1, 0, 2};
 const ::capnp::_::RawSchema s_f38e1de3041357ae = {
   0xf38e1de3041357ae, b_f38e1de3041357ae.words, 72, d_f38e1de3041357ae, m_f38e1de3041357ae,
-  1, 3, i_f38e1de3041357ae, nullptr, nullptr, { &s_f38e1de3041357ae, nullptr, nullptr, 0, 0, nullptr }, false
+  1, 3, i_f38e1de3041357ae, nullptr, nullptr, { &s_f38e1de3041357ae, nullptr, nullptr, 0, 0, nullptr }, false, h_f38e1de3041357ae
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<36> b_c2ba9038898e1fa2 = {
@@ -484,9 +488,10 @@ static const ::capnp::_::AlignedData<36> b_c2ba9038898e1fa2 = {
 #if !CAPNP_LITE
 static const uint16_t m_c2ba9038898e1fa2[] = {0};
 static const uint16_t i_c2ba9038898e1fa2[] = {0};
+static const uint16_t h_c2ba9038898e1fa2[] = {0, 0};
 const ::capnp::_::RawSchema s_c2ba9038898e1fa2 = {
   0xc2ba9038898e1fa2, b_c2ba9038898e1fa2.words, 36, nullptr, m_c2ba9038898e1fa2,
-  0, 1, i_c2ba9038898e1fa2, nullptr, nullptr, { &s_c2ba9038898e1fa2, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 1, i_c2ba9038898e1fa2, nullptr, nullptr, { &s_c2ba9038898e1fa2, nullptr, nullptr, 0, 0, nullptr }, false, h_c2ba9038898e1fa2
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<134> b_9ea0b19b37fb4435 = {
@@ -634,9 +639,10 @@ static const ::capnp::_::RawSchema* const d_9ea0b19b37fb4435[] = {
 };
 static const uint16_t m_9ea0b19b37fb4435[] = {0, 4, 5, 6, 3, 1, 2};
 static const uint16_t i_9ea0b19b37fb4435[] = {0, 1, 2, 3, 4, 5, 6};
+static const uint16_t h_9ea0b19b37fb4435[] = {25, 0, 0, 5, 6, 4, 5, 1, 0, 2, 3};
 const ::capnp::_::RawSchema s_9ea0b19b37fb4435 = {
   0x9ea0b19b37fb4435, b_9ea0b19b37fb4435.words, 134, d_9ea0b19b37fb4435, m_9ea0b19b37fb4435,
-  3, 7, i_9ea0b19b37fb4435, nullptr, nullptr, { &s_9ea0b19b37fb4435, nullptr, nullptr, 0, 0, nullptr }, true
+  3, 7, i_9ea0b19b37fb4435, nullptr, nullptr, { &s_9ea0b19b37fb4435, nullptr, nullptr, 0, 0, nullptr }, true, h_9ea0b19b37fb4435
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<37> b_b54ab3364333f598 = {
@@ -686,9 +692,10 @@ static const ::capnp::_::RawSchema* const d_b54ab3364333f598[] = {
 };
 static const uint16_t m_b54ab3364333f598[] = {0};
 static const uint16_t i_b54ab3364333f598[] = {0};
+static const uint16_t h_b54ab3364333f598[] = {0, 0};
 const ::capnp::_::RawSchema s_b54ab3364333f598 = {
   0xb54ab3364333f598, b_b54ab3364333f598.words, 37, d_b54ab3364333f598, m_b54ab3364333f598,
-  2, 1, i_b54ab3364333f598, nullptr, nullptr, { &s_b54ab3364333f598, nullptr, nullptr, 0, 0, nullptr }, true
+  2, 1, i_b54ab3364333f598, nullptr, nullptr, { &s_b54ab3364333f598, nullptr, nullptr, 0, 0, nullptr }, true, h_b54ab3364333f598
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<57> b_e82753cff0c2218f = {
@@ -759,9 +766,10 @@ static const ::capnp::_::RawSchema* const d_e82753cff0c2218f[] = {
 };
 static const uint16_t m_e82753cff0c2218f[] = {0, 1};
 static const uint16_t i_e82753cff0c2218f[] = {0, 1};
+static const uint16_t h_e82753cff0c2218f[] = {0, 1, 0};
 const ::capnp::_::RawSchema s_e82753cff0c2218f = {
   0xe82753cff0c2218f, b_e82753cff0c2218f.words, 57, d_e82753cff0c2218f, m_e82753cff0c2218f,
-  3, 2, i_e82753cff0c2218f, nullptr, nullptr, { &s_e82753cff0c2218f, nullptr, nullptr, 0, 0, nullptr }, true
+  3, 2, i_e82753cff0c2218f, nullptr, nullptr, { &s_e82753cff0c2218f, nullptr, nullptr, 0, 0, nullptr }, true, h_e82753cff0c2218f
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<47> b_b18aa5ac7a0d9420 = {
@@ -822,9 +830,10 @@ static const ::capnp::_::RawSchema* const d_b18aa5ac7a0d9420[] = {
 };
 static const uint16_t m_b18aa5ac7a0d9420[] = {0, 1};
 static const uint16_t i_b18aa5ac7a0d9420[] = {0, 1};
+static const uint16_t h_b18aa5ac7a0d9420[] = {1, 0, 1};
 const ::capnp::_::RawSchema s_b18aa5ac7a0d9420 = {
   0xb18aa5ac7a0d9420, b_b18aa5ac7a0d9420.words, 47, d_b18aa5ac7a0d9420, m_b18aa5ac7a0d9420,
-  3, 2, i_b18aa5ac7a0d9420, nullptr, nullptr, { &s_b18aa5ac7a0d9420, nullptr, nullptr, 0, 0, nullptr }, true
+  3, 2, i_b18aa5ac7a0d9420, nullptr, nullptr, { &s_b18aa5ac7a0d9420, nullptr, nullptr, 0, 0, nullptr }, true, h_b18aa5ac7a0d9420
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<228> b_ec1619d4400a0290 = {
@@ -1065,9 +1074,10 @@ static const ::capnp::_::RawSchema* const d_ec1619d4400a0290[] = {
 };
 static const uint16_t m_ec1619d4400a0290[] = {12, 2, 3, 4, 6, 1, 8, 9, 10, 11, 5, 7, 0};
 static const uint16_t i_ec1619d4400a0290[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+static const uint16_t h_ec1619d4400a0290[] = {2, 2, 0, 13, 29, 16, 0, 0, 10, 2, 11, 6, 8, 7, 5, 12, 3, 4, 9, 1};
 const ::capnp::_::RawSchema s_ec1619d4400a0290 = {
   0xec1619d4400a0290, b_ec1619d4400a0290.words, 228, d_ec1619d4400a0290, m_ec1619d4400a0290,
-  2, 13, i_ec1619d4400a0290, nullptr, nullptr, { &s_ec1619d4400a0290, nullptr, nullptr, 0, 0, nullptr }, false
+  2, 13, i_ec1619d4400a0290, nullptr, nullptr, { &s_ec1619d4400a0290, nullptr, nullptr, 0, 0, nullptr }, false, h_ec1619d4400a0290
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<114> b_9aad50a41f4af45f = {
@@ -1196,9 +1206,10 @@ static const ::capnp::_::RawSchema* const d_9aad50a41f4af45f[] = {
 };
 static const uint16_t m_9aad50a41f4af45f[] = {2, 1, 3, 5, 0, 6, 4};
 static const uint16_t i_9aad50a41f4af45f[] = {4, 5, 0, 1, 2, 3, 6};
+static const uint16_t h_9aad50a41f4af45f[] = {0, 0, 0, 10, 4, 5, 6, 0, 2, 3, 1};
 const ::capnp::_::RawSchema s_9aad50a41f4af45f = {
   0x9aad50a41f4af45f, b_9aad50a41f4af45f.words, 114, d_9aad50a41f4af45f, m_9aad50a41f4af45f,
-  4, 7, i_9aad50a41f4af45f, nullptr, nullptr, { &s_9aad50a41f4af45f, nullptr, nullptr, 0, 0, nullptr }, true
+  4, 7, i_9aad50a41f4af45f, nullptr, nullptr, { &s_9aad50a41f4af45f, nullptr, nullptr, 0, 0, nullptr }, true, h_9aad50a41f4af45f
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<25> b_97b14cbe7cfec712 = {
@@ -1232,7 +1243,7 @@ static const ::capnp::_::AlignedData<25> b_97b14cbe7cfec712 = {
 #if !CAPNP_LITE
 const ::capnp::_::RawSchema s_97b14cbe7cfec712 = {
   0x97b14cbe7cfec712, b_97b14cbe7cfec712.words, 25, nullptr, nullptr,
-  0, 0, nullptr, nullptr, nullptr, { &s_97b14cbe7cfec712, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 0, nullptr, nullptr, nullptr, { &s_97b14cbe7cfec712, nullptr, nullptr, 0, 0, nullptr }, false, nullptr
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<80> b_c42305476bb4746f = {
@@ -1326,9 +1337,10 @@ static const ::capnp::_::RawSchema* const d_c42305476bb4746f[] = {
 };
 static const uint16_t m_c42305476bb4746f[] = {2, 3, 0, 1};
 static const uint16_t i_c42305476bb4746f[] = {0, 1, 2, 3};
+static const uint16_t h_c42305476bb4746f[] = {4, 5, 1, 2, 0, 3};
 const ::capnp::_::RawSchema s_c42305476bb4746f = {
   0xc42305476bb4746f, b_c42305476bb4746f.words, 80, d_c42305476bb4746f, m_c42305476bb4746f,
-  3, 4, i_c42305476bb4746f, nullptr, nullptr, { &s_c42305476bb4746f, nullptr, nullptr, 0, 0, nullptr }, true
+  3, 4, i_c42305476bb4746f, nullptr, nullptr, { &s_c42305476bb4746f, nullptr, nullptr, 0, 0, nullptr }, true, h_c42305476bb4746f
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<32> b_cafccddb68db1d11 = {
@@ -1372,9 +1384,10 @@ static const ::capnp::_::RawSchema* const d_cafccddb68db1d11[] = {
 };
 static const uint16_t m_cafccddb68db1d11[] = {0};
 static const uint16_t i_cafccddb68db1d11[] = {0};
+static const uint16_t h_cafccddb68db1d11[] = {0, 0};
 const ::capnp::_::RawSchema s_cafccddb68db1d11 = {
   0xcafccddb68db1d11, b_cafccddb68db1d11.words, 32, d_cafccddb68db1d11, m_cafccddb68db1d11,
-  1, 1, i_cafccddb68db1d11, nullptr, nullptr, { &s_cafccddb68db1d11, nullptr, nullptr, 0, 0, nullptr }, false
+  1, 1, i_cafccddb68db1d11, nullptr, nullptr, { &s_cafccddb68db1d11, nullptr, nullptr, 0, 0, nullptr }, false, h_cafccddb68db1d11
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<50> b_bb90d5c287870be6 = {
@@ -1436,9 +1449,10 @@ static const ::capnp::_::RawSchema* const d_bb90d5c287870be6[] = {
 };
 static const uint16_t m_bb90d5c287870be6[] = {1, 0};
 static const uint16_t i_bb90d5c287870be6[] = {0, 1};
+static const uint16_t h_bb90d5c287870be6[] = {0, 0, 1};
 const ::capnp::_::RawSchema s_bb90d5c287870be6 = {
   0xbb90d5c287870be6, b_bb90d5c287870be6.words, 50, d_bb90d5c287870be6, m_bb90d5c287870be6,
-  1, 2, i_bb90d5c287870be6, nullptr, nullptr, { &s_bb90d5c287870be6, nullptr, nullptr, 0, 0, nullptr }, false
+  1, 2, i_bb90d5c287870be6, nullptr, nullptr, { &s_bb90d5c287870be6, nullptr, nullptr, 0, 0, nullptr }, false, h_bb90d5c287870be6
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<69> b_978a7cebdc549a4d = {
@@ -1519,9 +1533,10 @@ static const ::capnp::_::RawSchema* const d_978a7cebdc549a4d[] = {
 };
 static const uint16_t m_978a7cebdc549a4d[] = {2, 1, 0};
 static const uint16_t i_978a7cebdc549a4d[] = {0, 1, 2};
+static const uint16_t h_978a7cebdc549a4d[] = {3, 1, 1, 2, 0};
 const ::capnp::_::RawSchema s_978a7cebdc549a4d = {
   0x978a7cebdc549a4d, b_978a7cebdc549a4d.words, 69, d_978a7cebdc549a4d, m_978a7cebdc549a4d,
-  1, 3, i_978a7cebdc549a4d, nullptr, nullptr, { &s_978a7cebdc549a4d, nullptr, nullptr, 0, 0, nullptr }, true
+  1, 3, i_978a7cebdc549a4d, nullptr, nullptr, { &s_978a7cebdc549a4d, nullptr, nullptr, 0, 0, nullptr }, true, h_978a7cebdc549a4d
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<48> b_a9962a9ed0a4d7f8 = {
@@ -1581,9 +1596,10 @@ static const ::capnp::_::RawSchema* const d_a9962a9ed0a4d7f8[] = {
 };
 static const uint16_t m_a9962a9ed0a4d7f8[] = {1, 0};
 static const uint16_t i_a9962a9ed0a4d7f8[] = {0, 1};
+static const uint16_t h_a9962a9ed0a4d7f8[] = {0, 1, 0};
 const ::capnp::_::RawSchema s_a9962a9ed0a4d7f8 = {
   0xa9962a9ed0a4d7f8, b_a9962a9ed0a4d7f8.words, 48, d_a9962a9ed0a4d7f8, m_a9962a9ed0a4d7f8,
-  1, 2, i_a9962a9ed0a4d7f8, nullptr, nullptr, { &s_a9962a9ed0a4d7f8, nullptr, nullptr, 0, 0, nullptr }, false
+  1, 2, i_a9962a9ed0a4d7f8, nullptr, nullptr, { &s_a9962a9ed0a4d7f8, nullptr, nullptr, 0, 0, nullptr }, false, h_a9962a9ed0a4d7f8
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<155> b_9500cce23b334d80 = {
@@ -1752,9 +1768,10 @@ static const ::capnp::_::RawSchema* const d_9500cce23b334d80[] = {
 };
 static const uint16_t m_9500cce23b334d80[] = {4, 1, 7, 0, 5, 2, 6, 3};
 static const uint16_t i_9500cce23b334d80[] = {0, 1, 2, 3, 4, 5, 6, 7};
+static const uint16_t h_9500cce23b334d80[] = {0, 15, 1, 2, 1, 7, 5, 3, 4, 0, 2, 6};
 const ::capnp::_::RawSchema s_9500cce23b334d80 = {
   0x9500cce23b334d80, b_9500cce23b334d80.words, 155, d_9500cce23b334d80, m_9500cce23b334d80,
-  3, 8, i_9500cce23b334d80, nullptr, nullptr, { &s_9500cce23b334d80, nullptr, nullptr, 0, 0, nullptr }, true
+  3, 8, i_9500cce23b334d80, nullptr, nullptr, { &s_9500cce23b334d80, nullptr, nullptr, 0, 0, nullptr }, true, h_9500cce23b334d80
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<269> b_d07378ede1f9cc60 = {
@@ -2039,9 +2056,10 @@ static const ::capnp::_::RawSchema* const d_d07378ede1f9cc60[] = {
 };
 static const uint16_t m_d07378ede1f9cc60[] = {18, 1, 13, 15, 10, 11, 3, 4, 5, 2, 17, 14, 16, 12, 7, 8, 9, 6, 0};
 static const uint16_t i_d07378ede1f9cc60[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18};
+static const uint16_t h_d07378ede1f9cc60[] = {0, 0, 21, 0, 3, 3, 2, 1, 0, 71, 6, 18, 0, 16, 1, 4, 3, 15, 2, 7, 17, 8, 13, 9, 11, 5, 14, 10, 12};
 const ::capnp::_::RawSchema s_d07378ede1f9cc60 = {
   0xd07378ede1f9cc60, b_d07378ede1f9cc60.words, 269, d_d07378ede1f9cc60, m_d07378ede1f9cc60,
-  5, 19, i_d07378ede1f9cc60, nullptr, nullptr, { &s_d07378ede1f9cc60, nullptr, nullptr, 0, 0, nullptr }, false
+  5, 19, i_d07378ede1f9cc60, nullptr, nullptr, { &s_d07378ede1f9cc60, nullptr, nullptr, 0, 0, nullptr }, false, h_d07378ede1f9cc60
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<33> b_87e739250a60ea97 = {
@@ -2086,9 +2104,10 @@ static const ::capnp::_::RawSchema* const d_87e739250a60ea97[] = {
 };
 static const uint16_t m_87e739250a60ea97[] = {0};
 static const uint16_t i_87e739250a60ea97[] = {0};
+static const uint16_t h_87e739250a60ea97[] = {0, 0};
 const ::capnp::_::RawSchema s_87e739250a60ea97 = {
   0x87e739250a60ea97, b_87e739250a60ea97.words, 33, d_87e739250a60ea97, m_87e739250a60ea97,
-  1, 1, i_87e739250a60ea97, nullptr, nullptr, { &s_87e739250a60ea97, nullptr, nullptr, 0, 0, nullptr }, false
+  1, 1, i_87e739250a60ea97, nullptr, nullptr, { &s_87e739250a60ea97, nullptr, nullptr, 0, 0, nullptr }, false, h_87e739250a60ea97
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<47> b_9e0e78711a7f87a9 = {
@@ -2148,9 +2167,10 @@ static const ::capnp::_::RawSchema* const d_9e0e78711a7f87a9[] = {
 };
 static const uint16_t m_9e0e78711a7f87a9[] = {1, 0};
 static const uint16_t i_9e0e78711a7f87a9[] = {0, 1};
+static const uint16_t h_9e0e78711a7f87a9[] = {4, 0, 1};
 const ::capnp::_::RawSchema s_9e0e78711a7f87a9 = {
   0x9e0e78711a7f87a9, b_9e0e78711a7f87a9.words, 47, d_9e0e78711a7f87a9, m_9e0e78711a7f87a9,
-  2, 2, i_9e0e78711a7f87a9, nullptr, nullptr, { &s_9e0e78711a7f87a9, nullptr, nullptr, 0, 0, nullptr }, false
+  2, 2, i_9e0e78711a7f87a9, nullptr, nullptr, { &s_9e0e78711a7f87a9, nullptr, nullptr, 0, 0, nullptr }, false, h_9e0e78711a7f87a9
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<47> b_ac3a6f60ef4cc6d3 = {
@@ -2210,9 +2230,10 @@ static const ::capnp::_::RawSchema* const d_ac3a6f60ef4cc6d3[] = {
 };
 static const uint16_t m_ac3a6f60ef4cc6d3[] = {1, 0};
 static const uint16_t i_ac3a6f60ef4cc6d3[] = {0, 1};
+static const uint16_t h_ac3a6f60ef4cc6d3[] = {4, 0, 1};
 const ::capnp::_::RawSchema s_ac3a6f60ef4cc6d3 = {
   0xac3a6f60ef4cc6d3, b_ac3a6f60ef4cc6d3.words, 47, d_ac3a6f60ef4cc6d3, m_ac3a6f60ef4cc6d3,
-  2, 2, i_ac3a6f60ef4cc6d3, nullptr, nullptr, { &s_ac3a6f60ef4cc6d3, nullptr, nullptr, 0, 0, nullptr }, false
+  2, 2, i_ac3a6f60ef4cc6d3, nullptr, nullptr, { &s_ac3a6f60ef4cc6d3, nullptr, nullptr, 0, 0, nullptr }, false, h_ac3a6f60ef4cc6d3
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<48> b_ed8bca69f7fb0cbf = {
@@ -2273,9 +2294,10 @@ static const ::capnp::_::RawSchema* const d_ed8bca69f7fb0cbf[] = {
 };
 static const uint16_t m_ed8bca69f7fb0cbf[] = {1, 0};
 static const uint16_t i_ed8bca69f7fb0cbf[] = {0, 1};
+static const uint16_t h_ed8bca69f7fb0cbf[] = {4, 0, 1};
 const ::capnp::_::RawSchema s_ed8bca69f7fb0cbf = {
   0xed8bca69f7fb0cbf, b_ed8bca69f7fb0cbf.words, 48, d_ed8bca69f7fb0cbf, m_ed8bca69f7fb0cbf,
-  2, 2, i_ed8bca69f7fb0cbf, nullptr, nullptr, { &s_ed8bca69f7fb0cbf, nullptr, nullptr, 0, 0, nullptr }, false
+  2, 2, i_ed8bca69f7fb0cbf, nullptr, nullptr, { &s_ed8bca69f7fb0cbf, nullptr, nullptr, 0, 0, nullptr }, false, h_ed8bca69f7fb0cbf
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<46> b_c2573fe8a23e49f1 = {
@@ -2336,9 +2358,10 @@ static const ::capnp::_::RawSchema* const d_c2573fe8a23e49f1[] = {
 };
 static const uint16_t m_c2573fe8a23e49f1[] = {2, 1, 0};
 static const uint16_t i_c2573fe8a23e49f1[] = {0, 1, 2};
+static const uint16_t h_c2573fe8a23e49f1[] = {3, 5, 0, 1, 2};
 const ::capnp::_::RawSchema s_c2573fe8a23e49f1 = {
   0xc2573fe8a23e49f1, b_c2573fe8a23e49f1.words, 46, d_c2573fe8a23e49f1, m_c2573fe8a23e49f1,
-  4, 3, i_c2573fe8a23e49f1, nullptr, nullptr, { &s_c2573fe8a23e49f1, nullptr, nullptr, 0, 0, nullptr }, false
+  4, 3, i_c2573fe8a23e49f1, nullptr, nullptr, { &s_c2573fe8a23e49f1, nullptr, nullptr, 0, 0, nullptr }, false, h_c2573fe8a23e49f1
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<81> b_8e3b5f79fe593656 = {
@@ -2431,9 +2454,10 @@ static const ::capnp::_::RawSchema* const d_8e3b5f79fe593656[] = {
 };
 static const uint16_t m_8e3b5f79fe593656[] = {0, 3, 2, 1};
 static const uint16_t i_8e3b5f79fe593656[] = {0, 1, 2, 3};
+static const uint16_t h_8e3b5f79fe593656[] = {5, 1, 3, 1, 0, 2};
 const ::capnp::_::RawSchema s_8e3b5f79fe593656 = {
   0x8e3b5f79fe593656, b_8e3b5f79fe593656.words, 81, d_8e3b5f79fe593656, m_8e3b5f79fe593656,
-  1, 4, i_8e3b5f79fe593656, nullptr, nullptr, { &s_8e3b5f79fe593656, nullptr, nullptr, 0, 0, nullptr }, false
+  1, 4, i_8e3b5f79fe593656, nullptr, nullptr, { &s_8e3b5f79fe593656, nullptr, nullptr, 0, 0, nullptr }, false, h_8e3b5f79fe593656
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<50> b_9dd1f724f4614a85 = {
@@ -2495,9 +2519,10 @@ static const ::capnp::_::RawSchema* const d_9dd1f724f4614a85[] = {
 };
 static const uint16_t m_9dd1f724f4614a85[] = {1, 0};
 static const uint16_t i_9dd1f724f4614a85[] = {0, 1};
+static const uint16_t h_9dd1f724f4614a85[] = {0, 0, 1};
 const ::capnp::_::RawSchema s_9dd1f724f4614a85 = {
   0x9dd1f724f4614a85, b_9dd1f724f4614a85.words, 50, d_9dd1f724f4614a85, m_9dd1f724f4614a85,
-  1, 2, i_9dd1f724f4614a85, nullptr, nullptr, { &s_9dd1f724f4614a85, nullptr, nullptr, 0, 0, nullptr }, false
+  1, 2, i_9dd1f724f4614a85, nullptr, nullptr, { &s_9dd1f724f4614a85, nullptr, nullptr, 0, 0, nullptr }, false, h_9dd1f724f4614a85
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<37> b_baefc9120c56e274 = {
@@ -2546,9 +2571,10 @@ static const ::capnp::_::RawSchema* const d_baefc9120c56e274[] = {
 };
 static const uint16_t m_baefc9120c56e274[] = {0};
 static const uint16_t i_baefc9120c56e274[] = {0};
+static const uint16_t h_baefc9120c56e274[] = {0, 0};
 const ::capnp::_::RawSchema s_baefc9120c56e274 = {
   0xbaefc9120c56e274, b_baefc9120c56e274.words, 37, d_baefc9120c56e274, m_baefc9120c56e274,
-  1, 1, i_baefc9120c56e274, nullptr, nullptr, { &s_baefc9120c56e274, nullptr, nullptr, 0, 0, nullptr }, false
+  1, 1, i_baefc9120c56e274, nullptr, nullptr, { &s_baefc9120c56e274, nullptr, nullptr, 0, 0, nullptr }, false, h_baefc9120c56e274
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<43> b_903455f06065422b = {
@@ -2603,9 +2629,10 @@ static const ::capnp::_::RawSchema* const d_903455f06065422b[] = {
 };
 static const uint16_t m_903455f06065422b[] = {0};
 static const uint16_t i_903455f06065422b[] = {0};
+static const uint16_t h_903455f06065422b[] = {0, 0};
 const ::capnp::_::RawSchema s_903455f06065422b = {
   0x903455f06065422b, b_903455f06065422b.words, 43, d_903455f06065422b, m_903455f06065422b,
-  1, 1, i_903455f06065422b, nullptr, nullptr, { &s_903455f06065422b, nullptr, nullptr, 0, 0, nullptr }, false
+  1, 1, i_903455f06065422b, nullptr, nullptr, { &s_903455f06065422b, nullptr, nullptr, 0, 0, nullptr }, false, h_903455f06065422b
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<67> b_abd73485a9636bc9 = {
@@ -2684,9 +2711,10 @@ static const ::capnp::_::RawSchema* const d_abd73485a9636bc9[] = {
 };
 static const uint16_t m_abd73485a9636bc9[] = {1, 2, 0};
 static const uint16_t i_abd73485a9636bc9[] = {1, 2, 0};
+static const uint16_t h_abd73485a9636bc9[] = {0, 0, 2, 0, 1};
 const ::capnp::_::RawSchema s_abd73485a9636bc9 = {
   0xabd73485a9636bc9, b_abd73485a9636bc9.words, 67, d_abd73485a9636bc9, m_abd73485a9636bc9,
-  1, 3, i_abd73485a9636bc9, nullptr, nullptr, { &s_abd73485a9636bc9, nullptr, nullptr, 0, 0, nullptr }, false
+  1, 3, i_abd73485a9636bc9, nullptr, nullptr, { &s_abd73485a9636bc9, nullptr, nullptr, 0, 0, nullptr }, false, h_abd73485a9636bc9
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<49> b_c863cd16969ee7fc = {
@@ -2747,9 +2775,10 @@ static const ::capnp::_::RawSchema* const d_c863cd16969ee7fc[] = {
 };
 static const uint16_t m_c863cd16969ee7fc[] = {1, 0};
 static const uint16_t i_c863cd16969ee7fc[] = {0, 1};
+static const uint16_t h_c863cd16969ee7fc[] = {2, 1, 0};
 const ::capnp::_::RawSchema s_c863cd16969ee7fc = {
   0xc863cd16969ee7fc, b_c863cd16969ee7fc.words, 49, d_c863cd16969ee7fc, m_c863cd16969ee7fc,
-  1, 2, i_c863cd16969ee7fc, nullptr, nullptr, { &s_c863cd16969ee7fc, nullptr, nullptr, 0, 0, nullptr }, false
+  1, 2, i_c863cd16969ee7fc, nullptr, nullptr, { &s_c863cd16969ee7fc, nullptr, nullptr, 0, 0, nullptr }, false, h_c863cd16969ee7fc
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<305> b_ce23dcd2d7b00c9b = {
@@ -3063,9 +3092,10 @@ static const ::capnp::_::AlignedData<305> b_ce23dcd2d7b00c9b = {
 #if !CAPNP_LITE
 static const uint16_t m_ce23dcd2d7b00c9b[] = {18, 1, 13, 15, 10, 11, 3, 4, 5, 2, 17, 14, 16, 12, 7, 8, 9, 6, 0};
 static const uint16_t i_ce23dcd2d7b00c9b[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18};
+static const uint16_t h_ce23dcd2d7b00c9b[] = {0, 0, 21, 0, 3, 3, 2, 1, 0, 71, 6, 18, 0, 16, 1, 4, 3, 15, 2, 7, 17, 8, 13, 9, 11, 5, 14, 10, 12};
 const ::capnp::_::RawSchema s_ce23dcd2d7b00c9b = {
   0xce23dcd2d7b00c9b, b_ce23dcd2d7b00c9b.words, 305, nullptr, m_ce23dcd2d7b00c9b,
-  0, 19, i_ce23dcd2d7b00c9b, nullptr, nullptr, { &s_ce23dcd2d7b00c9b, nullptr, nullptr, 0, 0, nullptr }, true
+  0, 19, i_ce23dcd2d7b00c9b, nullptr, nullptr, { &s_ce23dcd2d7b00c9b, nullptr, nullptr, 0, 0, nullptr }, true, h_ce23dcd2d7b00c9b
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<63> b_f1c8950dab257542 = {
@@ -3141,9 +3171,10 @@ static const ::capnp::_::RawSchema* const d_f1c8950dab257542[] = {
 };
 static const uint16_t m_f1c8950dab257542[] = {2, 0, 1};
 static const uint16_t i_f1c8950dab257542[] = {0, 1, 2};
+static const uint16_t h_f1c8950dab257542[] = {13, 0, 0, 2, 1};
 const ::capnp::_::RawSchema s_f1c8950dab257542 = {
   0xf1c8950dab257542, b_f1c8950dab257542.words, 63, d_f1c8950dab257542, m_f1c8950dab257542,
-  2, 3, i_f1c8950dab257542, nullptr, nullptr, { &s_f1c8950dab257542, nullptr, nullptr, 0, 0, nullptr }, true
+  2, 3, i_f1c8950dab257542, nullptr, nullptr, { &s_f1c8950dab257542, nullptr, nullptr, 0, 0, nullptr }, true, h_f1c8950dab257542
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<54> b_d1958f7dba521926 = {
@@ -3205,9 +3236,10 @@ static const ::capnp::_::AlignedData<54> b_d1958f7dba521926 = {
 ::capnp::word const* const bp_d1958f7dba521926 = b_d1958f7dba521926.words;
 #if !CAPNP_LITE
 static const uint16_t m_d1958f7dba521926[] = {1, 2, 5, 0, 4, 7, 6, 3};
+static const uint16_t h_d1958f7dba521926[] = {1, 3, 0, 2, 6, 3, 7, 4, 5, 2, 1, 0};
 const ::capnp::_::RawSchema s_d1958f7dba521926 = {
   0xd1958f7dba521926, b_d1958f7dba521926.words, 54, nullptr, m_d1958f7dba521926,
-  0, 8, nullptr, nullptr, nullptr, { &s_d1958f7dba521926, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 8, nullptr, nullptr, nullptr, { &s_d1958f7dba521926, nullptr, nullptr, 0, 0, nullptr }, false, h_d1958f7dba521926
 };
 #endif  // !CAPNP_LITE
 CAPNP_DEFINE_ENUM(ElementSize_d1958f7dba521926, d1958f7dba521926);
@@ -3280,9 +3312,10 @@ static const ::capnp::_::AlignedData<63> b_d85d305b7d839963 = {
 #if !CAPNP_LITE
 static const uint16_t m_d85d305b7d839963[] = {0, 2, 1};
 static const uint16_t i_d85d305b7d839963[] = {0, 1, 2};
+static const uint16_t h_d85d305b7d839963[] = {3, 1, 1, 0, 2};
 const ::capnp::_::RawSchema s_d85d305b7d839963 = {
   0xd85d305b7d839963, b_d85d305b7d839963.words, 63, nullptr, m_d85d305b7d839963,
-  0, 3, i_d85d305b7d839963, nullptr, nullptr, { &s_d85d305b7d839963, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 3, i_d85d305b7d839963, nullptr, nullptr, { &s_d85d305b7d839963, nullptr, nullptr, 0, 0, nullptr }, false, h_d85d305b7d839963
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<98> b_bfc546f6210ad7ce = {
@@ -3395,9 +3428,10 @@ static const ::capnp::_::RawSchema* const d_bfc546f6210ad7ce[] = {
 };
 static const uint16_t m_bfc546f6210ad7ce[] = {2, 0, 1, 3};
 static const uint16_t i_bfc546f6210ad7ce[] = {0, 1, 2, 3};
+static const uint16_t h_bfc546f6210ad7ce[] = {1, 9, 3, 1, 0, 2};
 const ::capnp::_::RawSchema s_bfc546f6210ad7ce = {
   0xbfc546f6210ad7ce, b_bfc546f6210ad7ce.words, 98, d_bfc546f6210ad7ce, m_bfc546f6210ad7ce,
-  4, 4, i_bfc546f6210ad7ce, nullptr, nullptr, { &s_bfc546f6210ad7ce, nullptr, nullptr, 0, 0, nullptr }, true
+  4, 4, i_bfc546f6210ad7ce, nullptr, nullptr, { &s_bfc546f6210ad7ce, nullptr, nullptr, 0, 0, nullptr }, true, h_bfc546f6210ad7ce
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<74> b_cfea0eb02e810062 = {
@@ -3483,9 +3517,10 @@ static const ::capnp::_::RawSchema* const d_cfea0eb02e810062[] = {
 };
 static const uint16_t m_cfea0eb02e810062[] = {1, 0, 2};
 static const uint16_t i_cfea0eb02e810062[] = {0, 1, 2};
+static const uint16_t h_cfea0eb02e810062[] = {1, 1, 2, 1, 0};
 const ::capnp::_::RawSchema s_cfea0eb02e810062 = {
   0xcfea0eb02e810062, b_cfea0eb02e810062.words, 74, d_cfea0eb02e810062, m_cfea0eb02e810062,
-  1, 3, i_cfea0eb02e810062, nullptr, nullptr, { &s_cfea0eb02e810062, nullptr, nullptr, 0, 0, nullptr }, false
+  1, 3, i_cfea0eb02e810062, nullptr, nullptr, { &s_cfea0eb02e810062, nullptr, nullptr, 0, 0, nullptr }, false, h_cfea0eb02e810062
 };
 #endif  // !CAPNP_LITE
 static const ::capnp::_::AlignedData<52> b_ae504193122357e5 = {
@@ -3546,9 +3581,10 @@ static const ::capnp::_::AlignedData<52> b_ae504193122357e5 = {
 #if !CAPNP_LITE
 static const uint16_t m_ae504193122357e5[] = {0, 1};
 static const uint16_t i_ae504193122357e5[] = {0, 1};
+static const uint16_t h_ae504193122357e5[] = {0, 1, 0};
 const ::capnp::_::RawSchema s_ae504193122357e5 = {
   0xae504193122357e5, b_ae504193122357e5.words, 52, nullptr, m_ae504193122357e5,
-  0, 2, i_ae504193122357e5, nullptr, nullptr, { &s_ae504193122357e5, nullptr, nullptr, 0, 0, nullptr }, false
+  0, 2, i_ae504193122357e5, nullptr, nullptr, { &s_ae504193122357e5, nullptr, nullptr, 0, 0, nullptr }, false, h_ae504193122357e5
 };
 #endif  // !CAPNP_LITE
 }  // namespace schemas
@@ -0,0 +1,205 @@
+// Copyright (c) 2026 Cloudflare, Inc. and contributors
+// Licensed under the MIT License:
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include "striped-stream.h"
+#include "rpc-twoparty.h"
+#include "test-util.h"
+#include <kj/debug.h>
+#include <kj/test.h>
+
+namespace capnp {
+namespace _ {
+namespace {
+
+struct StripedPair {
+  kj::Own<kj::AsyncIoStream> left;
+  kj::Own<kj::AsyncIoStream> right;
+};
+
+StripedPair newStripedPair(uint count, size_t leftChunkSize, size_t rightChunkSize) {
+  // The right side lists the streams in reverse order, as though they were accepted in a
+  // different order than they were connected.
+  auto leftEnds = kj::heapArrayBuilder<kj::Own<kj::AsyncIoStream>>(count);
+  auto rightEnds = kj::heapArray<kj::Own<kj::AsyncIoStream>>(count);
+  for (uint i = 0; i < count; i++) {
+    auto pipe = kj::newTwoWayPipe();
+    leftEnds.add(kj::mv(pipe.ends[0]));
+    rightEnds[count - i - 1] = kj::mv(pipe.ends[1]);
+  }
+  return {
+    newStripedStream(leftEnds.finish(), leftChunkSize),
+    newStripedStream(kj::mv(rightEnds), rightChunkSize),
+  };
+}
+
+KJ_TEST("striped stream reassembles data in order") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  auto pair = newStripedPair(3, 1000, 64);
+
+  auto data = kj::heapArray<kj::byte>(100000);
+  for (auto i: kj::indices(data)) {
+    data[i] = i * 7 + i / 251;
+  }
+
+  // Write in two pieces, neither a multiple of the chunk size.
+  kj::ArrayPtr<const kj::byte> pieces[] = { data.slice(0, 1234), data.slice(1234, data.size()) };
+  auto writePromise = pair.left->write(pieces).then([&]() {
+    pair.left->shutdownWrite();
+  }).eagerlyEvaluate(nullptr);
+
+  auto received = kj::heapArray<kj::byte>(data.size() + 1);
+  size_t pos = 0;
+  for (;;) {
+    size_t n = pair.right->tryRead(received.begin() + pos, 1,
+        kj::min(received.size() - pos, 777)).wait(waitScope);
+    if (n == 0) break;
+    pos += n;
+  }
+  writePromise.wait(waitScope);
+
+  KJ_ASSERT(pos == data.size());
+  KJ_EXPECT(received.slice(0, pos) == data);
+
+  // Data flows the other way too, using the right side's chunk size.
+  auto reply = pair.right->write("hello world", 11);
+  char buffer[16];
+  pair.left->read(buffer, 11).wait(waitScope);
+  KJ_EXPECT(kj::heapString(buffer, 11) == "hello world");
+  reply.wait(waitScope);
+}
+
+KJ_TEST("striped stream reports EOF if the peer never wrote") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  auto pair = newStripedPair(2, 16, 16);
+  pair.left->shutdownWrite();
+
+  char buffer[4];
+  KJ_EXPECT(pair.right->tryRead(buffer, 1, sizeof(buffer)).wait(waitScope) == 0);
+}
+
+KJ_TEST("RPC over a striped stream") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  auto pair = newStripedPair(4, 256, 256);
+
+  int callCount = 0;
+  TwoPartyClient server(*pair.right, kj::heap<TestInterfaceImpl>(callCount),
+                        rpc::twoparty::Side::SERVER);
+  TwoPartyClient client(*pair.left);
+
+  auto cap = client.bootstrap().castAs<test::TestInterface>();
+  auto request = cap.bazRequest();
+  initTestMessage(request.initS());
+  request.send().wait(waitScope);
+
+  auto fooRequest = cap.fooRequest();
+  fooRequest.setI(123);
+  fooRequest.setJ(true);
+  KJ_EXPECT(fooRequest.send().wait(waitScope).getX() == "foo");
+  KJ_EXPECT(callCount == 2);
+}
+
+KJ_TEST("striped stream rejects out-of-sequence chunks") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  auto raw = kj::heapArrayBuilder<kj::Own<kj::AsyncIoStream>>(2);
+  auto ends = kj::heapArrayBuilder<kj::Own<kj::AsyncIoStream>>(2);
+  for (uint i = 0; i < 2; i++) {
+    auto pipe = kj::newTwoWayPipe();
+    raw.add(kj::mv(pipe.ends[0]));
+    ends.add(kj::mv(pipe.ends[1]));
+  }
+  auto rawStreams = raw.finish();
+  auto striped = newStripedStream(ends.finish());
+
+  // Hellos, then a chunk claiming sequence number 1 where 0 is expected.
+  const kj::byte hello0[] = { 0, 0, 0, 0, 2, 0, 0, 0 };
+  const kj::byte hello1[] = { 1, 0, 0, 0, 2, 0, 0, 0 };
+  const kj::byte badChunk[] = { 1, 0, 0, 0, 1, 0, 0, 0, 'x' };
+  auto writes = rawStreams[0]->write(hello0, sizeof(hello0))
+      .then([&]() { return rawStreams[0]->write(badChunk, sizeof(badChunk)); })
+      .exclusiveJoin(rawStreams[1]->write(hello1, sizeof(hello1)).then([]() {
+    return kj::Promise<void>(kj::NEVER_DONE);
+  })).eagerlyEvaluate(nullptr);
+
+  char buffer[4];
+  KJ_EXPECT_THROW_MESSAGE("out of sequence",
+      striped->tryRead(buffer, 1, sizeof(buffer)).wait(waitScope));
+}
+
+KJ_TEST("striped stream rejects a peer with a different number of streams") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  auto pipe = kj::newTwoWayPipe();
+  auto ends = kj::heapArrayBuilder<kj::Own<kj::AsyncIoStream>>(1);
+  ends.add(kj::mv(pipe.ends[1]));
+  auto striped = newStripedStream(ends.finish());
+
+  const kj::byte hello[] = { 0, 0, 0, 0, 3, 0, 0, 0 };
+  auto write = pipe.ends[0]->write(hello, sizeof(hello)).eagerlyEvaluate(nullptr);
+
+  char buffer[4];
+  KJ_EXPECT_THROW_MESSAGE("different number of streams",
+      striped->tryRead(buffer, 1, sizeof(buffer)).wait(waitScope));
+
+  // The failed handshake leaves the stream at EOF, rather than reading chunks from the wrong
+  // streams.
+  KJ_EXPECT(striped->tryRead(buffer, 1, sizeof(buffer)).wait(waitScope) == 0);
+}
+
+KJ_TEST("striped stream rejects duplicate stream indexes") {
+  kj::EventLoop loop;
+  kj::WaitScope waitScope(loop);
+
+  auto raw = kj::heapArrayBuilder<kj::Own<kj::AsyncIoStream>>(2);
+  auto ends = kj::heapArrayBuilder<kj::Own<kj::AsyncIoStream>>(2);
+  for (uint i = 0; i < 2; i++) {
+    auto pipe = kj::newTwoWayPipe();
+    raw.add(kj::mv(pipe.ends[0]));
+    ends.add(kj::mv(pipe.ends[1]));
+  }
+  auto rawStreams = raw.finish();
+  auto striped = newStripedStream(ends.finish());
+
+  // Both streams claim to be stream 0, so stream 1's position is never learned.
+  const kj::byte hello[] = { 0, 0, 0, 0, 2, 0, 0, 0 };
+  auto writes = rawStreams[0]->write(hello, sizeof(hello))
+      .exclusiveJoin(rawStreams[1]->write(hello, sizeof(hello)).then([]() {
+    return kj::Promise<void>(kj::NEVER_DONE);
+  })).eagerlyEvaluate(nullptr);
+
+  char buffer[4];
+  KJ_EXPECT_THROW_MESSAGE("invalid striped stream index",
+      striped->tryRead(buffer, 1, sizeof(buffer)).wait(waitScope));
+  KJ_EXPECT(striped->tryRead(buffer, 1, sizeof(buffer)).wait(waitScope) == 0);
+}
+
+}  // namespace
+}  // namespace _
+}  // namespace capnp
@@ -0,0 +1,250 @@
+// Copyright (c) 2026 Cloudflare, Inc. and contributors
+// Licensed under the MIT License:
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include "striped-stream.h"
+#include <kj/debug.h>
+#include <kj/vector.h>
+
+namespace capnp {
+
+namespace {
+
+constexpr size_t HEADER_SIZE = 8;
+// Both the per-stream hello and each chunk header consist of two little-endian 32-bit values:
+// (stream index, stream count) for the hello, and (sequence number, length) for a chunk.
+
+void writeHeader(kj::byte* out, uint32_t a, uint32_t b) {
+  for (uint i = 0; i < 4; i++) {
+    out[i] = a >> (i * 8);
+    out[i + 4] = b >> (i * 8);
+  }
+}
+
+uint32_t readUint32(const kj::byte* in) {
+  return uint32_t(in[0]) | (uint32_t(in[1]) << 8) | (uint32_t(in[2]) << 16) |
+         (uint32_t(in[3]) << 24);
+}
+
+class StripedStream final: public kj::AsyncIoStream {
+public:
+  StripedStream(kj::Array<kj::Own<kj::AsyncIoStream>> streamsParam, size_t chunkSize)
+      : streams(kj::mv(streamsParam)), chunkSize(chunkSize),
+        readOrder(kj::heapArray<uint>(streams.size())),
+        hellos(kj::heapArray<kj::byte>(streams.size() * HEADER_SIZE)) {
+    KJ_REQUIRE(streams.size() > 0, "striped stream needs at least one stream");
+    KJ_REQUIRE(chunkSize > 0 && chunkSize <= uint32_t(kj::maxValue),
+               "invalid stripe chunk size", chunkSize);
+    for (auto& i: readOrder) i = 0;
+  }
+
+  kj::Promise<size_t> tryRead(void* buffer, size_t minBytes, size_t maxBytes) override {
+    kj::Promise<void> ready = nullptr;
+    if (handshakeDone) {
+      ready = kj::READY_NOW;
+    } else {
+      ready = readHellos();
+    }
+    return ready.then([this, buffer, minBytes, maxBytes]() {
+      return readLoop(reinterpret_cast<kj::byte*>(buffer), minBytes, maxBytes, 0);
+    });
+  }
+
+  kj::Promise<void> write(const void* buffer, size_t size) override {
+    auto piece = kj::arrayPtr(reinterpret_cast<const kj::byte*>(buffer), size);
+    return write(kj::arrayPtr(&piece, 1));
+  }
+
+  kj::Promise<void> write(kj::ArrayPtr<const kj::ArrayPtr<const kj::byte>> pieces) override {
+    size_t total = 0;
+    for (auto& piece: pieces) total += piece.size();
+
+    uint chunkCount = (total + chunkSize - 1) / chunkSize;
+    uint helloCount = helloSent ? 0 : streams.size();
+    if (chunkCount == 0 && helloCount == 0) return kj::READY_NOW;
+
+    auto headers = kj::heapArray<kj::byte>((chunkCount + helloCount) * HEADER_SIZE);
+    kj::byte* nextHeader = headers.begin();
+    auto perStream = kj::heapArray<kj::Vector<kj::ArrayPtr<const kj::byte>>>(streams.size());
+
+    for (uint i = 0; i < helloCount; i++) {
+      writeHeader(nextHeader, i, streams.size());
+      perStream[i].add(kj::arrayPtr(nextHeader, HEADER_SIZE));
+      nextHeader += HEADER_SIZE;
+    }
+    helloSent = true;
+
+    // Cut the pieces into chunks, possibly spanning piece boundaries, and deal the chunks out.
+    size_t remaining = total;
+    size_t chunkRemaining = 0;
+    kj::Vector<kj::ArrayPtr<const kj::byte>>* target = nullptr;
+    for (auto piece: pieces) {
+      while (piece.size() > 0) {
+        if (chunkRemaining == 0) {
+          chunkRemaining = kj::min(remaining, chunkSize);
+          target = &perStream[writeSeq % streams.size()];
+          writeHeader(nextHeader, writeSeq++, chunkRemaining);
+          target->add(kj::arrayPtr(nextHeader, HEADER_SIZE));
+          nextHeader += HEADER_SIZE;
+        }
+        size_t n = kj::min(piece.size(), chunkRemaining);
+        target->add(piece.slice(0, n));
+        piece = piece.slice(n, piece.size());
+        chunkRemaining -= n;
+        remaining -= n;
+      }
+    }
+
+    kj::Vector<kj::Promise<void>> promises(streams.size());
+    for (auto i: kj::indices(streams)) {
+      if (perStream[i].size() > 0) {
+        promises.add(streams[i]->write(perStream[i].asPtr()));
+      }
+    }
+    return kj::joinPromises(promises.releaseAsArray()).attach(kj::mv(headers), kj::mv(perStream));
+  }
+
+  kj::Promise<void> whenWriteDisconnected() override {
+    kj::Promise<void> result = streams[0]->whenWriteDisconnected();
+    for (auto& stream: streams.slice(1, streams.size())) {
+      result = result.exclusiveJoin(stream->whenWriteDisconnected());
+    }
+    return result;
+  }
+
+  void shutdownWrite() override {
+    // Every stream ends at a chunk boundary, so the reader sees EOF on whichever stream it expects
+    // the next chunk from.
+    for (auto& stream: streams) stream->shutdownWrite();
+  }
+
+  void abortRead() override {
+    for (auto& stream: streams) stream->abortRead();
+  }
+
+private:
+  kj::Array<kj::Own<kj::AsyncIoStream>> streams;
+  size_t chunkSize;
+
+  bool helloSent = false;
+  uint32_t writeSeq = 0;
+
+  bool handshakeDone = false;
+  bool eof = false;
+  // Also set after any protocol error, so that later reads end rather than pick up mid-stream.
+  kj::Array<uint> readOrder;
+  // readOrder[i] is the position in `streams` of the peer's i'th stream.
+  kj::Array<kj::byte> hellos;
+  uint32_t readSeq = 0;
+  size_t chunkRemaining = 0;
+  uint currentStream = 0;
+
+  kj::Promise<void> readHellos() {
+    auto promises = kj::heapArrayBuilder<kj::Promise<size_t>>(streams.size());
+    for (auto i: kj::indices(streams)) {
+      promises.add(streams[i]->tryRead(hellos.begin() + i * HEADER_SIZE,
+                                       HEADER_SIZE, HEADER_SIZE));
+    }
+    return kj::joinPromises(promises.finish()).then([this](kj::Array<size_t> sizes) {
+      // Until every hello checks out, `readOrder` can't be trusted, so a handshake which fails in
+      // any way -- including by throwing -- leaves the stream at EOF.
+      handshakeDone = true;
+      eof = true;
+
+      auto seen = kj::heapArray<bool>(streams.size());
+      for (auto& s: seen) s = false;
+      for (auto i: kj::indices(streams)) {
+        if (sizes[i] == 0) {
+          // The peer shut down without ever writing.
+          return;
+        }
+        KJ_REQUIRE(sizes[i] == HEADER_SIZE, "striped stream ended during handshake") { return; }
+
+        const kj::byte* hello = hellos.begin() + i * HEADER_SIZE;
+        uint32_t index = readUint32(hello);
+        uint32_t count = readUint32(hello + 4);
+        KJ_REQUIRE(count == streams.size(),
+            "peer's striped stream has a different number of streams",
+            count, streams.size()) { return; }
+        KJ_REQUIRE(index < count && !seen[index], "invalid striped stream index", index) {
+          return;
+        }
+        seen[index] = true;
+        readOrder[index] = i;
+      }
+
+      eof = false;
+    });
+  }
+
+  kj::Promise<size_t> readLoop(kj::byte* buffer, size_t minBytes, size_t maxBytes,
+                               size_t alreadyRead) {
+    if (alreadyRead >= minBytes || eof) return alreadyRead;
+
+    if (chunkRemaining == 0) {
+      currentStream = readOrder[readSeq % streams.size()];
+      auto header = kj::heapArray<kj::byte>(HEADER_SIZE);
+      auto promise = streams[currentStream]->tryRead(header.begin(), HEADER_SIZE, HEADER_SIZE);
+      return promise.then([this, buffer, minBytes, maxBytes, alreadyRead,
+                           header = kj::mv(header)](size_t n) -> kj::Promise<size_t> {
+        // Cleared below once the header checks out.
+        eof = true;
+        if (n == 0) {
+          return alreadyRead;
+        }
+        KJ_REQUIRE(n == HEADER_SIZE, "striped stream ended mid-header") { return alreadyRead; }
+
+        uint32_t seq = readUint32(header.begin());
+        uint32_t size = readUint32(header.begin() + 4);
+        KJ_REQUIRE(seq == readSeq, "striped stream chunk out of sequence", seq, readSeq) {
+          return alreadyRead;
+        }
+        KJ_REQUIRE(size > 0, "empty striped stream chunk") { return alreadyRead; }
+        eof = false;
+        ++readSeq;
+        chunkRemaining = size;
+        return readLoop(buffer, minBytes, maxBytes, alreadyRead);
+      });
+    }
+
+    size_t n = kj::min(maxBytes - alreadyRead, chunkRemaining);
+    size_t want = kj::min(minBytes - alreadyRead, n);
+    return streams[currentStream]->tryRead(buffer + alreadyRead, want, n)
+        .then([this, buffer, minBytes, maxBytes, alreadyRead, want](size_t n)
+              -> kj::Promise<size_t> {
+      KJ_REQUIRE(n >= want, "striped stream ended mid-chunk") {
+        eof = true;
+        return alreadyRead + n;
+      }
+      chunkRemaining -= n;
+      return readLoop(buffer, minBytes, maxBytes, alreadyRead + n);
+    });
+  }
+};
+
+}  // namespace
+
+kj::Own<kj::AsyncIoStream> newStripedStream(
+    kj::Array<kj::Own<kj::AsyncIoStream>> streams, size_t chunkSize) {
+  return kj::heap<StripedStream>(kj::mv(streams), chunkSize);
+}
+
+}  // namespace capnp
@@ -0,0 +1,55 @@
+// Copyright (c) 2026 Cloudflare, Inc. and contributors
+// Licensed under the MIT License:
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#pragma once
+
+#include <capnp/common.h>
+#include <kj/async-io.h>
+
+CAPNP_BEGIN_HEADER
+
+namespace capnp {
+
+constexpr size_t DEFAULT_STRIPE_CHUNK_SIZE = 64 * 1024;
+
+kj::Own<kj::AsyncIoStream> newStripedStream(
+    kj::Array<kj::Own<kj::AsyncIoStream>> streams,
+    size_t chunkSize = DEFAULT_STRIPE_CHUNK_SIZE);
+// Combines several streams into one, splitting written data into chunks of at most `chunkSize`
+// bytes which are sent round-robin across `streams`. On a high-latency link, a single TCP
+// connection's throughput is limited by its window; striping over several connections multiplies
+// the achievable throughput. The result can be passed to TwoPartyVatNetwork (or TwoPartyClient)
+// like any other stream.
+//
+// Each chunk is prefixed with a sequence number and its length, and the reading side reassembles
+// chunks in sequence order. Before any data, each stream carries its index and the total stream
+// count, so the two sides need not list the streams in the same order -- e.g. a server may pass
+// streams in the order it accepted them. However, it is up to the application to decide which
+// connections belong to the same striped stream, and the other side must also use a striped
+// stream over the same number of connections. The two sides may use different chunk sizes.
+//
+// As with any AsyncIoStream, only one read and one write may be in progress at a time.
+// shutdownWrite() and abortRead() apply to all of the underlying streams.
+
+}  // namespace capnp
+
+CAPNP_END_HEADER
@@ -129,6 +129,14 @@ KJ_TEST("HttpHeaderTable") {
   KJ_EXPECT(KJ_ASSERT_NONNULL(table->stringToId("foo-BAR")) == fooBar);
   KJ_EXPECT(table->stringToId("foobar") == nullptr);
   KJ_EXPECT(table->stringToId("barfoo") == nullptr);
+
+  uint count = 0;
+  table->forEach([&](HttpHeaderId id, kj::StringPtr name) {
+    KJ_EXPECT(id.hashCode() == count);
+    KJ_EXPECT(table->idToString(id) == name);
+    ++count;
+  });
+  KJ_EXPECT(count == table->idCount());
 }
 
 KJ_TEST("HttpHeaders::parseRequest") {
@@ -246,6 +246,11 @@ public:
   kj::StringPtr idToString(HttpHeaderId id) const;
   // Get the canonical string name for the given ID.
 
+  template <typename Func>
+  void forEach(Func&& func) const;
+  // Calls `func(HttpHeaderId id, kj::StringPtr name)` for every ID in the table, in order of
+  // `id.hashCode()` (which ranges from 0 to idCount() - 1).
+
   bool isReady() const;
   // Returns true if this HttpHeaderTable either was default constructed or its Builder has
   // invoked `build()` and released it.
@@ -1411,6 +1416,13 @@ inline kj::StringPtr HttpHeaderTable::idToString(HttpHeaderId id) const {
   return namesById[id.id];
 }
 
+template <typename Func>
+inline void HttpHeaderTable::forEach(Func&& func) const {
+  for (auto i: kj::indices(namesById)) {
+    func(HttpHeaderId(this, i), namesById[i]);
+  }
+}
+
 inline kj::Maybe<kj::StringPtr> HttpHeaders::get(HttpHeaderId id) const {
   id.requireFrom(*table);
   auto result = indexedHeaders[id.id];